@@ -19,6 +19,7 @@
  */
 
 #include "CGSolver.h"
+#include "MatrixExpression.h"
 #include <lapacke.h>
 #include <math.h>
 
@@ -53,13 +54,13 @@ int CGSolver::solve(Matrix& b, Matrix& solution) {
     m_err = NAN;
     Matrix r(b);
     Matrix z = m_precond->call(r);
-    Matrix p = MatrixFactory::ShallowVector(z, 0);
+    Matrix p(z);                                    // p = z (p is updated in place below)
     bool keepgoing = true;
     Matrix Ap;
     while (keepgoing) {
         Ap = m_linop->call(p);                      // Ap = A * p
-        double a_denom = (p * Ap).get(0, 0);        //
-        double a_numer = (r * z).get(0, 0);         //
+        double a_denom = dot(lazy(p), lazy(Ap));    //
+        double a_numer = dot(lazy(r), lazy(z));     //
         double alpha = a_numer / a_denom;           // alpha = (r,z)/(p, Ap);
         Matrix::add(solution, alpha, p, 1.0);       // x = x + alpha * p
         Matrix r_new = r;                           // r_new = r
@@ -78,7 +79,7 @@ int CGSolver::solve(Matrix& b, Matrix& solution) {
         
         Matrix::add(r_new, -alpha, Ap, 1.0);        // r_new = r - alpha A p;
         Matrix z_new = m_precond->call(r_new);      // z_new = P(r_new)
-        double zr = (r_new * z_new).get(0, 0);      
+        double zr = dot(lazy(r_new), lazy(z_new));
         double beta = zr / a_numer;                 // beta = (r_new, z_nwq)/(r, z)
         Matrix::add(p, 1.0, z_new, beta);           // p = beta p + z_new
         z = z_new;                                  // z = z_new
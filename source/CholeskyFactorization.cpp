@@ -20,16 +20,27 @@
 
 #include "CholeskyFactorization.h"
 
+#include <algorithm>
+#include <cmath>
+
 CholeskyFactorization::CholeskyFactorization(Matrix& matrix) :
 FactoredSolver(matrix) {
     m_L = NULL;
+    m_Ls = NULL;
     m_factor = NULL;
+    m_factorized = false;
+    m_single = false;
+    m_kd = matrix.getLowerBandwidth();
     if (matrix.getNrows() != matrix.getNcols()){
         throw std::invalid_argument("CholeskyFactorization factorization can only be applied to square matrices");
     }
-    if (matrix.getType() != Matrix::MATRIX_SPARSE) {
+    if (matrix.getType() == Matrix::MATRIX_BLOCK) {
+        throw std::invalid_argument("CholeskyFactorization cannot be applied to block matrices");
+    }
+    if (matrix.getType() != Matrix::MATRIX_SPARSE && matrix.getType() != Matrix::MATRIX_DENSE) {
         this->m_L = new double[matrix.length()]();
     }
+    /* dense factors are allocated by factorize in the precision that is used */
 }
 
 CholeskyFactorization::~CholeskyFactorization() {
@@ -37,8 +48,12 @@ CholeskyFactorization::~CholeskyFactorization() {
         delete[] m_L;
         m_L = NULL;
     }
+    if (m_Ls != NULL) {
+        delete[] m_Ls;
+        m_Ls = NULL;
+    }
     if (m_factor != NULL) {
-        cholmod_free_factor(&m_factor, Matrix::cholmod_handle());
+        cholmod_free_factor(&m_factor, m_cholmod.handle());
         m_factor = NULL;
     }
 }
@@ -46,76 +61,236 @@ CholeskyFactorization::~CholeskyFactorization() {
 int CholeskyFactorization::factorize() {
     if (m_matrix_type == Matrix::MATRIX_SPARSE) {
         /* Cholesky decomposition of a SPARSE matrix: */
-        if (m_matrix->m_sparse == NULL) {
-            m_matrix->_createSparse();
+        m_matrix->_createSparse(); /* no-op if the CSC is up to date */
+        if (m_factor != NULL) {
+            cholmod_free_factor(&m_factor, m_cholmod.handle());
         }
         /* analyze */
-        m_factor = cholmod_analyze(m_matrix->m_sparse, Matrix::cholmod_handle());
+        m_factor = cholmod_analyze(m_matrix->m_sparse, m_cholmod.handle());
+        _savePattern(m_matrix->m_sparse);
         /* factorize */
-        cholmod_factorize(m_matrix->m_sparse, m_factor, Matrix::cholmod_handle());
+        cholmod_factorize(m_matrix->m_sparse, m_factor, m_cholmod.handle());
         /* Success: status = 0, else 1*/
         return (m_factor->minor == m_matrix->m_nrows) ? ForBESUtils::STATUS_OK : ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+    } else if (m_matrix_type == Matrix::MATRIX_BANDED) {
+        /* m_L := lower band of m_matrix (in LAPACK band storage) */
+        if (m_matrix->m_band_symmetric) {
+            memcpy(m_L, m_matrix->m_data, m_matrix->length() * sizeof (double));
+        } else {
+            for (size_t j = 0; j < m_matrix_nrows; j++) {
+                for (size_t i = j; i < std::min(m_matrix_nrows, j + m_kd + 1); i++) {
+                    m_L[i - j + j * (m_kd + 1)] = m_matrix->get(i, j);
+                }
+            }
+        }
+        return LAPACKE_dpbtrf(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, m_kd, m_L, m_kd + 1);
+    } else if (m_matrix_type == Matrix::MATRIX_SYMMETRIC) {
+        /* 
+         * m_L := m_matrix in rectangular full packed (RFP) format, which takes 
+         * as much memory as the packed storage, but allows the use of the 
+         * blocked (level-3) dpftrf instead of dpptrf.
+         */
+        int info = LAPACKE_dtpttf(LAPACK_COL_MAJOR, 'N', 'L', m_matrix_nrows, m_matrix->m_data, m_L);
+        if (info == ForBESUtils::STATUS_OK) {
+            info = LAPACKE_dpftrf(LAPACK_COL_MAJOR, 'N', 'L', m_matrix_nrows, m_L);
+        }
+        m_factorized = (info == ForBESUtils::STATUS_OK);
+        return info;
     } else { /* If this is any non-sparse matrix: */
-        memcpy(m_L, m_matrix->getData(), m_matrix->length() * sizeof (double)); /* m_L := m_matrix.m_data */
-        int info = ForBESUtils::STATUS_OK;
-        if (m_matrix_type == Matrix::MATRIX_DENSE) { /* This is a dense matrix */
-            info = LAPACKE_dpotrf(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, m_L, m_matrix_nrows);
+        if (m_matrix_type == Matrix::MATRIX_DENSE && m_mixed_precision) {
+            /* m_Ls := lower triangle of m_matrix in single precision */
+            if (m_Ls == NULL) {
+                m_Ls = new float[m_matrix_nrows * m_matrix_nrows];
+            }
+            _toSingle(m_matrix->m_data, m_matrix_nrows, m_Ls);
+            if (LAPACKE_spotrf(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, m_Ls, m_matrix_nrows) == ForBESUtils::STATUS_OK) {
+                m_single = true;
+                m_factorized = false;
+                return ForBESUtils::STATUS_OK;
+            }
+            /* not positive definite in single precision */
+        }
+        return factorizeDouble();
+    }
+}
+
+int CholeskyFactorization::factorizeDouble() {
+    if (m_Ls != NULL) { /* the single-precision factor is no longer used */
+        delete[] m_Ls;
+        m_Ls = NULL;
+    }
+    m_single = false;
+    if (m_L == NULL) {
+        m_L = new double[m_matrix->length()];
+    }
+    memcpy(m_L, m_matrix->m_data, m_matrix->length() * sizeof (double)); /* m_L := m_matrix.m_data */
+    int info = ForBESUtils::STATUS_OK;
+    if (m_matrix_type == Matrix::MATRIX_DENSE) { /* This is a dense matrix */
+        info = LAPACKE_dpotrf(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, m_L, m_matrix_nrows);
+        m_factorized = (info == ForBESUtils::STATUS_OK);
 #ifdef SET_L_OFFDIAG_TO_ZERO
-            for (size_t i = 0; i < m_matrix_nrows; i++) {
-                for (size_t j = i + 1; j < m_matrix_nrows; j++) {
-                    L.set(i, j, 0.0);
-                }
+        for (size_t i = 0; i < m_matrix_nrows; i++) {
+            for (size_t j = i + 1; j < m_matrix_nrows; j++) {
+                L.set(i, j, 0.0);
             }
+        }
 #endif
-        } else if (m_matrix_type == Matrix::MATRIX_SYMMETRIC) { /* This is a symmetric matrix */
-            info = LAPACKE_dpptrf(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, m_L);
+    }
+    return info;
+}
+
+int CholeskyFactorization::_solveSingle(float * x, size_t nrhs) {
+    return LAPACKE_spotrs(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, nrhs, m_Ls, m_matrix_nrows, x, m_matrix_nrows);
+}
+
+int CholeskyFactorization::refactorize() {
+    if (m_matrix_type != Matrix::MATRIX_SPARSE) {
+        /* dense factorizations have no symbolic phase */
+        size_t kd = (m_matrix_type == Matrix::MATRIX_BANDED) ? m_matrix->getLowerBandwidth() : m_kd;
+        if (kd != m_kd) { /* a banded matrix with a different bandwidth */
+            delete[] m_L;
+            m_L = new double[m_matrix->length()]();
+            m_kd = kd;
         }
-        return info;
+        return factorize();
+    }
+    m_matrix->_createSparse();
+    if (m_factor == NULL || !_hasSavedPattern(m_matrix->m_sparse)) {
+        return factorize();
     }
+    /* numeric factorization only (the symbolic factor is reused) */
+    cholmod_factorize(m_matrix->m_sparse, m_factor, m_cholmod.handle());
+    return (m_factor->minor == m_matrix->m_nrows) ? ForBESUtils::STATUS_OK : ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
 }
 
-int CholeskyFactorization::solve(Matrix& rhs, Matrix& solution) {
-    if (m_matrix_type == Matrix::MATRIX_SPARSE) {
-        cholmod_dense *x;
+/*
+ * Rank-one update (sign = 1) or downdate (sign = -1) of a lower triangular 
+ * Cholesky factor L (column-major, leading dimension ld), i.e., LL' := LL' + sign*xx',
+ * using (hyperbolic, for downdates) Givens rotations; x is overwritten. 
+ * Returns false if the downdated matrix is not positive definite.
+ */
+static bool cholesky_rank_one(double * L, size_t n, size_t ld, double * x, double sign) {
+    for (size_t k = 0; k < n; k++) {
+        double Lkk = L[k + k * ld];
+        double r_sq = Lkk * Lkk + sign * x[k] * x[k];
+        if (!(r_sq > 0.0)) {
+            return false;
+        }
+        double r = std::sqrt(r_sq);
+        double c = r / Lkk;
+        double s = x[k] / Lkk;
+        L[k + k * ld] = r;
+        for (size_t i = k + 1; i < n; i++) {
+            L[i + k * ld] = (L[i + k * ld] + sign * s * x[i]) / c;
+            x[i] = c * x[i] - s * L[i + k * ld];
+        }
+    }
+    return true;
+}
 
-        /* cast the RHS as a cholmod_dense b = rhs */
-        if (rhs.m_type == Matrix::MATRIX_DENSE) {
+int CholeskyFactorization::update(Matrix& C) {
+    return _updown(true, C);
+}
 
-            cholmod_dense *b;
-            b = cholmod_allocate_dense(rhs.m_nrows, rhs.m_ncols, rhs.m_nrows, CHOLMOD_REAL, Matrix::cholmod_handle());
-            b->x = rhs.m_data;
+int CholeskyFactorization::downdate(Matrix& C) {
+    return _updown(false, C);
+}
 
-            /* Solve - rhs is dense*/
-            x = cholmod_solve(CHOLMOD_A, m_factor, b, Matrix::cholmod_handle());
-            solution = Matrix(rhs.m_nrows, rhs.m_ncols);
-            solution.m_delete_data = false;
-            memcpy(solution.m_data, static_cast<double*> (x->x), rhs.m_nrows * rhs.m_ncols * sizeof (double));
-            cholmod_free_dense(&x, Matrix::cholmod_handle());
+int CholeskyFactorization::_updown(bool update, Matrix& C) {
+    if (C.getNrows() != m_matrix_nrows) {
+        throw std::invalid_argument("C must have as many rows as the factorized matrix");
+    }
+    if (m_matrix_type == Matrix::MATRIX_BANDED) {
+        throw std::logic_error("Updates of banded factorizations are not supported");
+    }
+    if (m_matrix_type == Matrix::MATRIX_SPARSE) {
+        if (m_factor == NULL) {
+            throw std::logic_error("The matrix has not been factorized");
+        }
+        return _updownFactor(update, C, m_factor, m_cholmod.handle());
+    }
+    if (m_single) { /* updates are applied to a double-precision factor */
+        int info = factorizeDouble();
+        if (info != ForBESUtils::STATUS_OK) {
+            return info;
+        }
+    }
+    if (!m_factorized || (m_matrix_type != Matrix::MATRIX_DENSE && m_matrix_type != Matrix::MATRIX_SYMMETRIC)) {
+        throw std::logic_error("The matrix has not been factorized");
+    }
+    size_t n = m_matrix_nrows;
+    double * L = m_L;
+    if (m_matrix_type == Matrix::MATRIX_SYMMETRIC) {
+        /* unpack the RFP factor */
+        L = new double[n * n]();
+        LAPACKE_dtfttr(LAPACK_COL_MAJOR, 'N', 'L', n, m_L, L, n);
+    }
+    double * x = new double[n];
+    double sign = update ? 1.0 : -1.0;
+    bool success = true;
+    for (size_t j = 0; j < C.getNcols() && success; j++) {
+        for (size_t i = 0; i < n; i++) {
+            x[i] = C.get(i, j);
+        }
+        success = cholesky_rank_one(L, n, n, x, sign);
+    }
+    delete[] x;
+    if (m_matrix_type == Matrix::MATRIX_SYMMETRIC) {
+        LAPACKE_dtrttf(LAPACK_COL_MAJOR, 'N', 'L', n, L, n, m_L);
+        delete[] L;
+    }
+    m_factorized = success;
+    return success ? ForBESUtils::STATUS_OK : ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+}
 
+int CholeskyFactorization::solve(Matrix& rhs, Matrix& solution) {
+    if (&rhs == &solution) {
+        Matrix rhs_copy(rhs); /* shares the data of rhs until solution is written */
+        return solve(rhs_copy, solution);
+    }
+    if (m_matrix_type == Matrix::MATRIX_SPARSE) {
+        if (rhs.m_type == Matrix::MATRIX_DENSE) {
+            /* solve directly into the storage of solution (reused if possible) */
+            _prepareSolution(solution, rhs.m_nrows, rhs.m_ncols);
+            const double * b = _rhsData(rhs, solution);
+            if (!m_cholmod.solve(CHOLMOD_A, m_factor, rhs.m_ncols, b, solution.m_data)) {
+                return ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+            }
         } else if (rhs.m_type == Matrix::MATRIX_SPARSE) {
             // still untested!
-            cholmod_sparse * rhs_sparse;
-            if (rhs.m_sparse == NULL) {
-                const_cast<Matrix&> (rhs)._createSparse();
+            cholmod_sparse * rhs_sparse = rhs._sparseOp(rhs.m_transpose);
+            cholmod_sparse * result = cholmod_spsolve(CHOLMOD_LDLt, m_factor, rhs_sparse, m_cholmod.handle());
+            if (rhs_sparse != rhs.m_sparse) {
+                cholmod_free_sparse(&rhs_sparse, Matrix::cholmod_handle());
             }
-            rhs_sparse = rhs.m_sparse;
-            cholmod_sparse * result = cholmod_spsolve(CHOLMOD_LDLt, m_factor, rhs_sparse, Matrix::cholmod_handle());
             solution = Matrix(rhs.m_nrows, rhs.m_ncols, Matrix::MATRIX_SPARSE);
             solution.m_sparse = result;
-            solution._createTriplet();
         } else {
             throw std::logic_error("Not supported");
         }
         return ForBESUtils::STATUS_OK;
     } else { /* the matrix to be factorized is not sparse */
         int info = ForBESUtils::STATUS_UNDEFINED_FUNCTION;
-        solution = Matrix(rhs);
+        _copyRhs(rhs, solution); /* overwritten by LAPACK below */
+        m_refinement_iterations = 0;
+        if (m_single) {
+            if (_solveMixed(m_matrix->m_data, m_matrix_nrows, rhs.m_ncols, solution.m_data)) {
+                return ForBESUtils::STATUS_OK;
+            }
+            /* the refinement has stalled (solution = rhs): use double precision */
+            info = factorizeDouble();
+            if (info != ForBESUtils::STATUS_OK) {
+                return info;
+            }
+        }
         if (m_matrix_type == Matrix::MATRIX_DENSE) {
             info = LAPACKE_dpotrs(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, rhs.m_ncols, m_L, m_matrix_nrows, solution.m_data, m_matrix_nrows);
         } else if (m_matrix_type == Matrix::MATRIX_SYMMETRIC) {
-            info = LAPACKE_dpptrs(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, rhs.m_ncols, m_L, solution.m_data, m_matrix_nrows);
+            info = LAPACKE_dpftrs(LAPACK_COL_MAJOR, 'N', 'L', m_matrix_nrows, rhs.m_ncols, m_L, solution.m_data, m_matrix_nrows);
+        } else if (m_matrix_type == Matrix::MATRIX_BANDED) {
+            info = LAPACKE_dpbtrs(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, m_kd, rhs.m_ncols, m_L, m_kd + 1, solution.m_data, m_matrix_nrows);
         } else {
-            throw std::invalid_argument("This matrix type is not supported - only DENSE, SPARSE and SYMMETRIC are supported");
+            throw std::invalid_argument("This matrix type is not supported - only DENSE, SPARSE, SYMMETRIC and BANDED are supported");
         }
         return info;
     }
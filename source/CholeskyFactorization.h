@@ -70,6 +70,10 @@
  *   
  *  delete cholesky;
  * \endcode
+ * 
+ * Sparse matrices are factorized by CHOLMOD using a context (workspace) which
+ * is owned by the factorization (see CholmodContext), so that different 
+ * factorizations can be computed and used by different threads concurrently.
  */
 class CholeskyFactorization : public FactoredSolver {
 public:
@@ -89,6 +93,21 @@ public:
      * matrix, then it is assumed it is symmetric (but there is no verification) and
      * only its lower triangular part is considered. Notice that the Cholesky factorization
      * can only be applied to symmetric and positive definite matrices.</p>  
+     * 
+     * <p>Symmetric matrices are converted from packed to rectangular full packed
+     * (RFP) storage, which takes the same memory, and are factorized with the
+     * blocked routine <code>dpftrf</code>.</p>
+     * 
+     * <p>Banded matrices are factorized with <code>dpbtrf</code> at a cost which
+     * is linear in their dimension. If a general (non-symmetric) banded matrix
+     * is given, it is assumed to be symmetric and only its lower band is 
+     * considered.</p>
+     * 
+     * <p>In mixed-precision mode (see \link FactoredSolver::setMixedPrecision
+     * setMixedPrecision\endlink), <code>MATRIX_DENSE</code> matrices are 
+     * factorized with <code>spotrf</code>; if the matrix is not numerically
+     * positive definite in single precision, <code>dpotrf</code> is used
+     * instead.</p>
      *      
      * @return status code. Returns <code>0</code> if the factorization succeeded.
      *      
@@ -117,11 +136,100 @@ public:
      */
     virtual int solve(Matrix& rhs, Matrix& solution);
 
+    using FactoredSolver::refactorize;
+
+    /**
+     * Recomputes the factorization after the values of the matrix have changed.
+     * 
+     * For sparse matrices, the symbolic analysis of the previous factorization
+     * (fill-reducing ordering and pattern of the factor), which typically takes 
+     * a considerable part of the factorization time, is reused provided that 
+     * the sparsity pattern of the matrix is the same; otherwise, the matrix is
+     * factorized from scratch. For all other types of matrices, this is the 
+     * same as #factorize.
+     * 
+     * Example of use:
+     * 
+     * \code{.cpp}
+     *  CholeskyFactorization cholesky(A);
+     *  cholesky.factorize();               // analysis and numeric factorization
+     *  for (size_t k = 0; k < n_steps; k++) {
+     *      A.set(0, 0, A.get(0, 0) + 1.0); // new values, same pattern
+     *      cholesky.refactorize();         // numeric factorization only
+     *      cholesky.solve(b, x);
+     *  }
+     * \endcode
+     * 
+     * @return status code (see #factorize)
+     */
+    virtual int refactorize(void);
+
+    /**
+     * Updates the factorization of \f$A\f$ so that it becomes the Cholesky
+     * factorization of \f$A+CC^{\top}\f$, where \f$C\in\mathbb{R}^{n\times k}\f$, 
+     * without factorizing the new matrix from scratch.
+     * 
+     * For sparse matrices this is done by CHOLMOD (<code>cholmod_updown</code>),
+     * while <code>MATRIX_DENSE</code> and <code>MATRIX_SYMMETRIC</code> factors 
+     * are modified by \f$k\f$ successive rank-one updates at a cost of 
+     * \f$O(n^2)\f$ each. Banded factors are not supported since the update
+     * would, in general, destroy their band structure.
+     * 
+     * The matrix that was passed to this solver is not modified; a subsequent
+     * call to #factorize or #refactorize will discard all updates.
+     * 
+     * @param C matrix \f$C\f$ (of any type) with as many rows as \f$A\f$
+     * @return status code. Returns <code>0</code> if the update succeeded.
+     * 
+     * \exception std::invalid_argument if \f$C\f$ has incompatible dimensions
+     * \exception std::logic_error if the matrix has not been factorized, or
+     * if it is banded
+     * 
+     * \sa #downdate
+     */
+    int update(Matrix& C);
+
+    /**
+     * Updates the factorization of \f$A\f$ so that it becomes the Cholesky
+     * factorization of \f$A-CC^{\top}\f$ (see #update).
+     * 
+     * If \f$A-CC^{\top}\f$ is not positive definite, this method returns 
+     * \link ForBESUtils::STATUS_NUMERICAL_PROBLEMS STATUS_NUMERICAL_PROBLEMS\endlink
+     * and the factorization is no longer valid; it needs to be recomputed 
+     * using #factorize.
+     * 
+     * @param C matrix \f$C\f$ (of any type) with as many rows as \f$A\f$
+     * @return status code. Returns <code>0</code> if the downdate succeeded.
+     * 
+     * \exception std::invalid_argument if \f$C\f$ has incompatible dimensions
+     * \exception std::logic_error if the matrix has not been factorized, or
+     * if it is banded
+     */
+    int downdate(Matrix& C);
+
+protected:
 
+    virtual int _solveSingle(float * x, size_t nrhs);
 
 private:
     double * m_L;
+    float * m_Ls; /**< single-precision factor (mixed-precision mode only) */
     cholmod_factor * m_factor;
+    CholmodContext m_cholmod; /**< CHOLMOD workspace of this factorization (sparse matrices only) */
+    size_t m_kd; /**< bandwidth (banded matrices only) */
+    bool m_factorized; /**< whether m_L holds a factor (non-sparse matrices only) */
+    bool m_single; /**< whether m_Ls holds the factor which is used by solve */
+
+    /**
+     * Factorizes a non-sparse matrix in double precision (discarding the 
+     * single-precision factor, if any).
+     */
+    int factorizeDouble();
+
+    /**
+     * Rank-k update (or downdate) of the factor, A := A + CC' (or A - CC').
+     */
+    int _updown(bool update, Matrix& C);
 
 };
 
@@ -0,0 +1,107 @@
+/*
+ * File:   CholmodContext.cpp
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 8:30 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CholmodContext.h"
+
+#include <mutex>
+
+/*
+ * cholmod_start initializes the global SuiteSparse configuration as well, so
+ * contexts are started one at a time
+ */
+static std::mutex & start_mutex() {
+    static std::mutex * const instance = new std::mutex();
+    return *instance;
+}
+
+/**
+ * Owner of the context of a thread; the context is destroyed when the thread
+ * exits.
+ */
+struct ThreadCholmodContext {
+    CholmodContext * context;
+
+    ThreadCholmodContext() : context(NULL) {
+    }
+
+    ~ThreadCholmodContext() {
+        delete context;
+    }
+};
+
+static thread_local ThreadCholmodContext thread_context;
+
+CholmodContext::CholmodContext() {
+    m_solve_Y = NULL;
+    m_solve_E = NULL;
+    std::lock_guard<std::mutex> lock(start_mutex());
+    cholmod_start(&m_common);
+}
+
+CholmodContext::~CholmodContext() {
+    cholmod_free_dense(&m_solve_Y, &m_common);
+    cholmod_free_dense(&m_solve_E, &m_common);
+    cholmod_finish(&m_common);
+}
+
+cholmod_common * CholmodContext::handle() {
+    return &m_common;
+}
+
+CholmodContext * CholmodContext::current() {
+    if (thread_context.context == NULL) {
+        thread_context.context = new CholmodContext();
+    }
+    return thread_context.context;
+}
+
+int CholmodContext::destroyCurrent() {
+    if (thread_context.context == NULL) {
+        return 0;
+    }
+    delete thread_context.context;
+    thread_context.context = NULL;
+    return 1;
+}
+
+bool CholmodContext::solve(int sys, cholmod_factor * L, size_t ncols, const double * b, double * x) {
+    cholmod_dense B = wrapDense(L->n, ncols, const_cast<double*> (b));
+    cholmod_dense X = wrapDense(L->n, ncols, x);
+    /* 
+     * X has the dimensions cholmod_solve2 expects, so it is used as is (and 
+     * not reallocated); B is read block-wise before the same block of X is 
+     * written, so b and x may coincide
+     */
+    cholmod_dense * X_handle = &X;
+    return cholmod_solve2(sys, L, &B, NULL, &X_handle, NULL, &m_solve_Y, &m_solve_E, &m_common) != 0;
+}
+
+cholmod_dense CholmodContext::wrapDense(size_t nrow, size_t ncol, double * x) {
+    cholmod_dense d;
+    d.nrow = nrow;
+    d.ncol = ncol;
+    d.nzmax = nrow * ncol;
+    d.d = nrow;
+    d.x = x;
+    d.z = NULL;
+    d.xtype = CHOLMOD_REAL;
+    d.dtype = CHOLMOD_DOUBLE;
+    return d;
+}
@@ -0,0 +1,130 @@
+/*
+ * File:   CholmodContext.h
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 8:30 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHOLMODCONTEXT_H
+#define	CHOLMODCONTEXT_H
+
+#include "cholmod.h"
+
+/**
+ * \class CholmodContext
+ * \brief A CHOLMOD workspace (<code>cholmod_common</code>)
+ * \version version 0.1
+ * \date Created on October 17, 2026, 8:30 PM
+ * \author ForBES contributors
+ *
+ * Every call to CHOLMOD needs a <code>cholmod_common</code> object, which holds
+ * parameters, statistics and workspace. Such an object must not be used by
+ * two threads at the same time, therefore, ForBES uses one context per thread
+ * and one context per sparse factorization:
+ *
+ * - Sparse matrix operations (e.g., products and sums of sparse matrices) use
+ *   the context of the calling thread (see #current and Matrix::cholmod_handle),
+ *   so different threads may operate on different sparse matrices concurrently.
+ * - Sparse factorizations (e.g., CholeskyFactorization) own a context, which
+ *   they use to compute, store and apply the factor. Different factorizations
+ *   may therefore be computed and used concurrently, even if they were created
+ *   by the same thread, while a single factorization must only be used by one
+ *   thread at a time.
+ *
+ * Sparse matrices are not bound to a context: all CHOLMOD objects are allocated
+ * by the same (global) memory allocator, so a matrix may be created by one
+ * thread and modified or destroyed by another.
+ *
+ * Contexts are created in a thread-safe way. The context of a thread is created
+ * when the thread first needs it and is destroyed when the thread exits (or
+ * when Matrix::destroy_handle is called).
+ */
+class CholmodContext {
+public:
+
+    /**
+     * Creates a new context with the default CHOLMOD parameters.
+     */
+    CholmodContext();
+
+    /**
+     * Destroys the context and its workspace.
+     */
+    virtual ~CholmodContext();
+
+    /**
+     * The <code>cholmod_common</code> object of this context.
+     * @return pointer to the <code>cholmod_common</code> of this context
+     */
+    cholmod_common * handle();
+
+    /**
+     * The context of the calling thread, which is created if it does not exist.
+     * @return context of the calling thread
+     */
+    static CholmodContext * current();
+
+    /**
+     * Destroys the context of the calling thread, if any; a new one will be
+     * created the next time #current is called.
+     *
+     * @return <code>1</code> if a context was destroyed and <code>0</code> if
+     * the calling thread had no context
+     */
+    static int destroyCurrent();
+
+    /**
+     * Solves a linear system using a CHOLMOD factor with <code>cholmod_solve2</code>.
+     * 
+     * The right-hand side and the solution are column-major arrays with
+     * <code>L->n</code> rows which are provided by the caller, so no memory is
+     * allocated for them. The workspaces of <code>cholmod_solve2</code> are kept
+     * in this context and are reused by subsequent calls (with the same or 
+     * fewer right-hand sides). The right-hand side may be solved in place, 
+     * i.e., <code>x</code> may be equal to <code>b</code>.
+     * 
+     * @param sys system to be solved (e.g., <code>CHOLMOD_A</code>)
+     * @param L CHOLMOD factor computed using this context
+     * @param ncols number of columns of the right-hand side
+     * @param b right-hand side
+     * @param x solution
+     * @return <code>true</code> if the system was solved successfully
+     */
+    bool solve(int sys, cholmod_factor * L, size_t ncols, const double * b, double * x);
+
+    /**
+     * A <code>cholmod_dense</code> header over an existing column-major buffer,
+     * so that it can be passed to CHOLMOD without copying (it must not be freed).
+     * 
+     * @param nrow number of rows
+     * @param ncol number of columns
+     * @param x data (of size at least <code>nrow*ncol</code>)
+     * @return <code>cholmod_dense</code> header
+     */
+    static cholmod_dense wrapDense(size_t nrow, size_t ncol, double * x);
+
+private:
+    CholmodContext(const CholmodContext&);
+    CholmodContext& operator=(const CholmodContext&);
+
+    cholmod_common m_common; /**< CHOLMOD parameters, statistics and workspace */
+    cholmod_dense * m_solve_Y; /**< workspace of cholmod_solve2 (see #solve) */
+    cholmod_dense * m_solve_E; /**< workspace of cholmod_solve2 (see #solve) */
+
+};
+
+#endif	/* CHOLMODCONTEXT_H */
+
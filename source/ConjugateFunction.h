@@ -50,6 +50,7 @@ class ConjugateFunction : public Function {
 public:
     
     using Function::call;
+    using Function::callProx;
     using Function::callConj;
 
     explicit ConjugateFunction(Function& funct);
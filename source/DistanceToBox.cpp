@@ -19,6 +19,7 @@
  */
 
 #include "DistanceToBox.h"
+#include "ElementWise.h"
 #include <cmath>
 
 void checkBounds(const Matrix* lb, const Matrix* ub);
@@ -43,6 +44,9 @@ void checkBounds(const Matrix* lb, const Matrix* ub) {
     if (lb->getType() != Matrix::MATRIX_DENSE || ub->getType() != Matrix::MATRIX_DENSE) {
         throw std::invalid_argument("UB and LB must be dense vectors - other types are not supported");
     }
+    if (!lb->isContiguous() || !ub->isContiguous()) {
+        throw std::invalid_argument("UB and LB cannot be strided views");
+    }
     //LCOV_EXCL_STOP
 }
 
@@ -56,6 +60,9 @@ Function(), m_weights(weights), m_lb(lb), m_ub(ub) {
     if (!weights->isColumnVector() || weights->isEmpty() || weights->getNrows() != lb->getNrows()) {
         throw std::invalid_argument("Invalid size of weights");
     }
+    if (!weights->isContiguous()) {
+        throw std::invalid_argument("The weights cannot be a strided view");
+    }
     //LCOV_EXCL_STOP
     checkBounds(lb, ub);
     m_is_weights_equal = false;
@@ -88,51 +95,39 @@ DistanceToBox::~DistanceToBox() {
     // nothing to delete
 }
 
-int DistanceToBox::compute_dx(const Matrix& x, const size_t n, Matrix& dx) const {
-    for (size_t i = 0; i < n; i++) {
-        if (x[i] < (m_is_bounds_uniform ? m_uniform_lb : m_lb->get(i))) {
-            dx[i] = x[i] - (m_is_bounds_uniform ? m_uniform_lb : m_lb->get(i));
-        } else if (x[i] > (m_is_bounds_uniform ? m_uniform_ub : m_ub->get(i))) {
-            dx[i] = x[i] - (m_is_bounds_uniform ? m_uniform_ub : m_ub->get(i));
-        }
+double DistanceToBox::compute_fun(Matrix& x, double * grad) const {
+    if (!x.isContiguous()) { /* strided view: evaluated on a compact copy */
+        Matrix x_compact(x);
+        return compute_fun(x_compact, grad);
     }
-    return ForBESUtils::STATUS_OK;
-}
-
-int DistanceToBox::compute_grad(Matrix& dx, const size_t n, Matrix& grad) const {
-    if (!m_is_weights_equal) {
-        for (size_t i = 0; i < n; i++) {
-            grad.set(i, 0, m_weights->get(i, 0) * dx.get(i, 0));
-        }
-    } else {
-        grad = m_weight * dx;
+    const Matrix& cx = x;
+    const double * lb = NULL;
+    const double * ub = NULL;
+    const double * w = NULL;
+    if (!m_is_bounds_uniform) {
+        const Matrix& clb = *m_lb;
+        const Matrix& cub = *m_ub;
+        lb = clb.getData();
+        ub = cub.getData();
     }
-    return ForBESUtils::STATUS_OK;
-}
-
-int DistanceToBox::compute_fun(const Matrix& dx, const size_t n, double& f) const {
-    f = 0.0;
-    for (size_t i = 0; i < n; i++) {
-        f += (m_is_weights_equal ? m_weight : m_weights->get(i, 0)) * std::pow(dx.get(i, 0), 2);
+    if (!m_is_weights_equal) {
+        const Matrix& cw = *m_weights;
+        w = cw.getData();
     }
-    f /= 2.0;
-    return ForBESUtils::STATUS_OK;
+    return ElementWise::distanceToBox(x.getNrows(), cx.getData(), lb, ub, w,
+            m_uniform_lb, m_uniform_ub, m_weight, grad);
 }
 
 int DistanceToBox::call(Matrix& x, double& f, Matrix& grad) {
-    const size_t n = x.getNrows(); // input dimension
-    Matrix dx(n, 1); // dx : n-by-1 (all zeros)
-    compute_dx(x, n, dx); // compute d(x)
-    compute_grad(dx, n, grad); // compute the gradient
-    compute_fun(dx, n, f); // compute f(x)
+    if (!grad.isContiguous()) { /* strided view */
+        return Function::call(VectorView(x), f, VectorView(grad));
+    }
+    f = compute_fun(x, grad.getData()); // f(x) and its gradient in one pass
     return ForBESUtils::STATUS_OK; // OK
 }
 
 int DistanceToBox::call(Matrix& x, double& f) {
-    const size_t n = x.getNrows(); // input dimension
-    Matrix dx(n, 1); // dx : n-by-1 (all zeros)
-    compute_dx(x, n, dx); // compute d(x)
-    compute_fun(dx, n, f); // compute f(x)
+    f = compute_fun(x, NULL); // compute f(x)
     return ForBESUtils::STATUS_OK; // OK
 }
 
@@ -144,9 +144,11 @@ public:
 
 private:
     
-    int compute_dx(const Matrix& x, const size_t n, Matrix& dx) const;
-    int compute_grad(Matrix& dx, const size_t n, Matrix& grad) const;
-    int compute_fun(const Matrix& dx, const size_t n, double& f) const;
+    /**
+     * Computes f(x) and, if <code>grad</code> is not <code>NULL</code>, 
+     * writes its gradient in <code>grad</code> (in a single pass over x).
+     */
+    double compute_fun(Matrix& x, double * grad) const;
 
     bool m_is_weights_equal; /**< Whether all weights are equal to each other. */
     bool m_is_bounds_uniform; /**< Whether box bounds are uniform. */
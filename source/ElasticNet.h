@@ -92,6 +92,7 @@ class ElasticNet : public Function{
 public:
     
     using Function::call;
+    using Function::callProx;
     
     /**
      * Create a new instance of ElasticNet with given parameters lambda and mu.
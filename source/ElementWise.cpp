@@ -0,0 +1,201 @@
+/*
+ * File:   ElementWise.cpp
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 7:25 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ElementWise.h"
+
+#include <cmath>
+#include <algorithm>
+
+/*
+ * The kernels of this file are compiled for several instruction sets and the
+ * dynamic loader picks the best one for the running CPU (GNU indirect
+ * functions). The generic templates of ElementWise.h are inlined into each
+ * version, so they are vectorized for the corresponding instruction set.
+ * Define FORBES_NO_SIMD_DISPATCH to compile a single version.
+ */
+#if defined(__GNUC__) && !defined(__clang__) && defined(__x86_64__) \
+    && defined(__linux__) && !defined(FORBES_NO_SIMD_DISPATCH)
+#define FORBES_SIMD_DISPATCH __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define FORBES_SIMD_DISPATCH
+#endif
+
+FORBES_SIMD_DISPATCH
+double ElementWise::sumAbs(size_t n, const double * x) {
+    return reduce(n, x, [](double xi) {
+        return std::fabs(xi);
+    });
+}
+
+FORBES_SIMD_DISPATCH
+double ElementWise::maxAbs(size_t n, const double * x) {
+    double m = 0.0;
+#pragma omp simd reduction(max:m)
+    for (size_t i = 0; i < n; i++) {
+        m = std::max(m, std::fabs(x[i]));
+    }
+    return m;
+}
+
+FORBES_SIMD_DISPATCH
+double ElementWise::sumSquares(size_t n, const double * x) {
+    return reduce(n, x, [](double xi) {
+        return xi * xi;
+    });
+}
+
+FORBES_SIMD_DISPATCH
+double ElementWise::subtractSumSquares(size_t n, const double * x, const double * z, double * d) {
+    return fusedReduce(n, [x, z, d](size_t i) {
+        double di = x[i] - z[i];
+        d[i] = di;
+        return di * di;
+    });
+}
+
+FORBES_SIMD_DISPATCH
+double ElementWise::softThreshold(size_t n, const double * x, double t, double * y) {
+    return fusedReduce(n, [x, t, y](size_t i) {
+        double xi = x[i];
+        double yi = (xi >= t) ? xi - t : ((xi <= -t) ? xi + t : 0.0);
+        y[i] = yi;
+        return std::fabs(yi);
+    });
+}
+
+FORBES_SIMD_DISPATCH
+void ElementWise::clamp(size_t n, const double * x, double lb, double ub, double * y) {
+    map(n, x, y, [lb, ub](double xi) {
+        return std::min(ub, std::max(lb, xi));
+    });
+}
+
+FORBES_SIMD_DISPATCH
+void ElementWise::clamp(size_t n, const double * x, const double * lb, const double * ub, double * y) {
+#pragma omp simd
+    for (size_t i = 0; i < n; i++) {
+        y[i] = std::min(ub[i], std::max(lb[i], x[i]));
+    }
+}
+
+FORBES_SIMD_DISPATCH
+size_t ElementWise::countOutside(size_t n, const double * x, double lb, double ub) {
+    size_t count = 0;
+#pragma omp simd reduction(+:count)
+    for (size_t i = 0; i < n; i++) {
+        count += (x[i] < lb || x[i] > ub) ? 1 : 0;
+    }
+    return count;
+}
+
+FORBES_SIMD_DISPATCH
+size_t ElementWise::countOutside(size_t n, const double * x, const double * lb, const double * ub) {
+    size_t count = 0;
+#pragma omp simd reduction(+:count)
+    for (size_t i = 0; i < n; i++) {
+        count += (x[i] < lb[i] || x[i] > ub[i]) ? 1 : 0;
+    }
+    return count;
+}
+
+FORBES_SIMD_DISPATCH
+double ElementWise::huber(size_t n, const double * x, double delta, double * grad) {
+    const double inv_delta = 1.0 / delta;
+    const double half_delta = delta / 2.0;
+    if (grad == NULL) {
+        return reduce(n, x, [delta, inv_delta, half_delta](double xi) {
+            double ai = std::fabs(xi);
+            return (ai <= delta) ? 0.5 * xi * xi * inv_delta : ai - half_delta;
+        });
+    }
+    return fusedReduce(n, [x, delta, inv_delta, half_delta, grad](size_t i) {
+        double xi = x[i];
+        double ai = std::fabs(xi);
+        bool quadratic = ai <= delta;
+        grad[i] = quadratic ? xi * inv_delta : std::copysign(1.0, xi);
+        return quadratic ? 0.5 * xi * xi * inv_delta : ai - half_delta;
+    });
+}
+
+FORBES_SIMD_DISPATCH
+double ElementWise::logLogistic(size_t n, const double * x, double mu, double * grad) {
+    /*
+     * With e = exp(-|x|) <= 1, log(1 + exp(-x)) = max(-x, 0) + log(1 + e)
+     * and sigma(x) - 1 = -e/(1+e) if x >= 0 and -1/(1+e) otherwise
+     */
+    double f;
+    if (grad == NULL) {
+        f = reduce(n, x, [](double xi) {
+            return std::max(-xi, 0.0) + std::log1p(std::exp(-std::fabs(xi)));
+        });
+    } else {
+        f = fusedReduce(n, [x, mu, grad](size_t i) {
+            double xi = x[i];
+            double ei = std::exp(-std::fabs(xi));
+            grad[i] = -mu * ((xi >= 0.0) ? ei : 1.0) / (1.0 + ei);
+            return std::max(-xi, 0.0) + std::log1p(ei);
+        });
+    }
+    return mu * f;
+}
+
+/*
+ * Squared distance from a box; the template arguments specify which of the
+ * bounds and weights are given element-wise, so that every combination is
+ * compiled into a branch-free loop
+ */
+template<bool VLB, bool VUB, bool VW>
+static inline double distance_to_box(size_t n, const double * x,
+        const double * lb, const double * ub, const double * w,
+        double lb0, double ub0, double w0, double * grad) {
+    double f;
+    if (grad == NULL) {
+        f = ElementWise::fusedReduce(n, [ = ](size_t i) {
+            double xi = x[i];
+            double di = xi - std::min(VUB ? ub[i] : ub0, std::max(VLB ? lb[i] : lb0, xi));
+            return (VW ? w[i] : w0) * di * di;
+        });
+    } else {
+        f = ElementWise::fusedReduce(n, [ = ](size_t i) {
+            double xi = x[i];
+            double di = xi - std::min(VUB ? ub[i] : ub0, std::max(VLB ? lb[i] : lb0, xi));
+            double gi = (VW ? w[i] : w0) * di;
+            grad[i] = gi;
+            return gi * di;
+        });
+    }
+    return f / 2.0;
+}
+
+FORBES_SIMD_DISPATCH
+double ElementWise::distanceToBox(size_t n, const double * x,
+        const double * lb, const double * ub, const double * w,
+        double lb0, double ub0, double w0, double * grad) {
+    switch ((lb != NULL ? 4 : 0) + (ub != NULL ? 2 : 0) + (w != NULL ? 1 : 0)) {
+        case 0: return distance_to_box<false, false, false>(n, x, lb, ub, w, lb0, ub0, w0, grad);
+        case 1: return distance_to_box<false, false, true>(n, x, lb, ub, w, lb0, ub0, w0, grad);
+        case 2: return distance_to_box<false, true, false>(n, x, lb, ub, w, lb0, ub0, w0, grad);
+        case 3: return distance_to_box<false, true, true>(n, x, lb, ub, w, lb0, ub0, w0, grad);
+        case 4: return distance_to_box<true, false, false>(n, x, lb, ub, w, lb0, ub0, w0, grad);
+        case 5: return distance_to_box<true, false, true>(n, x, lb, ub, w, lb0, ub0, w0, grad);
+        case 6: return distance_to_box<true, true, false>(n, x, lb, ub, w, lb0, ub0, w0, grad);
+        default: return distance_to_box<true, true, true>(n, x, lb, ub, w, lb0, ub0, w0, grad);
+    }
+}
@@ -20,6 +20,8 @@
 
 #include "FBCache.h"
 #include "LinearOperator.h"
+#include "MatrixExpression.h"
+#include "ElementWise.h"
 
 // #include <iostream>
 #include <cmath>
@@ -104,7 +106,7 @@ int FBCache::update_eval_f() {
 
     if (m_prob.f1() != NULL) {
         if (m_prob.L1() != NULL) {
-            *m_res1x = m_prob.L1()->call(*m_x);
+            ForBESUtils::fail_on_error(m_prob.L1()->call(*m_res1x, 1.0, *m_x, 0.0));
         } else {
             *m_res1x = *m_x;
         }
@@ -119,7 +121,7 @@ int FBCache::update_eval_f() {
 
     if (m_prob.f2() != NULL) {
         if (m_prob.L2() != NULL) {
-            *m_res2x = m_prob.L2()->call(*m_x);
+            ForBESUtils::fail_on_error(m_prob.L2()->call(*m_res2x, 1.0, *m_x, 0.0));
         } else {
             *m_res2x = *m_x;
         }
@@ -148,8 +150,7 @@ int FBCache::update_forward_step(double gamma) {
     }
 
     if (m_status >= FBCache::STATUS_FORWARD) {
-        *m_y = *m_x;
-        Matrix::add(*m_y, -gamma, *m_gradfx, 1.0);
+        evaluate(*m_y, lazy(*m_x) - gamma * lazy(*m_gradfx));
         m_gamma = gamma;
         return ForBESUtils::STATUS_OK;
     }
@@ -163,8 +164,11 @@ int FBCache::update_forward_step(double gamma) {
 
     if (m_prob.f1() != NULL) {
         if (m_prob.L1()) {
-            Matrix d_gradfx = m_prob.L1()->callAdjoint(*m_gradf1x);
-            *m_gradfx = d_gradfx;
+            /* gradfx = L1' * gradf1x (computed in place) */
+            status = m_prob.L1()->callAdjoint(*m_gradfx, 1.0, *m_gradf1x, 0.0);
+            if (!ForBESUtils::is_status_ok(status)) {
+                return status;
+            }
         } else {
             *m_gradfx = *m_gradf1x;
         }
@@ -176,9 +180,11 @@ int FBCache::update_forward_step(double gamma) {
             return status;
         }
         if (m_prob.L2() != NULL) {
-            Matrix d_gradfx = m_prob.L2()->callAdjoint(*m_gradf2x);
-            if (m_prob.f1() != NULL) *m_gradfx += d_gradfx;
-            else *m_gradfx = d_gradfx;
+            /* gradfx = L2' * gradf2x (+ gradfx, if f1 is present) */
+            status = m_prob.L2()->callAdjoint(*m_gradfx, 1.0, *m_gradf2x, m_prob.f1() != NULL ? 1.0 : 0.0);
+            if (!ForBESUtils::is_status_ok(status)) {
+                return status;
+            }
         } else {
             if (m_prob.f1() != NULL) *m_gradfx += *m_gradf2x;
             else *m_gradfx = *m_gradf2x;
@@ -193,8 +199,7 @@ int FBCache::update_forward_step(double gamma) {
         }
     }
 
-    *m_y = *m_x;
-    Matrix::add(*m_y, -gamma, *m_gradfx, 1.0);
+    evaluate(*m_y, lazy(*m_x) - gamma * lazy(*m_gradfx)); /* y = x - gamma * gradfx */
 
     m_gamma = gamma;
     m_status = FBCache::STATUS_FORWARD;
@@ -223,11 +228,20 @@ int FBCache::update_forward_backward_step(double gamma) {
     if (!ForBESUtils::is_status_ok(status)) {
         return status;
     }
-    *m_FPRx = (*m_x - *m_z);
-    m_sqnormFPRx = 0.0;
-    for (int i = 0; i < m_FPRx->length(); i++) {
-        double c = (*m_FPRx)[i];
-        m_sqnormFPRx += c*c;
+    const Matrix& x = *m_x;
+    const Matrix& z = *m_z;
+    Matrix& fpr = *m_FPRx;
+    if (x.getType() == Matrix::MATRIX_DENSE && z.getType() == Matrix::MATRIX_DENSE
+            && fpr.getType() == Matrix::MATRIX_DENSE
+            && x.isContiguous() && z.isContiguous() && fpr.isContiguous()
+            && x.isColumnVector() && z.isColumnVector() && fpr.isColumnVector()
+            && x.getNrows() == z.getNrows() && x.getNrows() == fpr.getNrows()) {
+        /* FPR = x - z and its squared norm in one pass */
+        m_sqnormFPRx = ElementWise::subtractSumSquares(fpr.getNrows(),
+                x.getData(), z.getData(), MatrixTerm::destination(fpr));
+    } else {
+        evaluate(*m_FPRx, lazy(*m_x) - lazy(*m_z));
+        m_sqnormFPRx = dot(lazy(*m_FPRx), lazy(*m_FPRx));
     }
 
     m_gamma = gamma;
@@ -252,11 +266,7 @@ int FBCache::update_eval_FBE(double gamma) {
         }
     }
 
-    Matrix innprox_mat(1, 1);
-    m_FPRx -> transpose();
-    Matrix::mult(innprox_mat, 1.0, *m_FPRx, *m_gradfx, 0.0);
-    m_FPRx -> transpose();
-    double innprod = innprox_mat[0];
+    double innprod = dot(lazy(*m_FPRx), lazy(*m_gradfx));
 
     m_FBEx = m_fx + m_gz - innprod + 0.5 / m_gamma*m_sqnormFPRx;
     m_gamma = gamma;
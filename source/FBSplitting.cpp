@@ -64,6 +64,7 @@ FBSplitting::~FBSplitting() {
 }
 
 int FBSplitting::run() {
+    MatrixArena arena; /* the temporaries of all iterations reuse pooled memory */
     int status = ForBESUtils::STATUS_OK;
     while (m_it < m_maxit && !stop() && !ForBESUtils::is_status_error(status)) {
         status = iterate();
@@ -1,4 +1,5 @@
 #include "FBStoppingRelative.h"
+#include "ElementWise.h"
 
 #include <cmath>
 #include <iostream>
@@ -8,13 +9,8 @@ FBStoppingRelative::FBStoppingRelative(double tol) : FBStopping(tol) {
 }
 
 int FBStoppingRelative::stop(FBCache & c) {
-    double normx = 0;
-    Matrix * x = c.get_point();
-    for (int i = 0; i < x->length(); i++) {
-        double acc = (*x)[i];
-        normx += acc*acc;
-    }
-    normx = sqrt(normx);
+    const Matrix& x = *c.get_point();
+    double normx = sqrt(ElementWise::sumSquares(x.length(), x.getData()));
     if (c.get_norm_fpr() <= m_tol * (1 + normx)) return 1;
     else return 0;
 }
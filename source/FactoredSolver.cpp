@@ -19,11 +19,209 @@
  */
 
 #include "FactoredSolver.h"
+#include "ForBESUtils.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#define MIXED_PRECISION_MAX_ITER 30
 
 FactoredSolver::FactoredSolver(Matrix& matrix) : MatrixSolver(matrix) {
-    
+    m_pattern_nrow = 0;
+    m_pattern_stype = 0;
+    m_mixed_precision = false;
+    m_refinement_iterations = 0;
+    m_single_norm = 0.0;
 }
 
 FactoredSolver::~FactoredSolver() {
 }
 
+int FactoredSolver::refactorize() {
+    return factorize();
+}
+
+int FactoredSolver::refactorize(Matrix& matrix) {
+    if (matrix.getType() != m_matrix_type) {
+        throw std::invalid_argument("The new matrix must be of the same type as the factorized one");
+    }
+    if (matrix.getNrows() != m_matrix_nrows || matrix.getNcols() != m_matrix_ncols) {
+        throw std::invalid_argument("The new matrix must have the same dimensions as the factorized one");
+    }
+    if (matrix.getType() == Matrix::MATRIX_BANDED
+            && (matrix.getLowerBandwidth() != m_matrix->getLowerBandwidth()
+            || matrix.getUpperBandwidth() != m_matrix->getUpperBandwidth())) {
+        throw std::invalid_argument("The new matrix must have the same bandwidths as the factorized one");
+    }
+    m_matrix = &matrix;
+    return refactorize();
+}
+
+void FactoredSolver::setMixedPrecision(bool mixed) {
+    m_mixed_precision = mixed;
+}
+
+bool FactoredSolver::isMixedPrecision() const {
+    return m_mixed_precision;
+}
+
+size_t FactoredSolver::getRefinementIterations() const {
+    return m_refinement_iterations;
+}
+
+void FactoredSolver::_toSingle(const double * A, size_t n, float * A_single) {
+    std::vector<double> row_sums(n, 0.0);
+    for (size_t j = 0; j < n; j++) {
+        for (size_t i = j; i < n; i++) {
+            double a_ij = A[i + j * n];
+            A_single[i + j * n] = static_cast<float> (a_ij);
+            row_sums[i] += std::abs(a_ij);
+            if (i != j) {
+                row_sums[j] += std::abs(a_ij);
+            }
+        }
+    }
+    m_single_norm = n > 0 ? *std::max_element(row_sums.begin(), row_sums.end()) : 0.0;
+}
+
+int FactoredSolver::_solveSingle(float * x, size_t nrhs) {
+    return ForBESUtils::STATUS_UNDEFINED_FUNCTION;
+}
+
+bool FactoredSolver::_solveMixed(const double * A, size_t n, size_t nrhs, double * x) {
+    const double tol = std::sqrt(static_cast<double> (n)) * std::numeric_limits<double>::epsilon() * m_single_norm;
+    std::vector<double> b(x, x + n * nrhs);
+    m_single_work.resize(n);
+    m_residual_work.resize(n);
+    float * d = &m_single_work[0];
+    double * r = &m_residual_work[0];
+    m_refinement_iterations = 0;
+    bool converged = true;
+    for (size_t j = 0; j < nrhs && converged; j++) {
+        double * x_j = x + j * n;
+        const double * b_j = &b[0] + j * n;
+        /* initial solution in single precision: x = A \ b */
+        std::copy(b_j, b_j + n, d);
+        converged = (_solveSingle(d, 1) == ForBESUtils::STATUS_OK);
+        std::copy(d, d + n, x_j);
+        double r_norm_previous = std::numeric_limits<double>::infinity();
+        for (size_t k = 0; converged; k++) {
+            /* r = b - A*x (double precision) */
+            std::copy(b_j, b_j + n, r);
+            cblas_dsymv(CblasColMajor, CblasLower, n, -1.0, A, n, x_j, 1, 1.0, r, 1);
+            double r_norm = std::abs(r[cblas_idamax(n, r, 1)]);
+            double x_norm = std::abs(x_j[cblas_idamax(n, x_j, 1)]);
+            if (r_norm <= tol * x_norm) {
+                break;
+            }
+            /* stop if the refinement does not converge (fast enough) */
+            if (k == MIXED_PRECISION_MAX_ITER || !(r_norm < 0.5 * r_norm_previous)) {
+                converged = false;
+                break;
+            }
+            r_norm_previous = r_norm;
+            /* x = x + A \ r */
+            std::copy(r, r + n, d);
+            converged = (_solveSingle(d, 1) == ForBESUtils::STATUS_OK);
+            for (size_t i = 0; i < n; i++) {
+                x_j[i] += d[i];
+            }
+            m_refinement_iterations++;
+        }
+    }
+    if (!converged) {
+        std::copy(b.begin(), b.end(), x);
+    }
+    return converged;
+}
+
+void FactoredSolver::_savePattern(const cholmod_sparse * A) {
+    m_pattern_p.clear();
+    m_pattern_i.clear();
+    if (!A->packed) {
+        return; /* never matches */
+    }
+    const int * Ap = static_cast<const int*> (A->p);
+    const int * Ai = static_cast<const int*> (A->i);
+    m_pattern_p.assign(Ap, Ap + A->ncol + 1);
+    m_pattern_i.assign(Ai, Ai + Ap[A->ncol]);
+    m_pattern_nrow = A->nrow;
+    m_pattern_stype = A->stype;
+}
+
+bool FactoredSolver::_hasSavedPattern(const cholmod_sparse * A) const {
+    if (!A->packed || m_pattern_p.empty() || A->nrow != m_pattern_nrow
+            || A->stype != m_pattern_stype || A->ncol + 1 != m_pattern_p.size()) {
+        return false;
+    }
+    const int * Ap = static_cast<const int*> (A->p);
+    const int * Ai = static_cast<const int*> (A->i);
+    return std::equal(m_pattern_p.begin(), m_pattern_p.end(), Ap)
+            && std::equal(m_pattern_i.begin(), m_pattern_i.end(), Ai);
+}
+
+int FactoredSolver::_updownFactor(bool update, Matrix& C, cholmod_factor * factor, cholmod_common * common) {
+    cholmod_sparse * C_sparse;
+    if (C.getType() == Matrix::MATRIX_SPARSE && C._sparseOp(false)->stype == 0) {
+        C_sparse = C._sparseOp(C.m_transpose);
+    } else {
+        /* a sparse copy of C without its zeros */
+        size_t n = C.getNrows();
+        size_t k = C.getNcols();
+        cholmod_dense * C_dense = cholmod_allocate_dense(n, k, n, CHOLMOD_REAL, common);
+        double * C_values = static_cast<double*> (C_dense->x);
+        for (size_t j = 0; j < k; j++) {
+            for (size_t i = 0; i < n; i++) {
+                C_values[i + j * n] = C.get(i, j);
+            }
+        }
+        C_sparse = cholmod_dense_to_sparse(C_dense, true, common);
+        cholmod_free_dense(&C_dense, common);
+    }
+    /* rows of C in the order of the factor: C(P, :) */
+    int * perm = static_cast<int*> (factor->Perm);
+    cholmod_sparse * C_perm = cholmod_submatrix(C_sparse, perm, perm == NULL ? -1 : static_cast<long> (factor->n),
+            NULL, -1, true, true, common);
+    if (C_sparse != C.m_sparse) {
+        cholmod_free_sparse(&C_sparse, common);
+    }
+    cholmod_updown(update, C_perm, factor, common);
+    cholmod_free_sparse(&C_perm, common);
+    return (factor->minor == factor->n) ? ForBESUtils::STATUS_OK : ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+}
+
+void FactoredSolver::_prepareSolution(Matrix& solution, size_t nrows, size_t ncols) {
+    if (solution.m_type == Matrix::MATRIX_DENSE && !solution.m_transpose && solution.m_data != NULL
+            && solution.isContiguous() && solution.length() == nrows * ncols) {
+        solution._detach(); /* other copies of solution keep their values */
+        solution.reshape(nrows, ncols);
+    } else {
+        solution = Matrix(nrows, ncols);
+    }
+}
+
+void FactoredSolver::_copyRhs(Matrix& rhs, Matrix& solution) {
+    _prepareSolution(solution, rhs.getNrows(), rhs.getNcols());
+    const double * b = _rhsData(rhs, solution);
+    if (b != solution.m_data) {
+        memcpy(solution.m_data, b, rhs.getNrows() * rhs.getNcols() * sizeof (double));
+    }
+}
+
+const double * FactoredSolver::_rhsData(Matrix& rhs, Matrix& solution) {
+    /* the data of a dense contiguous matrix (or vector) are its values in column-major order */
+    if (rhs.m_type == Matrix::MATRIX_DENSE && rhs.isContiguous()
+            && (!rhs.m_transpose || rhs.m_nrows == 1 || rhs.m_ncols == 1)) {
+        return rhs.m_data;
+    }
+    size_t n = rhs.getNrows();
+    for (size_t j = 0; j < rhs.getNcols(); j++) {
+        for (size_t i = 0; i < n; i++) {
+            solution.m_data[i + j * n] = rhs.get(i, j);
+        }
+    }
+    return solution.m_data;
+}
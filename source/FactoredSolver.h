@@ -25,6 +25,8 @@
 #include "LinSysSolver.h"
 #include "MatrixSolver.h"
 
+#include <vector>
+
 #ifdef USE_LIBS
 #include <cblas.h>
 #include <lapacke.h>
@@ -87,8 +89,208 @@ public:
      */
     virtual int solve(Matrix& rhs, Matrix& solution) = 0;
 
+    /**
+     * Recomputes the factorization after the values of the matrix have changed.
+     * 
+     * Sparse factorizations keep the symbolic analysis (fill-reducing ordering
+     * and the pattern of the factor) of the previous factorization and only
+     * recompute the numeric factor, as long as the sparsity pattern of the 
+     * matrix has not changed; otherwise, the matrix is factorized from scratch.
+     * If the matrix has not been factorized before, this is the same as 
+     * #factorize.
+     * 
+     * The default implementation calls #factorize.
+     * 
+     * @return status code (see #factorize)
+     */
+    virtual int refactorize(void);
+
+    /**
+     * Replaces the matrix of this solver by a matrix of the same type and 
+     * dimensions (typically, with the same sparsity pattern, but different 
+     * values) and recomputes the factorization (see #refactorize()).
+     * 
+     * As with the constructor, a reference to the given matrix is stored.
+     * 
+     * @param matrix new matrix
+     * @return status code (see #factorize)
+     * 
+     * \exception std::invalid_argument if the type or the dimensions (or, for
+     * banded matrices, the bandwidths) of the given matrix differ from those 
+     * of the current matrix
+     */
+    virtual int refactorize(Matrix& matrix);
+
+    /**
+     * Enables or disables the mixed-precision mode of this solver.
+     * 
+     * In mixed-precision mode, <code>MATRIX_DENSE</code> matrices are factorized 
+     * in single precision, which takes half the memory and typically about half 
+     * the time of a factorization in double precision. Every call to #solve 
+     * then computes a solution with the single-precision factor and refines 
+     * it iteratively, using residuals which are computed in double precision
+     * (with the matrix which was passed to this solver), until it is accurate
+     * to double precision. If the matrix cannot be factorized in single 
+     * precision, or if the refinement stalls (which is the case for matrices 
+     * whose condition number is of the order of \f$10^{7}\f$ or larger), the
+     * matrix is factorized in double precision and the solver no longer uses 
+     * the single-precision factor.
+     * 
+     * Matrices of all other types are always factorized in double precision.
+     * The new mode takes effect at the next call to #factorize.
+     * 
+     * \note In mixed-precision mode, #solve uses the matrix which was passed
+     * to this solver, so it must not be altered or destroyed as long as the 
+     * solver is in use.
+     * 
+     * @param mixed <code>true</code> to enable mixed precision
+     */
+    void setMixedPrecision(bool mixed);
+
+    /**
+     * Whether the mixed-precision mode is enabled (see #setMixedPrecision).
+     * 
+     * @return <code>true</code> if mixed precision is enabled
+     */
+    bool isMixedPrecision() const;
+
+    /**
+     * Number of steps of iterative refinement which were performed by the 
+     * last call to #solve (summed over all columns of the right-hand side).
+     * This is zero unless a single-precision factorization was used.
+     * 
+     * @return number of refinement steps
+     */
+    size_t getRefinementIterations() const;
+
+protected:
+
+    bool m_mixed_precision; /**< whether dense matrices are factorized in single precision */
+    size_t m_refinement_iterations; /**< refinement steps of the last solve */
+
+    /**
+     * Copies the lower triangle of a dense symmetric <code>n</code>-by-<code>n</code> 
+     * matrix into single precision (for a single-precision factorization) and
+     * stores its infinity norm, which is used by #_solveMixed.
+     * 
+     * @param A matrix (column-major, leading dimension <code>n</code>)
+     * @param n dimension
+     * @param A_single single-precision copy of the lower triangle of A
+     */
+    void _toSingle(const double * A, size_t n, float * A_single);
+
+    /**
+     * Solves linear systems with the single-precision factorization of this
+     * solver, in place.
+     * 
+     * The default implementation returns 
+     * \link ForBESUtils::STATUS_UNDEFINED_FUNCTION STATUS_UNDEFINED_FUNCTION\endlink.
+     * 
+     * @param x right-hand sides (column-major, overwritten by the solutions)
+     * @param nrhs number of right-hand sides
+     * @return status code
+     */
+    virtual int _solveSingle(float * x, size_t nrhs);
+
+    /**
+     * Solves \f$Ax=b\f$ by mixed-precision iterative refinement, i.e., using
+     * #_solveSingle and residuals which are computed in double precision, 
+     * where \f$A\f$ is a dense symmetric matrix (only the lower triangle of
+     * which is used), which has been passed to #_toSingle.
+     * 
+     * Refinement stops when \f$\|b-Ax\|_\infty \leq \sqrt{n}\epsilon\|A\|_\infty\|x\|_\infty\f$,
+     * like in LAPACK's <code>dsposv</code>.
+     * 
+     * @param A matrix (column-major, leading dimension <code>n</code>)
+     * @param n dimension
+     * @param nrhs number of right-hand sides
+     * @param x right-hand sides on entry, solutions on exit; if the refinement
+     * fails, the right-hand sides are restored
+     * @return <code>true</code> if the refinement converged for all right-hand
+     * sides and <code>false</code> if it stalled
+     */
+    bool _solveMixed(const double * A, size_t n, size_t nrhs, double * x);
+
+    /**
+     * Stores the sparsity pattern of a (packed) sparse matrix, which has been
+     * analyzed, so that it can be compared against future matrices using 
+     * #_hasSavedPattern.
+     * 
+     * @param A sparse matrix
+     */
+    void _savePattern(const cholmod_sparse * A);
+
+    /**
+     * Whether a sparse matrix has the same dimensions and sparsity pattern as 
+     * the one which was passed to #_savePattern.
+     * 
+     * @param A sparse matrix
+     * @return <code>true</code> if the pattern is the same
+     */
+    bool _hasSavedPattern(const cholmod_sparse * A) const;
+
+    /**
+     * Makes <code>solution</code> a dense <code>nrows</code>-by-<code>ncols</code>
+     * matrix which can be written to directly. The storage of <code>solution</code>
+     * is reused if it is dense, contiguous and has exactly 
+     * <code>nrows*ncols</code> elements (a larger buffer would leave stale
+     * data in it, which are seen by whole-storage operations such as 
+     * Matrix::norm_fro_sq); otherwise, new storage is allocated. The values 
+     * of <code>solution</code> are not defined.
+     * 
+     * @param solution matrix to be prepared
+     * @param nrows number of rows
+     * @param ncols number of columns
+     */
+    static void _prepareSolution(Matrix& solution, size_t nrows, size_t ncols);
+
+    /**
+     * Prepares <code>solution</code> using #_prepareSolution and copies the
+     * values of <code>rhs</code> into it (for solvers which work in place).
+     * 
+     * @param rhs right-hand side (of any type)
+     * @param solution matrix to be prepared
+     */
+    static void _copyRhs(Matrix& rhs, Matrix& solution);
+
+    /**
+     * The values of a right-hand side in (contiguous) column-major order. 
+     * These are the data of <code>rhs</code> if it is stored as such, 
+     * otherwise <code>rhs</code> is copied into <code>solution</code>, which 
+     * must have been prepared using #_prepareSolution.
+     * 
+     * @param rhs right-hand side (of any type)
+     * @param solution prepared solution
+     * @return pointer to the values of <code>rhs</code>
+     */
+    static const double * _rhsData(Matrix& rhs, Matrix& solution);
+
+    /**
+     * Modifies a CHOLMOD factor of a matrix \f$A\f$ so that it becomes a 
+     * factor of \f$A+CC^{\top}\f$ (update) or \f$A-CC^{\top}\f$ (downdate)
+     * using <code>cholmod_updown</code>. The rows of \f$C\f$ are permuted 
+     * according to the fill-reducing ordering of the factor.
+     * 
+     * @param update <code>true</code> to update and <code>false</code> to downdate
+     * @param C matrix \f$C\f$ (of any type)
+     * @param factor factor to be modified
+     * @param common CHOLMOD workspace of the factor
+     * @return \link ForBESUtils::STATUS_OK STATUS_OK\endlink if the modified
+     * matrix is positive definite and 
+     * \link ForBESUtils::STATUS_NUMERICAL_PROBLEMS STATUS_NUMERICAL_PROBLEMS\endlink
+     * otherwise
+     */
+    static int _updownFactor(bool update, Matrix& C, cholmod_factor * factor, cholmod_common * common);
+
 private:
 
+    std::vector<int> m_pattern_p; /**< column pointers of the saved pattern */
+    std::vector<int> m_pattern_i; /**< row indices of the saved pattern */
+    size_t m_pattern_nrow; /**< number of rows of the saved pattern */
+    int m_pattern_stype; /**< symmetry type of the saved pattern */
+    double m_single_norm; /**< infinity norm of the matrix passed to _toSingle */
+    std::vector<float> m_single_work; /**< single-precision workspace of _solveMixed */
+    std::vector<double> m_residual_work; /**< double-precision workspace of _solveMixed */
 
 };
 
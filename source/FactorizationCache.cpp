@@ -0,0 +1,124 @@
+/*
+ * File:   FactorizationCache.cpp
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 11:05 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "FactorizationCache.h"
+
+#include <stdexcept>
+
+FactorizationCache::FactorizationCache(size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("The capacity of a FactorizationCache must be positive");
+    }
+    m_capacity = capacity;
+    m_hits = 0;
+    m_misses = 0;
+}
+
+FactorizationCache::~FactorizationCache() {
+    clear();
+}
+
+void FactorizationCache::destroy(cache_entry& entry) {
+    /* the solver holds a reference to the matrix */
+    delete entry.solver;
+    entry.solver = NULL;
+    delete entry.matrix;
+    entry.matrix = NULL;
+}
+
+FactoredSolver * FactorizationCache::find(const void * owner, unsigned long version, double parameter) {
+    for (std::list<cache_entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->owner == owner && it->version == version && it->parameter == parameter) {
+            m_entries.splice(m_entries.begin(), m_entries, it); /* most recently used */
+            m_hits++;
+            return m_entries.front().solver;
+        }
+    }
+    m_misses++;
+    return NULL;
+}
+
+void FactorizationCache::insert(const void * owner, unsigned long version, double parameter, Matrix * matrix, FactoredSolver * solver) {
+    for (std::list<cache_entry>::iterator it = m_entries.begin(); it != m_entries.end(); ++it) {
+        if (it->owner == owner && it->version == version && it->parameter == parameter) {
+            destroy(*it);
+            m_entries.erase(it);
+            break;
+        }
+    }
+    shrink(m_capacity - 1);
+    cache_entry entry;
+    entry.owner = owner;
+    entry.version = version;
+    entry.parameter = parameter;
+    entry.matrix = matrix;
+    entry.solver = solver;
+    m_entries.push_front(entry);
+}
+
+size_t FactorizationCache::invalidate(const void * owner) {
+    size_t count = 0;
+    std::list<cache_entry>::iterator it = m_entries.begin();
+    while (it != m_entries.end()) {
+        if (it->owner == owner) {
+            destroy(*it);
+            it = m_entries.erase(it);
+            count++;
+        } else {
+            ++it;
+        }
+    }
+    return count;
+}
+
+void FactorizationCache::clear() {
+    shrink(0);
+}
+
+void FactorizationCache::shrink(size_t max_size) {
+    while (m_entries.size() > max_size) {
+        destroy(m_entries.back());
+        m_entries.pop_back();
+    }
+}
+
+size_t FactorizationCache::size() const {
+    return m_entries.size();
+}
+
+size_t FactorizationCache::getCapacity() const {
+    return m_capacity;
+}
+
+void FactorizationCache::setCapacity(size_t capacity) {
+    if (capacity == 0) {
+        throw std::invalid_argument("The capacity of a FactorizationCache must be positive");
+    }
+    m_capacity = capacity;
+    shrink(m_capacity);
+}
+
+size_t FactorizationCache::getHits() const {
+    return m_hits;
+}
+
+size_t FactorizationCache::getMisses() const {
+    return m_misses;
+}
@@ -0,0 +1,196 @@
+/*
+ * File:   FactorizationCache.h
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 11:05 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FACTORIZATIONCACHE_H
+#define	FACTORIZATIONCACHE_H
+
+#include "Matrix.h"
+#include "FactoredSolver.h"
+
+#include <list>
+
+/**
+ * \class FactorizationCache
+ * \brief A least-recently-used cache of factorizations
+ * \version version 0.1
+ * \date Created on October 17, 2026, 11:05 PM
+ * \author ForBES contributors
+ * \ingroup LinSysSolver-group
+ *
+ * Functions whose proximal operator (or conjugate) requires the solution of
+ * linear systems with a matrix which depends on a parameter, such as
+ * \f$I+\gamma Q\f$ for the proximal operator of a Quadratic function, need a
+ * new factorization for every value of the parameter. Algorithms with adaptive
+ * step sizes, however, keep revisiting a small set of values of \f$\gamma\f$.
+ *
+ * A FactorizationCache stores factorizations (instances of FactoredSolver
+ * together with the matrices they factorize) under a key which consists of
+ *
+ * - the owner of the factorization (e.g., the function which created it),
+ * - a version number, which the owner changes whenever the data the matrix
+ *   was constructed from change (e.g., when a new \f$Q\f$ is set), and
+ * - the value of the parameter (e.g., \f$\gamma\f$).
+ *
+ * The cache holds at most #getCapacity factorizations; when a new one is
+ * inserted into a full cache, the least recently used one is destroyed.
+ * A cache may be shared by several functions, e.g.,
+ *
+ * \code{.cpp}
+ * FactorizationCache cache(16);
+ * Quadratic f1(Q1);
+ * Quadratic f2(Q2);
+ * f1.setFactorizationCache(cache);
+ * f2.setFactorizationCache(cache);
+ * \endcode
+ *
+ * in which case the cache must outlive the functions which use it.
+ *
+ * \note A cache must not be used by more than one thread at a time.
+ */
+class FactorizationCache {
+public:
+
+    /**
+     * Creates a new empty cache.
+     *
+     * @param capacity maximum number of factorizations in the cache
+     *
+     * \exception std::invalid_argument if the capacity is zero
+     */
+    explicit FactorizationCache(size_t capacity = 8);
+
+    /**
+     * Destroys the cache and all factorizations it holds.
+     */
+    virtual ~FactorizationCache();
+
+    /**
+     * Looks up a factorization and marks it as the most recently used one.
+     *
+     * The returned solver belongs to the cache and remains valid until it is
+     * evicted, that is, until the next call to #insert, #invalidate, #clear
+     * or #setCapacity.
+     *
+     * @param owner owner of the factorization
+     * @param version version of the data of the owner
+     * @param parameter parameter of the factorized matrix
+     * @return cached solver or <code>NULL</code> if there is none
+     */
+    FactoredSolver * find(const void * owner, unsigned long version, double parameter);
+
+    /**
+     * Inserts a factorization into the cache, which takes ownership of both
+     * the solver and the factorized matrix (they are destroyed by the cache
+     * using <code>delete</code>). Any factorization which is stored under the
+     * same key is replaced and, if the cache is full, the least recently used
+     * factorization is evicted.
+     *
+     * @param owner owner of the factorization
+     * @param version version of the data of the owner
+     * @param parameter parameter of the factorized matrix
+     * @param matrix factorized matrix (allocated with <code>new</code>)
+     * @param solver factorization of <code>matrix</code> (allocated with <code>new</code>)
+     */
+    void insert(const void * owner, unsigned long version, double parameter, Matrix * matrix, FactoredSolver * solver);
+
+    /**
+     * Destroys all factorizations of an owner, e.g., when its data change or
+     * when it is destroyed.
+     *
+     * @param owner owner of the factorizations
+     * @return number of factorizations which were destroyed
+     */
+    size_t invalidate(const void * owner);
+
+    /**
+     * Destroys all factorizations in the cache.
+     */
+    void clear();
+
+    /**
+     * Number of factorizations in the cache.
+     * @return number of factorizations
+     */
+    size_t size() const;
+
+    /**
+     * Maximum number of factorizations in the cache.
+     * @return capacity
+     */
+    size_t getCapacity() const;
+
+    /**
+     * Changes the capacity of the cache; if there are more factorizations in
+     * the cache, the least recently used ones are destroyed.
+     *
+     * @param capacity new capacity
+     *
+     * \exception std::invalid_argument if the capacity is zero
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * Number of calls to #find which returned a cached factorization.
+     * @return number of hits
+     */
+    size_t getHits() const;
+
+    /**
+     * Number of calls to #find which returned <code>NULL</code>.
+     * @return number of misses
+     */
+    size_t getMisses() const;
+
+private:
+
+    FactorizationCache(const FactorizationCache&);
+    FactorizationCache& operator=(const FactorizationCache&);
+
+    /**
+     * A cached factorization
+     */
+    typedef struct factorization_cache_entry_struct {
+        const void * owner; /**< Owner of the factorization */
+        unsigned long version; /**< Version of the data of the owner */
+        double parameter; /**< Parameter of the factorized matrix */
+        Matrix * matrix; /**< Factorized matrix */
+        FactoredSolver * solver; /**< Factorization of the matrix */
+    } cache_entry;
+
+    std::list<cache_entry> m_entries; /**< Cached factorizations (most recently used first) */
+    size_t m_capacity; /**< Maximum number of factorizations */
+    size_t m_hits; /**< Number of successful look-ups */
+    size_t m_misses; /**< Number of unsuccessful look-ups */
+
+    /**
+     * Destroys the solver and the matrix of an entry.
+     */
+    static void destroy(cache_entry& entry);
+
+    /**
+     * Evicts the least recently used entries so that at most
+     * <code>max_size</code> remain.
+     */
+    void shrink(size_t max_size);
+
+};
+
+#endif	/* FACTORIZATIONCACHE_H */
+
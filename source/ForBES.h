@@ -34,14 +34,22 @@
 /*
  * MATRICES and FACTORIZATIONS
  */
+#include "MatrixAllocator.h"        /* Aligned, pooled memory for matrices */
 #include "Matrix.h"                 /* Matrices */
+#include "Vector.h"                 /* Lightweight vectors and vector views */
+#include "MatrixF.h"                /* Single-precision matrices */
 #include "MatrixFactory.h"          /* Matrix Factory to construct matrices */
+#include "SparseMatrixBuilder.h"    /* Entry-by-entry assembly of sparse matrices */
+#include "MatrixExpression.h"       /* Lazy expressions (linear combinations, dot products) */
+#include "ElementWise.h"            /* Vectorized element-wise kernels */
 #include "LinSysSolver.h"           /* Abstraction tier for linear system solvers */
 #include "FactoredSolver.h"         /* Generic factored solver tier */
+#include "FactorizationCache.h"     /* LRU cache of factorizations */
 #include "LDLFactorization.h"       /* LDL factorization */
 #include "CholeskyFactorization.h"  /* Cholesky factorization */
 #include "S_LDLFactorization.h"     /* LDL' factorization of AA'+bI */
 #include "CGSolver.h"               /* Conjugate gradient solver (for linear operators) */
+#include "TriangularSolver.h"       /* Solver for triangular systems */
 #include "MatrixSolver.h"           /* Factorized solver for matrices */
 
 /* 
@@ -64,6 +64,40 @@ int Function::callProx(Matrix& x, double gamma, Matrix& prox, double& f_at_prox)
 }
 //LCOV_EXCL_STOP
 
+/*
+ * The following methods wrap their arguments into matrices; strided views are
+ * copied into contiguous vectors, as most functions index their arguments
+ * directly, and the outputs are written back.
+ */
+int Function::call(VectorView x, double& f) {
+    Matrix x_mat = x.asContiguousMatrix();
+    return call(x_mat, f);
+}
+
+int Function::call(VectorView x, double& f, VectorView grad) {
+    Matrix x_mat = x.asContiguousMatrix();
+    Matrix grad_mat = grad.asContiguousMatrix();
+    int status = call(x_mat, f, grad_mat);
+    grad.copyFrom(grad_mat);
+    return status;
+}
+
+int Function::callProx(VectorView x, double gamma, VectorView prox) {
+    Matrix x_mat = x.asContiguousMatrix();
+    Matrix prox_mat = prox.asContiguousMatrix();
+    int status = callProx(x_mat, gamma, prox_mat);
+    prox.copyFrom(prox_mat);
+    return status;
+}
+
+int Function::callProx(VectorView x, double gamma, VectorView prox, double& f_at_prox) {
+    Matrix x_mat = x.asContiguousMatrix();
+    Matrix prox_mat = prox.asContiguousMatrix();
+    int status = callProx(x_mat, gamma, prox_mat, f_at_prox);
+    prox.copyFrom(prox_mat);
+    return status;
+}
+
 Function& Function::operator=(const Function& right) {
     if (this == &right) { // Check for self-assignment!
         return *this;
@@ -23,6 +23,7 @@
 #define	FUNCTION_H
 
 #include "Matrix.h"
+#include "Vector.h"
 #include "ForBESUtils.h"
 #include "FunctionOntologicalClass.h"
 #include "FunctionOntologyRegistry.h"
@@ -266,6 +267,61 @@ public:
      */
     virtual int hessianProductConj(Matrix& x, Matrix& z, Matrix& Hz);
 
+    /**
+     * Same as \link Function::call(Matrix&, double&) call(Matrix&, double&)\endlink,
+     * but on a lightweight vector.
+     * 
+     * The default implementation wraps <code>x</code> in a shallow %Matrix and
+     * calls \link Function::call(Matrix&, double&) call(Matrix&, double&)\endlink;
+     * functions which are evaluated frequently on small vectors override it 
+     * to avoid this overhead.
+     * 
+     * @param x the vector where \f$f(x)\f$ should be computed
+     * @param f the computed value of \f$f(x)\f$
+     * @return status code (see \link Function::call(Matrix&, double&) call(Matrix&, double&)\endlink)
+     */
+    virtual int call(VectorView x, double& f);
+
+    /**
+     * Same as \link Function::call(Matrix&, double&, Matrix&) call(Matrix&, double&, Matrix&)\endlink,
+     * but on lightweight vectors.
+     * 
+     * @param x the vector where \f$f(x)\f$ should be computed
+     * @param f the computed value of \f$f(x)\f$
+     * @param grad the gradient of f at x, \f$\nabla f(x)\f$
+     * @return status code
+     * 
+     * \sa call(VectorView, double&)
+     */
+    virtual int call(VectorView x, double& f, VectorView grad);
+
+    /**
+     * Same as \link Function::callProx(Matrix&, double, Matrix&) callProx(Matrix&, double, Matrix&)\endlink,
+     * but on lightweight vectors.
+     * 
+     * @param x the vector x where \f$\mathrm{prox}_{\gamma f}(x)\f$ should be computed
+     * @param gamma the parameter \f$\gamma\f$ of \f$\mathrm{prox}_{\gamma f}\f$
+     * @param prox the result of this operation
+     * @return status code
+     * 
+     * \sa call(VectorView, double&)
+     */
+    virtual int callProx(VectorView x, double gamma, VectorView prox);
+
+    /**
+     * Same as \link Function::callProx(Matrix&, double, Matrix&, double&) callProx(Matrix&, double, Matrix&, double&)\endlink,
+     * but on lightweight vectors.
+     * 
+     * @param x the vector x where \f$\mathrm{prox}_{\gamma f}(x)\f$ should be computed
+     * @param gamma the parameter \f$\gamma\f$ of \f$\mathrm{prox}_{\gamma f}\f$
+     * @param prox the result of this operation
+     * @param f_at_prox value of this function at the proximal operator
+     * @return status code
+     * 
+     * \sa call(VectorView, double&)
+     */
+    virtual int callProx(VectorView x, double gamma, VectorView prox, double& f_at_prox);
+
     /**
      * Assignment operator throws a logic_error whenever it is invoked. The assignment
      * operator is not supported and is not allowed on such objects.
@@ -60,6 +60,7 @@ class HingeLoss : public Function {
 public:
 
     using Function::call;
+    using Function::callProx;
     
     /**
      * Create a new instance of HingleLoss providing the parameters b and mu.
@@ -19,6 +19,7 @@
  */
 
 #include "HuberLoss.h"
+#include "ElementWise.h"
 #include <cmath>
 
 HuberLoss::HuberLoss(double delta) :
@@ -34,16 +35,12 @@ int HuberLoss::call(Matrix& x, double& f) {
         throw std::invalid_argument("x must be a column-vector");
     }
     //LCOV_EXCL_STOP
-    f = 0.0;
-    for (size_t i = 0; i < x.getNrows(); i++) {
-        double xi;
-        xi = x[i];
-        if (std::abs(xi) <= m_delta) {
-            f += std::pow(xi, 2) / (2.0 * m_delta);
-        } else {
-            f += std::abs(xi) - m_delta / 2.0;
-        }
+    if (!x.isContiguous()) { /* strided view: evaluated on a compact copy */
+        Matrix x_compact(x);
+        return call(x_compact, f);
     }
+    const Matrix& cx = x;
+    f = ElementWise::huber(x.getNrows(), cx.getData(), m_delta, NULL);
     return ForBESUtils::STATUS_OK;
 }
 
@@ -53,18 +50,11 @@ int HuberLoss::call(Matrix& x, double& f, Matrix& grad) {
         throw std::invalid_argument("x must be a column-vector");
     }
     //LCOV_EXCL_STOP
-    f = 0.0;
-    for (size_t i = 0; i < x.getNrows(); i++) {
-        double xi;
-        xi = x[i];
-        if (std::abs(xi) <= m_delta) {
-            f += std::pow(xi, 2) / (2.0 * m_delta);
-            grad[i] = xi / m_delta;
-        } else {
-            f += std::abs(xi) - m_delta / 2.0;
-            grad[i] = std::signbit(xi) ? -1.0 : 1.0;
-        }
+    if (!x.isContiguous() || !grad.isContiguous()) { /* strided views */
+        return Function::call(VectorView(x), f, VectorView(grad));
     }
+    const Matrix& cx = x;
+    f = ElementWise::huber(x.getNrows(), cx.getData(), m_delta, grad.getData());
     return ForBESUtils::STATUS_OK;
 }
 
@@ -61,6 +61,9 @@
  */
 class IndBall2 : public Function {
 public:
+
+    using Function::callProx;
+
     /**
      * Construct a new instance of IndBall2 centered at the origin \f$x_c=0\f$ and
      * with radius \f$\rho=1.0\f$.
@@ -20,6 +20,7 @@
 
 
 #include "IndBox.h"
+#include "ElementWise.h"
 #include <cmath>
 #include <assert.h>
 
@@ -37,6 +38,12 @@ IndBox::IndBox(Matrix& lb, Matrix& ub) : Function() {
     if (!ub.isColumnVector()) {
         throw std::invalid_argument("UB must be a vector");
     }
+    if (lb.getType() != Matrix::MATRIX_DENSE || ub.getType() != Matrix::MATRIX_DENSE) {
+        throw std::invalid_argument("LB and UB must be dense vectors");
+    }
+    if (!lb.isContiguous() || !ub.isContiguous()) {
+        throw std::invalid_argument("LB and UB cannot be strided views");
+    }
     m_lb = &lb;
     m_ub = &ub;
     m_uniform_lb = NULL;
@@ -50,74 +57,52 @@ int IndBox::call(Matrix& x, double& f) {
     if (!x.isColumnVector()) {
         throw std::invalid_argument("x must be a vector");
     }
-    bool isInside = true;
-    volatile size_t i = 0;
-
-    if (m_uniform_lb != NULL && !isinf(-(*m_uniform_lb))) { /* there's a uniform LB and this is not -inf*/
-        while (i < x.getNrows() && isInside) {
-            if (m_uniform_lb != NULL) {
-                isInside = isInside && (x[i] >= *m_uniform_lb);
-            }
-            i++;
-        }
-        i = 0;
-    }
-
-    if (m_uniform_ub != NULL && !isinf(*m_uniform_ub)) {/* there's a uniform UB and this is not +inf*/
-        while (i < x.getNrows() && isInside) {
-            if (m_uniform_lb != NULL) {
-                isInside = isInside && x[i] <= *m_uniform_ub;
-            }
-            i++;
-        }
-        i = 0;
+    if (!x.isContiguous()) { /* strided view: evaluated on a compact copy */
+        Matrix x_compact(x);
+        return call(x_compact, f);
     }
-
-    if (m_lb != NULL) {
-        while (i < x.getNrows() && isInside) {
-            isInside = isInside && x[i] >= m_lb->get(i);
-            i++;
-        }
-        i = 0;
-    }
-
-    if (m_ub != NULL) {
-        while (i < x.getNrows() && isInside) {
-            isInside = isInside && x[i] <= m_ub->get(i);
-            i++;
-        }
-    }
-    f = isInside ? 0.0 : INFINITY;
+    const Matrix& cx = x;
+    f = (countOutside(x.getNrows(), cx.getData()) == 0) ? 0.0 : INFINITY;
     return ForBESUtils::STATUS_OK;
 }
 
 int IndBox::callProx(Matrix& x, double gamma, Matrix& prox, double& f_at_prox) {
     f_at_prox = 0.0;
     assert(x.isColumnVector());
+    if (!x.isContiguous() || !prox.isContiguous()) { /* strided views */
+        return Function::callProx(VectorView(x), gamma, VectorView(prox), f_at_prox);
+    }
+    const Matrix& cx = x;
+    project(x.getNrows(), cx.getData(), prox.getData());
+    return ForBESUtils::STATUS_OK;
+}
 
-    // Step 1
-    // prox = max(LB, x)
-    for (size_t i = 0; i < x.getNrows(); i++) {
-        if (m_lb != NULL) {
-            prox[i] = std::max(m_lb->get(i), x[i]);
-        } else if (m_uniform_lb != NULL) {
-            prox[i] = std::max(*m_uniform_lb, x[i]);
-        }
+int IndBox::callProx(Matrix& x, double gamma, Matrix& prox) {
+    double val;
+    return callProx(x, gamma, prox, val);
+}
+
+int IndBox::call(VectorView x, double& f) {
+    if (x.stride() != 1) {
+        return Function::call(x, f);
     }
+    f = (countOutside(x.size(), x.data()) == 0) ? 0.0 : INFINITY;
+    return ForBESUtils::STATUS_OK;
+}
 
-    // Step 2
-    // prox = min(UB, prox)
-    for (size_t i = 0; i < x.getNrows(); i++) {
-        if (m_ub != NULL) {
-            prox[i] = std::min(m_ub->get(i), prox[i]);
-        } else if (m_uniform_ub != NULL) {
-            prox[i] = std::min(*m_uniform_ub, prox[i]);
-        }
+int IndBox::callProx(VectorView x, double gamma, VectorView prox, double& f_at_prox) {
+    if (x.size() != prox.size()) {
+        throw std::invalid_argument("x and prox must have the same size");
+    }
+    if (x.stride() != 1 || prox.stride() != 1) {
+        return Function::callProx(x, gamma, prox, f_at_prox);
     }
+    f_at_prox = 0.0;
+    project(x.size(), x.data(), prox.data());
     return ForBESUtils::STATUS_OK;
 }
 
-int IndBox::callProx(Matrix& x, double gamma, Matrix& prox) {
+int IndBox::callProx(VectorView x, double gamma, VectorView prox) {
     double val;
     return callProx(x, gamma, prox, val);
 }
@@ -134,17 +119,52 @@ int IndBox::callConj(Matrix& x, double& f_star) {
      * Note: either m_lb or m_uniform_lb will be non-NULL. 
      * Check out the two constructors of this class.
      */
+    if (!x.isContiguous()) { /* strided view: evaluated on a compact copy */
+        Matrix x_compact(x);
+        return callConj(x_compact, f_star);
+    }
+    const Matrix& cx = x;
+    const double * xd = cx.getData();
     if (m_uniform_lb == NULL) {
-        for (size_t i = 0; i < x.getNrows(); i++) {
-            double val = x[i];
-            f_star += std::max(val * m_lb->get(i), val * m_ub->get(i));
-        }
+        const Matrix& lb = *m_lb;
+        const Matrix& ub = *m_ub;
+        const double * lbd = lb.getData();
+        const double * ubd = ub.getData();
+        f_star = ElementWise::fusedReduce(x.getNrows(), [xd, lbd, ubd](size_t i) {
+            return std::max(xd[i] * lbd[i], xd[i] * ubd[i]);
+        });
     } else {
-        for (size_t i = 0; i < x.getNrows(); i++) {
-            double val = x[i];
-            f_star += std::max(val * (*m_uniform_lb), val * (*m_uniform_ub));
-        }
+        const double lb = *m_uniform_lb;
+        const double ub = *m_uniform_ub;
+        f_star = ElementWise::reduce(x.getNrows(), xd, [lb, ub](double xi) {
+            return std::max(xi * lb, xi * ub);
+        });
     }
 
     return ForBESUtils::STATUS_OK;
 }
+
+size_t IndBox::countOutside(size_t n, const double * x) const {
+    if (m_lb != NULL) {
+        if (n != m_lb->length()) {
+            throw std::invalid_argument("x and the bounds have different sizes");
+        }
+        const Matrix& lb = *m_lb;
+        const Matrix& ub = *m_ub;
+        return ElementWise::countOutside(n, x, lb.getData(), ub.getData());
+    }
+    return ElementWise::countOutside(n, x, *m_uniform_lb, *m_uniform_ub);
+}
+
+void IndBox::project(size_t n, const double * x, double * prox) const {
+    if (m_lb != NULL) {
+        if (n != m_lb->length()) {
+            throw std::invalid_argument("x and the bounds have different sizes");
+        }
+        const Matrix& lb = *m_lb;
+        const Matrix& ub = *m_ub;
+        ElementWise::clamp(n, x, lb.getData(), ub.getData(), prox);
+    } else {
+        ElementWise::clamp(n, x, *m_uniform_lb, *m_uniform_ub, prox);
+    }
+}
@@ -111,6 +111,12 @@ public:
 
     virtual int callProx(Matrix& x, double gamma, Matrix& prox);
 
+    virtual int call(VectorView x, double& f);
+
+    virtual int callProx(VectorView x, double gamma, VectorView prox, double& f_at_prox);
+
+    virtual int callProx(VectorView x, double gamma, VectorView prox);
+
     /**
      * Computes the conjugate of IndBox at a point <code>x</code> which is 
      * given by
@@ -142,6 +148,17 @@ private:
     double * m_uniform_lb;
     double * m_uniform_ub;
 
+    /**
+     * Number of elements of a contiguous array of size <code>n</code> which
+     * violate the bounds.
+     */
+    size_t countOutside(size_t n, const double * x) const;
+
+    /**
+     * Projects a contiguous array of size <code>n</code> on the box.
+     */
+    void project(size_t n, const double * x, double * prox) const;
+
 
 };
 
@@ -81,6 +81,7 @@
 class IndPos : public Function {
 public:
     using Function::call;
+    using Function::callProx;
     using Function::callConj;
     
     /**
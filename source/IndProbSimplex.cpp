@@ -35,7 +35,10 @@ int IndProbSimplex::callProx(Matrix& x, double gamma, Matrix& prox) {
 
     size_t n = x.getNrows();
 
-    std::vector<double> x_hat_vec(x.getData(), x.getData() + n);
+    std::vector<double> x_hat_vec(n);
+    for (size_t j = 0; j < n; j++) {
+        x_hat_vec[j] = x[j]; /* x may be a strided view */
+    }
 
     /* x_hat := rev_sort(x_hat) */
     std::sort(x_hat_vec.rbegin(), x_hat_vec.rend());
@@ -64,7 +64,8 @@
  */
 class IndProbSimplex : public Function {
 public:
-    using Function::call;    
+    using Function::call;
+    using Function::callProx;
     
     /**
      * Constructs a new instance of the indicator function of the probability
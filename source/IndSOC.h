@@ -49,6 +49,7 @@ class IndSOC : public Function {
 public:
     
     using Function::call;
+    using Function::callProx;
 
     /**
      * Constructor for instances of IndSOC given the dimension \f$n\f$
@@ -20,10 +20,18 @@
 
 #include "LDLFactorization.h"
 
+#include <algorithm>
+
 LDLFactorization::LDLFactorization(Matrix& matr) : FactoredSolver(matr) {
     this->LDL = NULL;
     this->ipiv = NULL;
     this->m_sparse_ldl_factor = NULL;
+    this->m_LDLs = NULL;
+    this->m_single = false;
+    this->m_ordering = ORDERING_AMD;
+    this->m_flops = 0.0;
+    this->m_kl = matr.getLowerBandwidth();
+    this->m_ku = matr.getUpperBandwidth();
     this->m_matrix_type = m_matrix->getType();
     this->m_matrix_nrows = m_matrix->getNrows();
     if (matr.isEmpty()){
@@ -34,7 +42,8 @@ LDLFactorization::LDLFactorization(Matrix& matr) : FactoredSolver(matr) {
     }
     if (m_matrix_type != Matrix::MATRIX_DENSE &&
             matr.getType() != Matrix::MATRIX_SYMMETRIC &&
-            matr.getType() != Matrix::MATRIX_SPARSE) { // Only DENSE and SYMMETRIC and SPARSE are supported!
+            matr.getType() != Matrix::MATRIX_SPARSE &&
+            matr.getType() != Matrix::MATRIX_BANDED) { // Only DENSE, SYMMETRIC, SPARSE and BANDED are supported!
         throw std::logic_error("This matrix type is not supported by LDLFactorization");
     }
     if (matr.getNrows() != matr.getNcols()) {
@@ -44,9 +53,18 @@ LDLFactorization::LDLFactorization(Matrix& matr) : FactoredSolver(matr) {
         m_sparse_ldl_factor = new sparse_ldl_factor;
         return;
     }
-    this->LDL = new double[matr.length()];
+    if (m_matrix_type == Matrix::MATRIX_BANDED) {
+        /* band storage for dgbtrf: A(i,j) is at LDL[kl+ku+i-j + j*ldab] */
+        size_t ldab = 2 * m_kl + m_ku + 1;
+        this->LDL = new double[ldab * m_matrix_nrows];
+        this->ipiv = new int[m_matrix_nrows];
+        return; /* copied by factorize */
+    }
     this->ipiv = new int[matr.getNrows()];
-    memcpy(this->LDL, matr.getData(), matr.length() * sizeof (double));
+    if (m_matrix_type == Matrix::MATRIX_DENSE) {
+        return; /* copied by factorize, in the precision that is used */
+    }
+    this->LDL = new double[matr.length()]; /* copied by factorize */
 }
 
 LDLFactorization::~LDLFactorization() {
@@ -56,85 +74,234 @@ LDLFactorization::~LDLFactorization() {
     if (this->ipiv != NULL) {
         delete[] this->ipiv;
     }
+    if (this->m_LDLs != NULL) {
+        delete[] m_LDLs;
+    }
+    if (this->m_sparse_ldl_factor != NULL) {
+        delete m_sparse_ldl_factor;
+    }
 }
 
 int LDLFactorization::factorize() {
     int status = ForBESUtils::STATUS_UNDEFINED_FUNCTION;
     if (this->m_matrix_type == Matrix::MATRIX_DENSE) {
-        status = LAPACKE_dsytrf(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, LDL, m_matrix_nrows, ipiv);
+        if (m_mixed_precision) {
+            /* m_LDLs := lower triangle of the matrix in single precision */
+            if (m_LDLs == NULL) {
+                m_LDLs = new float[m_matrix_nrows * m_matrix_nrows];
+            }
+            _toSingle(m_matrix->m_data, m_matrix_nrows, m_LDLs);
+            if (LAPACKE_ssytrf(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, m_LDLs, m_matrix_nrows, ipiv) == ForBESUtils::STATUS_OK) {
+                m_single = true;
+                return ForBESUtils::STATUS_OK;
+            }
+            /* singular in single precision */
+        }
+        status = factorizeDouble();
     } else if (this->m_matrix_type == Matrix::MATRIX_SYMMETRIC) {
+        /* dsptrf overwrites LDL, so the matrix is copied on every factorization */
+        memcpy(LDL, m_matrix->m_data, m_matrix->length() * sizeof (double));
         status = LAPACKE_dsptrf(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, LDL, ipiv);
+    } else if (this->m_matrix_type == Matrix::MATRIX_BANDED) {
+        /* band storage for dgbtrf: A(i,j) is at LDL[kl+ku+i-j + j*ldab] */
+        size_t ldab = 2 * m_kl + m_ku + 1;
+        std::fill(LDL, LDL + ldab * m_matrix_nrows, 0.0);
+        for (size_t j = 0; j < m_matrix_nrows; j++) {
+            size_t i_end = std::min(m_matrix_nrows, j + m_kl + 1);
+            for (size_t i = (j > m_ku ? j - m_ku : 0); i < i_end; i++) {
+                LDL[m_kl + m_ku + i - j + j * ldab] = m_matrix->get(i, j);
+            }
+        }
+        status = LAPACKE_dgbtrf(LAPACK_COL_MAJOR, m_matrix_nrows, m_matrix_nrows, m_kl, m_ku, LDL, 2 * m_kl + m_ku + 1, ipiv);
     } else if (this->m_matrix_type == Matrix::MATRIX_SPARSE) {
         // Factorize sparse matrix
-        m_matrix->_createSparse();
-        int * Parent = new int[m_matrix_nrows];
-        int * Lnz = new int[m_matrix_nrows];
-        int * Flag = new int[m_matrix_nrows];
-        m_sparse_ldl_factor->Lp = new int[m_matrix_nrows + 1];
-        ldl_symbolic(m_matrix_nrows,
-                static_cast<int*>(m_matrix->m_sparse->p),
-                static_cast<int*>(m_matrix->m_sparse->i),
-                m_sparse_ldl_factor->Lp,
-                Parent,
-                Lnz,
-                Flag, 
-                NULL, NULL);
-        int lnz = m_sparse_ldl_factor->Lp[m_matrix_nrows];
-        int d;
-        m_sparse_ldl_factor->Li = new int[lnz];
-        m_sparse_ldl_factor->Lx = new double[lnz];
-        m_sparse_ldl_factor->D = new double[m_matrix_nrows];
-
-        double *Y = new double[m_matrix_nrows];
-        int *Pattern = new int[m_matrix_nrows];
-
-        d = ldl_numeric(m_matrix_nrows,
-                static_cast<int*>(m_matrix->m_sparse->p),
-                static_cast<int*>(m_matrix->m_sparse->i),
-                static_cast<double*>(m_matrix->m_sparse->x),
-                m_sparse_ldl_factor->Lp,
-                Parent,
-                Lnz,
-                m_sparse_ldl_factor->Li,
-                m_sparse_ldl_factor->Lx,
-                m_sparse_ldl_factor->D,
-                Y, 
-                Pattern, 
-                Flag, 
-                NULL, NULL);
-        
-        delete[] Parent;
-        delete[] Pattern;
-        delete[] Y;
-        delete[] Flag;
-        delete[] Lnz;
-        
-        return d == m_matrix_nrows ? ForBESUtils::STATUS_OK : ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+        sparse_ldl_factor& F = *m_sparse_ldl_factor;
+        int n = m_matrix_nrows;
+        cholmod_sparse * A = full_sparse();
+        int * Ap = static_cast<int*> (A->p);
+        int * Ai = static_cast<int*> (A->i);
+        F.Parent.resize(n);
+        F.Lnz.resize(n);
+        F.Flag.resize(n);
+        F.Lp.resize(n + 1);
+        F.Y.resize(n);
+        F.Pattern.resize(n);
+
+        /* fill-reducing ordering */
+        if (m_ordering == ORDERING_AMD) {
+            F.P.resize(n);
+            double info[AMD_INFO];
+            if (amd_order(n, Ap, Ai, &F.P[0], NULL, info) < AMD_OK) {
+                F.P.clear(); /* factorize without a permutation */
+            }
+        } else if (m_ordering == ORDERING_NATURAL) {
+            F.P.clear();
+        }
+        int * P = F.P.empty() ? NULL : &F.P[0];
+        F.Pinv.resize(F.P.size());
+        int * Pinv = F.P.empty() ? NULL : &F.Pinv[0];
 
+        ldl_symbolic(n, Ap, Ai, &F.Lp[0], &F.Parent[0], &F.Lnz[0], &F.Flag[0], P, Pinv);
+        int lnz = F.Lp[n];
+        F.Li.resize(std::max(lnz, 1));
+        F.Lx.resize(std::max(lnz, 1));
+        F.D.resize(n);
+        m_flops = 0.0;
+        for (int j = 0; j < n; j++) {
+            double l_j = F.Lnz[j];
+            m_flops += l_j * l_j + 2.0 * l_j;
+        }
+        _savePattern(A);
+
+        status = numeric_sparse(A);
+        if (A != m_matrix->m_sparse) {
+            cholmod_free_sparse(&A, Matrix::cholmod_handle());
+        }
+        return status;
     } else {
         throw std::invalid_argument("This matrix type is not supported by LDLFactorization");
     }    
     return status;
 }
 
+int LDLFactorization::factorizeDouble() {
+    if (m_LDLs != NULL) { /* the single-precision factor is no longer used */
+        delete[] m_LDLs;
+        m_LDLs = NULL;
+    }
+    m_single = false;
+    if (LDL == NULL) {
+        LDL = new double[m_matrix->length()];
+    }
+    memcpy(LDL, m_matrix->m_data, m_matrix->length() * sizeof (double));
+    return LAPACKE_dsytrf(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, LDL, m_matrix_nrows, ipiv);
+}
+
+int LDLFactorization::_solveSingle(float * x, size_t nrhs) {
+    return LAPACKE_ssytrs(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, nrhs, m_LDLs, m_matrix_nrows, ipiv, x, m_matrix_nrows);
+}
+
+cholmod_sparse * LDLFactorization::full_sparse() {
+    m_matrix->_createSparse();
+    if (m_matrix->m_sparse->stype != 0) {
+        /* LDL needs both triangles if a permutation is used */
+        return cholmod_copy(m_matrix->m_sparse, 0, 1, Matrix::cholmod_handle());
+    }
+    return m_matrix->m_sparse;
+}
+
+int LDLFactorization::numeric_sparse(cholmod_sparse * A) {
+    sparse_ldl_factor& F = *m_sparse_ldl_factor;
+    int n = m_matrix_nrows;
+    int d = ldl_numeric(n,
+            static_cast<int*> (A->p),
+            static_cast<int*> (A->i),
+            static_cast<double*> (A->x),
+            &F.Lp[0], &F.Parent[0], &F.Lnz[0], &F.Li[0], &F.Lx[0], &F.D[0],
+            &F.Y[0], &F.Pattern[0], &F.Flag[0],
+            F.P.empty() ? NULL : &F.P[0],
+            F.P.empty() ? NULL : &F.Pinv[0]);
+    return d == n ? ForBESUtils::STATUS_OK : ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+}
+
+int LDLFactorization::refactorize() {
+    if (m_matrix_type != Matrix::MATRIX_SPARSE || m_sparse_ldl_factor->Lp.empty()) {
+        return factorize();
+    }
+    cholmod_sparse * A = full_sparse();
+    bool same_pattern = _hasSavedPattern(A);
+    int status = ForBESUtils::STATUS_OK;
+    if (same_pattern) {
+        status = numeric_sparse(A); /* numeric factorization only */
+    }
+    if (A != m_matrix->m_sparse) {
+        cholmod_free_sparse(&A, Matrix::cholmod_handle());
+    }
+    return same_pattern ? status : factorize();
+}
+
+void LDLFactorization::setOrdering(Ordering ordering) {
+    if (ordering == ORDERING_USER && (m_sparse_ldl_factor == NULL || m_sparse_ldl_factor->P.empty())) {
+        throw std::invalid_argument("No permutation has been set (see setPermutation)");
+    }
+    m_ordering = ordering;
+}
+
+LDLFactorization::Ordering LDLFactorization::getOrdering() const {
+    return m_ordering;
+}
+
+void LDLFactorization::setPermutation(const std::vector<int>& P) {
+    if (m_sparse_ldl_factor == NULL) {
+        throw std::invalid_argument("Permutations apply to sparse matrices only");
+    }
+    std::vector<int> flag(m_matrix_nrows);
+    if (P.size() != m_matrix_nrows
+            || !ldl_valid_perm(m_matrix_nrows, const_cast<int*> (&P[0]), &flag[0])) {
+        throw std::invalid_argument("P is not a permutation of 0, ..., n-1");
+    }
+    m_sparse_ldl_factor->P = P;
+    m_ordering = ORDERING_USER;
+}
+
+const std::vector<int>& LDLFactorization::getPermutation() const {
+    static const std::vector<int> none;
+    return m_sparse_ldl_factor == NULL ? none : m_sparse_ldl_factor->P;
+}
+
+size_t LDLFactorization::getFactorNonzeros() const {
+    if (m_sparse_ldl_factor == NULL || m_sparse_ldl_factor->Lp.empty()) {
+        return 0;
+    }
+    return m_sparse_ldl_factor->Lp.back();
+}
+
+double LDLFactorization::getFactorFlops() const {
+    return m_flops;
+}
+
 int LDLFactorization::solve(Matrix& rhs, Matrix& solution) {
-    solution = Matrix(m_matrix_nrows, 1, Matrix::MATRIX_DENSE); // solution = rhs (DENSE)
-    for (size_t i = 0; i < m_matrix_nrows; i++) {
-        solution.set(i, 0, rhs.get(i, 0));
+    if (&rhs == &solution) {
+        Matrix rhs_copy(rhs); /* shares the data of rhs until solution is written */
+        return solve(rhs_copy, solution);
     }
+    _copyRhs(rhs, solution); /* solution = rhs (DENSE), solved in place below */
+    size_t nrhs = rhs.getNcols();
     int status = ForBESUtils::STATUS_OK;
+    m_refinement_iterations = 0;
+    if (m_single) {
+        if (_solveMixed(m_matrix->m_data, m_matrix_nrows, nrhs, solution.m_data)) {
+            return ForBESUtils::STATUS_OK;
+        }
+        /* the refinement has stalled (solution = rhs): use double precision */
+        status = factorizeDouble();
+        if (status != ForBESUtils::STATUS_OK) {
+            return status;
+        }
+    }
     if (Matrix::MATRIX_DENSE == this->m_matrix_type) {        
-        status = LAPACKE_dsytrs(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, 1, LDL, m_matrix_nrows, ipiv, solution.getData(), m_matrix_nrows);
+        status = LAPACKE_dsytrs(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, nrhs, LDL, m_matrix_nrows, ipiv, solution.m_data, m_matrix_nrows);
     } else if (Matrix::MATRIX_SYMMETRIC == this->m_matrix_type) {
-        status = LAPACKE_dsptrs(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, 1, LDL, ipiv, solution.getData(), m_matrix_nrows);
+        status = LAPACKE_dsptrs(LAPACK_COL_MAJOR, 'L', m_matrix_nrows, nrhs, LDL, ipiv, solution.m_data, m_matrix_nrows);
+    } else if (Matrix::MATRIX_BANDED == this->m_matrix_type) {
+        status = LAPACKE_dgbtrs(LAPACK_COL_MAJOR, 'N', m_matrix_nrows, m_kl, m_ku, nrhs, LDL, 2 * m_kl + m_ku + 1, ipiv, solution.m_data, m_matrix_nrows);
     } else if (Matrix::MATRIX_SPARSE == this->m_matrix_type) {
-        double * b = solution.getData();
-        ldl_lsolve(m_matrix_nrows, b,
-                m_sparse_ldl_factor->Lp,
-                m_sparse_ldl_factor->Li,
-                m_sparse_ldl_factor->Lx);
-        ldl_dsolve(m_matrix_nrows, b, m_sparse_ldl_factor->D);
-        ldl_ltsolve(m_matrix_nrows, b, m_sparse_ldl_factor->Lp, m_sparse_ldl_factor->Li, m_sparse_ldl_factor->Lx);
+        sparse_ldl_factor& F = *m_sparse_ldl_factor;
+        int * P = F.P.empty() ? NULL : &F.P[0];
+        for (size_t j = 0; j < nrhs; j++) {
+            double * b = solution.m_data + j * m_matrix_nrows;
+            double * x = b;
+            if (P != NULL) { /* x = Pb */
+                x = &F.Y[0];
+                ldl_perm(m_matrix_nrows, x, b, P);
+            }
+            ldl_lsolve(m_matrix_nrows, x, &F.Lp[0], &F.Li[0], &F.Lx[0]);
+            ldl_dsolve(m_matrix_nrows, x, &F.D[0]);
+            ldl_ltsolve(m_matrix_nrows, x, &F.Lp[0], &F.Li[0], &F.Lx[0]);
+            if (P != NULL) { /* b = P'x */
+                ldl_permt(m_matrix_nrows, b, x, P);
+            }
+        }
         status = ForBESUtils::STATUS_OK;
     }
     return status;
@@ -22,6 +22,7 @@
 #define	LDLFACTORIZATION_H
 
 #include <cstring>
+#include <vector>
 
 #include "ForBESUtils.h"
 #include "Matrix.h"
@@ -30,6 +31,7 @@
 extern "C" {
 #include "ldl.h"
 }
+#include "amd.h"
 
 /**
  * \class LDLFactorization
@@ -38,10 +40,27 @@ extern "C" {
  * \date July 30, 2015, 3:02 AM
  * \brief LDL factorization and solver
  * \ingroup LinSysSolver-group
+ * 
+ * Sparse matrices are factorized by <a href="http://faculty.cse.tamu.edu/davis/suitesparse.html">LDL</a>
+ * as \f$PAP^{\top}=LDL^{\top}\f$, where \f$P\f$ is a fill-reducing permutation
+ * which is computed by AMD (see #setOrdering). The permutation and the 
+ * symbolic structure of the factor are kept, so that matrices with the same 
+ * sparsity pattern can be factorized again at the cost of the numeric 
+ * factorization only (see #refactorize). The fill-in of a factorization is
+ * reported by #getFactorNonzeros and #getFactorFlops.
  */
 class LDLFactorization : public FactoredSolver {
 public:
 
+    /**
+     * Fill-reducing orderings of sparse matrices
+     */
+    enum Ordering {
+        ORDERING_NATURAL = 0, /**< No permutation */
+        ORDERING_AMD = 1, /**< Approximate minimum degree ordering (default) */
+        ORDERING_USER = 2 /**< Permutation given by the user (see #setPermutation) */
+    };
+
     /**
      * Creates an LDL factorizer given a %Matrix object.
      * 
@@ -54,6 +73,20 @@ public:
      * \exception std::logic_error the factorization cannot be applied to matrices
      * of type <code>MATRIX_DIAGONAL</code>. However, solving diagonal systems is
      * a trivial case.
+     * 
+     * \note LAPACK offers no symmetric indefinite factorization for banded 
+     * matrices, therefore matrices of type <code>MATRIX_BANDED</code> (symmetric
+     * or not) are factorized by an LU factorization with partial pivoting using
+     * <code>dgbtrf</code>, which preserves the band structure (with 
+     * <code>kl</code> additional super-diagonals). In that case #getLDL returns
+     * the LU factors in LAPACK band storage.
+     * 
+     * \note In mixed-precision mode (see \link FactoredSolver::setMixedPrecision
+     * setMixedPrecision\endlink), <code>MATRIX_DENSE</code> matrices are 
+     * factorized with <code>ssytrf</code>; the double-precision factorization
+     * (<code>dsytrf</code>) is only computed if the matrix is singular in 
+     * single precision or the iterative refinement stalls. Until then, 
+     * #getLDL returns <code>NULL</code>.
      */
     explicit LDLFactorization(Matrix& m_matrix);
 
@@ -78,25 +111,110 @@ public:
      * \sa FactoredSolver::solve
      */
     virtual int solve( Matrix& rhs, Matrix& solution);
+
+    using FactoredSolver::refactorize;
+
+    /**
+     * Recomputes the factorization after the values of the matrix have changed.
+     * 
+     * For sparse matrices with the same sparsity pattern, the permutation and
+     * the symbolic structure of the previous factorization are reused and only
+     * the numeric factorization is computed; otherwise, this is the same as 
+     * #factorize.
+     * 
+     * @return status code (see #factorize)
+     */
+    virtual int refactorize(void);
+
+    /**
+     * Sets the fill-reducing ordering which is used by #factorize for sparse
+     * matrices (it has no effect on other types of matrices).
+     * 
+     * @param ordering ordering
+     * 
+     * \exception std::invalid_argument if <code>ORDERING_USER</code> is given
+     * but no permutation has been set using #setPermutation
+     */
+    void setOrdering(Ordering ordering);
+
+    /**
+     * The fill-reducing ordering of sparse matrices.
+     * @return ordering
+     */
+    Ordering getOrdering() const;
+
+    /**
+     * Sets a user-defined permutation for sparse matrices, so that \f$PAP^{\top}\f$
+     * is factorized, where the <code>k</code>-th row of \f$PAP^{\top}\f$ is 
+     * row <code>P[k]</code> of \f$A\f$. The ordering becomes <code>ORDERING_USER</code>.
+     * 
+     * @param P permutation of <code>0, ..., n-1</code>
+     * 
+     * \exception std::invalid_argument if <code>P</code> is not a permutation
+     * of <code>0, ..., n-1</code>
+     */
+    void setPermutation(const std::vector<int>& P);
+
+    /**
+     * The permutation of the last sparse factorization (empty if no permutation 
+     * was used).
+     * 
+     * @return permutation
+     */
+    const std::vector<int>& getPermutation() const;
+
+    /**
+     * The number of nonzeros of the (strictly lower triangular) factor \f$L\f$
+     * of the last sparse factorization.
+     * 
+     * @return number of nonzeros of \f$L\f$
+     */
+    size_t getFactorNonzeros() const;
+
+    /**
+     * The number of floating point operations of the numeric factorization of
+     * the last sparse factorization, that is, \f$\sum_j (l_j^2 + 2 l_j)\f$, 
+     * where \f$l_j\f$ is the number of nonzeros of the <code>j</code>-th
+     * column of \f$L\f$ (\f$l_j\f$ divisions and \f$l_j(l_j+1)/2\f$ 
+     * multiply-subtract pairs).
+     * 
+     * @return number of flops
+     */
+    double getFactorFlops() const;
     
     double* getLDL() const;
 
     int* getIpiv() const;
 
+protected:
+
+    virtual int _solveSingle(float * x, size_t nrhs);
+
 private:
 
 
     double* LDL; /**< LDL factorization computed by lapack */
     int* ipiv;   /**< Pivots for the LDL factorization computed by lapack */
+    float* m_LDLs; /**< Single-precision LDL factorization (mixed-precision mode only) */
+    bool m_single; /**< Whether m_LDLs holds the factorization which is used by solve */
+    size_t m_kl; /**< Lower bandwidth (banded matrices only) */
+    size_t m_ku; /**< Upper bandwidth (banded matrices only) */
 
     /**
      * A sparse LDL factorization
      */
     typedef struct sparse_ldl_factor_struct {
-        double * Lx;    /**< Values of L */
-        int * Li;       /**< i-pointers of L */
-        int * Lp;       /**< p-pointers of L */
-        double * D;     /**< Diagonal part of the LDL factorization*/
+        std::vector<double> Lx; /**< Values of L */
+        std::vector<int> Li;    /**< i-pointers of L */
+        std::vector<int> Lp;    /**< p-pointers of L */
+        std::vector<double> D;  /**< Diagonal part of the LDL factorization*/
+        std::vector<int> P;     /**< Permutation (empty if none) */
+        std::vector<int> Pinv;  /**< Inverse permutation */
+        std::vector<int> Parent; /**< Elimination tree */
+        std::vector<int> Lnz;   /**< Number of nonzeros in each column of L */
+        std::vector<double> Y;  /**< Workspace */
+        std::vector<int> Pattern; /**< Workspace */
+        std::vector<int> Flag;  /**< Workspace */
     } sparse_ldl_factor;
 
     /**
@@ -104,6 +222,26 @@ private:
      */
     sparse_ldl_factor * m_sparse_ldl_factor;    
     
+    Ordering m_ordering; /**< Fill-reducing ordering (sparse matrices only) */
+    double m_flops; /**< Flops of the last sparse factorization */
+
+    /**
+     * Factorizes a dense matrix in double precision (discarding the 
+     * single-precision factorization, if any).
+     */
+    int factorizeDouble();
+
+    /**
+     * The CSC of the sparse matrix with both its triangles (a new matrix if 
+     * only one of them is stored, which the caller must free).
+     */
+    cholmod_sparse * full_sparse();
+
+    /**
+     * Numeric sparse factorization using the current symbolic structure.
+     */
+    int numeric_sparse(cholmod_sparse * A);
+
 
 };
 
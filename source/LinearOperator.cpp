@@ -41,3 +41,19 @@ Matrix LinearOperator::callAdjoint(Matrix& x) {
     ForBESUtils::fail_on_error(callAdjoint(y_star, alpha, x, gamma));
     return y_star;
 }
+
+int LinearOperator::call(VectorView y, double alpha, VectorView x, double gamma) {
+    Matrix y_mat = y.asContiguousMatrix();
+    Matrix x_mat = x.asContiguousMatrix();
+    int status = call(y_mat, alpha, x_mat, gamma);
+    y.copyFrom(y_mat);
+    return status;
+}
+
+int LinearOperator::callAdjoint(VectorView y, double alpha, VectorView x, double gamma) {
+    Matrix y_mat = y.asContiguousMatrix();
+    Matrix x_mat = x.asContiguousMatrix();
+    int status = callAdjoint(y_mat, alpha, x_mat, gamma);
+    y.copyFrom(y_mat);
+    return status;
+}
@@ -32,6 +32,7 @@
 #define _EMPTY_OP_DIM _VECTOR_OP_DIM(0)
 
 #include "Matrix.h"
+#include "Vector.h"
 
 /**
  * \class LinearOperator
@@ -104,6 +105,39 @@ public:
      * @return status code
      */
     virtual int callAdjoint(Matrix& y, double alpha, Matrix& x, double gamma) = 0;
+
+    /**
+     * Same as \link LinearOperator::call(Matrix&, double, Matrix&, double) 
+     * call(Matrix&, double, Matrix&, double)\endlink, but on lightweight 
+     * vectors, that is
+     * \f[
+     *  y \leftarrow \gamma y + \alpha T(x).
+     * \f]
+     * 
+     * The default implementation wraps the vectors in (contiguous) matrices; 
+     * operators which are applied frequently on small vectors override it to
+     * avoid this overhead.
+     * 
+     * @param y vector to be updated
+     * @param alpha scalar \f$\alpha\f$
+     * @param x vector where the operator should be calculated
+     * @param gamma scalar \f$\gamma\f$
+     * @return status code
+     */
+    virtual int call(VectorView y, double alpha, VectorView x, double gamma);
+
+    /**
+     * Same as \link LinearOperator::callAdjoint(Matrix&, double, Matrix&, double) 
+     * callAdjoint(Matrix&, double, Matrix&, double)\endlink, but on lightweight 
+     * vectors (see call(VectorView, double, VectorView, double)).
+     * 
+     * @param y vector to be updated
+     * @param alpha scalar \f$\alpha\f$
+     * @param x vector where the adjoint should be calculated
+     * @param gamma scalar \f$\gamma\f$
+     * @return status code
+     */
+    virtual int callAdjoint(VectorView y, double alpha, VectorView x, double gamma);
     
     
     
@@ -19,6 +19,7 @@
  */
 
 #include "LogLogisticLoss.h"
+#include "ElementWise.h"
 #include <cmath>
 
 LogLogisticLoss::LogLogisticLoss() {
@@ -38,13 +39,12 @@ int LogLogisticLoss::call(Matrix& x, double& f) {
         throw std::invalid_argument("x must be a column-vector");
     }
     //LCOV_EXCL_STOP
-    f = 0.0;
-    for (size_t i = 0; i < x.getNrows(); i++) {
-        double si = std::exp(x[i]);
-        si /= (1.0 + si);
-        f -= std::log(si);
+    if (!x.isContiguous()) { /* strided view: evaluated on a compact copy */
+        Matrix x_compact(x);
+        return call(x_compact, f);
     }
-    f *= m_mu;
+    const Matrix& cx = x;
+    f = ElementWise::logLogistic(x.getNrows(), cx.getData(), m_mu, NULL);
     return ForBESUtils::STATUS_OK;
 }
 
@@ -54,22 +54,12 @@ int LogLogisticLoss::call(Matrix& x, double& f, Matrix& grad) {
         throw std::invalid_argument("x must be a column-vector");
     }
     //LCOV_EXCL_STOP
-    f = 0.0;
-    int status = ForBESUtils::STATUS_OK;
-    for (size_t i = 0; i < x.getNrows(); i++) {        
-        double xi = x[i];
-        if (xi < 33) {                      /* because for values higher than 33, 
-                                             * s1 is practically equal to 1. 
-                                             * This saves the computational burden for
-                                             * high values of x_i */
-            double si = std::exp(xi);       /* si = e^xi              */
-            si = si / (1 + si);             /* si = e^xi / (1+e^xi)   */
-            f -= std::log(si);              /* f -= ln(si)            */
-            grad[i] = m_mu * (si - 1);      /* prox_i = mu*(si-1)     */
-        }
+    if (!x.isContiguous() || !grad.isContiguous()) { /* strided views */
+        return Function::call(VectorView(x), f, VectorView(grad));
     }
-    f *= m_mu;
-    return status;
+    const Matrix& cx = x;
+    f = ElementWise::logLogistic(x.getNrows(), cx.getData(), m_mu, grad.getData());
+    return ForBESUtils::STATUS_OK;
 }
 
 int LogLogisticLoss::hessianProduct(Matrix& x, Matrix& z, Matrix& Hz) {
@@ -78,19 +68,26 @@ int LogLogisticLoss::hessianProduct(Matrix& x, Matrix& z, Matrix& Hz) {
         throw std::invalid_argument("x must be a column-vector");
     }
     //LCOV_EXCL_STOP
-    int status = ForBESUtils::STATUS_OK;
-    for (size_t i = 0; i < x.getNrows(); i++) {        
-        double xi = x[i];
-        if (xi < 33) {                      /* because for values higher than 33, 
-                                             * s1 is practically equal to 1. 
-                                             * This saves the computational burden for
-                                             * high values of x_i */
-            double si = std::exp(xi);       /* si = e^xi              */
-            si = si / (1 + si);             /* si = e^xi / (1+e^xi)   */
-            Hz[i] = m_mu * z[i] * si * (1 - si);
-        }
+    if (!Hz.isContiguous()) { /* strided view: computed into a temporary */
+        Matrix Hz_compact(Hz.getNrows(), Hz.getNcols());
+        int status = hessianProduct(x, z, Hz_compact);
+        VectorView(Hz).copyFrom(Hz_compact);
+        return status;
+    }
+    if (!x.isContiguous() || !z.isContiguous()) { /* strided views are copied */
+        Matrix x_compact(x);
+        Matrix z_compact(z);
+        return hessianProduct(x_compact, z_compact, Hz);
     }
-    return status;
+    const Matrix& cx = x;
+    const Matrix& cz = z;
+    const double mu = m_mu;
+    /* Hz_i = mu * z_i * s_i * (1 - s_i), where s_i = 1/(1+exp(-x_i)) */
+    ElementWise::zip(x.getNrows(), cx.getData(), cz.getData(), Hz.getData(), [mu](double xi, double zi) {
+        double ei = std::exp(-std::fabs(xi));
+        return mu * zi * ei / ((1.0 + ei) * (1.0 + ei));
+    });
+    return ForBESUtils::STATUS_OK;
 }
 
 FunctionOntologicalClass LogLogisticLoss::category() {
@@ -19,57 +19,286 @@
  */
 
 #include "Matrix.h"
+#include "MatrixExpression.h"
+#include "Vector.h"
 #include <iostream>
 #include <stdexcept>
 #include <complex>
 #include <cstdlib>
 #include <stdlib.h>
 #include <iomanip>
+#include <sstream>
 #include <cmath>
 #include <cstring>
 #include <assert.h>
 #include <limits>
+#include <algorithm>
+#include <vector>
+#include <atomic>
+#include <mutex>
 
 #ifdef USE_LIBS
 #include <cblas.h>
 #include <lapacke.h>
 #endif
 
-/* STATIC MEMBERS */
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
-cholmod_common* Matrix::ms_singleton = NULL;
+/**
+ * Reference count of data which are shared by copies of a matrix (copy-on-write).
+ * All matrices which point to the same SharedStorage hold the same m_data,
+ * m_triplet, m_sparse and m_dense; the last one to release them (the one which
+ * takes the count to zero) frees them.
+ * 
+ * The mutex guards the lazy construction of the CSC (see Matrix::_createSparse)
+ * and of its transpose of a matrix which is only read, possibly by several
+ * threads. Sparse data are shared only once their CSC is up to date, so it is
+ * never (re)built while the data are shared; its transpose is kept here, so 
+ * that all copies use it.
+ */
+struct Matrix::SharedStorage {
+    std::atomic<size_t> refs;
+    std::mutex mutex;
+    /** CSC of the transpose of m_sparse (see Matrix::_sparseTransposed) */
+    cholmod_sparse * sparse_trans;
 
-cholmod_common* Matrix::cholmod_handle() {
-    if (ms_singleton == NULL) {
-        ms_singleton = new cholmod_common;
-        cholmod_start(ms_singleton);
+    SharedStorage() : refs(1), sparse_trans(NULL) {
+    }
+
+    ~SharedStorage() {
+        invalidate();
+    }
+
+    /** Frees the data which are derived from m_sparse, when it changes */
+    void invalidate() {
+        if (sparse_trans != NULL) {
+            cholmod_free_sparse(&sparse_trans, Matrix::cholmod_handle());
+        }
+    }
+
+private:
+    SharedStorage(const SharedStorage&);
+    SharedStorage& operator=(const SharedStorage&);
+};
+
+/**
+ * Blocks of a block matrix: the stored matrix is partitioned into block rows
+ * and block columns whose boundaries are given by row_offsets and col_offsets.
+ * Block (I,J) is at blocks[I + J * number of block rows] and is NULL if it is
+ * zero. The blocks are owned (and deep-copied) by this structure.
+ */
+struct Matrix::BlockStorage {
+    std::vector<size_t> row_offsets;
+    std::vector<size_t> col_offsets;
+    std::vector<Matrix*> blocks;
+
+    BlockStorage(const std::vector<size_t>& row_sizes, const std::vector<size_t>& col_sizes) {
+        row_offsets.push_back(0);
+        for (size_t I = 0; I < row_sizes.size(); I++) {
+            row_offsets.push_back(row_offsets.back() + row_sizes[I]);
+        }
+        col_offsets.push_back(0);
+        for (size_t J = 0; J < col_sizes.size(); J++) {
+            col_offsets.push_back(col_offsets.back() + col_sizes[J]);
+        }
+        blocks.assign(row_sizes.size() * col_sizes.size(), NULL);
+    }
+
+    BlockStorage(const BlockStorage& orig) :
+    row_offsets(orig.row_offsets), col_offsets(orig.col_offsets), blocks(orig.blocks.size(), NULL) {
+        for (size_t k = 0; k < blocks.size(); k++) {
+            if (orig.blocks[k] != NULL) {
+                blocks[k] = new Matrix(*orig.blocks[k]);
+            }
+        }
+    }
+
+    ~BlockStorage() {
+        for (size_t k = 0; k < blocks.size(); k++) {
+            delete blocks[k];
+        }
+    }
+
+    size_t nbr() const {
+        return row_offsets.size() - 1;
+    }
+
+    size_t nbc() const {
+        return col_offsets.size() - 1;
+    }
+
+    Matrix*& at(size_t I, size_t J) {
+        return blocks[I + J * nbr()];
+    }
+
+    Matrix * at(size_t I, size_t J) const {
+        return blocks[I + J * nbr()];
+    }
+
+private:
+    BlockStorage& operator=(const BlockStorage&);
+};
+
+/* y := alpha * x + gamma * y, where x and y have length n */
+static void axpby(size_t n, double alpha, const double * x, double gamma, double * y) {
+    if (gamma == 0.0) {
+        cblas_dcopy(n, x, 1, y, 1);
+        if (alpha != 1.0) {
+            cblas_dscal(n, alpha, y, 1);
+        }
+    } else {
+        if (gamma != 1.0) {
+            cblas_dscal(n, gamma, y, 1);
+        }
+        cblas_daxpy(n, alpha, x, 1, y, 1);
     }
-    return ms_singleton;
 }
 
-int Matrix::destroy_handle() {
-    if (ms_singleton == NULL) {
-        return 0;
+/* dst (rows x cols) := transpose of src, where src is cols x rows with leading dimension ld */
+static void transpose_copy(size_t rows, size_t cols, const double * src, size_t ld, double * dst) {
+    for (size_t i = 0; i < rows; i++) {
+        cblas_dcopy(cols, src + i * ld, 1, dst + i, rows);
     }
-    int status = cholmod_finish(ms_singleton);
-    ms_singleton = NULL;
-    return status;
+}
+
+/* dst := src, where both are rows x cols with leading dimensions ldd and lds */
+static void copy_strided(size_t rows, size_t cols, const double * src, size_t lds, double * dst, size_t ldd) {
+    for (size_t j = 0; j < cols; j++) {
+        cblas_dcopy(rows, src + j * lds, 1, dst + j * ldd, 1);
+    }
+}
+
+/* index of the part of [offsets[k], offsets[k+1]) which contains i */
+static size_t block_index(const std::vector<size_t>& offsets, size_t i) {
+    return std::upper_bound(offsets.begin(), offsets.end(), i) - offsets.begin() - 1;
+}
+
+/**
+ * Whether two packed CSC matrices have exactly the same sparsity pattern (so
+ * that their values can be combined entry-wise).
+ */
+static bool same_pattern(const cholmod_sparse * A, const cholmod_sparse * B) {
+    if (A->nrow != B->nrow || A->ncol != B->ncol || A->stype != B->stype
+            || !A->packed || !B->packed) {
+        return false;
+    }
+    const int * Ap = static_cast<const int*> (A->p);
+    const int * Bp = static_cast<const int*> (B->p);
+    if (!std::equal(Ap, Ap + A->ncol + 1, Bp)) {
+        return false;
+    }
+    return std::equal(
+            static_cast<const int*> (A->i),
+            static_cast<const int*> (A->i) + Ap[A->ncol],
+            static_cast<const int*> (B->i));
+}
+
+/**
+ * Sparse matrices with fewer nonzeros than this are multiplied on a single 
+ * thread (spawning threads would cost more than the product itself).
+ */
+static const size_t SPMV_PARALLEL_MIN_NNZ = 20000;
+
+/**
+ * First column of the <code>part</code>-th out of <code>nparts</code> chunks
+ * of columns of a packed CSC matrix with column pointers <code>Ap</code>, so 
+ * that all chunks have (about) the same number of nonzeros.
+ */
+static size_t nnz_split(const int * Ap, size_t ncol, int part, int nparts) {
+    if (part >= nparts) {
+        return ncol;
+    }
+    const long target = static_cast<long> (Ap[ncol]) * part / nparts;
+    return std::lower_bound(Ap, Ap + ncol, target) - Ap;
+}
+
+/**
+ * y := gamma * y + alpha * A' * x for an unsymmetric packed CSC matrix A.
+ * 
+ * Every y(j) is the inner product of the j-th column of A with x, so the
+ * columns of A (the rows of A') are split among the threads in chunks with
+ * equal numbers of nonzeros and each thread writes its own part of y.
+ */
+static void csc_spmv_trans(const cholmod_sparse * A, double alpha, const double * x, double gamma, double * y) {
+    const int * Ap = static_cast<const int*> (A->p);
+    const int * Ai = static_cast<const int*> (A->i);
+    const double * Ax = static_cast<const double*> (A->x);
+    const size_t n = A->ncol;
+    const bool is_gamma_zero = (gamma == 0.0);
+#pragma omp parallel if (static_cast<size_t> (Ap[n]) >= SPMV_PARALLEL_MIN_NNZ)
+    {
+        int nthreads = 1;
+        int tid = 0;
+#ifdef _OPENMP
+        nthreads = omp_get_num_threads();
+        tid = omp_get_thread_num();
+#endif
+        const size_t j_end = nnz_split(Ap, n, tid + 1, nthreads);
+        for (size_t j = nnz_split(Ap, n, tid, nthreads); j < j_end; j++) {
+            double t = 0.0;
+            for (int p = Ap[j]; p < Ap[j + 1]; p++) {
+                t += Ax[p] * x[Ai[p]];
+            }
+            y[j] = is_gamma_zero ? alpha * t : gamma * y[j] + alpha * t;
+        }
+    }
+}
+
+/**
+ * y := gamma * y + alpha * A * x for an unsymmetric packed CSC matrix A, on
+ * a single thread: the columns of A, scaled by the entries of x, are 
+ * scattered into y.
+ */
+static void csc_spmv(const cholmod_sparse * A, double alpha, const double * x, double gamma, double * y) {
+    const int * Ap = static_cast<const int*> (A->p);
+    const int * Ai = static_cast<const int*> (A->i);
+    const double * Ax = static_cast<const double*> (A->x);
+    const size_t m = A->nrow;
+    const size_t n = A->ncol;
+    if (gamma == 0.0) {
+        std::fill(y, y + m, 0.0);
+    } else if (gamma != 1.0) {
+        cblas_dscal(m, gamma, y, 1);
+    }
+    for (size_t j = 0; j < n; j++) {
+        const double axj = alpha * x[j];
+        for (int p = Ap[j]; p < Ap[j + 1]; p++) {
+            y[Ai[p]] += Ax[p] * axj;
+        }
+    }
+}
+
+cholmod_common* Matrix::cholmod_handle() {
+    return CholmodContext::current()->handle();
+}
+
+int Matrix::destroy_handle() {
+    return CholmodContext::destroyCurrent();
 }
 
 /********* CONSTRUCTORS ************/
 Matrix::Matrix() {
     m_nrows = 0;
     m_ncols = 0;
-    m_data = new double[1];
-    *m_data = 0;
+    m_data = MatrixAllocator::allocate_data(1, true);
     m_type = MATRIX_DENSE;
     m_dataLength = 0;
+    m_ld = 0;
     m_transpose = false;
     m_triplet = NULL;
     m_sparse = NULL;
     m_dense = NULL;
+    m_sparse_dirty = false;
     m_sparseStorageType = CHOLMOD_TYPE_TRIPLET;
     m_delete_data = true;
+    m_kl = 0;
+    m_ku = 0;
+    m_band_symmetric = false;
+    m_blocks = NULL;
+    m_shared = NULL;
+    m_exposed = false;
 }
 
 Matrix::Matrix(std::pair<size_t, size_t> dimensions) {
@@ -107,36 +336,154 @@ Matrix::Matrix(const Matrix& orig) {
     m_triplet = NULL;
     m_sparse = NULL;
     m_dense = NULL;
+    m_sparse_dirty = false;
     m_type = orig.m_type;
+    m_kl = orig.m_kl;
+    m_ku = orig.m_ku;
+    m_band_symmetric = orig.m_band_symmetric;
+    m_blocks = (orig.m_blocks != NULL) ? new BlockStorage(*orig.m_blocks) : NULL;
+    m_ld = orig._storedRows(); /* copies of strided views are contiguous */
+    m_shared = NULL;
+    m_exposed = false;
+    if (orig._isShareable()) {
+        _share(orig);
+    } else {
+        _copyData(orig);
+    }
+    m_sparseStorageType = orig.m_sparseStorageType;
+}
+
+void Matrix::_copyData(const Matrix& orig) {
+    m_dataLength = orig.m_dataLength;
+    m_sparse_dirty = false;
     if (orig.m_type != MATRIX_SPARSE) {
         size_t n = orig.m_dataLength;
         if (n == 0) {
             n = 1;
         }
-        m_data = new double[n];
-        memcpy(m_data, orig.m_data, n * sizeof (double));
-        m_dataLength = orig.m_dataLength;
+        m_data = MatrixAllocator::allocate_data(n, false);
+        if (orig.isContiguous()) {
+            memcpy(m_data, orig.m_data, n * sizeof (double));
+        } else {
+            copy_strided(m_ld, orig.m_transpose ? orig.m_nrows : orig.m_ncols, orig.m_data, orig.m_ld, m_data, m_ld);
+        }
         m_delete_data = true;
     } else {
+        std::lock_guard<std::mutex> lock(orig._storage()->mutex); /* see #_createSparse */
         if (orig.m_triplet != NULL) {
             m_triplet = cholmod_copy_triplet(orig.m_triplet, Matrix::cholmod_handle());
         }
-        if (orig.m_sparse != NULL) {
+        if (orig.m_sparse != NULL && !orig.m_sparse_dirty) { /* no need to copy a stale CSC */
             m_sparse = cholmod_copy_sparse(orig.m_sparse, Matrix::cholmod_handle());
         }
         if (orig.m_dense != NULL) {
             m_dense = cholmod_copy_dense(orig.m_dense, Matrix::cholmod_handle());
         }
     }
-    m_sparseStorageType = orig.m_sparseStorageType;
+}
+
+bool Matrix::_isShareable() const {
+    if (m_exposed || m_type == MATRIX_BLOCK) {
+        return false;
+    }
+    /* sparse data are always owned; dense data must be owned and contiguous */
+    return m_type == MATRIX_SPARSE || (m_delete_data && m_data != NULL && isContiguous());
+}
+
+Matrix::SharedStorage * Matrix::_storage() const {
+    SharedStorage * storage = m_shared.load();
+    if (storage == NULL) {
+        SharedStorage * created = new SharedStorage();
+        if (m_shared.compare_exchange_strong(storage, created)) {
+            storage = created;
+        } else {
+            delete created; /* another thread installed one first (now in storage) */
+        }
+    }
+    return storage;
+}
+
+void Matrix::_share(const Matrix& orig) {
+    SharedStorage * storage = orig._storage();
+    std::lock_guard<std::mutex> lock(storage->mutex);
+    if (orig.m_type == MATRIX_SPARSE) {
+        /* the CSC is built before the data are shared (see SharedStorage) */
+        const_cast<Matrix&> (orig)._buildSparse();
+    }
+    storage->refs.fetch_add(1);
+    m_shared = storage;
+    m_data = orig.m_data;
+    m_dataLength = orig.m_dataLength;
+    m_delete_data = orig.m_delete_data;
+    m_triplet = orig.m_triplet;
+    m_sparse = orig.m_sparse;
+    m_dense = orig.m_dense;
+    m_sparse_dirty = orig.m_sparse_dirty;
+}
+
+void Matrix::_detach() {
+    SharedStorage * storage = m_shared.load();
+    if (storage == NULL || storage->refs.load() == 1) {
+        /*
+         * The data are not shared; the count cannot grow concurrently, as 
+         * this matrix may not be copied while it is being modified.
+         */
+        if (storage != NULL) {
+            storage->invalidate(); /* the data are about to change */
+        }
+        return;
+    }
+    /* hand our reference over to a temporary (which releases it) and copy its data */
+    Matrix shared(true);
+    shared.m_type = m_type;
+    shared.m_dataLength = m_dataLength;
+    shared.m_data = m_data;
+    shared.m_delete_data = m_delete_data;
+    shared.m_triplet = m_triplet;
+    shared.m_sparse = m_sparse;
+    shared.m_dense = m_dense;
+    shared.m_sparse_dirty = m_sparse_dirty;
+    shared.m_shared = storage;
+    m_shared = NULL;
+    m_data = NULL;
+    m_triplet = NULL;
+    m_sparse = NULL;
+    m_dense = NULL;
+    _copyData(shared);
+}
+
+void Matrix::_expose() {
+    _detach();
+    m_exposed = true;
+}
+
+Matrix::Matrix(Matrix&& orig) {
+    _steal(orig);
 }
 
 /********* DENSTRUCTOR ************/
 Matrix::~Matrix() {
     m_ncols = 0;
     m_nrows = 0;
+    _release();
+}
+
+void Matrix::_release() {
+    SharedStorage * storage = m_shared.load();
+    if (storage != NULL) {
+        if (storage->refs.fetch_sub(1) > 1) { /* the data are still used by other copies */
+            m_data = NULL;
+            m_triplet = NULL;
+            m_sparse = NULL;
+            m_dense = NULL;
+        } else {
+            delete storage;
+        }
+        m_shared = NULL;
+    }
+    m_exposed = false;
     if (m_data != NULL && m_delete_data) {
-        delete[] m_data;
+        MatrixAllocator::free_data(m_data);
     }
     m_data = NULL; /* so that we don't double-free */
     m_delete_data = false; /* for extra safety (just in case) */
@@ -148,6 +495,9 @@ Matrix::~Matrix() {
         cholmod_free_sparse(&m_sparse, Matrix::cholmod_handle());
         m_sparse = NULL;
     }
+    m_sparse_dirty = false;
+    delete m_blocks;
+    m_blocks = NULL;
     if (m_dense != NULL) {
         m_dense->x = NULL;
         cholmod_free_dense(&m_dense, Matrix::cholmod_handle());
@@ -155,6 +505,63 @@ Matrix::~Matrix() {
     }
 }
 
+void Matrix::_steal(Matrix& orig) {
+    m_nrows = orig.m_nrows;
+    m_ncols = orig.m_ncols;
+    m_transpose = orig.m_transpose;
+    m_type = orig.m_type;
+    m_dataLength = orig.m_dataLength;
+    m_data = orig.m_data;
+    m_ld = orig.m_ld;
+    m_delete_data = orig.m_delete_data;
+    m_triplet = orig.m_triplet;
+    m_sparse = orig.m_sparse;
+    m_dense = orig.m_dense;
+    m_sparse_dirty = orig.m_sparse_dirty;
+    m_sparseStorageType = orig.m_sparseStorageType;
+    m_kl = orig.m_kl;
+    m_ku = orig.m_ku;
+    m_band_symmetric = orig.m_band_symmetric;
+    m_blocks = orig.m_blocks;
+    m_shared = orig.m_shared.load();
+    m_exposed = orig.m_exposed;
+
+    /* leave orig as an empty shallow matrix */
+    orig.m_nrows = 0;
+    orig.m_ncols = 0;
+    orig.m_transpose = false;
+    orig.m_type = MATRIX_DENSE;
+    orig.m_dataLength = 0;
+    orig.m_data = NULL;
+    orig.m_ld = 0;
+    orig.m_delete_data = false;
+    orig.m_triplet = NULL;
+    orig.m_sparse = NULL;
+    orig.m_dense = NULL;
+    orig.m_sparse_dirty = false;
+    orig.m_sparseStorageType = CHOLMOD_TYPE_TRIPLET;
+    orig.m_kl = 0;
+    orig.m_ku = 0;
+    orig.m_band_symmetric = false;
+    orig.m_blocks = NULL;
+    orig.m_shared = NULL;
+    orig.m_exposed = false;
+}
+
+Matrix Matrix::_similar() const {
+    Matrix result(true);
+    if (m_type == MATRIX_BANDED) {
+        result = Matrix(m_transpose ? m_ncols : m_nrows, m_transpose ? m_nrows : m_ncols,
+                m_kl, m_ku, m_band_symmetric);
+    } else {
+        result = Matrix(m_transpose ? m_ncols : m_nrows, m_transpose ? m_nrows : m_ncols, m_type);
+    }
+    if (m_transpose) {
+        result.transpose();
+    }
+    return result;
+}
+
 /********* GETTERS/SETTERS ************/
 size_t Matrix::getNcols() const {
     return m_ncols;
@@ -165,9 +572,39 @@ size_t Matrix::getNrows() const {
 }
 
 double * Matrix::getData() {
+    _expose();
     return m_data;
 }
 
+const double * Matrix::getData() const {
+    return m_data;
+}
+
+size_t Matrix::getLeadingDimension() const {
+    return m_ld;
+}
+
+bool Matrix::isContiguous() const {
+    return m_type != MATRIX_DENSE || m_ld == _storedRows()
+            || (m_transpose ? m_nrows : m_ncols) <= 1;
+}
+
+size_t Matrix::_storedRows() const {
+    return m_transpose ? m_ncols : m_nrows;
+}
+
+size_t Matrix::_linearIndex(size_t k) const {
+    if (isContiguous()) {
+        return k;
+    }
+    size_t rows = _storedRows();
+    return k % rows + (k / rows) * m_ld;
+}
+
+size_t Matrix::_vectorInc() const {
+    return _storedRows() == 1 && (m_nrows > 1 || m_ncols > 1) ? m_ld : 1;
+}
+
 bool Matrix::isEmpty() const {
     return (m_nrows == 0 || m_ncols == 0);
 }
@@ -184,17 +621,90 @@ size_t Matrix::length() const {
     return m_dataLength;
 }
 
+size_t Matrix::getLowerBandwidth() const {
+    return m_transpose ? m_ku : m_kl;
+}
+
+size_t Matrix::getUpperBandwidth() const {
+    return m_transpose ? m_kl : m_ku;
+}
+
+size_t Matrix::getBlockRows() const {
+    if (m_type != MATRIX_BLOCK) {
+        return 1;
+    }
+    return m_transpose ? m_blocks->nbc() : m_blocks->nbr();
+}
+
+size_t Matrix::getBlockCols() const {
+    if (m_type != MATRIX_BLOCK) {
+        return 1;
+    }
+    return m_transpose ? m_blocks->nbr() : m_blocks->nbc();
+}
+
+void Matrix::setBlock(size_t I, size_t J, const Matrix& block) {
+    if (m_type != MATRIX_BLOCK) {
+        throw std::logic_error("setBlock can only be applied to block matrices");
+    }
+    if (I >= getBlockRows() || J >= getBlockCols()) {
+        throw std::out_of_range("Block index out of range");
+    }
+    size_t I_ = m_transpose ? J : I; /* position in the stored matrix */
+    size_t J_ = m_transpose ? I : J;
+    size_t rows = m_blocks->row_offsets[I_ + 1] - m_blocks->row_offsets[I_];
+    size_t cols = m_blocks->col_offsets[J_ + 1] - m_blocks->col_offsets[J_];
+    if (block.getNrows() != (m_transpose ? cols : rows) || block.getNcols() != (m_transpose ? rows : cols)) {
+        std::ostringstream oss;
+        oss << "Block (" << I << "," << J << ") must be " << (m_transpose ? cols : rows)
+                << "x" << (m_transpose ? rows : cols) << ", but it is "
+                << block.getNrows() << "x" << block.getNcols();
+        throw std::invalid_argument(oss.str().c_str());
+    }
+    Matrix * copy = new Matrix(block);
+    if (m_transpose) {
+        copy->transpose();
+    }
+    delete m_blocks->at(I_, J_);
+    m_blocks->at(I_, J_) = copy;
+}
+
+Matrix Matrix::getBlock(size_t I, size_t J) const {
+    if (m_type != MATRIX_BLOCK) {
+        throw std::logic_error("getBlock can only be applied to block matrices");
+    }
+    if (I >= getBlockRows() || J >= getBlockCols()) {
+        throw std::out_of_range("Block index out of range");
+    }
+    size_t I_ = m_transpose ? J : I;
+    size_t J_ = m_transpose ? I : J;
+    Matrix * stored = m_blocks->at(I_, J_);
+    if (stored == NULL) { /* zero block: a sparse matrix without nonzeros */
+        size_t rows = m_blocks->row_offsets[I_ + 1] - m_blocks->row_offsets[I_];
+        size_t cols = m_blocks->col_offsets[J_ + 1] - m_blocks->col_offsets[J_];
+        Matrix zero(m_transpose ? cols : rows, m_transpose ? rows : cols, MATRIX_SPARSE);
+        zero.m_triplet = cholmod_allocate_triplet(zero.m_nrows, zero.m_ncols, 1, 0, CHOLMOD_REAL, Matrix::cholmod_handle());
+        return zero;
+    }
+    Matrix block(*stored);
+    if (m_transpose) {
+        block.transpose();
+    }
+    return block;
+}
+
 /********* OTHER METHODS ************/
 
 void Matrix::transpose() {
-    if (m_type == MATRIX_DIAGONAL || m_type == MATRIX_SYMMETRIC) {
+    if (m_type == MATRIX_DIAGONAL || m_type == MATRIX_SYMMETRIC
+            || (m_type == MATRIX_BANDED && m_band_symmetric)) {
         return;
     }
 
-    if (m_type == MATRIX_SPARSE) {
-        _createSparse();
-        m_sparse = cholmod_transpose(m_sparse, 1, cholmod_handle());
-    }
+    /*
+     * Sparse matrices are stored as they were created and only the transpose
+     * flag is toggled here (see #_sparseOp).
+     */
     if (this -> m_transpose) {
         this -> m_transpose = false;
     } else {
@@ -211,13 +721,17 @@ int Matrix::reshape(size_t nrows, size_t ncols) {
     if (new_size > length()) {
         return -2;
     }
+    if (!isContiguous()) {
+        return -3;
+    }
     this -> m_nrows = nrows;
     this -> m_ncols = ncols;
+    this -> m_ld = _storedRows();
     return 0;
 }
 
 double Matrix::get(const size_t i) const {
-    return m_data[i];
+    return m_data[_linearIndex(i)];
 }
 
 double Matrix::get(const size_t i, const size_t j) const {
@@ -230,7 +744,7 @@ double Matrix::get(const size_t i, const size_t j) const {
     }
     //LCOV_EXCL_STOP
     if (m_type == MATRIX_DENSE) {
-        return !m_transpose ? m_data[i + j * m_nrows] : m_data[j + i * m_ncols];
+        return !m_transpose ? m_data[i + j * m_ld] : m_data[j + i * m_ld];
     } else if (m_type == MATRIX_DIAGONAL) {
         if (i == j) {
             return m_data[i];
@@ -245,22 +759,37 @@ double Matrix::get(const size_t i, const size_t j) const {
         return m_transpose
                 ? (j >= i) ? m_data[j + m_ncols * i - i * (i + 1) / 2] : 0.0
                 : (i >= j) ? m_data[i + m_nrows * j - j * (j + 1) / 2] : 0.0;
+    } else if (m_type == MATRIX_BANDED) {
+        const double * val = _bandEntry(i, j);
+        return (val != NULL) ? *val : 0.0;
+    } else if (m_type == MATRIX_BLOCK) {
+        size_t i_block;
+        size_t j_block;
+        const Matrix * block = _blockEntry(i, j, i_block, j_block);
+        return (block != NULL) ? block->get(i_block, j_block) : 0.0;
     } else {
         /* if (m_type == MATRIX_SPARSE) */
+        int i_ = m_transpose ? j : i;
+        int j_ = m_transpose ? i : j;
+        /* another thread may be building the CSC (see #_createSparse) */
+        std::lock_guard<std::mutex> lock(_storage()->mutex);
+        if (m_sparse != NULL && !m_sparse_dirty) { /* look up the CSC first */
+            double * val = _sparseEntry(i_, j_);
+            return (val != NULL) ? *val : 0.0;
+        }
         //LCOV_EXCL_START
         if (m_triplet == NULL) {
             throw std::logic_error("not supported yet");
         }
         //LCOV_EXCL_STOP
         double val = 0.0;
-        int i_ = m_transpose ? j : i;
-        int j_ = m_transpose ? i : j;
+        const int * ti = static_cast<int*> (m_triplet->i);
+        const int * tj = static_cast<int*> (m_triplet->j);
         for (size_t k = 0; k < m_triplet->nnz; k++) {
-            if (i_ == (static_cast<int*> (m_triplet->i))[k]) {
-                if (j_ == (static_cast<int*> (m_triplet->j))[k]) {
-                    val = (static_cast<double*> (m_triplet->x))[k];
-                    break;
-                }
+            if ((i_ == ti[k] && j_ == tj[k])
+                    || (m_triplet->stype != 0 && i_ == tj[k] && j_ == ti[k])) {
+                val = (static_cast<double*> (m_triplet->x))[k];
+                break;
             }
         }
         return val;
@@ -274,11 +803,12 @@ void Matrix::set(size_t i, size_t j, double v) {
         throw std::out_of_range("Index out of range!");
     }
     //LCOV_EXCL_STOP
+    _detach();
     if (m_type == MATRIX_DENSE) {
         if (m_transpose) {
-            m_data[j + i * m_ncols] = v;
+            m_data[j + i * m_ld] = v;
         } else {
-            m_data[i + j * m_nrows] = v;
+            m_data[i + j * m_ld] = v;
         }
     } else if (m_type == MATRIX_DIAGONAL && i == j) {
         m_data[i] = v;
@@ -288,41 +818,69 @@ void Matrix::set(size_t i, size_t j, double v) {
         int i_ = std::max(i, j);
         int j_ = std::min(i, j);
         m_data[i_ + m_nrows * j_ - j_ * (j_ + 1) / 2] = v;
+    } else if (m_type == MATRIX_BANDED) { /* symmetric: sets A(i,j) = A(j,i) = v */
+        double * entry = _bandEntry(i, j);
+        if (entry == NULL) {
+            throw std::out_of_range("Cannot set an element outside the band of a banded matrix");
+        }
+        *entry = v;
+    } else if (m_type == MATRIX_BLOCK) {
+        size_t i_block;
+        size_t j_block;
+        Matrix * block = _blockEntry(i, j, i_block, j_block);
+        if (block == NULL) {
+            throw std::logic_error("Cannot set an element of a zero block (use setBlock)");
+        }
+        block->set(i_block, j_block, v);
     } else if (m_type == MATRIX_SPARSE) {
-        if (m_triplet == NULL) { /* Create triplets if they don't exist */
-            _createTriplet();
-        }
-        if (m_triplet->nnz == m_triplet->nzmax) { /* max NNZ exceeded */
-            cholmod_reallocate_triplet(m_triplet->nzmax + 1, m_triplet, Matrix::cholmod_handle());
+        int i_ = m_transpose ? j : i; /* position in the stored matrix */
+        int j_ = m_transpose ? i : j;
+        if (m_dense != NULL) {
+            cholmod_free_dense(&m_dense, Matrix::cholmod_handle());
+            m_dense = NULL;
+        }
+        bool is_new_nonzero = false;
+        if (m_sparse != NULL && !m_sparse_dirty) {
+            double * val = _sparseEntry(i_, j_);
+            if (val != NULL) { /* same sparsity pattern: update the CSC in place */
+                *val = v;
+                if (m_triplet != NULL) { /* the CSC is now the only valid representation */
+                    cholmod_free_triplet(&m_triplet, Matrix::cholmod_handle());
+                    m_triplet = NULL;
+                }
+                m_sparseStorageType = CHOLMOD_TYPE_SPARSE;
+                return;
+            }
+            is_new_nonzero = true; /* not in the (up to date) CSC, so not in the triplets */
         }
 
+        /* new nonzero (or no valid CSC): update the triplets */
+        _createTriplet();
+        int * ti = static_cast<int*> (m_triplet->i);
+        int * tj = static_cast<int*> (m_triplet->j);
         int k_found = -1;
-        for (size_t s = 0; s < m_triplet->nnz; s++) {
-            if (i == (static_cast<int*> (m_triplet->i))[s] && j == (static_cast<int*> (m_triplet->j))[s]) {
+        for (size_t s = 0; !is_new_nonzero && s < m_triplet->nnz; s++) {
+            if ((i_ == ti[s] && j_ == tj[s])
+                    || (m_triplet->stype != 0 && i_ == tj[s] && j_ == ti[s])) {
                 k_found = s;
                 break;
             }
         }
 
         if (k_found == -1) {
-            (static_cast<int*> (m_triplet->i))[m_triplet->nnz] = i;
-            (static_cast<int*> (m_triplet->j))[m_triplet->nnz] = j;
+            if (m_triplet->nnz == m_triplet->nzmax) { /* max NNZ exceeded: grow geometrically */
+                cholmod_reallocate_triplet(2 * m_triplet->nzmax + 1, m_triplet, Matrix::cholmod_handle());
+            }
+            (static_cast<int*> (m_triplet->i))[m_triplet->nnz] = i_;
+            (static_cast<int*> (m_triplet->j))[m_triplet->nnz] = j_;
             (static_cast<double*> (m_triplet->x))[m_triplet->nnz] = v;
             (m_triplet->nnz)++;
         } else {
-            (static_cast<int*> (m_triplet->i))[k_found] = i;
-            (static_cast<int*> (m_triplet->j))[k_found] = j;
             (static_cast<double*> (m_triplet->x))[k_found] = v;
         }
-        /* Invalidate alternative sparse representations */
-        if (m_sparse != NULL) {
-            cholmod_free_sparse(&m_sparse, Matrix::cholmod_handle());
-        }
-        if (m_dense != NULL) {
-            cholmod_free_dense(&m_dense, Matrix::cholmod_handle());
-        }
-        m_sparse = NULL;
-        m_dense = NULL;
+        /* The CSC (if any) is kept and rebuilt lazily by #_createSparse */
+        m_sparse_dirty = (m_sparse != NULL);
+        m_sparseStorageType = CHOLMOD_TYPE_TRIPLET;
     } else {
         //LCOV_EXCL_START
         throw std::invalid_argument("Illegal operation");
@@ -332,7 +890,13 @@ void Matrix::set(size_t i, size_t j, double v) {
 }
 
 double Matrix::norm_fro_sq() {
-    if (m_type == Matrix::MATRIX_DENSE
+    if (!isContiguous()) { /* strided view: column by column */
+        double t = 0.0;
+        for (size_t j = 0; j < (m_transpose ? m_nrows : m_ncols); j++) {
+            t += std::pow(cblas_dnrm2(_storedRows(), m_data + j * m_ld, 1), 2);
+        }
+        return std::sqrt(t);
+    } else if (m_type == Matrix::MATRIX_DENSE
             || m_type == Matrix::MATRIX_DIAGONAL
             || m_type == Matrix::MATRIX_LOWERTR) {
         return cblas_dnrm2(m_dataLength, m_data, 1);
@@ -347,7 +911,29 @@ double Matrix::norm_fro_sq() {
             t += std::pow(m_data[i + m_nrows * i - i * (i + 1) / 2], 2);
         }
         return std::sqrt(t);
+    } else if (m_type == Matrix::MATRIX_BANDED) {
+        /* unused positions of the band storage are zero */
+        double t = cblas_dnrm2(m_dataLength, m_data, 1);
+        if (!m_band_symmetric) {
+            return t;
+        }
+        double d = cblas_dnrm2(m_ncols, m_data, _bandLd()); /* the diagonal */
+        return std::sqrt(2.0 * t * t - d * d);
+    } else if (m_type == Matrix::MATRIX_BLOCK) {
+        double t = 0.0;
+        for (size_t k = 0; k < m_blocks->blocks.size(); k++) {
+            if (m_blocks->blocks[k] != NULL) {
+                double t_k = m_blocks->blocks[k]->norm_fro_sq();
+                t += t_k * t_k;
+            }
+        }
+        return std::sqrt(t);
     } else {
+        if (m_sparse != NULL && !m_sparse_dirty && m_sparse->packed) {
+            return cblas_dnrm2((static_cast<int*> (m_sparse->p))[m_sparse->ncol],
+                    static_cast<double*> (m_sparse->x), 1);
+        }
+        _createTriplet();
         double * sparse_data = static_cast<double*> (m_triplet->x);
         return cblas_dnrm2(m_triplet->nnz, sparse_data, 1);
     }
@@ -363,6 +949,24 @@ double Matrix::quadFromTriplet(const Matrix& x) const {
     return r;
 }
 
+double Matrix::quadFromSparse(const Matrix& x) const {
+    double r = 0.0;
+    const int * Ap = static_cast<int*> (m_sparse->p);
+    const int * Ai = static_cast<int*> (m_sparse->i);
+    const int * Anz = static_cast<int*> (m_sparse->nz);
+    const double * Ax = static_cast<double*> (m_sparse->x);
+    for (size_t j = 0; j < m_sparse->ncol; j++) {
+        int p = Ap[j];
+        int pend = (m_sparse->packed) ? Ap[j + 1] : p + Anz[j];
+        double t = 0.0;
+        for (; p < pend; p++) {
+            t += x.get(Ai[p], 0) * Ax[p];
+        }
+        r += t * x.get(j, 0);
+    }
+    return r;
+}
+
 double Matrix::quad(Matrix & x) const {
     //LCOV_EXCL_START
     if (!x.isColumnVector()) {
@@ -380,7 +984,7 @@ double Matrix::quad(Matrix & x) const {
     if (MATRIX_DENSE == m_type || MATRIX_LOWERTR == m_type) { /* DENSE or LOWER TRIANGULAR */
         for (size_t j = 0; j < m_ncols; j++) {
             for (size_t i = 0; i < m_nrows; i++) {
-                result += x[i] * (!m_transpose ? m_data[i + j * m_nrows] : m_data[j + i * m_ncols]) * x[j];
+                result += x[i] * (!m_transpose ? m_data[i + j * m_ld] : m_data[j + i * m_ld]) * x[j];
             }
         }
     } else if (MATRIX_DIAGONAL == m_type) { /* DIAGONAL */
@@ -394,13 +998,22 @@ double Matrix::quad(Matrix & x) const {
             }
             result += x[i] * get(i, i) * x[i];
         }
+    } else if (MATRIX_BANDED == m_type) { /* BANDED */
+        Matrix Ax(m_nrows, 1);
+        _bandGemv(false, 1.0, x.m_data, 0.0, Ax.m_data);
+        result = cblas_ddot(m_nrows, x.m_data, 1, Ax.m_data, 1);
+    } else if (MATRIX_BLOCK == m_type) { /* BLOCK: y = A*x is computed block-wise */
+        Matrix Ax(m_nrows, 1);
+        multiply_helper_left_block(Ax, 1.0, const_cast<Matrix&> (*this), x, 0.0, false);
+        result = cblas_ddot(m_nrows, x.m_data, 1, Ax.m_data, 1);
     } else if (MATRIX_SPARSE == m_type) { /* SPARSE */
-        if (m_triplet != NULL) {
+        if (m_sparse != NULL && !m_sparse_dirty) {
+            result = quadFromSparse(x);
+        } else if (m_triplet != NULL) {
             result = quadFromTriplet(x);
         } else {
-            /* \todo Implement quadFromSparse */
             //LCOV_EXCL_START
-            throw std::logic_error("Quad on sparse matrix - no triplets found (not implemented yet)");
+            throw std::logic_error("Quad on sparse matrix - no sparse data found");
             //LCOV_EXCL_STOP
         }
     }
@@ -433,13 +1046,21 @@ double Matrix::quad(Matrix& x, Matrix & q) const {
 }
 
 void Matrix::plusop() {
-    if (m_type != Matrix::MATRIX_SPARSE) {
+    _detach();
+    if (m_type == Matrix::MATRIX_BLOCK) {
+        for (size_t k = 0; k < m_blocks->blocks.size(); k++) {
+            if (m_blocks->blocks[k] != NULL) {
+                m_blocks->blocks[k]->plusop();
+            }
+        }
+    } else if (m_type != Matrix::MATRIX_SPARSE) {
         for (size_t i = 0; i < length(); i++) {
             if (m_data[i] < 0) {
                 m_data[i] = 0.0;
             }
         }
     } else {
+        /* Both representations are updated in place (the pattern is unchanged) */
         if (m_triplet != NULL) {
             for (size_t k = 0; k < m_triplet->nnz; k++) {
                 double * val = (static_cast<double*> (m_triplet->x)) + k;
@@ -447,8 +1068,9 @@ void Matrix::plusop() {
                     *val = 0.0;
                 }
             }
-        } else if (m_sparse != NULL) {
-            for (size_t j = 0; j < m_ncols; j++) {
+        }
+        if (m_sparse != NULL && !m_sparse_dirty) {
+            for (size_t j = 0; j < m_sparse->ncol; j++) {
                 int p = (static_cast<int*> (m_sparse->p))[j];
                 int pend = (m_sparse->packed == 1)
                         ? ((static_cast<int*> (m_sparse->p))[j + 1])
@@ -465,10 +1087,11 @@ void Matrix::plusop() {
 }
 
 void Matrix::plusop(Matrix* mat) const {
-    if (m_type != Matrix::MATRIX_SPARSE) {
+    if (m_type != Matrix::MATRIX_SPARSE && m_type != Matrix::MATRIX_BLOCK) {
         if (length() != mat->length()) {
             throw std::invalid_argument("Input matrix allocation/size error");
         }
+        mat->_detach();
         for (size_t i = 0; i < length(); i++) {
             mat->m_data[i] = m_data[i] < 0.0 ? 0.0 : m_data[i];
         }
@@ -498,11 +1121,11 @@ std::ostream& operator<<(std::ostream& os, const Matrix & obj) {
     if (obj.m_transpose) {
         os << "Stored as transpose : YES\n";
     }
-    const char * const types[] = {"Dense", "Sparse", "Diagonal", "Lower Triangular", "Symmetric"};
+    const char * const types[] = {"Dense", "Sparse", "Diagonal", "Lower Triangular", "Symmetric", "Banded", "Block"};
     os << "Type: " << types[obj.m_type] << std::endl;
     if (obj.m_type == Matrix::MATRIX_SPARSE && obj.m_triplet == NULL && obj.m_sparse != NULL) {
         os << "Storage type: Packed Sparse" << std::endl;
-        for (size_t j = 0; j < obj.m_ncols; j++) {
+        for (size_t j = 0; j < obj.m_sparse->ncol; j++) {
             int p = (static_cast<int*> (obj.m_sparse->p))[j];
             int pend = (obj.m_sparse->packed == 1)
                     ? ((static_cast<int*> (obj.m_sparse->p))[j + 1])
@@ -529,13 +1152,20 @@ std::ostream& operator<<(std::ostream& os, const Matrix & obj) {
 }
 //LCOV_EXCL_STOP
 
-double &Matrix::operator[](size_t sub) const {
+double &Matrix::operator[](size_t sub) {
     //LCOV_EXCL_START
     //    if (sub >= length()) {
     //        throw std::out_of_range("Exception: Index out of range for Matrix");
     //    }
     //LCOV_EXCL_STOP
-    return m_data[sub];
+    if (!m_exposed) { /* the element may be written through the reference */
+        _expose();
+    }
+    return m_data[_linearIndex(sub)];
+}
+
+const double &Matrix::operator[](size_t sub) const {
+    return m_data[_linearIndex(sub)];
 }
 
 inline void Matrix::_addIJ(size_t i, size_t j, double a) {
@@ -590,6 +1220,13 @@ Matrix Matrix::operator+(Matrix & right) const {
     if (this->getNrows() != right.getNrows() || this->getNcols() != right.getNcols()) {
         throw std::invalid_argument("Addition of matrices of incompatible dimensions!");
     }
+    MatrixTerm lhs(*this);
+    MatrixTerm rhs(right);
+    if (lhs.isFusableInto(*this) && rhs.isFusableInto(*this)) {
+        Matrix result = _similar();
+        evaluate(result, lhs + rhs); // single pass; no copy of *this
+        return result;
+    }
     Matrix result(*this); // Make a copy of myself.
     result += right;
 
@@ -600,6 +1237,13 @@ Matrix Matrix::operator-(Matrix & right) const {
     if (this->getNrows() != right.getNrows() || this->getNcols() != right.getNcols()) {
         throw std::invalid_argument("Addition of matrices of incompatible dimensions!");
     }
+    MatrixTerm lhs(*this);
+    MatrixTerm rhs(right);
+    if (lhs.isFusableInto(*this) && rhs.isFusableInto(*this)) {
+        Matrix result = _similar();
+        evaluate(result, lhs - rhs); // single pass; no copy of *this
+        return result;
+    }
     Matrix result(*this); // Make a copy of myself.      
     result -= right;
 
@@ -607,15 +1251,23 @@ Matrix Matrix::operator-(Matrix & right) const {
 }
 
 Matrix Matrix::operator*(Matrix & right) {
-    if (!(getType() == Matrix::MATRIX_SPARSE && right.getType() == Matrix::MATRIX_SPARSE) &&
+    if (getType() != Matrix::MATRIX_SPARSE && right.getType() == Matrix::MATRIX_SPARSE &&
+            isColumnVector() && right.isColumnVector() && length() == right.length()) {
+        return right * (*this); // dot product with a sparse vector: x'*s = s'*x
+    }
+    if (getType() != Matrix::MATRIX_SPARSE && right.getType() != Matrix::MATRIX_SPARSE &&
             isColumnVector() && right.isColumnVector() && length() == right.length()) {
         double t = 0.0;
         // multiplication of two column vectors = dot product
         Matrix r(1, 1);
-        for (size_t i = 0; i < m_nrows * m_ncols; i++) {
-            t += m_data[i] * right.m_data[i];
+        if (isContiguous() && right.isContiguous()) {
+            for (size_t i = 0; i < m_nrows * m_ncols; i++) {
+                t += m_data[i] * right.m_data[i];
+            }
+        } else {
+            t = cblas_ddot(m_nrows, m_data, _vectorInc(), right.m_data, right._vectorInc());
         }
-        r[0] = t;
+        r.m_data[0] = t;
         return r;
     }
     if (!(isColumnVector() && right.isColumnVector()) && (m_ncols != right.m_nrows)) {
@@ -639,8 +1291,18 @@ Matrix Matrix::operator*(Matrix & right) {
         case MATRIX_SPARSE:
             result = multiplyLeftSparse(right);
             break;
+        case MATRIX_BANDED:
+            result = Matrix(m_nrows, right.m_ncols);
+            multiply_helper_left_banded(result, 1.0, *this, right, 0.0, false);
+            break;
+        case MATRIX_BLOCK:
+            result = Matrix(m_nrows, right.m_ncols);
+            multiply_helper_left_block(result, 1.0, *this, right, 0.0, false);
+            break;
         case MATRIX_LOWERTR:
-            throw std::logic_error("Lower triangular multiplication not implemented yet");
+            result = Matrix(m_nrows, right.m_ncols);
+            multiply_helper_left_lowertr(result, 1.0, *this, right, 0.0, false);
+            break;
         default:
             throw std::logic_error("unsupported");
     }
@@ -652,14 +1314,52 @@ Matrix & Matrix::operator=(const Matrix & right) {
     if (this == &right) {// Same object?
         return *this; // Yes, so skip assignment, and just return *this.
     }
+
+    /*
+     * If this matrix owns a (non-sparse) buffer of the right size, we hold on
+     * to it and copy the new data in place instead of reallocating. This is 
+     * always done if pointers to the buffer have been handed out; otherwise
+     * we rather share the data of right (copy-on-write).
+     */
+    double * reusable_data = NULL;
+    bool reusable_exposed = m_exposed;
+    SharedStorage * storage = m_shared.load();
+    bool can_reuse = (storage == NULL || storage->refs.load() == 1)
+            && m_delete_data && m_data != NULL && m_dataLength > 0
+            && m_type != MATRIX_SPARSE && right.m_type != MATRIX_SPARSE
+            && m_dataLength == right.m_dataLength;
+    bool share = right._isShareable() && !(can_reuse && m_exposed);
+    if (can_reuse && !share) {
+        reusable_data = m_data;
+        m_data = NULL;
+    }
+    _release(); /* free whatever else we used to hold */
+
+    if (share) {
+        m_ncols = right.m_ncols;
+        m_nrows = right.m_nrows;
+        m_type = right.m_type;
+        m_kl = right.m_kl;
+        m_ku = right.m_ku;
+        m_band_symmetric = right.m_band_symmetric;
+        m_transpose = right.m_transpose;
+        m_sparseStorageType = right.m_sparseStorageType;
+        m_ld = right._storedRows();
+        _share(right);
+        return *this;
+    }
+
     /* make sure shallow copies remain shallow */
     m_delete_data = (right.m_type != Matrix::MATRIX_SPARSE);
     m_ncols = right.m_ncols;
     m_nrows = right.m_nrows;
     m_type = right.m_type;
-    m_triplet = NULL;
-    m_sparse = NULL;
-    m_dense = NULL;
+    m_kl = right.m_kl;
+    m_ku = right.m_ku;
+    m_band_symmetric = right.m_band_symmetric;
+    if (right.m_blocks != NULL) {
+        m_blocks = new BlockStorage(*right.m_blocks);
+    }
 
 
     /* 
@@ -668,37 +1368,51 @@ Matrix & Matrix::operator=(const Matrix & right) {
      * (ii) the matrix is not shallow
      */
     m_dataLength = right.m_dataLength;
-    m_data = NULL;
     if (right.m_type != MATRIX_SPARSE) {
-        m_data = new double[m_dataLength];
+        m_data = (reusable_data != NULL)
+                ? reusable_data
+                : MatrixAllocator::allocate_data(m_dataLength, false);
         m_delete_data = true;
+        m_exposed = (reusable_data != NULL) && reusable_exposed; /* the buffer may still be referenced */
     }
     m_transpose = right.m_transpose;
     m_sparseStorageType = right.m_sparseStorageType;
+    m_ld = right._storedRows(); /* copies of strided views are contiguous */
 
     if (m_type == MATRIX_SPARSE) {
         if (right.m_triplet != NULL) {
             m_triplet = cholmod_copy_triplet(right.m_triplet, Matrix::cholmod_handle());
         }
-        if (right.m_sparse != NULL) {
+        if (right.m_sparse != NULL && !right.m_sparse_dirty) {
             m_sparse = cholmod_copy_sparse(right.m_sparse, Matrix::cholmod_handle());
         }
         if (right.m_dense != NULL) {
             m_dense = cholmod_copy_dense(right.m_dense, Matrix::cholmod_handle());
         }
     }
-    if (Matrix::MATRIX_SPARSE != right.getType() && right.m_data != NULL) {
+    if (!right.isContiguous()) {
+        copy_strided(m_ld, m_transpose ? m_nrows : m_ncols, right.m_data, right.m_ld, m_data, m_ld);
+    } else if (Matrix::MATRIX_SPARSE != right.getType() && right.m_data != NULL) {
 #ifdef USE_LIBS
         cblas_dcopy(m_dataLength, right.m_data, 1, m_data, 1);
 #else
         for (int i = 0; i < m_dataLength; i++) {
-            m_data[i] = right[i];
+            m_data[i] = right.m_data[i];
         }
 #endif
     }
     return *this;
 }
 
+Matrix & Matrix::operator=(Matrix && right) {
+    if (this == &right) {
+        return *this;
+    }
+    _release();
+    _steal(right);
+    return *this;
+}
+
 /********* PRIVATE METHODS ************/
 void Matrix::domm(const Matrix &right, Matrix & result) const {
     // multiply with LHS being dense
@@ -716,15 +1430,15 @@ void Matrix::domm(const Matrix &right, Matrix & result) const {
     }
 }
 
-void Matrix::domm(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma) {
+void Matrix::domm(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA) {
     // multiply with A being dense
     double t;
     for (size_t j = 0; j < B.m_ncols; j++) {
         for (size_t i = 0; i < C.m_nrows; i++) {
             t = 0.0;
-            for (size_t k = 0; k < C.m_ncols; k++) {
+            for (size_t k = 0; k < B.m_nrows; k++) {
                 if (!(B.getType() == MATRIX_LOWERTR && k < j)) {
-                    t += A.get(i, k) * B.get(k, j);
+                    t += (transA ? A.get(k, i) : A.get(i, k)) * B.get(k, j);
                 }
             }
             C._addIJ(i, j, alpha*t, gamma);
@@ -739,24 +1453,17 @@ Matrix Matrix::multiplyLeftDense(const Matrix & right) const {
         cblas_dgemm(CblasColMajor,
                 m_transpose ? CblasTrans : CblasNoTrans,
                 right.m_transpose ? CblasTrans : CblasNoTrans,
-                m_nrows, right.m_ncols, m_ncols, 1.0, m_data, m_transpose ? m_ncols : m_nrows,
-                right.m_data, right.m_transpose ? right.m_ncols : right.m_nrows, 0.0,
+                m_nrows, right.m_ncols, m_ncols, 1.0, m_data, m_ld,
+                right.m_data, right.m_ld, 0.0,
                 result.m_data, m_nrows);
 #else
         domm(right, result);
 #endif
         return result;
-    } else if (MATRIX_DIAGONAL == right.m_type) { // {DENSE} * {DIAGONAL} = {DENSE} - RHS is diagonal
-        Matrix result(getNrows(), getNcols());
-        for (size_t j = 0; j < getNcols(); j++) {
-            for (size_t i = 0; i < getNrows(); i++) {
-                result.set(i, j, (!m_transpose ? m_data[i + j * m_nrows] : m_data[j + i * m_ncols]) * right.m_data[j]);
-            }
-        }
-        return result;
-    } else if (MATRIX_SYMMETRIC == right.m_type || MATRIX_LOWERTR == right.m_type) {
+    } else if (MATRIX_DIAGONAL == right.m_type || MATRIX_SYMMETRIC == right.m_type
+            || MATRIX_LOWERTR == right.m_type) { // column scaling, dsymm or dtrmm
         Matrix result(m_nrows, right.m_ncols, Matrix::MATRIX_DENSE);
-        domm(right, result);
+        multiply_helper_left_dense(result, 1.0, const_cast<Matrix&> (*this), const_cast<Matrix&> (right), 0.0, false);
         return result;
     } else { /* {DENSE} * {SPARSE} =  */
         /*
@@ -776,22 +1483,17 @@ Matrix Matrix::multiplyLeftDense(const Matrix & right) const {
 Matrix Matrix::multiplyLeftSymmetric(const Matrix & right) const {
     // multiply when the LHS is symmetric    
     Matrix result(m_nrows, right.m_ncols);
-    if (right.isColumnVector()) {
-#ifdef USE_LIBS
-        cblas_dspmv(CblasColMajor,
-                CblasLower,
-                m_nrows, 1.0, m_data,
-                right.m_data, 1,
-                0.0, result.m_data, 1);
-        return result;
-#endif
-    }
-    domm(right, result);
+    multiply_helper_left_symmetric(result, 1.0, const_cast<Matrix&> (*this), const_cast<Matrix&> (right), 0.0);
     return result;
 }
 
 Matrix Matrix::multiplyLeftDiagonal(const Matrix & right) const {
     // multiply when the LHS is diagonal
+    if (MATRIX_DENSE == right.m_type) { /* row scaling */
+        Matrix result(m_nrows, right.m_ncols);
+        multiply_helper_left_diagonal(result, 1.0, const_cast<Matrix&> (*this), const_cast<Matrix&> (right), 0.0);
+        return result;
+    }
     Matrix result(m_nrows, right.m_ncols, right.m_type);
     for (size_t i = 0; i < m_nrows; i++) {
         if (MATRIX_SYMMETRIC == right.m_type) {
@@ -817,92 +1519,62 @@ Matrix Matrix::multiplyLeftDiagonal(const Matrix & right) const {
 Matrix Matrix::multiplyLeftSparse(Matrix & right) {
     if (right.m_type == MATRIX_SPARSE) {
         // RHS is sparse
-        if (m_sparse == NULL) {
-            _createSparse();
-        }
-        if (right.m_sparse == NULL) {
-            right._createSparse();
-        }
+        bool dotProd = isColumnVector() && right.isColumnVector();
+        cholmod_sparse * lhs = _sparseOp(dotProd ? !m_transpose : m_transpose);
+        cholmod_sparse * rhs = right._sparseOp(right.m_transpose);
         cholmod_sparse *r;
         r = cholmod_ssmult(
-                (isColumnVector() && right.isColumnVector()) ? cholmod_transpose(m_sparse, 1, Matrix::cholmod_handle()) : m_sparse,
-                right.m_sparse,
+                lhs,
+                rhs,
                 0,
                 true,
                 false,
                 Matrix::cholmod_handle());
+        if (lhs != m_sparse) {
+            cholmod_free_sparse(&lhs, Matrix::cholmod_handle());
+        }
+        if (rhs != right.m_sparse) {
+            cholmod_free_sparse(&rhs, Matrix::cholmod_handle());
+        }
         Matrix result(true);
-        if (isColumnVector() && right.isColumnVector()) { /* Sparse-sparse dot product */
+        if (dotProd) { /* Sparse-sparse dot product */
             result = Matrix(1, 1, Matrix::MATRIX_SPARSE);
         } else {
             result = Matrix(m_nrows, right.m_ncols, Matrix::MATRIX_SPARSE);
         }
         result.m_sparse = r;
-        result._createTriplet();
+        result.m_sparseStorageType = CHOLMOD_TYPE_SPARSE;
         return result;
     } else if (right.m_type == MATRIX_DENSE) { /* SPRASE * DENSE */
         // RHS is dense
-        Matrix result(getNrows(), right.getNcols());
-
-        if (m_triplet != NULL && m_sparse == NULL)
-            _createSparse();
-
-        double alpha[2] = {1.0, 0.0};
-        double beta[2] = {0.0, 0.0};
+        bool dotProd = isColumnVector() && right.isColumnVector();
+        Matrix result(dotProd ? 1 : getNrows(), right.getNcols());
 
-        if (right.m_dense == NULL) { /* Prepare right.m_dense */
-            right.m_dense = cholmod_allocate_dense(
-                    right.getNrows(),
-                    right.getNcols(),
-                    right.getNrows(),
-                    CHOLMOD_REAL,
-                    Matrix::cholmod_handle());
+        _createSparse();
 
-            if (!right.m_transpose) {
-                right.m_dense->x = right.m_data;
-            } else {
-                /* Store RHS as transpose into right.m_dense */
-                for (size_t i = 0; i < right.getNrows(); i++) { /* SPARSE x DENSE' */
-                    for (size_t j = 0; j < right.getNcols(); j++) {
-                        (static_cast<double*> (right.m_dense->x))[i + j * right.getNrows()] =
-                                right.get(i, j);
-                    }
+        /* the columns of right (untransposed if necessary) */
+        Matrix right_untransposed(true);
+        if (right.m_transpose) { /* SPARSE x DENSE' */
+            right_untransposed = Matrix(right.getNrows(), right.getNcols());
+            for (size_t i = 0; i < right.getNrows(); i++) {
+                for (size_t j = 0; j < right.getNcols(); j++) {
+                    right_untransposed.m_data[i + j * right.getNrows()] = right.get(i, j);
                 }
             }
         }
-
-        bool dotProd = isColumnVector() && right.isColumnVector();
-        result.m_dense = cholmod_allocate_dense(
-                dotProd ? 1 : result.getNrows(),
-                dotProd ? 1 : result.getNcols(),
-                dotProd ? 1 : result.getNrows(),
-                CHOLMOD_REAL,
-                Matrix::cholmod_handle());
-        if (m_transpose) {
-            this->transpose();
-        }
-        cholmod_sdmult(
-                m_sparse,
-                dotProd ? true : m_transpose,
-                alpha,
-                beta,
-                right.m_dense,
-                result.m_dense,
-                Matrix::cholmod_handle()
-                );
-        if (m_transpose) {
-            this->transpose();
-        }
-        for (size_t k = 0; k < result.length(); k++) {
-            result.m_data[k] = (static_cast<double*> (result.m_dense->x))[k];
+        const double * rhs_data = right.m_transpose ? right_untransposed.m_data : right.m_data;
+        for (size_t k = 0; k < right.getNcols(); k++) {
+            _sparseGemv(
+                    dotProd ? !m_transpose : m_transpose,
+                    1.0,
+                    rhs_data + k * right.getNrows(),
+                    0.0,
+                    result.m_data + k * result.getNrows());
         }
         return result;
     } else if (right.m_type == MATRIX_DIAGONAL) { // SPARSE * DIAGONAL = SPARSE
         Matrix result(*this); // COPY [result := right]
-        for (size_t k = 0; k < result.m_triplet->nnz; k++) {
-            int j_ = (static_cast<int*> (result.m_triplet->j))[k];
-            (static_cast<double*> (result.m_triplet->x))[k] *= right.m_data[j_];
-        }
+        result._sparseScaleColumns(1.0, right);
         return result;
     } else {
         //LCOV_EXCL_START
@@ -921,20 +1593,28 @@ Matrix::MatrixType Matrix::getType() const {
     return m_type;
 }
 
-void Matrix::init(size_t nr, size_t nc, MatrixType mType) {
+void Matrix::init(size_t nr, size_t nc, MatrixType mType, size_t kl, size_t ku, bool bandSymmetric) {
     this -> m_transpose = false;
     this -> m_ncols = nc;
     this -> m_nrows = nr;
     this -> m_type = mType;
     this -> m_data = NULL;
+    this -> m_ld = nr;
     this -> m_delete_data = true;
     this -> m_triplet = NULL;
     this -> m_sparse = NULL;
     this -> m_dense = NULL;
+    this -> m_sparse_dirty = false;
+    this -> m_kl = kl;
+    this -> m_ku = bandSymmetric ? kl : ku;
+    this -> m_band_symmetric = bandSymmetric;
+    this -> m_blocks = NULL;
+    this -> m_shared = NULL;
+    this -> m_exposed = false;
     switch (m_type) {
         case MATRIX_DENSE:
             m_dataLength = nc * nr;
-            m_data = new double[m_dataLength]();
+            m_data = MatrixAllocator::allocate_data(m_dataLength, true);
             break;
         case MATRIX_DIAGONAL:
             if (nc != nr) {
@@ -943,7 +1623,7 @@ void Matrix::init(size_t nr, size_t nc, MatrixType mType) {
                 //LCOV_EXCL_STOP
             }
             m_dataLength = nc;
-            m_data = new double[m_dataLength]();
+            m_data = MatrixAllocator::allocate_data(m_dataLength, true);
             break;
         case MATRIX_LOWERTR:
         case MATRIX_SYMMETRIC:
@@ -953,7 +1633,22 @@ void Matrix::init(size_t nr, size_t nc, MatrixType mType) {
                 //LCOV_EXCL_STOP
             }
             m_dataLength = nc * (nc + 1) / 2;
-            m_data = new double[m_dataLength]();
+            m_data = MatrixAllocator::allocate_data(m_dataLength, true);
+            break;
+        case MATRIX_BANDED:
+            if (bandSymmetric && nc != nr) {
+                throw std::invalid_argument("Symmetric banded matrices must be square");
+            }
+            if ((nr > 0 && m_kl >= nr) || (nc > 0 && m_ku >= nc)) {
+                throw std::invalid_argument("The bandwidth exceeds the matrix dimensions");
+            }
+            m_dataLength = _bandLd() * nc;
+            m_data = MatrixAllocator::allocate_data(m_dataLength, true);
+            break;
+        case MATRIX_BLOCK: /* a single zero block */
+            m_dataLength = 0;
+            m_data = MatrixAllocator::allocate_data(1, true);
+            m_blocks = new BlockStorage(std::vector<size_t>(1, nr), std::vector<size_t>(1, nc));
             break;
         case MATRIX_SPARSE:
             m_data = NULL;
@@ -965,6 +1660,21 @@ void Matrix::init(size_t nr, size_t nc, MatrixType mType) {
 }
 
 void Matrix::_createSparse() {
+    std::lock_guard<std::mutex> lock(_storage()->mutex);
+    _buildSparse();
+}
+
+void Matrix::_buildSparse() {
+    if (m_sparse != NULL && !m_sparse_dirty) {
+        return; /* the CSC is up to date: nothing to do */
+    }
+    /* the data are not shared (see SharedStorage) */
+    m_shared.load()->invalidate();
+    if (m_sparse != NULL) { /* stale CSC - the pattern has changed */
+        cholmod_free_sparse(&m_sparse, Matrix::cholmod_handle());
+        m_sparse = NULL;
+    }
+    m_sparse_dirty = false;
     if (m_triplet != NULL) { // from triplets
         m_sparse = cholmod_triplet_to_sparse(m_triplet, m_triplet->nzmax, Matrix::cholmod_handle());
         return;
@@ -976,28 +1686,189 @@ void Matrix::_createSparse() {
 }
 
 void Matrix::_createTriplet() {
+    if (m_triplet != NULL) {
+        return; /* the triplets are always kept up to date */
+    }
+    _detach();
     _createSparse();
     if (m_sparse != NULL) { /* make triplets from sparse */
         m_triplet = cholmod_sparse_to_triplet(m_sparse, Matrix::cholmod_handle());
     }
 }
 
+cholmod_sparse * Matrix::_sparseOp(bool transposed) {
+    _createSparse();
+    if (!transposed || m_sparse == NULL || m_sparse->stype != 0) {
+        return m_sparse; /* symmetric CHOLMOD matrices are their own transposes */
+    }
+    return cholmod_transpose(m_sparse, 1, Matrix::cholmod_handle());
+}
+
+cholmod_sparse * Matrix::_sparseTransposed() {
+    SharedStorage * storage = _storage();
+    std::lock_guard<std::mutex> lock(storage->mutex);
+    _buildSparse();
+    if (storage->sparse_trans == NULL) {
+        storage->sparse_trans = cholmod_transpose(m_sparse, 1, Matrix::cholmod_handle());
+    }
+    return storage->sparse_trans;
+}
+
+/*
+ * Products with the transpose and products on a single thread use the CSC 
+ * directly. Otherwise, the rows of A (the columns of the CSC of A', which is
+ * built once and kept with the data) are split among the threads, so every
+ * thread writes its own part of y and no workspace is needed. Symmetric and
+ * unpacked CHOLMOD matrices are delegated to cholmod_sdmult.
+ */
+void Matrix::_sparseGemv(bool transposed, double alpha, const double * x, double gamma, double * y) {
+    _createSparse();
+    if (m_sparse->stype != 0 || !m_sparse->packed) {
+        double alpha_t[2] = {alpha, 0.0};
+        double gamma_t[2] = {gamma, 0.0};
+        size_t opA_ncols = transposed ? m_sparse->nrow : m_sparse->ncol;
+        size_t opA_nrows = transposed ? m_sparse->ncol : m_sparse->nrow;
+        cholmod_dense x_dense = CholmodContext::wrapDense(opA_ncols, 1, const_cast<double*> (x));
+        cholmod_dense y_dense = CholmodContext::wrapDense(opA_nrows, 1, y);
+        cholmod_sdmult(m_sparse, (transposed && m_sparse->stype == 0) ? 1 : 0,
+                alpha_t, gamma_t, &x_dense, &y_dense, Matrix::cholmod_handle());
+        return;
+    }
+    if (transposed) {
+        csc_spmv_trans(m_sparse, alpha, x, gamma, y);
+        return;
+    }
+    bool parallel = false;
+#ifdef _OPENMP
+    parallel = omp_get_max_threads() > 1
+            && static_cast<size_t> (static_cast<int*> (m_sparse->p)[m_sparse->ncol]) >= SPMV_PARALLEL_MIN_NNZ;
+#endif
+    if (parallel) {
+        csc_spmv_trans(_sparseTransposed(), alpha, x, gamma, y);
+    } else {
+        csc_spmv(m_sparse, alpha, x, gamma, y);
+    }
+}
+
+double * Matrix::_sparseEntry(size_t i, size_t j) const {
+    if ((m_sparse->stype > 0 && i > j) || (m_sparse->stype < 0 && i < j)) {
+        std::swap(i, j); /* only one triangle is stored */
+    }
+    const int * Ap = static_cast<int*> (m_sparse->p);
+    const int * Ai = static_cast<int*> (m_sparse->i);
+    int p = Ap[j];
+    int pend = (m_sparse->packed) ? Ap[j + 1] : p + (static_cast<int*> (m_sparse->nz))[j];
+    const int row = static_cast<int> (i);
+    if (m_sparse->sorted) { /* binary search in column j */
+        const int * pos = std::lower_bound(Ai + p, Ai + pend, row);
+        if (pos != Ai + pend && *pos == row) {
+            return static_cast<double*> (m_sparse->x) + (pos - Ai);
+        }
+        return NULL;
+    }
+    for (; p < pend; p++) {
+        if (Ai[p] == row) {
+            return static_cast<double*> (m_sparse->x) + p;
+        }
+    }
+    return NULL;
+}
+
+void Matrix::_sparseScaleColumns(double alpha, const Matrix& D) {
+    _detach();
+    _createSparse();
+    if (m_sparse->stype != 0) {
+        /* A*D is not symmetric: switch to an unsymmetric CSC first */
+        cholmod_sparse * unsym = cholmod_copy(m_sparse, 0, 1, Matrix::cholmod_handle());
+        cholmod_free_sparse(&m_sparse, Matrix::cholmod_handle());
+        m_sparse = unsym;
+        if (m_triplet != NULL) {
+            cholmod_free_triplet(&m_triplet, Matrix::cholmod_handle());
+            m_triplet = NULL;
+        }
+    }
+    /* column j of A is row j of the stored matrix if A is transposed */
+    const int * Ap = static_cast<int*> (m_sparse->p);
+    const int * Ai = static_cast<int*> (m_sparse->i);
+    double * Ax = static_cast<double*> (m_sparse->x);
+    for (size_t j = 0; j < m_sparse->ncol; j++) {
+        int p = Ap[j];
+        int pend = (m_sparse->packed) ? Ap[j + 1] : p + (static_cast<int*> (m_sparse->nz))[j];
+        for (; p < pend; p++) {
+            Ax[p] *= alpha * D.m_data[m_transpose ? Ai[p] : j];
+        }
+    }
+    if (m_triplet != NULL) {
+        const int * ti = static_cast<int*> (m_transpose ? m_triplet->i : m_triplet->j);
+        double * tx = static_cast<double*> (m_triplet->x);
+        for (size_t k = 0; k < m_triplet->nnz; k++) {
+            tx[k] *= alpha * D.m_data[ti[k]];
+        }
+    }
+}
+
+void Matrix::_sparseAddTo(Matrix& C, double alpha) {
+    _createSparse();
+    const int * Ap = static_cast<int*> (m_sparse->p);
+    const int * Ai = static_cast<int*> (m_sparse->i);
+    const double * Ax = static_cast<double*> (m_sparse->x);
+    for (size_t j = 0; j < m_sparse->ncol; j++) {
+        int p = Ap[j];
+        int pend = (m_sparse->packed) ? Ap[j + 1] : p + (static_cast<int*> (m_sparse->nz))[j];
+        for (; p < pend; p++) {
+            size_t i = Ai[p];
+            double a = alpha * Ax[p];
+            C._addIJ(m_transpose ? j : i, m_transpose ? i : j, a);
+            if (m_sparse->stype != 0 && i != j) { /* mirror the stored triangle */
+                C._addIJ(m_transpose ? i : j, m_transpose ? j : i, a);
+            }
+        }
+    }
+}
+
 bool Matrix::isSymmetric() const {
     return (m_nrows == m_ncols) && ((Matrix::MATRIX_SYMMETRIC == m_type)
             || (Matrix::MATRIX_SPARSE == m_type && m_triplet != NULL && m_triplet->stype != 0)
+            /* without triplets, the CSC is not built lazily */
+            || (Matrix::MATRIX_SPARSE == m_type && m_triplet == NULL && m_sparse != NULL && m_sparse->stype != 0)
+            || (Matrix::MATRIX_BANDED == m_type && m_band_symmetric)
             || (Matrix::MATRIX_DIAGONAL == m_type));
 }
 
 Matrix& operator*=(Matrix& obj, double alpha) {
-    if (obj.m_type != Matrix::MATRIX_SPARSE) {
+    obj._detach();
+    if (obj.m_type == Matrix::MATRIX_BLOCK) {
+        for (size_t k = 0; k < obj.m_blocks->blocks.size(); k++) {
+            if (obj.m_blocks->blocks[k] != NULL) {
+                *obj.m_blocks->blocks[k] *= alpha;
+            }
+        }
+    } else if (!obj.isContiguous()) { /* strided view: column by column */
+        for (size_t j = 0; j < (obj.m_transpose ? obj.m_nrows : obj.m_ncols); j++) {
+            cblas_dscal(obj._storedRows(), alpha, obj.m_data + j * obj.m_ld, 1);
+        }
+    } else if (obj.m_type != Matrix::MATRIX_SPARSE) {
         assert(obj.m_data != NULL);
-        cblas_dscal(obj.m_dataLength, alpha, obj.m_data, 1);
+        evaluate(obj, alpha * lazy(obj));
     } else {
-        obj._createTriplet();
-        obj.m_sparse = NULL;
-        obj.m_dense = NULL;
-        for (size_t k = 0; k < obj.m_triplet->nnz; k++) {
-            (static_cast<double*> (obj.m_triplet->x))[k] *= alpha;
+        /* scale the nonzeros in place; no representation is rebuilt */
+        if (obj.m_dense != NULL) {
+            cholmod_free_dense(&obj.m_dense, Matrix::cholmod_handle());
+            obj.m_dense = NULL;
+        }
+        if (obj.m_sparse != NULL && !obj.m_sparse_dirty) {
+            for (size_t j = 0; j < obj.m_sparse->ncol; j++) {
+                int p = (static_cast<int*> (obj.m_sparse->p))[j];
+                int pend = (obj.m_sparse->packed == 1)
+                        ? ((static_cast<int*> (obj.m_sparse->p))[j + 1])
+                        : p + (static_cast<int*> (obj.m_sparse->nz))[j];
+                if (pend > p) {
+                    cblas_dscal(pend - p, alpha, static_cast<double*> (obj.m_sparse->x) + p, 1);
+                }
+            }
+        }
+        if (obj.m_triplet != NULL && obj.m_triplet->nnz > 0) {
+            cblas_dscal(obj.m_triplet->nnz, alpha, static_cast<double*> (obj.m_triplet->x), 1);
         }
     }
     return obj;
@@ -1006,17 +1877,19 @@ Matrix& operator*=(Matrix& obj, double alpha) {
 Matrix operator*(double alpha, Matrix& obj) {
     Matrix M(obj);
     M *= alpha;
-    return (M);
+    return M;
 }
 
 std::string Matrix::getTypeString() const {
     //LCOV_EXCL_START
-    const char names[5][10] = {
+    const char names[7][10] = {
         "dense",
         "sparse",
         "diagonal",
         "lower",
-        "symmetric"
+        "symmetric",
+        "banded",
+        "block"
     };
 
     int i = static_cast<int> (getType());
@@ -1057,26 +1930,31 @@ Matrix Matrix::submatrixCopy(size_t row_start, size_t row_end, size_t col_start,
         dlacpy_(const_cast<char*> ("A"),
                 reinterpret_cast<int*> (m_transpose ? &cols : &rows),
                 reinterpret_cast<int*> (m_transpose ? &rows : &cols),
-                m_data + (m_transpose ? row_start * m_ncols + col_start : row_start + col_start * m_nrows),
-                const_cast<int*> (reinterpret_cast<const int*> (m_transpose ? &m_ncols : &m_nrows)),
+                m_data + (m_transpose ? row_start * m_ld + col_start : row_start + col_start * m_ld),
+                const_cast<int*> (reinterpret_cast<const int*> (&m_ld)),
                 M.m_data,
                 reinterpret_cast<int*> (m_transpose ? &cols : &rows));
         M.m_transpose = m_transpose;
+        M.m_ld = M._storedRows();
     } else if (m_type == Matrix::MATRIX_SPARSE) {
         int * rs = new int[rows];
         int * cs = new int[cols];
-        for (size_t i = 0; i <= rows; i++) {
+        for (size_t i = 0; i < rows; i++) {
             rs[i] = row_start + i;
         }
-        for (size_t j = 0; j <= cols; j++) {
+        for (size_t j = 0; j < cols; j++) {
             cs[j] = col_start + j;
         }
-        this->_createSparse();
-        // int nnz = std::max(1, (int) (rows * cols / 20));
-        cholmod_sparse * sp; // = cholmod_allocate_sparse(rows, cols, nnz, 1, 1, m_sparse->stype, m_sparse->xtype, cholmod_handle());
-        sp = cholmod_submatrix(m_sparse, rs, rows, cs, cols, 1, 1, Matrix::cholmod_handle());
+        cholmod_sparse * op = _sparseOp(m_transpose);
+        cholmod_sparse * sp;
+        sp = cholmod_submatrix(op, rs, rows, cs, cols, 1, 1, Matrix::cholmod_handle());
+        if (op != m_sparse) {
+            cholmod_free_sparse(&op, Matrix::cholmod_handle());
+        }
+        delete[] rs;
+        delete[] cs;
         M.m_sparse = sp;
-        M._createTriplet();
+        M.m_sparseStorageType = CHOLMOD_TYPE_SPARSE;
     } else {
         //LCOV_EXCL_START
         throw std::logic_error("Matrix::submatrixCopy is available only for MATRIX_DENSE and MATRIX_SPARSE type matrices.");
@@ -1111,12 +1989,12 @@ Matrix Matrix::multiplySubmatrix(
 
         size_t left_start_idx =
                 m_transpose
-                ? left_row_start * m_ncols + left_col_start
-                : left_row_start + left_col_start * m_nrows;
+                ? left_row_start * m_ld + left_col_start
+                : left_row_start + left_col_start * m_ld;
         size_t right_start_idx =
                 right.m_transpose
-                ? right_row_start * right.m_ncols + right_col_start
-                : right_row_start + right_col_start * right.m_nrows;
+                ? right_row_start * right.m_ld + right_col_start
+                : right_row_start + right_col_start * right.m_ld;
 
         Matrix result(left_rows, right_cols, MATRIX_DENSE);
 
@@ -1129,9 +2007,9 @@ Matrix Matrix::multiplySubmatrix(
                 left_cols,
                 1.0,
                 m_data + left_start_idx,
-                m_transpose ? m_ncols : m_nrows,
+                m_ld,
                 right.m_data + right_start_idx,
-                right.m_transpose ? right.m_ncols : right.m_nrows,
+                right.m_ld,
                 0.0,
                 result.m_data,
                 left_rows);
@@ -1151,12 +2029,16 @@ void Matrix::toggle_diagonal() {
     if (!isColumnVector() && m_type != MATRIX_DIAGONAL) {
         throw std::invalid_argument("Can only be applied to column vectors and diagonal matrices");
     }
+    if (!isContiguous()) {
+        throw std::invalid_argument("Cannot be applied to strided views");
+    }
     m_type = isColumnVector() ? MATRIX_DIAGONAL : MATRIX_DENSE;
     if (isColumnVector()) {
         m_ncols = m_nrows;
     } else {
         m_ncols = 1;
     }
+    m_ld = _storedRows();
 }
 
 Matrix::Matrix(bool shallow) {
@@ -1165,12 +2047,47 @@ Matrix::Matrix(bool shallow) {
     m_nrows = 0;
     m_ncols = 0;
     m_dataLength = 0;
+    m_ld = 0;
     m_type = MATRIX_DENSE;
     m_transpose = false;
     m_triplet = NULL;
     m_sparse = NULL;
     m_dense = NULL;
+    m_sparse_dirty = false;
     m_sparseStorageType = CHOLMOD_TYPE_TRIPLET;
+    m_kl = 0;
+    m_ku = 0;
+    m_band_symmetric = false;
+    m_blocks = NULL;
+    m_shared = NULL;
+    m_exposed = false;
+}
+
+Matrix::Matrix(size_t nr, size_t nc, size_t kl, size_t ku, bool symmetric) {
+    init(nr, nc, MATRIX_BANDED, kl, ku, symmetric);
+}
+
+Matrix::Matrix(const std::vector<size_t>& row_sizes, const std::vector<size_t>& col_sizes) {
+    if (row_sizes.empty() || col_sizes.empty()) {
+        throw std::invalid_argument("A block matrix needs at least one block row and one block column");
+    }
+    size_t nr = 0;
+    size_t nc = 0;
+    for (size_t I = 0; I < row_sizes.size(); I++) {
+        if (row_sizes[I] == 0) {
+            throw std::invalid_argument("Empty block rows are not allowed");
+        }
+        nr += row_sizes[I];
+    }
+    for (size_t J = 0; J < col_sizes.size(); J++) {
+        if (col_sizes[J] == 0) {
+            throw std::invalid_argument("Empty block columns are not allowed");
+        }
+        nc += col_sizes[J];
+    }
+    init(nr, nc, MATRIX_BLOCK);
+    delete m_blocks;
+    m_blocks = new BlockStorage(row_sizes, col_sizes);
 }
 
 int Matrix::add(Matrix& C, double alpha, Matrix& A, double gamma) {
@@ -1178,6 +2095,12 @@ int Matrix::add(Matrix& C, double alpha, Matrix& A, double gamma) {
     if (C.getNcols() != A.getNcols() || C.getNrows() != A.getNrows()) {
         throw std::invalid_argument("LHS and RHS do not have compatible dimensions");
     }
+    if (C.getType() != MATRIX_DENSE && !A.isContiguous()) {
+        /* only dense matrices are updated directly with strided views */
+        Matrix A_compact(A);
+        return add(C, alpha, A_compact, gamma);
+    }
+    C._detach();
     // C := gamma * C + alpha * A
     int status;
     switch (C.getType()) {
@@ -1196,6 +2119,12 @@ int Matrix::add(Matrix& C, double alpha, Matrix& A, double gamma) {
         case MATRIX_SPARSE: /* SPARSE += ? */
             status = generic_add_helper_left_sparse(C, alpha, A, gamma);
             break;
+        case MATRIX_BANDED: /* BANDED += ? */
+            status = generic_add_helper_left_banded(C, alpha, A, gamma);
+            break;
+        case MATRIX_BLOCK: /* BLOCK += ? */
+            status = generic_add_helper_left_block(C, alpha, A, gamma);
+            break;
         default:
             status = ForBESUtils::STATUS_UNDEFINED_FUNCTION;
             break;
@@ -1210,7 +2139,13 @@ int Matrix::generic_add_helper_left_dense(Matrix& C, double alpha, Matrix& A, do
 
     bool is_gamma_one = (std::abs(gamma - 1.0) < std::numeric_limits<double>::epsilon());
 
-    if (type_of_A == MATRIX_DENSE && C.m_transpose == A.m_transpose) {
+    if (type_of_A == MATRIX_DENSE && C.m_transpose == A.m_transpose
+            && !(A.isContiguous() && C.isContiguous())) { /* strided views: one stored column at a time */
+        size_t rows = C._storedRows();
+        for (size_t j = 0; j < (C.m_transpose ? C.m_nrows : C.m_ncols); j++) {
+            axpby(rows, alpha, A.m_data + j * A.m_ld, gamma, C.m_data + j * C.m_ld);
+        }
+    } else if (type_of_A == MATRIX_DENSE && C.m_transpose == A.m_transpose) {
         if (is_gamma_one) {
             cblas_daxpy(A.length(), alpha, A.m_data, 1, C.m_data, 1);
             return ForBESUtils::STATUS_OK;
@@ -1219,36 +2154,63 @@ int Matrix::generic_add_helper_left_dense(Matrix& C, double alpha, Matrix& A, do
                 C.m_data[i] = (gamma * C.m_data[i]) + (alpha * A.m_data[i]);
             }
         }
-    } else if (type_of_A == MATRIX_DIAGONAL) { /* DENSE + DIAGONAL */
-        for (size_t i = 0; i < A.getNrows(); i++) {
-            C._addIJ(i, i, alpha * A.m_data[i], gamma);
+    } else if (type_of_A == MATRIX_DIAGONAL) { /* DENSE + DIAGONAL: the diagonal of C has stride ldc+1 */
+        if (!is_gamma_one) {
+            C *= gamma;
         }
-    } else if (type_of_A == MATRIX_LOWERTR) { /* DENSE + LOWER */
-        /* TODO This is to be tested!!! */
-        for (size_t i = 0; i < A.getNrows(); i++) {
-            if (!A.m_transpose) {
-                for (size_t j = 0; j <= i; j++) {
-                    C._addIJ(i, j, alpha * A.get(i, j), gamma);
-                }
-            } else {
-                for (size_t j = i; j < A.m_ncols; j++) {
-                    C._addIJ(i, j, alpha * A.get(i, j), gamma);
-                }
+        cblas_daxpy(A.m_nrows, alpha, A.m_data, 1, C.m_data, C.m_ld + 1);
+    } else if (type_of_A == MATRIX_LOWERTR || type_of_A == MATRIX_SYMMETRIC) { /* DENSE + LOWER/SYMMETRIC */
+        if (!is_gamma_one) {
+            C *= gamma;
+        }
+        /* 
+         * Column j of the packed (lower) storage of A is added to C either 
+         * along a column or along a row of the storage of C.
+         */
+        size_t n = A.m_nrows;
+        size_t ldc = C.m_ld;
+        size_t inc = (type_of_A == MATRIX_LOWERTR && A.m_transpose != C.m_transpose) ? ldc : 1;
+        const double * A_j = A.m_data;
+        for (size_t j = 0; j < n; j++) {
+            double * C_jj = C.m_data + j + j * ldc;
+            cblas_daxpy(n - j, alpha, A_j, 1, C_jj, inc);
+            if (type_of_A == MATRIX_SYMMETRIC && j + 1 < n) { /* strictly upper part */
+                cblas_daxpy(n - j - 1, alpha, A_j + 1, 1, C_jj + ldc, ldc);
             }
+            A_j += n - j;
+        }
+    } else if (type_of_A == MATRIX_DENSE) { /* DENSE + DENSE' or DENSE' + DENSE: one strided daxpy per column */
+        if (!is_gamma_one) {
+            C *= gamma;
+        }
+        size_t rows = A._storedRows();
+        size_t sda = A.m_transpose ? A.m_nrows : A.m_ncols;
+        for (size_t j = 0; j < sda; j++) {
+            cblas_daxpy(rows, alpha, A.m_data + j * A.m_ld, 1, C.m_data + j, C.m_ld);
         }
     } else if (type_of_A == MATRIX_SPARSE) {
-        A._createTriplet();
-        assert(A.m_triplet != NULL);
         if (!is_gamma_one) {
             C *= gamma;
         }
-        for (size_t k = 0; k < A.m_triplet->nnz; k++) {
-            int i_ = (static_cast<int *> (A.m_triplet->i))[k];
-            int j_ = (static_cast<int *> (A.m_triplet->j))[k];
-            if (A.m_transpose) std::swap(i_, j_);
-            C._addIJ(i_, j_, alpha * (static_cast<double *> (A.m_triplet->x))[k]);
+        A._sparseAddTo(C, alpha);
+    } else if (type_of_A == MATRIX_BANDED) { /* DENSE + BANDED: only the band is traversed */
+        if (!is_gamma_one) {
+            C *= gamma;
         }
-    } else { /* Symmetric and Dense+Dense' or Dense'+Dense (not of same transpose type) */
+        size_t kl = A.getLowerBandwidth();
+        size_t ku = A.getUpperBandwidth();
+        for (size_t j = 0; j < A.getNcols(); j++) {
+            size_t i_end = std::min(A.getNrows(), j + kl + 1);
+            for (size_t i = (j > ku ? j - ku : 0); i < i_end; i++) {
+                C._addIJ(i, j, alpha * A.get(i, j));
+            }
+        }
+    } else if (type_of_A == MATRIX_BLOCK) { /* DENSE + BLOCK: block by block */
+        if (!is_gamma_one) {
+            C *= gamma;
+        }
+        A._blockAddTo(C, alpha);
+    } else {
         for (size_t i = 0; i < A.getNrows(); i++) {
             for (size_t j = 0; j < A.getNcols(); j++) {
                 C._addIJ(i, j, alpha * A.get(i, j), gamma);
@@ -1278,9 +2240,10 @@ int Matrix::generic_add_helper_left_symmetric(Matrix& C, double alpha, Matrix& A
             double val = C.m_data[idx];
             C.m_data[idx] = gamma * val + alpha * A.m_data[i];
         }
-    } else if (type_of_A == MATRIX_LOWERTR || type_of_A == MATRIX_DENSE) { /* SYMMETRIC + LOWER_TRI/DENSE = DENSE */
+    } else if (type_of_A == MATRIX_LOWERTR || type_of_A == MATRIX_DENSE
+            || type_of_A == MATRIX_BANDED || type_of_A == MATRIX_BLOCK) { /* SYMMETRIC + LOWER_TRI/DENSE/BANDED/BLOCK = DENSE */
         C.m_dataLength = ncols * nrows; /* SYMMETRIC + DENSE = DENSE     */
-        double * newData = new double[C.m_dataLength]; // realloc data
+        double * newData = MatrixAllocator::allocate_data(C.m_dataLength, false);
         for (size_t i = 0; i < nrows; i++) {
             for (size_t j = 0; j < ncols; j++) {
                 newData[i + j * nrows] = gamma * C.get(i, j); // load data (recast into full storage format)
@@ -1289,49 +2252,29 @@ int Matrix::generic_add_helper_left_symmetric(Matrix& C, double alpha, Matrix& A
                 }
             }
         }
-        double * temp_data;
-        temp_data = static_cast<double *> (realloc(C.m_data, C.m_dataLength * sizeof (double))); // reallocate memory
-        if (temp_data == NULL) { /* could not allocate using realloc */
-            delete[] C.m_data;
-            if (newData != NULL) {
-                delete[] newData;
-            }
-            throw std::bad_alloc();
-        } else if (temp_data == C.m_data) { /* nothing happened */
-            temp_data = NULL;
-        } else { /* realloc succeeded */
-            C.m_data = temp_data; /* have m_data point to temp_data */
-            temp_data = NULL; /* nullify temp_data */
-        }
-        C.m_data = static_cast<double *> (memcpy(C.m_data, newData, C.m_dataLength * sizeof (double))); // copy newData to m_data
-        delete[] newData;
+        if (C.m_delete_data) {
+            MatrixAllocator::free_data(C.m_data);
+        }
+        C.m_data = newData;
+        C.m_delete_data = true;
         C.m_type = MATRIX_DENSE;
         status = ForBESUtils::STATUS_HAD_TO_REALLOC;
     } else if (type_of_A == MATRIX_SPARSE) { /* SYMMETRIC + SPARSE */
-        C.m_dataLength = ncols * nrows;
-        double * newData = new double[C.m_dataLength];
-        C.m_data = static_cast<double *> (realloc(C.m_data, C.m_dataLength * sizeof (double))); // reallocate memory
-
+        double * newData = MatrixAllocator::allocate_data(ncols * nrows, false);
         for (size_t i = 0; i < nrows; i++) {
             for (size_t j = 0; j < ncols; j++) {
-                newData[i + j * nrows] = C.get(i, j); /* restructure symmetric C data into dense */
+                newData[i + j * nrows] = gamma * C.get(i, j); /* restructure symmetric C data into dense */
             }
         }
-
-        C.m_data = static_cast<double *> (memcpy(C.m_data, newData, C.m_dataLength * sizeof (double))); // copy newData to m_data
-
-        A._createTriplet();
-        assert(A.m_triplet != NULL);
-
-        C.m_type = MATRIX_DENSE;
-
-        for (size_t k = 0; k < A.m_triplet->nnz; k++) {
-            int i_ = (static_cast<int*> (A.m_triplet->i))[k];
-            int j_ = (static_cast<int*> (A.m_triplet->j))[k];
-            C._addIJ(A.m_transpose ? j_ : i_, A.m_transpose ? i_ : j_, alpha * (static_cast<double*> (A.m_triplet->x))[k], gamma);
+        if (C.m_delete_data) {
+            MatrixAllocator::free_data(C.m_data);
         }
+        C.m_data = newData;
+        C.m_delete_data = true;
+        C.m_dataLength = ncols * nrows;
+        C.m_type = MATRIX_DENSE;
 
-        delete[] newData;
+        A._sparseAddTo(C, alpha);
         status = ForBESUtils::STATUS_HAD_TO_REALLOC;
     }
     return status;
@@ -1347,78 +2290,54 @@ int Matrix::generic_add_helper_left_sparse(Matrix& C, double alpha, Matrix& A, d
         double __gamma_t[1] = {gamma};
         double __alpha_t[1] = {alpha};
 
+        C._createSparse();
+        A._createSparse();
 
-        /*
-         * Comments on the following two blocks of code:
-         * IMPORTANT: READ ME
-         * Don't forget that m_triplet is not really transposed - see #transpose().
-         * When, at this point, m_sparse is NULL, the sparse data are stored in 
-         * m_triplet. 
-         * 
-         * Recall that the code in #transpose() regarding sparse matrices is merely:
-         * 
-         * if (m_type == MATRIX_SPARSE) {
-         *      _createSparse();
-         *      m_sparse = cholmod_transpose(m_sparse, 1, cholmod_handle());
-         * }
-         * 
-         * It doesn't modify m_triplet whatsoever. Now, take a look at #get():
-         * 
-         * double val = 0.0;
-         * int i_ = m_transpose ? j : i;
-         * int j_ = m_transpose ? i : j;
-         * for (size_t k = 0; k < m_triplet->nnz; k++) {
-         *     if (i_ == (static_cast<int*> (m_triplet->i))[k]) {
-         *         if (j_ == (static_cast<int*> (m_triplet->j))[k]) {
-         *             val = (static_cast<double*> (m_triplet->x))[k];
-         *             break;
-         *         }
-         *     }
-         * }
-         * 
-         * We swap ::i and ::j to get the correct entry and this is why the output
-         * stream operator works as well (it uses #get(size_t, size_t)).
-         * 
-         * ERGO: If we create m_sparse out of the non-transposed m_triplet, hell
-         * will brake loose. 
-         */
-
-        if (C.m_sparse == NULL) {
-            C._createSparse(); /* CHOLMOD_SPARSE: create it 
-                                from other representations */
-            if (C.m_transpose) {
-                C.m_sparse = cholmod_transpose(C.m_sparse, 1, cholmod_handle());
+        if (C.m_transpose == A.m_transpose && same_pattern(C.m_sparse, A.m_sparse)) {
+            /* Same sparsity pattern: C := gamma * C + alpha * A in place */
+            size_t nnz = (static_cast<int*> (C.m_sparse->p))[C.m_sparse->ncol];
+            double * Cx = static_cast<double*> (C.m_sparse->x);
+            const double * Ax = static_cast<double*> (A.m_sparse->x);
+            for (size_t k = 0; k < nnz; k++) {
+                Cx[k] = gamma * Cx[k] + alpha * Ax[k];
             }
-        }
-
-        if (A.m_sparse == NULL) {
-            A._createSparse(); /* Likewise for the RHS */
-            if (A.m_transpose) {
-                A.m_sparse = cholmod_transpose(A.m_sparse, 1, cholmod_handle());
+            if (C.m_triplet != NULL) { /* the CSC is now the only valid representation */
+                cholmod_free_triplet(&C.m_triplet, Matrix::cholmod_handle());
+                C.m_triplet = NULL;
             }
+            C.m_sparseStorageType = CHOLMOD_TYPE_SPARSE;
+            return status;
         }
 
         /*
-         * Don't store C as transpose any more - it will not have all values 
-         * in the right order.
+         * Both CSC representations store the matrices as they were created, 
+         * so they are transposed as needed before they are added. The sum
+         * is stored as a (non-transposed) CSC; triplets are created lazily.
          */
-        if (C.m_transpose) {
-            C.m_transpose = false;
-        }
-
-        C.m_sparse = cholmod_add(
-                C.m_sparse,
-                A.m_sparse,
+        cholmod_sparse * C_op = C._sparseOp(C.m_transpose);
+        cholmod_sparse * A_op = A._sparseOp(A.m_transpose);
+        cholmod_sparse * sum = cholmod_add(
+                C_op,
+                A_op,
                 __gamma_t,
                 __alpha_t,
                 true,
                 true,
                 Matrix::cholmod_handle()); /* Use cholmod_add to compute the sum C := gamma * C + alpha * A */
-
-        C.m_triplet = cholmod_sparse_to_triplet(
-                C.m_sparse,
-                Matrix::cholmod_handle()); /* Update the triplet of the result (optional) */
-
+        if (C_op != C.m_sparse) {
+            cholmod_free_sparse(&C_op, Matrix::cholmod_handle());
+        }
+        if (A_op != A.m_sparse) {
+            cholmod_free_sparse(&A_op, Matrix::cholmod_handle());
+        }
+        if (C.m_triplet != NULL) {
+            cholmod_free_triplet(&C.m_triplet, Matrix::cholmod_handle());
+            C.m_triplet = NULL;
+        }
+        cholmod_free_sparse(&C.m_sparse, Matrix::cholmod_handle());
+        C.m_sparse = sum;
+        C.m_transpose = false;
+        C.m_sparseStorageType = CHOLMOD_TYPE_SPARSE;
 
     } else if (type_of_A == MATRIX_DIAGONAL) { /* SPARSE + DIAGONAL */
         C._createTriplet();
@@ -1437,45 +2356,17 @@ int Matrix::generic_add_helper_left_sparse(Matrix& C, double alpha, Matrix& A, d
                 }
             }
         }
-    } else if (type_of_A == MATRIX_DENSE) { /* SPARSE + DENSE */
-        C.m_type = MATRIX_DENSE; /* Sparse + Dense = Dense */
-        C.m_dataLength = A.getNcols() * A.getNrows(); /* Space to be allocated for the dense result */
-        C.m_data = new double[C.m_dataLength]; /* allocate space */
-        for (size_t i = 0; i < C.getNrows(); i++) {
-            for (size_t j = 0; j < C.getNcols(); j++) {
-                C.set(i, j, gamma * A.get(i, j)); /* store the rhs on m_data (accounting for transpose) */
-            }
-        }
-        //_createTriplet();
-        if (C.m_triplet != NULL) {
-            /* Add triplets */
-            for (size_t k = 0; k < C.m_triplet->nnz; k++) {
-                int i = (static_cast<int*> (C.m_triplet->i))[k];
-                int j = (static_cast<int*> (C.m_triplet->j))[k];
-                if (C.m_transpose) {
-                    std::swap(i, j);
-                }
-                double v = (static_cast<double*> (C.m_triplet->x))[k];
-                C._addIJ(i, j, v, alpha);
-            }
-        }
-        status = ForBESUtils::STATUS_HAD_TO_REALLOC;
-    } else if (type_of_A == MATRIX_SYMMETRIC) { /* SPARSE + SYMMETRIC (result is dense) */
-        C.m_dataLength = C.m_nrows * C.m_ncols;
-        C.m_data = new double[C.m_dataLength](); // reallocate memory
-        C.m_type = MATRIX_DENSE;
-        for (size_t i = 0; i < nrows; i++) {
-            for (size_t j = 0; j < ncols; j++) {
-                C.set(i, j, gamma * A.get(i, j)); // load symmetric data                
+    } else if (type_of_A == MATRIX_DENSE || type_of_A == MATRIX_SYMMETRIC
+            || type_of_A == MATRIX_BANDED || type_of_A == MATRIX_BLOCK) {
+        /* SPARSE + DENSE/SYMMETRIC/BANDED/BLOCK = DENSE */
+        Matrix result(nrows, ncols, MATRIX_DENSE);
+        for (size_t j = 0; j < ncols; j++) {
+            for (size_t i = 0; i < nrows; i++) {
+                result.m_data[i + j * nrows] = alpha * A.get(i, j);
             }
         }
-        C._createTriplet();
-        for (size_t k = 0; k < C.m_triplet->nnz; k++) {
-            C._addIJ((static_cast<int*> (C.m_triplet->i))[k],
-                    (static_cast<int*> (C.m_triplet->j))[k],
-                    (static_cast<double*> (C.m_triplet->x))[k],
-                    alpha);
-        }
+        C._sparseAddTo(result, gamma);
+        C = std::move(result);
         status = ForBESUtils::STATUS_HAD_TO_REALLOC;
     }
     return status;
@@ -1491,10 +2382,40 @@ int Matrix::generic_add_helper_left_diagonal(Matrix& C, double alpha, Matrix& A,
                 C.m_data[i] = (gamma * C.m_data[i]) + (alpha * A.m_data[i]);
             }
         }
+        return ForBESUtils::STATUS_OK;
+    }
+    /* DIAGONAL + ANY: gamma * C is promoted to the type of A (BLOCK: to DENSE) */
+    size_t n = C.m_nrows;
+    Matrix result(true);
+    if (A.m_type == MATRIX_SPARSE) {
+        result = Matrix(n, n, MATRIX_SPARSE);
+        result.m_triplet = cholmod_allocate_triplet(n, n, n, 0, CHOLMOD_REAL, Matrix::cholmod_handle());
+        result.m_sparseStorageType = CHOLMOD_TYPE_TRIPLET;
+        int * ti = static_cast<int*> (result.m_triplet->i);
+        int * tj = static_cast<int*> (result.m_triplet->j);
+        double * tx = static_cast<double*> (result.m_triplet->x);
+        for (size_t i = 0; i < n; i++) {
+            ti[i] = i;
+            tj[i] = i;
+            tx[i] = gamma * C.m_data[i];
+        }
+        result.m_triplet->nnz = n;
     } else {
-        throw std::logic_error("Diagonal + Non-diagonal: not supported yet!");
+        if (A.m_type == MATRIX_BANDED) {
+            result = Matrix(n, n, A.m_kl, A.m_ku, A.m_band_symmetric);
+        } else if (A.m_type == MATRIX_SYMMETRIC || A.m_type == MATRIX_LOWERTR) {
+            result = Matrix(n, n, A.m_type);
+        } else {
+            result = Matrix(n, n);
+        }
+        result.m_transpose = A.m_transpose; /* same storage as A */
+        for (size_t i = 0; i < n; i++) {
+            result.set(i, i, gamma * C.m_data[i]);
+        }
     }
-    return ForBESUtils::STATUS_OK;
+    add(result, alpha, A, 1.0);
+    C = std::move(result);
+    return ForBESUtils::STATUS_HAD_TO_REALLOC;
 }
 
 int Matrix::generic_add_helper_left_lower_tri(Matrix& C, double alpha, Matrix& A, double gamma) {
@@ -1508,8 +2429,12 @@ int Matrix::generic_add_helper_left_lower_tri(Matrix& C, double alpha, Matrix& A
             }
         }
     } else if (A.m_type == Matrix::MATRIX_DIAGONAL) {
-        for (size_t i = 0; i < A.m_nrows; i++) {
-            C._addIJ(i, i, alpha * A.get(i, i), gamma);
+        if (!is_gamma_one) {
+            cblas_dscal(C.m_dataLength, gamma, C.m_data, 1);
+        }
+        size_t n = A.m_nrows;
+        for (size_t i = 0; i < n; i++) { /* diagonal of the packed storage */
+            C.m_data[i + n * i - i * (i + 1) / 2] += alpha * A.m_data[i];
         }
     } else {
         throw std::logic_error("Lower-triangular + Non-lower triangular): not supported yet!");
@@ -1518,39 +2443,54 @@ int Matrix::generic_add_helper_left_lower_tri(Matrix& C, double alpha, Matrix& A
 }
 
 int Matrix::mult(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma) {
+    return mult(C, alpha, A, B, gamma, false);
+}
+
+int Matrix::mult(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA) {
+    /* dimensions of op(A) */
+    size_t opA_nrows = transA ? A.getNcols() : A.getNrows();
+    size_t opA_ncols = transA ? A.getNrows() : A.getNcols();
     // A and C must have compatible dimensions
-    if (A.getNcols() != B.getNrows()) {
+    if (opA_ncols != B.getNrows()) {
         std::ostringstream oss;
-        oss << "A (" << A.getNrows() << "x" << A.getNcols()
+        oss << "op(A) (" << opA_nrows << "x" << opA_ncols
                 << ") and B (" << B.getNrows() << "x" << B.getNcols()
                 << ") do not have compatible dimensions";
         throw std::invalid_argument(oss.str().c_str());
     }
     /* C must have proper dimensions */
-    if (C.getNrows() != A.getNrows() || C.getNcols() != B.getNcols()) {
+    if (C.getNrows() != opA_nrows || C.getNcols() != B.getNcols()) {
         std::ostringstream oss;
-        oss << "C is " << C.getNrows() << "x" << C.getNrows()
-                << ", but it should be " << A.getNrows() << "x"
+        oss << "C is " << C.getNrows() << "x" << C.getNcols()
+                << ", but it should be " << opA_nrows << "x"
                 << B.getNcols();
         throw std::invalid_argument(oss.str().c_str());
     }
-    // C := gamma * C + alpha * A * B
+    C._detach();
+    // C := gamma * C + alpha * op(A) * B
+    // (diagonal and symmetric matrices are their own transposes)
     int status = ForBESUtils::STATUS_UNDEFINED_FUNCTION;
     switch (A.getType()) {
         case MATRIX_DENSE: /* DENSE += ? */
-            status = multiply_helper_left_dense(C, alpha, A, B, gamma);
+            status = multiply_helper_left_dense(C, alpha, A, B, gamma, transA);
             break;
         case MATRIX_SYMMETRIC: /* SYMMETRIC += ? */
             status = multiply_helper_left_symmetric(C, alpha, A, B, gamma);
             break;
         case MATRIX_LOWERTR: /* LOWER TRIANGULAR += ? */
-            //            status = generic_add_helper_left_lower_tri(C, alpha, A, gamma);
+            status = multiply_helper_left_lowertr(C, alpha, A, B, gamma, transA);
             break;
         case MATRIX_DIAGONAL: /* DIAGONAL += ? */
             status = multiply_helper_left_diagonal(C, alpha, A, B, gamma);
             break;
         case MATRIX_SPARSE: /* SPARSE += ? */
-            status = multiply_helper_left_sparse(C, alpha, A, B, gamma);
+            status = multiply_helper_left_sparse(C, alpha, A, B, gamma, transA);
+            break;
+        case MATRIX_BANDED: /* BANDED += ? */
+            status = multiply_helper_left_banded(C, alpha, A, B, gamma, transA);
+            break;
+        case MATRIX_BLOCK: /* BLOCK += ? */
+            status = multiply_helper_left_block(C, alpha, A, B, gamma, transA);
             break;
         default:
             break;
@@ -1558,88 +2498,257 @@ int Matrix::mult(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma) {
     return status;
 }
 
-int Matrix::multiply_helper_left_dense(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma) {
+int Matrix::mult(VectorView y, double alpha, Matrix& A, VectorView x, double gamma, bool transA) {
+    size_t opA_nrows = transA ? A.getNcols() : A.getNrows();
+    size_t opA_ncols = transA ? A.getNrows() : A.getNcols();
+    if (opA_ncols != x.size() || opA_nrows != y.size()) {
+        std::ostringstream oss;
+        oss << "op(A) (" << opA_nrows << "x" << opA_ncols
+                << "), x (" << x.size() << ") and y (" << y.size()
+                << ") do not have compatible dimensions";
+        throw std::invalid_argument(oss.str().c_str());
+    }
+    if (A.m_type == MATRIX_DENSE && opA_nrows > 0 && opA_ncols > 0) {
+        cblas_dgemv(CblasColMajor, (A.m_transpose != transA) ? CblasTrans : CblasNoTrans,
+                A._storedRows(), A.m_transpose ? A.m_nrows : A.m_ncols,
+                alpha, A.m_data, A.m_ld, x.data(), x.stride(), gamma, y.data(), y.stride());
+        return ForBESUtils::STATUS_OK;
+    }
+    if (A.m_type == MATRIX_SPARSE && x.stride() == 1 && y.stride() == 1) {
+        A._sparseGemv(A.m_transpose != transA, alpha, x.data(), gamma, y.data());
+        return ForBESUtils::STATUS_OK;
+    }
+    Matrix y_mat = y.asMatrix();
+    Matrix x_mat = x.asMatrix();
+    return mult(y_mat, alpha, A, x_mat, gamma, transA);
+}
+
+Matrix Matrix::_view(size_t row_start, size_t rows, size_t col_start, size_t cols) const {
+    Matrix view(true);
+    view.m_transpose = m_transpose;
+    view.m_nrows = rows;
+    view.m_ncols = cols;
+    view.m_dataLength = rows * cols;
+    view.m_ld = m_ld;
+    view.m_data = m_data + (m_transpose ? col_start + row_start * m_ld : row_start + col_start * m_ld);
+    return view;
+}
+
+int Matrix::multiply_helper_compact(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA) {
+    Matrix B_compact(true);
+    if (!B.isContiguous()) {
+        B_compact = B;
+    }
+    Matrix& B_ = B.isContiguous() ? B : B_compact;
+    if (C.isContiguous()) {
+        return mult(C, alpha, A, B_, gamma, transA);
+    }
+    /* compute op(A)*B into a contiguous matrix and add it to the view C */
+    Matrix AB(C.getNrows(), C.getNcols());
+    int status = mult(AB, 1.0, A, B_, 0.0, transA);
+    return std::max(status, add(C, alpha, AB, gamma));
+}
+
+int Matrix::multiply_helper_left_dense(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA) {
     /* A is dense */
+    if (C.m_type == MATRIX_SYMMETRIC && &A == &B && transA) {
+        /* 
+         * C := gamma*C + alpha*A'*A is a symmetric rank-k update which is 
+         * computed by dsfrk on the rectangular full packed (RFP) form of C,
+         * so C remains symmetric and takes up only n(n+1)/2 elements.
+         */
+        size_t n = A.getNcols();
+        if (C.getNrows() != n || C.getNcols() != n) {
+            std::ostringstream oss;
+            oss << "C is " << C.getNrows() << "x" << C.getNcols()
+                    << ", but it should be " << n << "x" << n;
+            throw std::invalid_argument(oss.str().c_str());
+        }
+        double * C_rfp = MatrixAllocator::allocate_data(C.m_dataLength, false);
+        int info = LAPACKE_dtpttf(LAPACK_COL_MAJOR, 'N', 'L', n, C.m_data, C_rfp);
+        if (info == ForBESUtils::STATUS_OK) {
+            info = LAPACKE_dsfrk(LAPACK_COL_MAJOR, 'N', 'L',
+                    A.m_transpose ? 'N' : 'T', /* A'A = S'S if A = S, or S S' if A = S' */
+                    n,
+                    A.m_nrows, /* k: the number of rows of A */
+                    alpha,
+                    A.m_data,
+                    A.m_ld,
+                    gamma,
+                    C_rfp);
+        }
+        if (info == ForBESUtils::STATUS_OK) { /* C is modified only on success */
+            info = LAPACKE_dtfttp(LAPACK_COL_MAJOR, 'N', 'L', n, C_rfp, C.m_data);
+        }
+        MatrixAllocator::free_data(C_rfp);
+        return info;
+    }
+    if (C.m_transpose) {
+        /* compute op(A)*B into a (non-transposed) dense matrix and add it to C */
+        Matrix AB(C.getNrows(), C.getNcols());
+        int status = multiply_helper_left_dense(AB, 1.0, A, B, 0.0, transA);
+        return std::max(status, add(C, alpha, AB, gamma));
+    }
     int status = ForBESUtils::STATUS_OK;
     if (C.m_dataLength < C.getNrows() * C.getNcols()) {
         C = Matrix(C.getNrows(), C.getNcols(), Matrix::MATRIX_DENSE);
         status = ForBESUtils::STATUS_HAD_TO_REALLOC;
     }
     C.m_type = Matrix::MATRIX_DENSE;
-    if (MATRIX_DENSE == B.m_type) { // B is also dense    
+    /* 
+     * A is stored as a (rows x sda) column-major array with leading dimension
+     * lda; the leading dimensions of B and C are those of their stored data,
+     * so strided views are operated on in place
+     */
+    bool trans = (A.m_transpose != transA);
+    size_t lda = A.m_ld;
+    size_t ldc = C.m_ld;
+    size_t sda = A.m_transpose ? A.m_nrows : A.m_ncols;
+    if (MATRIX_DENSE == B.m_type && B.isColumnVector()) { // B is a dense vector
+        cblas_dgemv(CblasColMajor,
+                trans ? CblasTrans : CblasNoTrans,
+                A._storedRows(),
+                sda,
+                alpha,
+                A.m_data,
+                lda,
+                B.m_data,
+                B._vectorInc(),
+                gamma,
+                C.m_data,
+                1);
+    } else if (MATRIX_DENSE == B.m_type) { // B is also dense    
         cblas_dgemm(CblasColMajor,
-                A.m_transpose ? CblasTrans : CblasNoTrans,
+                trans ? CblasTrans : CblasNoTrans,
                 B.m_transpose ? CblasTrans : CblasNoTrans,
-                A.m_nrows,
+                C.m_nrows,
                 B.m_ncols,
-                A.m_ncols,
+                B.m_nrows,
                 alpha,
                 A.m_data,
-                A.m_transpose ? A.m_ncols : A.m_nrows,
+                lda,
                 B.m_data,
-                B.m_transpose ? B.m_ncols : B.m_nrows,
+                B.m_ld,
                 gamma,
                 C.m_data,
-                C.m_nrows);
+                ldc);
         status = std::max(status, ForBESUtils::STATUS_OK);
     } else if (MATRIX_DIAGONAL == B.m_type) { // {DENSE} * {DIAGONAL} = {DENSE} - B is diagonal
-        for (size_t j = 0; j < C.getNcols(); j++) {
-            for (size_t i = 0; i < C.getNrows(); i++) {
-                C._addIJ(i, j, alpha * A.get(i, j) * B.get(j, j), gamma);
+        /* column scaling: C(:,j) = gamma * C(:,j) + alpha * B(j,j) * op(A)(:,j) */
+        for (size_t j = 0; j < C.m_ncols; j++) {
+            double * C_j = C.m_data + j * ldc;
+            if (gamma != 1.0) {
+                cblas_dscal(C.m_nrows, gamma, C_j, 1);
             }
+            cblas_daxpy(C.m_nrows, alpha * B.m_data[j],
+                    trans ? A.m_data + j : A.m_data + j * lda, trans ? lda : 1,
+                    C_j, 1);
+        }
+    } else if (MATRIX_SYMMETRIC == B.m_type) { // {DENSE} * {SYMMETRIC}: dsymm from the right
+        Matrix B_full = B._packedToDense();
+        Matrix opA(true);
+        if (trans) {
+            opA = Matrix(C.m_nrows, B.m_nrows);
+            transpose_copy(C.m_nrows, B.m_nrows, A.m_data, lda, opA.m_data);
+        }
+        cblas_dsymm(CblasColMajor,
+                CblasRight,
+                CblasLower,
+                C.m_nrows,
+                C.m_ncols,
+                alpha,
+                B_full.m_data,
+                B.m_nrows,
+                trans ? opA.m_data : A.m_data,
+                trans ? C.m_nrows : lda,
+                gamma,
+                C.m_data,
+                ldc);
+    } else if (MATRIX_LOWERTR == B.m_type) { // {DENSE} * {LOWER/UPPER TRIANGULAR}: dtrmm from the right
+        Matrix B_full = B._packedToDense();
+        Matrix T(C.m_nrows, C.m_ncols); /* T := op(A) */
+        if (trans) {
+            transpose_copy(C.m_nrows, C.m_ncols, A.m_data, lda, T.m_data);
+        } else {
+            copy_strided(C.m_nrows, C.m_ncols, A.m_data, lda, T.m_data, T.m_nrows);
         }
-        status = ForBESUtils::STATUS_OK;
-    } else if (MATRIX_SYMMETRIC == B.m_type || MATRIX_LOWERTR == B.m_type) {
-        domm(C, alpha, A, B, gamma);
-        status = ForBESUtils::STATUS_OK;
-    } else { /* {DENSE} * {SPARSE} =  */
-        /*
-         * Trick: For D: dense, S: sparse it is
-         * D * S = (S' * D')'
-         */
-        //        Matrix tempSparse(right);
-        //        (const_cast<Matrix&> (*this)).transpose(); /*  D'  */
-        //        tempSparse.transpose(); /*  S'  */
-        //        Matrix r = tempSparse * (const_cast<Matrix&> (*this)); /*  r = S' * D'   */
-        //        r.transpose(); /*  r'  */
-        //        (const_cast<Matrix&> (*this)).transpose(); /*  D  */
-        //        return r;
+        cblas_dtrmm(CblasColMajor,
+                CblasRight,
+                CblasLower,
+                B.m_transpose ? CblasTrans : CblasNoTrans,
+                CblasNonUnit,
+                T.m_nrows,
+                T.m_ncols,
+                alpha,
+                B_full.m_data,
+                B_full.m_nrows,
+                T.m_data,
+                T.m_nrows);
+        if (C.isContiguous()) {
+            axpby(T.m_dataLength, 1.0, T.m_data, gamma, C.m_data);
+        } else {
+            status = std::max(status, add(C, 1.0, T, gamma));
+        }
+    } else if (MATRIX_SPARSE == B.m_type) { // {DENSE} * {SPARSE}: one daxpy per nonzero of B
+        if (gamma != 1.0) {
+            C *= gamma;
+        }
+        B._createSparse();
+        const int * Bp = static_cast<int*> (B.m_sparse->p);
+        const int * Bi = static_cast<int*> (B.m_sparse->i);
+        const double * Bx = static_cast<double*> (B.m_sparse->x);
+        for (size_t jj = 0; jj < B.m_sparse->ncol; jj++) {
+            for (int p = Bp[jj]; p < Bp[jj + 1]; p++) {
+                /* B(i,j) = Bx[p] */
+                size_t i = B.m_transpose ? jj : Bi[p];
+                size_t j = B.m_transpose ? Bi[p] : jj;
+                cblas_daxpy(C.m_nrows, alpha * Bx[p],
+                        trans ? A.m_data + i : A.m_data + i * lda, trans ? lda : 1,
+                        C.m_data + j * ldc, 1);
+                if (B.m_sparse->stype != 0 && i != j) { /* B(j,i) = Bx[p] */
+                    cblas_daxpy(C.m_nrows, alpha * Bx[p],
+                            trans ? A.m_data + j : A.m_data + j * lda, trans ? lda : 1,
+                            C.m_data + i * ldc, 1);
+                }
+            }
+        }
+    } else {
+        domm(C, alpha, A, B, gamma, transA);
     }
     return status;
 }
 
-int Matrix::multiply_helper_left_sparse(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma) {
+int Matrix::multiply_helper_left_sparse(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA) {
     bool is_alpha_one = (std::abs(alpha - 1.0) < std::numeric_limits<double>::epsilon());
     bool is_gamma_zero = (std::abs(gamma) < std::numeric_limits<double>::epsilon());
     //    bool is_gamma_one = (std::abs(gamma) < std::numeric_limits<double>::epsilon());
     int status = ForBESUtils::STATUS_UNDEFINED_FUNCTION;
     if (B.m_type == MATRIX_SPARSE) {
         // RHS is sparse
-        if (A.m_sparse == NULL) {
-            A._createSparse();
-        }
-        if (B.m_sparse == NULL) {
-            B._createSparse();
-        }
-        if (C.m_sparse == NULL) {
-            C._createSparse();
-        }
+        bool trans = (A.m_transpose != transA);
+        bool dotProd = (transA ? A.isRowVector() : A.isColumnVector()) && B.isColumnVector();
+        cholmod_sparse * A_op = A._sparseOp(dotProd ? !trans : trans);
+        cholmod_sparse * B_op = B._sparseOp(B.m_transpose);
         cholmod_sparse *r; // r will store A * B
         r = cholmod_ssmult(
-                (A.isColumnVector() && B.isColumnVector())
-                ? cholmod_transpose(A.m_sparse, 1, Matrix::cholmod_handle())
-                : A.m_sparse,
-                B.m_sparse,
+                A_op,
+                B_op,
                 0,
                 true,
                 false,
                 Matrix::cholmod_handle()); // r = A*B
+        if (A_op != A.m_sparse) {
+            cholmod_free_sparse(&A_op, Matrix::cholmod_handle());
+        }
+        if (B_op != B.m_sparse) {
+            cholmod_free_sparse(&B_op, Matrix::cholmod_handle());
+        }
 
         /*
          * SCALE: r *= alpha (unless alpha == 1)
          */
         if (!is_alpha_one) {
-            for (size_t j = 0; j < C.m_ncols; j++) {
+            for (size_t j = 0; j < r->ncol; j++) {
                 int p = (static_cast<int*> (r->p))[j];
                 int pend = (r->packed == 1)
                         ? ((static_cast<int*> (r->p))[j + 1])
@@ -1650,89 +2759,71 @@ int Matrix::multiply_helper_left_sparse(Matrix& C, double alpha, Matrix& A, Matr
             }
         }
 
-
-        if (is_gamma_zero) {
-            cholmod_triplet * r_to_triplet = cholmod_sparse_to_triplet(r, Matrix::cholmod_handle());
+        if (is_gamma_zero && C.m_type == MATRIX_SPARSE) {
             // C := alpha * A * B = r
+            if (C.m_triplet != NULL) {
+                cholmod_free_triplet(&C.m_triplet, Matrix::cholmod_handle());
+                C.m_triplet = NULL;
+            }
+            if (C.m_sparse != NULL) {
+                cholmod_free_sparse(&C.m_sparse, Matrix::cholmod_handle());
+            }
             C.m_sparse = r;
-            C.m_triplet = r_to_triplet;
+            C.m_sparse_dirty = false;
+            C.m_transpose = false;
+            C.m_sparseStorageType = CHOLMOD_TYPE_SPARSE;
             status = ForBESUtils::STATUS_OK;
         } else {
-            Matrix temp_r = Matrix(true);
+            Matrix temp_r = Matrix(true); // takes ownership of r
             temp_r.m_nrows = C.getNrows();
             temp_r.m_ncols = C.getNcols();
-            temp_r.m_sparse = cholmod_copy_sparse(r, cholmod_handle());
+            temp_r.m_ld = C.getNrows();
+            temp_r.m_sparse = r;
             temp_r.m_type = MATRIX_SPARSE;
-            temp_r.m_triplet = cholmod_sparse_to_triplet(temp_r.m_sparse, Matrix::cholmod_handle());
-            add(C, 1.0, temp_r, gamma);
-            status = ForBESUtils::STATUS_OK;
+            status = add(C, 1.0, temp_r, gamma);
         }
     } else if (B.m_type == MATRIX_DENSE) { /* C = gamma * C + alpha * SPARSE * DENSE */
-
-
-        // RHS is dense
-        //                Matrix result(A.getNrows(), B..getNcols());
-
-        //        if (A.m_triplet != NULL && A.m_sparse == NULL)
-        //            A._createSparse();
-        //
-        //        double alpha[2] = {1.0, 0.0};
-        //        double beta[2] = {0.0, 0.0};
-        //
-        //        if (B.m_dense == NULL) { /* Prepare right.m_dense */
-        //            B.m_dense = cholmod_allocate_dense(
-        //                    B.getNrows(),
-        //                    B.getNcols(),
-        //                    B.getNrows(),
-        //                    CHOLMOD_REAL,
-        //                    Matrix::cholmod_handle());
-        //
-        //            if (!B.m_transpose) {
-        //                B.m_dense->x = B.m_data;
-        //            } else {
-        //                /* Store RHS as transpose into right.m_dense */
-        //                for (size_t i = 0; i < B.getNrows(); i++) { /* SPARSE x DENSE' */
-        //                    for (size_t j = 0; j < B.getNcols(); j++) {
-        //                        (static_cast<double*> (B.m_dense->x))[i + j * B.getNrows()] = B.get(i, j);
-        //                    }
-        //                }
-        //            }
-        //        }
-        //
-        //        bool dotProd = isColumnVector() && B.isColumnVector();
-        //        C.m_dense = cholmod_allocate_dense(
-        //                dotProd ? 1 : B.getNrows(),
-        //                dotProd ? 1 : B.getNcols(),
-        //                dotProd ? 1 : B.getNrows(),
-        //                CHOLMOD_REAL,
-        //                Matrix::cholmod_handle());
-
-        //        if (m_transpose) {
-        //            this->transpose();
-        //        }
-        //        cholmod_sdmult(
-        //                m_sparse,
-        //                dotProd ? true : m_transpose,
-        //                alpha,
-        //                beta,
-        //                right.m_dense,
-        //                result.m_dense,
-        //                Matrix::cholmod_handle()
-        //                );
-        //        if (m_transpose) {
-        //            this->transpose();
-        //        }
-        //        for (size_t k = 0; k < result.length(); k++) {
-        //            result.m_data[k] = (static_cast<double*> (result.m_dense->x))[k];
-        //        }
-
-
+        if (C.m_type != MATRIX_DENSE || C.m_transpose || C.m_data == B.m_data) {
+            /* compute alpha * A * B into a temporary and add it to C */
+            Matrix AB(C.getNrows(), C.getNcols());
+            status = multiply_helper_left_sparse(AB, alpha, A, B, 0.0, transA);
+            if (!ForBESUtils::is_status_ok(status)) {
+                return status;
+            }
+            return std::max(status, add(C, 1.0, AB, gamma));
+        }
+        status = ForBESUtils::STATUS_OK;
+        if (C.m_dataLength < C.getNrows() * C.getNcols()) {
+            C = Matrix(C.getNrows(), C.getNcols(), Matrix::MATRIX_DENSE);
+            status = ForBESUtils::STATUS_HAD_TO_REALLOC;
+        }
+        A._createSparse();
+        Matrix B_untransposed(true);
+        if (B.m_transpose) {
+            B_untransposed = Matrix(B.getNrows(), B.getNcols());
+            for (size_t i = 0; i < B.getNrows(); i++) {
+                for (size_t j = 0; j < B.getNcols(); j++) {
+                    B_untransposed.m_data[i + j * B.getNrows()] = B.get(i, j);
+                }
+            }
+        }
+        const double * B_data = B.m_transpose ? B_untransposed.m_data : B.m_data;
+        size_t ldb = B.m_transpose ? B.getNrows() : B.m_ld;
+        /* column by column: C(:,k) = gamma * C(:,k) + alpha * A * B(:,k) */
+        for (size_t k = 0; k < B.getNcols(); k++) {
+            A._sparseGemv(
+                    A.m_transpose != transA,
+                    alpha,
+                    B_data + k * ldb,
+                    gamma,
+                    C.m_data + k * C.m_ld);
+        }
     } else if (B.m_type == MATRIX_DIAGONAL) { // += alpha * SPARSE * DIAGONAL
-        Matrix A_temp(A); //  Compute A_temp = A * alpha;
-        for (size_t k = 0; k < A.m_triplet->nnz; k++) {
-            int j_ = (static_cast<int*> (A_temp.m_triplet->j))[k];
-            static_cast<double*> (A_temp.m_triplet->x)[k] *= (alpha * B.get(j_, j_));
+        Matrix A_temp(A); //  Compute A_temp = alpha * op(A) * B;
+        if (transA) {
+            A_temp.transpose();
         }
+        A_temp._sparseScaleColumns(alpha, B);
         status = add(C, 1.0, A_temp, gamma);
     } else {
         //LCOV_EXCL_START
@@ -1743,6 +2834,44 @@ int Matrix::multiply_helper_left_sparse(Matrix& C, double alpha, Matrix& A, Matr
 }
 
 int Matrix::multiply_helper_left_diagonal(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma) {
+    if (!B.isContiguous() || !C.isContiguous()) {
+        return multiply_helper_compact(C, alpha, A, B, gamma, false);
+    }
+    if (B.m_type == MATRIX_SPARSE) { /* D*B = (B'*D)': the rows of B are scaled */
+        Matrix DB(B);
+        DB.transpose();
+        DB._sparseScaleColumns(alpha, A);
+        DB.transpose();
+        return add(C, 1.0, DB, gamma);
+    }
+    if (C.m_type == MATRIX_DENSE && !C.m_transpose && B.m_type != MATRIX_DIAGONAL) {
+        /* row scaling: C(:,j) = gamma * C(:,j) + alpha * A * B(:,j) (dsbmv with no off-diagonals) */
+        Matrix B_dense(true);
+        if (B.m_type == MATRIX_SYMMETRIC || B.m_type == MATRIX_LOWERTR) {
+            B_dense = B._packedToDense();
+            B_dense.m_transpose = B.m_transpose;
+        } else if (B.m_type != MATRIX_DENSE) {
+            B_dense = Matrix(B.getNrows(), B.getNcols());
+            add(B_dense, 1.0, B, 0.0);
+        }
+        Matrix& B_ = (B.m_type == MATRIX_DENSE) ? B : B_dense;
+        size_t ldb = B_.m_transpose ? B_.m_ncols : B_.m_nrows;
+        for (size_t j = 0; j < C.m_ncols; j++) {
+            cblas_dsbmv(CblasColMajor,
+                    CblasLower,
+                    C.m_nrows,
+                    0,
+                    alpha,
+                    A.m_data,
+                    1,
+                    B_.m_transpose ? B_.m_data + j : B_.m_data + j * ldb,
+                    B_.m_transpose ? ldb : 1,
+                    gamma,
+                    C.m_data + j * C.m_nrows,
+                    1);
+        }
+        return ForBESUtils::STATUS_OK;
+    }
     for (size_t i = 0; i < C.m_nrows; i++) {
         if (MATRIX_SYMMETRIC == B.m_type) {
             for (size_t j = i; j < B.m_ncols; j++) {
@@ -1764,8 +2893,17 @@ int Matrix::multiply_helper_left_diagonal(Matrix& C, double alpha, Matrix& A, Ma
 }
 
 int Matrix::multiply_helper_left_symmetric(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma) {
+    if (!B.isContiguous() || !C.isContiguous()) {
+        return multiply_helper_compact(C, alpha, A, B, gamma, false);
+    }
     // multiply when the LHS is symmetric        
-    if (B.isColumnVector()) {
+    if (C.m_type != MATRIX_DENSE || C.m_transpose) {
+        /* compute A*B into a dense matrix and add it to C */
+        Matrix AB(C.getNrows(), C.getNcols());
+        int status = multiply_helper_left_symmetric(AB, 1.0, A, B, 0.0);
+        return std::max(status, add(C, alpha, AB, gamma));
+    }
+    if (B.m_type == MATRIX_DENSE && B.isColumnVector()) { /* packed storage: dspmv */
         cblas_dspmv(CblasColMajor,
                 CblasLower,
                 A.m_nrows,
@@ -1776,8 +2914,396 @@ int Matrix::multiply_helper_left_symmetric(Matrix& C, double alpha, Matrix& A, M
                 gamma,
                 C.m_data,
                 1);
+    } else if (B.m_type == MATRIX_DENSE) { /* full storage: dsymm */
+        Matrix A_full = A._packedToDense();
+        Matrix B_untransposed(true);
+        if (B.m_transpose) {
+            B_untransposed = Matrix(B.getNrows(), B.getNcols());
+            transpose_copy(B.getNrows(), B.getNcols(), B.m_data, B.m_ncols, B_untransposed.m_data);
+        }
+        cblas_dsymm(CblasColMajor,
+                CblasLeft,
+                CblasLower,
+                C.m_nrows,
+                C.m_ncols,
+                alpha,
+                A_full.m_data,
+                A.m_nrows,
+                B.m_transpose ? B_untransposed.m_data : B.m_data,
+                B.m_nrows,
+                gamma,
+                C.m_data,
+                C.m_nrows);
+    } else {
+        Matrix A_full = A._packedToDense();
+        return multiply_helper_left_dense(C, alpha, A_full, B, gamma, false);
+    }
+    return ForBESUtils::STATUS_OK;
+}
+
+int Matrix::multiply_helper_left_lowertr(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA) {
+    if (!B.isContiguous() || !C.isContiguous()) {
+        return multiply_helper_compact(C, alpha, A, B, gamma, transA);
+    }
+    /* A is lower triangular (upper triangular if it is transposed) */
+    if (C.m_type != MATRIX_DENSE || C.m_transpose) {
+        /* compute op(A)*B into a dense matrix and add it to C */
+        Matrix AB(C.getNrows(), C.getNcols());
+        int status = multiply_helper_left_lowertr(AB, 1.0, A, B, 0.0, transA);
+        return std::max(status, add(C, alpha, AB, gamma));
+    }
+    bool trans = (A.m_transpose != transA);
+    size_t n = A.m_nrows;
+    if (B.m_type == MATRIX_DENSE && B.isColumnVector()) { /* packed storage: dtpmv */
+        Matrix x(B);
+        x._detach(); /* x is overwritten by dtpmv */
+        cblas_dtpmv(CblasColMajor,
+                CblasLower,
+                trans ? CblasTrans : CblasNoTrans,
+                CblasNonUnit,
+                n,
+                A.m_data,
+                x.m_data,
+                1);
+        axpby(n, alpha, x.m_data, gamma, C.m_data);
+    } else if (B.m_type == MATRIX_DENSE) { /* full storage: dtrmm */
+        Matrix A_full = A._packedToDense();
+        Matrix T(B.getNrows(), B.getNcols()); /* T := B */
+        if (B.m_transpose) {
+            transpose_copy(T.m_nrows, T.m_ncols, B.m_data, B.m_ncols, T.m_data);
+        } else {
+            cblas_dcopy(T.m_dataLength, B.m_data, 1, T.m_data, 1);
+        }
+        cblas_dtrmm(CblasColMajor,
+                CblasLeft,
+                CblasLower,
+                trans ? CblasTrans : CblasNoTrans,
+                CblasNonUnit,
+                T.m_nrows,
+                T.m_ncols,
+                alpha,
+                A_full.m_data,
+                n,
+                T.m_data,
+                T.m_nrows);
+        axpby(T.m_dataLength, 1.0, T.m_data, gamma, C.m_data);
     } else {
-        domm(C, alpha, A, B, gamma);
+        Matrix A_full = A._packedToDense();
+        return multiply_helper_left_dense(C, alpha, A_full, B, gamma, trans);
     }
     return ForBESUtils::STATUS_OK;
 }
+
+Matrix Matrix::_packedToDense() const {
+    size_t n = m_transpose ? m_ncols : m_nrows;
+    Matrix full(n, n);
+    LAPACKE_dtpttr(LAPACK_COL_MAJOR, 'L', n, m_data, full.m_data, n);
+    if (m_type == MATRIX_SYMMETRIC) {
+        for (size_t j = 1; j < n; j++) { /* upper part of column j := lower part of row j */
+            cblas_dcopy(j, full.m_data + j, n, full.m_data + j * n, 1);
+        }
+    }
+    return full;
+}
+
+int Matrix::multiply_helper_left_banded(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA) {
+    if (!B.isContiguous() || !C.isContiguous()) {
+        return multiply_helper_compact(C, alpha, A, B, gamma, transA);
+    }
+    /* A is banded */
+    if (C.m_type != MATRIX_DENSE || C.m_transpose) {
+        /* compute op(A)*B into a dense matrix and add it to C */
+        Matrix AB(C.getNrows(), C.getNcols());
+        multiply_helper_left_banded(AB, 1.0, A, B, 0.0, transA);
+        return add(C, alpha, AB, gamma);
+    }
+    if (B.m_type == MATRIX_DENSE && !B.m_transpose) {
+        /* one banded matrix-vector product per column of B */
+        for (size_t k = 0; k < B.m_ncols; k++) {
+            A._bandGemv(transA, alpha, B.m_data + k * B.m_nrows, gamma, C.m_data + k * C.m_nrows);
+        }
+    } else {
+        domm(C, alpha, A, B, gamma, transA);
+    }
+    return ForBESUtils::STATUS_OK;
+}
+
+int Matrix::generic_add_helper_left_banded(Matrix& C, double alpha, Matrix& A, double gamma) {
+    bool is_gamma_one = (std::abs(gamma - 1.0) < std::numeric_limits<double>::epsilon());
+    if (A.m_type == MATRIX_BANDED && A.m_kl == C.m_kl && A.m_ku == C.m_ku
+            && A.m_band_symmetric == C.m_band_symmetric && A.m_transpose == C.m_transpose) {
+        /* BANDED + BANDED (same band) = BANDED */
+        if (is_gamma_one) {
+            cblas_daxpy(A.length(), alpha, A.m_data, 1, C.m_data, 1);
+        } else {
+            for (size_t i = 0; i < A.length(); i++) {
+                C.m_data[i] = (gamma * C.m_data[i]) + (alpha * A.m_data[i]);
+            }
+        }
+        return ForBESUtils::STATUS_OK;
+    } else if (A.m_type == MATRIX_DIAGONAL) { /* BANDED + DIAGONAL = BANDED */
+        if (!is_gamma_one) {
+            cblas_dscal(C.length(), gamma, C.m_data, 1);
+        }
+        for (size_t i = 0; i < A.m_nrows; i++) {
+            *C._bandEntry(i, i) += alpha * A.m_data[i];
+        }
+        return ForBESUtils::STATUS_OK;
+    }
+    /* BANDED + ANY = DENSE */
+    Matrix result(C.getNrows(), C.getNcols());
+    for (size_t j = 0; j < C.getNcols(); j++) {
+        size_t i_end = std::min(C.getNrows(), j + C.getLowerBandwidth() + 1);
+        size_t ku = C.getUpperBandwidth();
+        for (size_t i = (j > ku ? j - ku : 0); i < i_end; i++) {
+            result.m_data[i + j * result.m_nrows] = gamma * C.get(i, j);
+        }
+    }
+    generic_add_helper_left_dense(result, alpha, A, 1.0);
+    C = std::move(result);
+    return ForBESUtils::STATUS_HAD_TO_REALLOC;
+}
+
+size_t Matrix::_bandLd() const {
+    return m_band_symmetric ? m_kl + 1 : m_kl + m_ku + 1;
+}
+
+double * Matrix::_bandEntry(size_t i, size_t j) const {
+    size_t i_ = m_transpose ? j : i; /* position in the stored matrix */
+    size_t j_ = m_transpose ? i : j;
+    if (m_band_symmetric && i_ < j_) { /* only the lower band is stored */
+        std::swap(i_, j_);
+    }
+    if (i_ > j_ + m_kl || j_ > i_ + m_ku) {
+        return NULL;
+    }
+    return m_data + (m_band_symmetric ? i_ - j_ : m_ku + i_ - j_) + j_ * _bandLd();
+}
+
+void Matrix::_bandGemv(bool transA, double alpha, const double * x, double gamma, double * y) const {
+    if (m_band_symmetric) {
+        cblas_dsbmv(CblasColMajor, CblasLower, m_nrows, m_kl, alpha, m_data, _bandLd(),
+                x, 1, gamma, y, 1);
+    } else {
+        bool trans = (m_transpose != transA);
+        cblas_dgbmv(CblasColMajor, trans ? CblasTrans : CblasNoTrans,
+                m_transpose ? m_ncols : m_nrows, m_transpose ? m_nrows : m_ncols,
+                m_kl, m_ku, alpha, m_data, _bandLd(), x, 1, gamma, y, 1);
+    }
+}
+
+Matrix * Matrix::_blockEntry(size_t i, size_t j, size_t& i_block, size_t& j_block) const {
+    size_t i_ = m_transpose ? j : i; /* position in the stored matrix */
+    size_t j_ = m_transpose ? i : j;
+    size_t I = block_index(m_blocks->row_offsets, i_);
+    size_t J = block_index(m_blocks->col_offsets, j_);
+    i_block = i_ - m_blocks->row_offsets[I]; /* position in the (stored) block */
+    j_block = j_ - m_blocks->col_offsets[J];
+    return m_blocks->at(I, J);
+}
+
+void Matrix::_blockPrepare() {
+    for (size_t k = 0; k < m_blocks->blocks.size(); k++) {
+        Matrix * block = m_blocks->blocks[k];
+        if (block == NULL) {
+            continue;
+        }
+        if (block->m_type == MATRIX_SPARSE) {
+            block->_createSparse();
+        } else if (block->m_type == MATRIX_BLOCK) {
+            block->_blockPrepare();
+        }
+    }
+}
+
+void Matrix::_blockAddTo(Matrix& C, double alpha) {
+    for (size_t J = 0; J < m_blocks->nbc(); J++) {
+        for (size_t I = 0; I < m_blocks->nbr(); I++) {
+            Matrix * block = m_blocks->at(I, J);
+            if (block == NULL) {
+                continue;
+            }
+            size_t r0 = m_blocks->row_offsets[I];
+            size_t c0 = m_blocks->col_offsets[J];
+            /* element (i,j) of the block is element (r0+i, c0+j) of the stored matrix */
+            if (block->m_type == MATRIX_SPARSE) {
+                block->_createSparse();
+                const int * Bp = static_cast<int*> (block->m_sparse->p);
+                const int * Bi = static_cast<int*> (block->m_sparse->i);
+                const double * Bx = static_cast<double*> (block->m_sparse->x);
+                for (size_t jj = 0; jj < block->m_sparse->ncol; jj++) {
+                    for (int p = Bp[jj]; p < Bp[jj + 1]; p++) {
+                        size_t i = block->m_transpose ? jj : Bi[p];
+                        size_t j = block->m_transpose ? Bi[p] : jj;
+                        double v = alpha * Bx[p];
+                        C._addIJ(m_transpose ? c0 + j : r0 + i, m_transpose ? r0 + i : c0 + j, v);
+                        if (block->m_sparse->stype != 0 && i != j) { /* the other triangle */
+                            C._addIJ(m_transpose ? c0 + i : r0 + j, m_transpose ? r0 + j : c0 + i, v);
+                        }
+                    }
+                }
+            } else if (block->m_type == MATRIX_DIAGONAL) {
+                for (size_t i = 0; i < block->m_nrows; i++) {
+                    C._addIJ(m_transpose ? c0 + i : r0 + i, m_transpose ? r0 + i : c0 + i, alpha * block->m_data[i]);
+                }
+            } else {
+                for (size_t j = 0; j < block->getNcols(); j++) {
+                    for (size_t i = 0; i < block->getNrows(); i++) {
+                        C._addIJ(m_transpose ? c0 + j : r0 + i, m_transpose ? r0 + i : c0 + j, alpha * block->get(i, j));
+                    }
+                }
+            }
+        }
+    }
+}
+
+int Matrix::generic_add_helper_left_block(Matrix& C, double alpha, Matrix& A, double gamma) {
+    if (A.m_type == MATRIX_BLOCK && A.m_transpose == C.m_transpose
+            && A.m_blocks->row_offsets == C.m_blocks->row_offsets
+            && A.m_blocks->col_offsets == C.m_blocks->col_offsets) {
+        /* BLOCK + BLOCK (same partition) = BLOCK, block by block */
+        BlockStorage * Cb = C.m_blocks;
+        BlockStorage * Ab = A.m_blocks;
+        size_t nblocks = Cb->blocks.size();
+        /* blocks which involve CHOLMOD are updated sequentially */
+        std::vector<char> sequential(nblocks, 0);
+        bool any_parallel = false;
+        for (size_t k = 0; k < nblocks; k++) {
+            Matrix * Ck = Cb->blocks[k];
+            Matrix * Ak = Ab->blocks[k];
+            sequential[k] = (Ck != NULL && (Ck->m_type == MATRIX_SPARSE || Ck->m_type == MATRIX_BLOCK))
+                    || (Ak != NULL && (Ak->m_type == MATRIX_SPARSE || Ak->m_type == MATRIX_BLOCK));
+            any_parallel = any_parallel || !sequential[k];
+        }
+        int status = ForBESUtils::STATUS_OK;
+        for (int pass = 0; pass < 2; pass++) {
+            /* pass 0: sequential blocks; pass 1: all other blocks (in parallel) */
+#pragma omp parallel for schedule(dynamic) if (pass == 1 && any_parallel)
+            for (size_t k = 0; k < nblocks; k++) {
+                if (sequential[k] != (pass == 0)) {
+                    continue;
+                }
+                Matrix * Ck = Cb->blocks[k];
+                Matrix * Ak = Ab->blocks[k];
+                int status_k = ForBESUtils::STATUS_OK;
+                if (Ak == NULL) {
+                    if (Ck != NULL) {
+                        *Ck *= gamma;
+                    }
+                } else if (Ck == NULL) {
+                    Cb->blocks[k] = new Matrix(*Ak);
+                    *Cb->blocks[k] *= alpha;
+                } else {
+                    status_k = add(*Ck, alpha, *Ak, gamma);
+                }
+                if (status_k != ForBESUtils::STATUS_OK) {
+#pragma omp critical
+                    status = std::max(status, status_k);
+                }
+            }
+        }
+        return status;
+    }
+    if (A.m_type == MATRIX_DIAGONAL && C.m_blocks->row_offsets == C.m_blocks->col_offsets) {
+        /* BLOCK + DIAGONAL = BLOCK: only the diagonal blocks change */
+        BlockStorage * Cb = C.m_blocks;
+        int status = ForBESUtils::STATUS_OK;
+        for (size_t J = 0; J < Cb->nbc(); J++) {
+            for (size_t I = 0; I < Cb->nbr(); I++) {
+                Matrix * Ck = Cb->at(I, J);
+                if (I != J) {
+                    if (Ck != NULL) {
+                        *Ck *= gamma;
+                    }
+                    continue;
+                }
+                size_t n = Cb->row_offsets[I + 1] - Cb->row_offsets[I];
+                Matrix D(n, n, MATRIX_DIAGONAL);
+                memcpy(D.m_data, A.m_data + Cb->row_offsets[I], n * sizeof (double));
+                if (Ck == NULL) {
+                    Cb->at(I, J) = new Matrix(D);
+                    *Cb->at(I, J) *= alpha;
+                } else {
+                    *Ck *= gamma;
+                    status = std::max(status, add(*Ck, alpha, D, 1.0));
+                }
+            }
+        }
+        return status;
+    }
+    /* BLOCK + ANY = DENSE */
+    Matrix result(C.getNrows(), C.getNcols());
+    C._blockAddTo(result, gamma);
+    generic_add_helper_left_dense(result, alpha, A, 1.0);
+    C = std::move(result);
+    return ForBESUtils::STATUS_HAD_TO_REALLOC;
+}
+
+int Matrix::multiply_helper_left_block(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA) {
+    if (C.m_type != MATRIX_DENSE || C.m_transpose || C.m_data == B.m_data) {
+        /* compute op(A)*B into a dense matrix and add it to C */
+        Matrix AB(C.getNrows(), C.getNcols());
+        int status = multiply_helper_left_block(AB, 1.0, A, B, 0.0, transA);
+        return std::max(status, add(C, alpha, AB, gamma));
+    }
+    bool trans = (A.m_transpose != transA);
+    BlockStorage * blocks = A.m_blocks;
+    /* block rows of op(A) and block rows of B */
+    const std::vector<size_t>& out_offsets = trans ? blocks->col_offsets : blocks->row_offsets;
+    const std::vector<size_t>& in_offsets = trans ? blocks->row_offsets : blocks->col_offsets;
+    size_t n_out = out_offsets.size() - 1;
+    size_t n_in = in_offsets.size() - 1;
+    size_t ncols = B.getNcols();
+
+    /* 
+     * Slices of B which correspond to the block columns of op(A) are strided
+     * views of B, so nothing is copied. B is first converted to a dense
+     * matrix if necessary.
+     */
+    Matrix B_dense(true);
+    if (B.m_type != MATRIX_DENSE) {
+        B_dense = Matrix(B.getNrows(), ncols);
+        add(B_dense, 1.0, B, 0.0);
+    }
+    Matrix& B_ = (B.m_type != MATRIX_DENSE) ? B_dense : B;
+    std::vector<Matrix> B_slices;
+    B_slices.reserve(n_in);
+    for (size_t K = 0; K < n_in; K++) {
+        B_slices.push_back(B_._view(in_offsets[K], in_offsets[K + 1] - in_offsets[K], 0, ncols));
+    }
+
+    /* 
+     * Every block row of the result is computed independently (in parallel)
+     * and in place, in a view of C; the CSC of sparse blocks is created 
+     * beforehand, so that the products do not need to call CHOLMOD.
+     */
+    A._blockPrepare();
+    int status = ForBESUtils::STATUS_OK;
+#pragma omp parallel for schedule(dynamic) if (n_out > 1)
+    for (size_t K = 0; K < n_out; K++) {
+        size_t r0 = out_offsets[K];
+        size_t rows = out_offsets[K + 1] - r0;
+        Matrix C_K = C._view(r0, rows, 0, ncols); /* C_K = gamma * C_K + alpha * sum_L op(A)_{K,L} * B_L */
+        int status_K = ForBESUtils::STATUS_OK;
+        double gamma_K = gamma;
+        for (size_t L = 0; L < n_in; L++) {
+            Matrix * block = trans ? blocks->at(L, K) : blocks->at(K, L);
+            if (block != NULL) {
+                status_K = std::max(status_K, mult(C_K, alpha, *block, B_slices[L], gamma_K, trans));
+                gamma_K = 1.0;
+            }
+        }
+        if (gamma_K == 0.0) { /* zero block row and C is not to be read */
+            for (size_t j = 0; j < ncols; j++) {
+                std::fill(C_K.m_data + j * C_K.m_ld, C_K.m_data + j * C_K.m_ld + rows, 0.0);
+            }
+        } else if (gamma_K != 1.0) {
+            C_K *= gamma_K;
+        }
+        if (status_K != ForBESUtils::STATUS_OK) {
+#pragma omp critical
+            status = std::max(status, status_K);
+        }
+    }
+    return status;
+}
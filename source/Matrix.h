@@ -24,8 +24,14 @@
 
 
 #include "cholmod.h"
+#include "CholmodContext.h"
 #include "ForBESUtils.h"
+#include "MatrixAllocator.h"
 #include <utility>
+#include <vector>
+#include <atomic>
+
+class VectorView;
 
 /**
  * \class Matrix
@@ -43,14 +49,26 @@
  *
  * \par
  * A generic matrix which can be an unstructured dense, a structured dense (e.g.,
- * symmetric or lower triangular, stored in packed form) or a dense matrix.
+ * symmetric or lower triangular, stored in packed form), a banded matrix (stored
+ * in LAPACK band storage), a block matrix whose blocks are matrices of any type,
+ * or a dense matrix.
  * This class provides a uniform access framework (an API) to matrix-matrix
  * operations (e.g., addition and multiplication), factorizations and other useful
  * operations.
  *
  * \par
  * To construct a Matrix you can use one of this class's constructors. However,
- * for sparse matrices it is advisable to use the factory class <code>MatrixFactory</code>.
+ * for sparse matrices it is advisable to use the factory class <code>MatrixFactory</code>,
+ * which is also the only way to construct banded and block matrices.
+ * 
+ * \par
+ * Copies of matrices share their data (dense data and CHOLMOD representations)
+ * until either of them is modified (copy-on-write), so copying a matrix costs
+ * O(1). The data of a matrix are no longer shared once pointers to them have 
+ * been handed out for writing (by the non-const #getData and <code>operator[]</code>,
+ * or by shallow matrices and views of MatrixFactory), since writes through such
+ * pointers cannot be tracked. Read-only access (e.g., through a const reference)
+ * and operations which only read a matrix (such as products) do not copy it.
  * 
  * \attention
  * Do not create methods where arguments of type %Matrix are passed as const. Most
@@ -70,26 +88,28 @@ public:
     /* STATIC */
 
     /**
-     * This is the single access method to the singleton <code>cholmod_common</code>
-     * used in this project. Typically clients will not be interested in using this
-     * <code>cholmod_common</code> to perform any matrix-matrix operations or factorization,
-     * however, it can be used to check the status of computations, get the overall
-     * flop count and more.
+     * The <code>cholmod_common</code> of the calling thread (see CholmodContext),
+     * which is used for all CHOLMOD operations on sparse matrices that are
+     * performed by this thread. Typically clients will not be interested in 
+     * using this <code>cholmod_common</code> to perform any matrix-matrix 
+     * operations or factorization, however, it can be used to check the status
+     * of computations, get the overall flop count and more.
      *
-     * This method will construct and store internally an instance of <code>cholmod_common</code>
-     * if one does not exist.
+     * Each thread has its own <code>cholmod_common</code>, which is created
+     * the first time this method is called by the thread, so that sparse
+     * matrices can be used by several threads concurrently.
      *
-     * @return The singleton <code>cholmod_common</code> object.
+     * @return The <code>cholmod_common</code> object of the calling thread.
      */
     static cholmod_common* cholmod_handle();
 
     /**
-     * Static method used to destroy the singleton <code>cholmod_handle</code>,
-     * if any.
-     *
+     * Static method used to destroy the <code>cholmod_handle</code> of the 
+     * calling thread, if any. The handle of a thread is also destroyed 
+     * automatically when the thread exits.
      *
-     * @return status this call returns <code>0</code> when it succeeds. See the
-     * CHOLMOD documentation for the interpretation of error codes.
+     * @return status this call returns <code>1</code> if a handle was destroyed
+     * and <code>0</code> if the calling thread had no handle.
      */
     static int destroy_handle();
 
@@ -101,7 +121,9 @@ public:
         MATRIX_SPARSE, /**< A sparse matrix (powered by SuiteSparse) */
         MATRIX_DIAGONAL, /**< A diagonal matrix */
         MATRIX_LOWERTR, /**< A lower-triangular matrix */
-        MATRIX_SYMMETRIC /**< A symmetric matrix */
+        MATRIX_SYMMETRIC, /**< A symmetric matrix */
+        MATRIX_BANDED, /**< A (general or symmetric) banded matrix (see MatrixFactory::MakeBanded) */
+        MATRIX_BLOCK /**< A matrix composed of blocks of any type (see MatrixFactory::MakeBlock) */
     };
 
     /**
@@ -185,12 +207,30 @@ public:
     Matrix(size_t nr, size_t nc, const double * data, MatrixType matrixType);
 
     /**
-     * Copy-constructor. This constructor will hard-copy the contents and state of
-     * the given matrix.
+     * Copy-constructor. The new matrix has the contents and state of the 
+     * given matrix. The data are shared with <code>orig</code> and copied only
+     * when either matrix is modified (copy-on-write); shallow matrices, strided
+     * views and matrices whose data have been exposed (see #getData) are 
+     * copied immediately.
      * @param orig
      */
     Matrix(const Matrix& orig);
 
+    /**
+     * Move-constructor. The new matrix takes over the data of <code>orig</code>
+     * (its dense data and all its CHOLMOD representations) without allocating
+     * any memory or copying any data. 
+     * 
+     * Shallow matrices remain shallow, i.e., if <code>orig</code> does not own
+     * its data, neither will the new matrix.
+     * 
+     * \post <code>orig</code> is left as an empty matrix which does not own
+     * any data.
+     * 
+     * @param orig matrix to be moved
+     */
+    Matrix(Matrix&& orig);
+
     /**
      * Destructor.
      *
@@ -230,6 +270,10 @@ public:
      * internal state of the Matrix. This method is also equivalent to (and a shorthand
      * for) <code>get(i)</code>.
      * 
+     * For strided views (see MatrixFactory::ShallowVector and 
+     * MatrixFactory::ShallowSubmatrix), <code>i</code> is the index of the 
+     * element in the (column-major) stored elements of the view, not its offset
+     * in memory, so that strided vectors can be traversed like contiguous ones.
      * 
      * @param i data index
      * @return data value
@@ -249,9 +293,18 @@ public:
      * then both <code>A(i,j)</code> and <code>A(j,i)</code> will be set to the 
      * same value.
      * 
+     * \note For sparse matrices, setting an element which is already stored
+     * is cheap, but every new nonzero element invalidates the compressed storage. 
+     * Use a SparseMatrixBuilder to assemble sparse matrices element by element.
+     * 
      * @param i row index (<code>0,...,nrows-1</code>)
      * @param j column index (<code>0,...,ncols-1</code>)
      * @param val value to be set at <code>(i,j)</code>
+     * 
+     * \exception std::out_of_range if <code>(i,j)</code> is out of range or 
+     * outside the band of a banded matrix
+     * \exception std::logic_error if <code>(i,j)</code> is in a zero block of a
+     * block matrix
      */
     void set(size_t i, size_t j, double val);
 
@@ -280,10 +333,52 @@ public:
      * not affected - instead a boolean flag is used to indicate that the matrix
      * is transposed.
      *
+     * The returned pointer may be used to modify the matrix, so if the data are
+     * shared with a copy of this matrix, they are copied first; from then on 
+     * they are not shared with any future copies (see Matrix(const Matrix&)).
+     *
+     * The columns of the stored data of a dense matrix are
+     * #getLeadingDimension elements apart; this is larger than the number of
+     * stored rows only for strided views (see #isContiguous).
+     *
      * @return Pointer to the matrix data
      */
     double * getData();
 
+    /**
+     * Read-only access to the matrix data (see #getData). Unlike #getData, this
+     * does not stop the data from being shared with copies of this matrix; the
+     * returned pointer is valid until this matrix is modified or destroyed.
+     *
+     * @return Pointer to the matrix data
+     */
+    const double * getData() const;
+
+    /**
+     * Leading dimension of the stored data of a dense matrix, i.e., element 
+     * <code>(i,j)</code> of the stored (non-transposed) matrix is 
+     * <code>getData()[i + j * getLeadingDimension()]</code>.
+     *
+     * @return leading dimension
+     */
+    size_t getLeadingDimension() const;
+
+    /**
+     * Whether the data of this matrix occupy a contiguous array of #length
+     * elements. This is the case for all matrices except for strided views
+     * which are created by MatrixFactory::ShallowSubmatrix and 
+     * MatrixFactory::ShallowVector(const Matrix&, size_t, size_t, size_t).
+     *
+     * Strided views are supported by #get, #set, #mult, #add, the multiplication
+     * and addition operators and by scaling; all other operations (in particular,
+     * direct access to the data by #getData and <code>operator[]</code>) require
+     * contiguous matrices. A contiguous copy of a view is obtained using the 
+     * copy-constructor.
+     *
+     * @return <code>true</code> if the data are contiguous
+     */
+    bool isContiguous() const;
+
     /**
      * Returns the type of this matrix as <code>MatrixType</code>
      * @return
@@ -308,14 +403,77 @@ public:
      *
      * @return status code: <code>0</code> if reshaping succeeded, <code>-1</code>
      * if some of the new dimensions is 0, <code>-2</code> if reshaping is
-     * impossible.
+     * impossible, <code>-3</code> if this is a strided view (see #isContiguous).
      */
     int reshape(size_t nrows, size_t ncols);
 
 
+    /**
+     * Number of nonzero sub-diagonals of a banded matrix (<code>0</code> for
+     * matrices which are not of type <code>MATRIX_BANDED</code>).
+     *
+     * @return lower bandwidth
+     */
+    size_t getLowerBandwidth() const;
+
+    /**
+     * Number of nonzero super-diagonals of a banded matrix (<code>0</code> for
+     * matrices which are not of type <code>MATRIX_BANDED</code>).
+     *
+     * @return upper bandwidth
+     */
+    size_t getUpperBandwidth() const;
+
+    /**
+     * Number of block rows of a block matrix (<code>1</code> for matrices which
+     * are not of type <code>MATRIX_BLOCK</code>).
+     *
+     * @return number of block rows
+     */
+    size_t getBlockRows() const;
+
+    /**
+     * Number of block columns of a block matrix (<code>1</code> for matrices 
+     * which are not of type <code>MATRIX_BLOCK</code>).
+     *
+     * @return number of block columns
+     */
+    size_t getBlockCols() const;
+
+    /**
+     * Sets block <code>(I,J)</code> of a block matrix to a copy of a given
+     * matrix. The block keeps its own type (e.g., dense, sparse or diagonal),
+     * so that operations with this block are delegated to the most appropriate
+     * kernel.
+     *
+     * @param I block row index
+     * @param J block column index
+     * @param block new block; its dimensions must match the dimensions of the
+     * block row <code>I</code> and the block column <code>J</code>
+     *
+     * \exception std::logic_error if this is not a block matrix
+     * \exception std::out_of_range if <code>(I,J)</code> is out of range
+     * \exception std::invalid_argument if the block has wrong dimensions
+     */
+    void setBlock(size_t I, size_t J, const Matrix& block);
+
+    /**
+     * Copy of block <code>(I,J)</code> of a block matrix. Blocks which have
+     * not been set are returned as sparse matrices without nonzeros.
+     *
+     * @param I block row index
+     * @param J block column index
+     * @return copy of the block
+     *
+     * \exception std::logic_error if this is not a block matrix
+     * \exception std::out_of_range if <code>(I,J)</code> is out of range
+     */
+    Matrix getBlock(size_t I, size_t J) const;
+
     /**
      * Whether the matrix is symmetric. Returns \c true if the matrix type is
-     * either MATRIX_DIAGONAL or MATRIX_SYMMETRIC.
+     * either MATRIX_DIAGONAL or MATRIX_SYMMETRIC, or if it is a symmetric
+     * banded matrix.
      * 
      * @return 
      */
@@ -449,15 +607,28 @@ public:
 
     /**
      * Direct access to the matrix data.
-     * Shorthand for <code>matrix.getData()[]</code>; it is however safer to access
-     * the matrix entries using <code>get</code> and <code>set</code>.
+     * Shorthand for <code>matrix.getData()[]</code> (except for strided views,
+     * whose elements are indexed as in get(size_t)); it is however safer to access
+     * the matrix entries using <code>get</code> and <code>set</code>. Like 
+     * #getData, this stops the data of this matrix from being shared with its
+     * copies.
      *
      * @param sub index
      * @return reference to matrix data
      * 
      * \exception std::out_of_range in case the provided index is out of range.
      */
-    double &operator[](const size_t sub) const; //overloading []
+    double &operator[](const size_t sub); //overloading []
+
+    /**
+     * Read-only access to the matrix data; unlike the non-const 
+     * <code>operator[]</code>, this does not stop the data of this matrix 
+     * from being shared with its copies.
+     *
+     * @param sub index
+     * @return reference to matrix data
+     */
+    const double &operator[](const size_t sub) const;
 
     /**
      * Summation operator.
@@ -522,6 +693,23 @@ public:
      */
     Matrix& operator=(const Matrix& right);
 
+    /**
+     * Move-assignment operator.
+     * 
+     * Releases the resources held by the current object and takes over 
+     * the data of <code>right</code> without any memory allocation. This 
+     * is what happens when a temporary, such as the result of 
+     * <code>A * x</code> or of LinearOperator::call(Matrix&), is assigned
+     * to an existing matrix.
+     * 
+     * @param right is the right-hand operand (an rvalue).
+     * @return The current object.
+     * 
+     * \post <code>right</code> is left as an empty matrix which does not own
+     * any data.
+     */
+    Matrix& operator=(Matrix&& right);
+
     /**
      * Equality relational operator: returns <code>true</code> iff both sides
      * are equal. Two matrices are equal if they are of the same type, have equal
@@ -663,6 +851,59 @@ public:
      */
     static int mult(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma);
 
+    /**
+     * Performs the following operation
+     * \f[
+     * C \leftarrow \gamma C + \alpha \mathrm{op}(A) B,
+     * \f]
+     * where \f$\mathrm{op}(A) = A^\top\f$ if <code>transA</code> is <code>true</code>
+     * and \f$\mathrm{op}(A) = A\f$ otherwise.
+     * 
+     * Unlike transposing <code>A</code>, calling this method and transposing back,
+     * <code>A</code> is never modified (its transposition flag is left untouched),
+     * so the same matrix can be shared among several callers. The transposition
+     * is passed on to BLAS (as a <code>trans</code> argument) for dense matrices and 
+     * to the transposed sparse kernel for sparse ones.
+     * 
+     * If <code>C</code> is symmetric, <code>A</code> is dense and 
+     * <code>Matrix::mult(C, alpha, A, A, gamma, true)</code> is called, then 
+     * \f$A^\top A\f$ is computed by a symmetric rank-k update 
+     * (<code>dsfrk</code>) and <code>C</code> remains symmetric.
+     * 
+     * @param C reference of matrix to be updated
+     * @param alpha scalar which multiplies the product <code>op(A)B</code>
+     * @param A matrix A
+     * @param B matrix B
+     * @param gamma scalar which multiplies C
+     * @param transA whether A should be transposed
+     * @return 
+     * A status code (see #mult(Matrix&, double, Matrix&, Matrix&, double)).
+     */
+    static int mult(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA);
+
+    /**
+     * Matrix-vector product on lightweight vectors,
+     * \f[
+     * y \leftarrow \gamma y + \alpha \mathrm{op}(A) x.
+     * \f]
+     * 
+     * Dense matrices are passed to <code>dgemv</code> directly (with the strides
+     * of the vectors) and sparse matrices to the sparse matrix-vector kernel if
+     * the vectors are contiguous; no %Matrix objects are created in either case. 
+     * All other cases are delegated to #mult(Matrix&, double, Matrix&, Matrix&, double, bool).
+     * 
+     * @param y vector to be updated
+     * @param alpha scalar which multiplies the product <code>op(A)x</code>
+     * @param A matrix A
+     * @param x vector x
+     * @param gamma scalar which multiplies y
+     * @param transA whether A should be transposed
+     * @return status code (see #mult(Matrix&, double, Matrix&, Matrix&, double))
+     * 
+     * \exception std::invalid_argument if the dimensions are not compatible
+     */
+    static int mult(VectorView y, double alpha, Matrix& A, VectorView x, double gamma, bool transA);
+
 
 
 
@@ -679,13 +920,44 @@ private:
      */
     explicit Matrix(bool shallow);
 
+    /**
+     * Allocates a banded matrix with <code>kl</code> sub-diagonals and
+     * <code>ku</code> super-diagonals, initialized with zeros. Clients create
+     * banded matrices using MatrixFactory::MakeBanded and
+     * MatrixFactory::MakeBandedSymmetric.
+     *
+     * @param nr number of rows
+     * @param nc number of columns
+     * @param kl lower bandwidth
+     * @param ku upper bandwidth (ignored if the matrix is symmetric)
+     * @param symmetric whether the matrix is symmetric
+     */
+    Matrix(size_t nr, size_t nc, size_t kl, size_t ku, bool symmetric);
+
+    /**
+     * Allocates a block matrix with given block-row and block-column sizes, all
+     * of whose blocks are zero. Clients create block matrices using 
+     * MatrixFactory::MakeBlock.
+     *
+     * @param row_sizes numbers of rows of the block rows
+     * @param col_sizes numbers of columns of the block columns
+     */
+    Matrix(const std::vector<size_t>& row_sizes, const std::vector<size_t>& col_sizes);
+
     /* MatrixFactory is allowed to access these private fields! */
     friend class MatrixFactory;
+    friend class FactoredSolver;
     friend class CholeskyFactorization;
     friend class LDLFactorization;
     friend class S_LDLFactorization;
     friend class MatrixWriter;
+    friend class SparseMatrixBuilder;
+    friend class MatrixF;
     friend class LeastSquares;
+    friend class MatrixTerm;
+    friend class TriangularSolver;
+    friend class VectorView;
+    friend class QuadOverAffine;
 
     size_t m_nrows; /**< Number of rows */
     size_t m_ncols; /**< Number of columns */
@@ -696,38 +968,327 @@ private:
 
     size_t m_dataLength; /**< Length of data */
     double *m_data; /**< Data (for non-sparse matrices) */
-    bool m_delete_data; /**< Whether it is allowed to delete[] m_data */
+    size_t m_ld; /**< Leading dimension of the stored data (dense matrices) */
+    bool m_delete_data; /**< Whether it is allowed to free m_data (see MatrixAllocator::free_data) */
+
+    /*
+     * For banded matrices: the stored (non-transposed) matrix is kept in
+     * LAPACK band storage, i.e., A(i,j) is stored in m_data[ku+i-j + j*(kl+ku+1)].
+     * Symmetric banded matrices store their lower band only, i.e., A(i,j) with
+     * i>=j is stored in m_data[i-j + j*(kl+1)]. Unused positions of the band
+     * storage are always zero.
+     */
+
+    size_t m_kl; /**< Lower bandwidth of the stored banded matrix */
+    size_t m_ku; /**< Upper bandwidth of the stored banded matrix */
+    bool m_band_symmetric; /**< Whether the banded matrix is symmetric */
+
+    /**
+     * Blocks of a block matrix (see Matrix.cpp). The blocks partition the 
+     * stored (non-transposed) matrix; zero blocks are not stored.
+     */
+    struct BlockStorage;
+
+    BlockStorage * m_blocks; /**< Blocks (block matrices only) */
+
+    /**
+     * Reference count of the data (m_data and the CHOLMOD objects) which are
+     * shared by copies of a matrix and lock which guards the lazy construction
+     * of their compressed-column form (see Matrix.cpp); <code>NULL</code> until
+     * it is first needed (see #_storage).
+     */
+    struct SharedStorage;
+
+    mutable std::atomic<SharedStorage*> m_shared; /**< Shared data (copy-on-write) */
+    bool m_exposed; /**< Whether pointers to m_data have been handed out, so it cannot be shared */
 
     /* CSparse members */
     cholmod_triplet *m_triplet; /**< Sparse triplets */
     cholmod_sparse *m_sparse; /**< A sparse matrix */
     cholmod_dense *m_dense; /**< A dense CHOLMOD matrix */
+    bool m_sparse_dirty; /**< Whether m_sparse is out of date with respect to m_triplet */
+
+
+    /**
+     * Releases all resources held by this matrix (dense data, if owned, and 
+     * CHOLMOD objects). After this call, all data pointers are <code>NULL</code>.
+     */
+    void _release();
+
+    /**
+     * Makes sure that the data of this matrix are not shared with any other
+     * matrix (copying them if necessary) before they are modified.
+     */
+    void _detach();
+
+    /**
+     * The reference count of the data of this matrix, which is created (with
+     * a count of one) if it does not exist yet. Concurrent calls on the same
+     * matrix are safe: the count is installed with a compare-and-swap.
+     *
+     * @return reference count of the data
+     */
+    SharedStorage * _storage() const;
+
+    /**
+     * Detaches the data of this matrix and marks them as exposed, i.e.,
+     * pointers to them are handed out, so they will not be shared with 
+     * future copies.
+     */
+    void _expose();
+
+    /**
+     * Whether copies of this matrix may share its data.
+     * @return <code>true</code> if the data may be shared
+     */
+    bool _isShareable() const;
 
+    /**
+     * Makes this matrix (which holds no data) a copy of <code>orig</code> 
+     * which shares its data.
+     * @param orig matrix whose data are shared
+     */
+    void _share(const Matrix& orig);
+
+    /**
+     * Hard copy of the data (m_data and CHOLMOD objects) of <code>orig</code>
+     * into this matrix (which holds no data), as in the copy-constructor.
+     * @param orig matrix to be copied
+     */
+    void _copyData(const Matrix& orig);
+
+    /**
+     * Takes over the internal state of another matrix and leaves it empty 
+     * (and shallow). No memory is allocated or copied.
+     * 
+     * \pre The current object holds no resources (see #_release).
+     * 
+     * @param orig matrix whose state is to be moved into this object
+     */
+    void _steal(Matrix& orig);
 
-    /* SINGLETON CHOLMOD HANDLE */
-    static cholmod_common *ms_singleton; /**< Singleton instance of cholmod_common */
+    /**
+     * Creates a new (non-sparse) matrix of the same type, dimensions and storage 
+     * layout (including the transposition flag) as this one. The new matrix
+     * is initialized with zeros.
+     * 
+     * @return new matrix with the layout of this one
+     */
+    Matrix _similar() const;
 
     /**
-     * Instantiates <code>m_sparse</code> from <code>m_triplet</code>
-     * using CHOLMOD's <code>cholmod_triplet_to_sparse</code>. Can only be
-     * applied to sparse matrices.
+     * Makes sure <code>m_sparse</code> (the compressed-column representation)
+     * is up to date. It is rebuilt from <code>m_triplet</code> using CHOLMOD's 
+     * <code>cholmod_triplet_to_sparse</code> only if it does not exist or it is
+     * dirty, that is, if the sparsity pattern has changed since it was last built.
+     * Can only be applied to sparse matrices.
+     * 
+     * The CSC is derived data, so this is not a modification of the matrix:
+     * it may be called on the same matrix by several threads at a time (the 
+     * construction is guarded by the lock of #_storage) and it does not stop
+     * the data from being shared with copies.
+     * 
+     * \note Both <code>m_sparse</code> and <code>m_triplet</code> always store
+     * the matrix as it was created; transposition is only recorded in 
+     * <code>m_transpose</code>.
      */
     void _createSparse();
 
+    /**
+     * Same as #_createSparse, but the caller must hold the lock of #_storage.
+     */
+    void _buildSparse();
+
 
     /**
-     * Creates m_triplet from other existing sparse matrix representations.
+     * Creates m_triplet from other existing sparse matrix representations
+     * (if it does not exist already).
      */
     void _createTriplet();
 
+    /**
+     * Compressed-column representation of the matrix or of its transpose.
+     * 
+     * @param transposed whether the transpose of the stored matrix is needed
+     * @return <code>m_sparse</code> if \c transposed is \c false, otherwise a 
+     * new <code>cholmod_sparse</code> which the caller needs to free
+     */
+    cholmod_sparse * _sparseOp(bool transposed);
+
+    /**
+     * Compressed-column representation of the transpose of the stored matrix
+     * (i.e., its compressed-row representation), which is built on first use
+     * and kept, along with the data, until they are modified. Like 
+     * #_createSparse, this may be called by several threads at a time.
+     * 
+     * @return transpose of <code>m_sparse</code> (owned by this matrix)
+     */
+    cholmod_sparse * _sparseTransposed();
+
+    /**
+     * Sparse matrix-vector product <code>y := gamma * y + alpha * op(A) * x</code>,
+     * where <code>A</code> is the stored matrix and <code>op(A)</code> is 
+     * <code>A</code> or its transpose. The vectors are contiguous and must not
+     * overlap; <code>y</code> is written directly (see Matrix.cpp).
+     * 
+     * @param transposed whether op(A) is the transpose of the stored matrix
+     * @param alpha scalar alpha
+     * @param x input vector
+     * @param gamma scalar gamma
+     * @param y output vector
+     */
+    void _sparseGemv(bool transposed, double alpha, const double * x, double gamma, double * y);
+
+    /**
+     * Pointer to the value of the stored element <code>(i,j)</code> in the 
+     * compressed-column representation (which must be up to date). For
+     * symmetric CHOLMOD matrices, the stored triangle is looked up.
+     * 
+     * @param i row index (in the stored matrix)
+     * @param j column index (in the stored matrix)
+     * @return pointer to the value or \c NULL if <code>(i,j)</code> is not 
+     * in the sparsity pattern
+     */
+    double * _sparseEntry(size_t i, size_t j) const;
+
+    /**
+     * Multiplies every column <code>j</code> of this sparse matrix with 
+     * <code>alpha*D(j,j)</code> in place. The sparsity pattern does not change,
+     * so no representation is rebuilt.
+     * 
+     * @param alpha scalar
+     * @param D diagonal matrix
+     */
+    void _sparseScaleColumns(double alpha, const Matrix& D);
+
+    /**
+     * Adds <code>alpha</code> times this sparse matrix to a non-sparse 
+     * matrix <code>C</code> (of the same dimensions) by traversing its 
+     * compressed-column representation, i.e., <code>C += alpha * this</code>.
+     * 
+     * @param C non-sparse matrix to be updated
+     * @param alpha scalar
+     */
+    void _sparseAddTo(Matrix& C, double alpha);
+
     /**
      * Initialize the current matrix (allocate memory etc) for a given number of
      * rows and columns and a given matrix type.
      * @param nrows Number of rows
      * @param ncols Number of column
      * @param matrixType Matrix type
+     * @param kl lower bandwidth (banded matrices only)
+     * @param ku upper bandwidth (banded matrices only)
+     * @param bandSymmetric whether a banded matrix is symmetric
+     */
+    inline void init(size_t nrows, size_t ncols, MatrixType matrixType,
+            size_t kl = 0, size_t ku = 0, bool bandSymmetric = false);
+
+    /**
+     * Leading dimension of the band storage of a banded matrix.
+     * @return <code>kl+1</code> for symmetric and <code>kl+ku+1</code> for
+     * general banded matrices
+     */
+    size_t _bandLd() const;
+
+    /**
+     * Pointer to the position of element <code>(i,j)</code> of this banded
+     * matrix in its band storage (the transposition flag is taken into account).
+     *
+     * @param i row index
+     * @param j column index
+     * @return pointer to the element or <code>NULL</code> if <code>(i,j)</code>
+     * lies outside the band
      */
-    inline void init(size_t nrows, size_t ncols, MatrixType matrixType);
+    double * _bandEntry(size_t i, size_t j) const;
+
+    /**
+     * Computes \f$y \leftarrow \gamma y + \alpha \mathrm{op}(A) x\f$ for this
+     * banded matrix A using <code>dgbmv</code> (or <code>dsbmv</code> if it
+     * is symmetric).
+     *
+     * @param transA whether op(A) is the transpose of A
+     * @param alpha scalar
+     * @param x dense vector (of length equal to the columns of op(A))
+     * @param gamma scalar
+     * @param y dense vector (of length equal to the rows of op(A))
+     */
+    void _bandGemv(bool transA, double alpha, const double * x, double gamma, double * y) const;
+
+    /**
+     * Full (column-major) storage of a symmetric or lower triangular matrix
+     * which is stored in packed form. For symmetric matrices both triangles are
+     * filled in; for lower triangular matrices the upper triangle is zero. The
+     * transpose flag of this matrix is not taken into account.
+     *
+     * @return dense matrix
+     */
+    Matrix _packedToDense() const;
+
+    /**
+     * Block of this block matrix which contains element <code>(i,j)</code>.
+     *
+     * @param i row index
+     * @param j column index
+     * @param i_block on exit, row index of the element in the block
+     * @param j_block on exit, column index of the element in the block
+     * @return pointer to the (stored) block or <code>NULL</code> if it is zero
+     */
+    Matrix * _blockEntry(size_t i, size_t j, size_t& i_block, size_t& j_block) const;
+
+    /**
+     * Builds the compressed-column representation of all sparse blocks of this
+     * block matrix (recursively), so that products with its blocks do not use
+     * the (shared) CHOLMOD handle and may run in parallel.
+     */
+    void _blockPrepare();
+
+    /**
+     * Adds <code>alpha</code> times this block matrix to a dense matrix 
+     * <code>C</code> of the same dimensions, block by block.
+     *
+     * @param C dense matrix to be updated
+     * @param alpha scalar
+     */
+    void _blockAddTo(Matrix& C, double alpha);
+
+    /**
+     * Strided view of the <code>rows</code>-by-<code>cols</code> submatrix of
+     * this dense matrix whose top-left element is <code>(row_start, col_start)</code>.
+     * The view points to the data of this matrix (nothing is copied).
+     *
+     * @param row_start first row
+     * @param rows number of rows
+     * @param col_start first column
+     * @param cols number of columns
+     * @return view
+     */
+    Matrix _view(size_t row_start, size_t rows, size_t col_start, size_t cols) const;
+
+    /**
+     * Distance between two consecutive elements of this dense vector in 
+     * <code>m_data</code>.
+     *
+     * @return increment (for BLAS)
+     */
+    size_t _vectorInc() const;
+
+    /**
+     * Position in <code>m_data</code> of the <code>k</code>-th stored element
+     * (in column-major order), taking into account the leading dimension of 
+     * strided views.
+     *
+     * @param k index of the element
+     * @return offset in <code>m_data</code>
+     */
+    size_t _linearIndex(size_t k) const;
+
+    /**
+     * Number of rows of the stored (non-transposed) data.
+     *
+     * @return stored rows
+     */
+    size_t _storedRows() const;
 
     /**
      * Check whether a given pair of indexes is within the matrix bounds.
@@ -775,7 +1336,11 @@ private:
      */
     void domm(const Matrix &right, Matrix &result) const;
 
-    static void domm(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma);
+    /**
+     * Custom implementation of C := gamma*C + alpha*op(A)*B, where op(A) is
+     * A' if transA is true.
+     */
+    static void domm(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA);
 
     /**
      * Storage types for sparse matrix data.
@@ -801,6 +1366,15 @@ private:
      */
     inline double quadFromTriplet(const Matrix& x) const;
 
+    /**
+     * Computes <code>x'*A*x</code> using the compressed-column representation 
+     * of this matrix (which must be up to date).
+     * 
+     * @param x column vector
+     * @return value of the quadratic form
+     */
+    inline double quadFromSparse(const Matrix& x) const;
+
 
     inline void _addIJ(size_t i, size_t j, double v);
     inline void _addIJ(size_t i, size_t j, double v, double gamma);
@@ -835,17 +1409,33 @@ private:
      * C := gamma*C + alpha*A, where C is lower triangular
      */
     static int generic_add_helper_left_lower_tri(Matrix& C, double alpha, Matrix& A, double gamma);
+    /**
+     * C := gamma*C + alpha*A, where C is banded
+     */
+    static int generic_add_helper_left_banded(Matrix& C, double alpha, Matrix& A, double gamma);
+    /**
+     * C := gamma*C + alpha*A, where C is a block matrix
+     */
+    static int generic_add_helper_left_block(Matrix& C, double alpha, Matrix& A, double gamma);
 
     /**
      * 
-     * C := gamma * C + alpha*A*B, where A is dense
+     * C := gamma * C + alpha*op(A)*B on contiguous copies of B and C; this is
+     * used by the kernels of structured matrices if B or C is a strided view
+     */
+    static int multiply_helper_compact(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA);
+    /**
+     * 
+     * C := gamma * C + alpha*op(A)*B, where A is dense and op(A) is A'
+     * if transA is true
      */
-    static int multiply_helper_left_dense(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma);
+    static int multiply_helper_left_dense(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA);
     /**
      * 
-     * C := gamma * C + alpha*A*B, where A is sparse
+     * C := gamma * C + alpha*op(A)*B, where A is sparse and op(A) is A'
+     * if transA is true
      */
-    static int multiply_helper_left_sparse(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma);
+    static int multiply_helper_left_sparse(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA);
     /**
      * 
      * C := gamma * C + alpha*A*B, where A is diagonal
@@ -856,6 +1446,24 @@ private:
      * C := gamma * C + alpha*A*B, where A is symmetric
      */
     static int multiply_helper_left_symmetric(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma);
+    /**
+     * 
+     * C := gamma * C + alpha*op(A)*B, where A is lower triangular and op(A) 
+     * is A' if transA is true
+     */
+    static int multiply_helper_left_lowertr(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA);
+    /**
+     * 
+     * C := gamma * C + alpha*op(A)*B, where A is banded and op(A) is A'
+     * if transA is true
+     */
+    static int multiply_helper_left_banded(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA);
+    /**
+     * 
+     * C := gamma * C + alpha*op(A)*B, where A is a block matrix and op(A) is A'
+     * if transA is true
+     */
+    static int multiply_helper_left_block(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA);
 
 };
 
@@ -0,0 +1,258 @@
+/*
+ * File:   MatrixAllocator.cpp
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 1:05 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MatrixAllocator.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+#include <mutex>
+#include <atomic>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+/*
+ * Every buffer is preceded by a header of ALIGNMENT bytes, which records the
+ * allocator the buffer was taken from and the size of the whole block.
+ */
+struct MatrixBlockHeader {
+    MatrixAllocator * owner;
+    size_t bytes;
+};
+
+static_assert(sizeof (MatrixBlockHeader) <= MatrixAllocator::ALIGNMENT,
+        "the block header must fit in ALIGNMENT bytes");
+
+static std::atomic<bool> use_huge_pages(false);
+
+/**
+ * The default allocator: aligned system memory, optionally backed by
+ * (transparent) huge pages for large blocks.
+ */
+class SystemAllocator : public MatrixAllocator {
+public:
+
+    void * allocate(size_t bytes) {
+        void * ptr = NULL;
+        bool huge = use_huge_pages.load() && bytes >= HUGE_PAGE_SIZE;
+        if (posix_memalign(&ptr, huge ? HUGE_PAGE_SIZE : ALIGNMENT, bytes) != 0) {
+            return NULL;
+        }
+#ifdef MADV_HUGEPAGE
+        if (huge) {
+            madvise(ptr, bytes, MADV_HUGEPAGE); /* only a hint - failure is harmless */
+        }
+#endif
+        return ptr;
+    }
+
+    void deallocate(void * ptr, size_t bytes) {
+        free(ptr);
+    }
+};
+
+/* never destroyed, so that static matrices can be freed at exit */
+static SystemAllocator& system_allocator() {
+    static SystemAllocator * const instance = new SystemAllocator();
+    return *instance;
+}
+
+static thread_local MatrixAllocator * current_allocator = NULL;
+
+/**
+ * Pool of blocks with power-of-two size classes, owned by a MatrixArena.
+ *
+ * When the arena is closed, the cached blocks are released; the pool itself
+ * is deleted as soon as the last block it has handed out is returned.
+ */
+class MatrixPool : public MatrixAllocator {
+public:
+
+    MatrixPool() : m_closed(false), m_outstanding(0), m_pooled(0), m_reused(0) {
+    }
+
+    void * allocate(size_t bytes) {
+        size_t c = size_class(bytes);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (c < NUM_CLASSES && !m_free[c].empty()) {
+            void * ptr = m_free[c].back();
+            m_free[c].pop_back();
+            m_outstanding++;
+            m_reused++;
+            return ptr;
+        }
+        void * ptr = system_allocator().allocate(class_bytes(c, bytes));
+        if (ptr != NULL) {
+            m_outstanding++;
+            m_pooled += class_bytes(c, bytes);
+        }
+        return ptr;
+    }
+
+    void deallocate(void * ptr, size_t bytes) {
+        size_t c = size_class(bytes);
+        bool destroy = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_outstanding--;
+            if (m_closed || c >= NUM_CLASSES) {
+                system_allocator().deallocate(ptr, bytes);
+                m_pooled -= class_bytes(c, bytes);
+            } else {
+                m_free[c].push_back(ptr);
+            }
+            destroy = m_closed && m_outstanding == 0;
+        }
+        if (destroy) {
+            delete this;
+        }
+    }
+
+    /**
+     * Releases all cached blocks; the pool deletes itself once all blocks
+     * that are still in use have been returned.
+     */
+    void close() {
+        bool destroy = false;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (size_t c = 0; c < NUM_CLASSES; c++) {
+                for (size_t k = 0; k < m_free[c].size(); k++) {
+                    system_allocator().deallocate(m_free[c][k], class_bytes(c, 0));
+                    m_pooled -= class_bytes(c, 0);
+                }
+                m_free[c].clear();
+            }
+            m_closed = true;
+            destroy = (m_outstanding == 0);
+        }
+        if (destroy) {
+            delete this;
+        }
+    }
+
+    size_t pooledBytes() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_pooled;
+    }
+
+    size_t reuseCount() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_reused;
+    }
+
+private:
+    /* blocks of up to 2^(NUM_CLASSES - 1) bytes (256MB) are pooled */
+    static const size_t NUM_CLASSES = 29;
+
+    /* smallest c such that bytes <= 2^c */
+    static size_t size_class(size_t bytes) {
+        size_t c = 0;
+        while ((static_cast<size_t> (1) << c) < bytes) {
+            c++;
+        }
+        return c;
+    }
+
+    static size_t class_bytes(size_t c, size_t bytes) {
+        return c < NUM_CLASSES ? (static_cast<size_t> (1) << c) : bytes;
+    }
+
+    std::mutex m_mutex;
+    std::vector<void*> m_free[NUM_CLASSES];
+    bool m_closed;
+    size_t m_outstanding;
+    size_t m_pooled;
+    size_t m_reused;
+};
+
+MatrixAllocator::~MatrixAllocator() {
+}
+
+void * MatrixAllocator::allocate_bytes(size_t bytes, bool zero) {
+    if (bytes == 0) {
+        bytes = 1;
+    }
+    MatrixAllocator * owner = current();
+    size_t block_bytes = ALIGNMENT + bytes;
+    char * block = static_cast<char*> (owner->allocate(block_bytes));
+    if (block == NULL) {
+        throw std::bad_alloc();
+    }
+    MatrixBlockHeader * header = reinterpret_cast<MatrixBlockHeader*> (block);
+    header->owner = owner;
+    header->bytes = block_bytes;
+    if (zero) {
+        memset(block + ALIGNMENT, 0, bytes);
+    }
+    return block + ALIGNMENT;
+}
+
+void MatrixAllocator::free_bytes(void* buffer) {
+    if (buffer == NULL) {
+        return;
+    }
+    char * block = static_cast<char*> (buffer) - ALIGNMENT;
+    MatrixBlockHeader * header = reinterpret_cast<MatrixBlockHeader*> (block);
+    header->owner->deallocate(block, header->bytes);
+}
+
+double * MatrixAllocator::allocate_data(size_t n, bool zero) {
+    return static_cast<double*> (allocate_bytes((n > 0 ? n : 1) * sizeof (double), zero));
+}
+
+void MatrixAllocator::free_data(double* data) {
+    free_bytes(data);
+}
+
+MatrixAllocator * MatrixAllocator::current() {
+    return current_allocator != NULL ? current_allocator : &system_allocator();
+}
+
+MatrixAllocator * MatrixAllocator::setCurrent(MatrixAllocator* allocator) {
+    MatrixAllocator * previous = current();
+    current_allocator = allocator;
+    return previous;
+}
+
+void MatrixAllocator::setHugePages(bool enabled) {
+    use_huge_pages.store(enabled);
+}
+
+MatrixArena::MatrixArena() {
+    m_pool = new MatrixPool();
+    m_previous = MatrixAllocator::setCurrent(m_pool);
+}
+
+MatrixArena::~MatrixArena() {
+    MatrixAllocator::setCurrent(m_previous);
+    m_pool->close();
+}
+
+size_t MatrixArena::pooledBytes() const {
+    return m_pool->pooledBytes();
+}
+
+size_t MatrixArena::reuseCount() const {
+    return m_pool->reuseCount();
+}
@@ -0,0 +1,212 @@
+/*
+ * File:   MatrixAllocator.h
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 1:05 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MATRIXALLOCATOR_H
+#define	MATRIXALLOCATOR_H
+
+#include <cstddef>
+
+/**
+ * \class MatrixAllocator
+ * \brief Allocator of the data of dense, diagonal, symmetric and lower triangular matrices.
+ * \version version 0.1
+ * \date Created on October 17, 2026, 1:05 PM
+ * \author ForBES contributors
+ *
+ * All %Matrix data are allocated by #allocate_data and released by #free_data.
+ * The returned buffers are always aligned at #ALIGNMENT bytes (a cache line),
+ * which allows the compiler and BLAS to use aligned vector loads and stores.
+ *
+ * Memory is requested from the <em>current</em> allocator of the calling thread
+ * (see #setCurrent). By default this is an allocator which uses the system's
+ * aligned <code>malloc</code> and can optionally back large buffers with
+ * transparent huge pages (see #setHugePages). Custom allocators may be
+ * plugged in by subclassing MatrixAllocator; each buffer remembers the
+ * allocator it was taken from, so it is always returned to it, even if the
+ * current allocator has changed in the meantime.
+ *
+ * To reuse memory across the iterations of an algorithm, use a MatrixArena.
+ *
+ * \sa MatrixArena
+ */
+class MatrixAllocator {
+public:
+
+    /**
+     * Alignment (in bytes) of all matrix data.
+     */
+    static const size_t ALIGNMENT = 64;
+
+    /**
+     * Buffers of at least this size (in bytes) are backed by huge pages if
+     * huge pages are enabled.
+     */
+    static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+    virtual ~MatrixAllocator();
+
+    /**
+     * Allocates a block of memory.
+     *
+     * @param bytes size of the block in bytes
+     * @return pointer to a block aligned at #ALIGNMENT bytes or <code>NULL</code>
+     * if the allocation has failed
+     */
+    virtual void * allocate(size_t bytes) = 0;
+
+    /**
+     * Releases a block of memory which was allocated by #allocate.
+     *
+     * @param ptr pointer to the block
+     * @param bytes size of the block (as passed to #allocate)
+     */
+    virtual void deallocate(void * ptr, size_t bytes) = 0;
+
+    /**
+     * Allocates an aligned array of doubles using the current allocator.
+     *
+     * @param n number of elements (if <code>0</code>, one element is allocated)
+     * @param zero whether to initialize the array with zeros
+     * @return pointer to the array
+     *
+     * \exception std::bad_alloc if the allocation fails
+     */
+    static double * allocate_data(size_t n, bool zero);
+
+    /**
+     * Frees an array which was allocated with #allocate_data. It is safe to
+     * call this method with a <code>NULL</code> argument.
+     *
+     * @param data pointer to the array
+     */
+    static void free_data(double * data);
+
+    /**
+     * Allocates an aligned buffer of arbitrary type using the current allocator
+     * (e.g., single-precision data).
+     *
+     * @param bytes size of the buffer in bytes (at least one byte is allocated)
+     * @param zero whether to initialize the buffer with zeros
+     * @return pointer to the buffer
+     *
+     * \exception std::bad_alloc if the allocation fails
+     */
+    static void * allocate_bytes(size_t bytes, bool zero);
+
+    /**
+     * Frees a buffer which was allocated with #allocate_bytes. It is safe to
+     * call this method with a <code>NULL</code> argument.
+     *
+     * @param buffer pointer to the buffer
+     */
+    static void free_bytes(void * buffer);
+
+    /**
+     * The allocator that is used by the calling thread.
+     * @return current allocator
+     */
+    static MatrixAllocator * current();
+
+    /**
+     * Sets the allocator that is used by the calling thread.
+     *
+     * \note The allocator must outlive all buffers it has allocated.
+     *
+     * @param allocator new allocator; if <code>NULL</code>, the default
+     * allocator is used
+     * @return the previous allocator
+     */
+    static MatrixAllocator * setCurrent(MatrixAllocator * allocator);
+
+    /**
+     * Enables or disables huge-page backing of large buffers (of at least
+     * #HUGE_PAGE_SIZE bytes) which are allocated by the default allocator.
+     * This is only supported on Linux (transparent huge pages) and is disabled
+     * by default.
+     *
+     * @param enabled whether to use huge pages
+     */
+    static void setHugePages(bool enabled);
+
+};
+
+class MatrixPool;
+
+/**
+ * \class MatrixArena
+ * \brief Scoped pool of matrix memory.
+ * \version version 0.1
+ * \date Created on October 17, 2026, 1:05 PM
+ * \author ForBES contributors
+ *
+ * While a MatrixArena is in scope, all matrices which are created by the same
+ * thread take their memory from a pool with power-of-two size classes. Freed
+ * buffers are kept in the pool and handed out again to the next matrix of the
+ * same size class, so that an algorithm which creates temporary matrices at
+ * every iteration only hits the system allocator during the first iteration.
+ *
+ * \code{.cpp}
+ * {
+ *     MatrixArena arena;
+ *     solver.run();    // temporaries reuse pooled memory
+ * }                    // cached memory is released here
+ * \endcode
+ *
+ * Matrices may outlive the arena in which they were created; their memory
+ * is returned to the system when they are destroyed. Arenas may be nested.
+ */
+class MatrixArena {
+public:
+
+    /**
+     * Opens a new arena for the calling thread.
+     */
+    MatrixArena();
+
+    /**
+     * Closes the arena; the thread's previous allocator is restored and all
+     * cached memory is released.
+     */
+    virtual ~MatrixArena();
+
+    /**
+     * Memory (in bytes) which is currently held by the pool, both in use and
+     * cached for reuse.
+     * @return pooled bytes
+     */
+    size_t pooledBytes() const;
+
+    /**
+     * Number of allocations which were served by reusing cached memory.
+     * @return number of reused blocks
+     */
+    size_t reuseCount() const;
+
+private:
+    MatrixArena(const MatrixArena&);
+    MatrixArena& operator=(const MatrixArena&);
+
+    MatrixPool * m_pool;
+    MatrixAllocator * m_previous;
+
+};
+
+#endif	/* MATRIXALLOCATOR_H */
+
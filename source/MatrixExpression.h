@@ -0,0 +1,593 @@
+/*
+ * File:   MatrixExpression.h
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 10:12 AM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MATRIXEXPRESSION_H
+#define	MATRIXEXPRESSION_H
+
+#include "Matrix.h"
+#include <stdexcept>
+#include <algorithm>
+
+/**
+ * \class MatrixExpression
+ * \brief Lazy linear combinations of matrices
+ * \version version 0.1
+ * \ingroup Matrix-group
+ * \date Created on October 17, 2026, 10:12 AM
+ * \author ForBES contributors
+ *
+ * Base class (in the CRTP sense) of all lazy matrix expressions. Expressions
+ * are built with #lazy and the operators <code>+</code>, <code>-</code> and
+ * <code>*</code> and are not evaluated until they are passed to #evaluate
+ * or #dot.
+ *
+ * Whenever all operands are non-sparse matrices of the same type, dimensions
+ * and storage layout as the destination, an expression is evaluated in a
+ * single pass over the data without any intermediate matrices. Otherwise,
+ * every term is accumulated into the destination using Matrix::add and
+ * Matrix::mult, again without creating temporaries.
+ *
+ * Example of use:
+ *
+ * \code{.cpp}
+ * Matrix y(n, 1);
+ * evaluate(y, lazy(x) - gamma * lazy(grad));     // y = x - gamma * grad
+ * evaluate(y, 2.0 * lazy(A) * lazy(x), 1.0);      // y = y + 2 * A * x
+ * double t = dot(lazy(x), lazy(y));               // t = x'y
+ * \endcode
+ *
+ * \note Expressions hold references to their operands, so they must not
+ * outlive them.
+ */
+template<typename E>
+class MatrixExpression {
+public:
+
+    /**
+     * The actual expression (static down-cast).
+     * @return reference to the derived expression
+     */
+    const E& self() const {
+        return static_cast<const E&> (*this);
+    }
+
+    /**
+     * Number of rows of the result.
+     * @return number of rows
+     */
+    size_t getNrows() const {
+        return self().getNrows();
+    }
+
+    /**
+     * Number of columns of the result.
+     * @return number of columns
+     */
+    size_t getNcols() const {
+        return self().getNcols();
+    }
+
+    /**
+     * Whether the expression can be evaluated element-wise into a given
+     * matrix, i.e., whether all its operands share the storage layout
+     * of \c C.
+     *
+     * @param C destination matrix
+     * @return \c true if the expression may be evaluated in a single pass
+     */
+    bool isFusableInto(const Matrix& C) const {
+        return self().isFusableInto(C);
+    }
+
+    /**
+     * Whether \c C is one of the operands of the expression, or an operand
+     * whose data overlap with those of \c C (see MatrixTerm::aliases).
+     * @param C matrix
+     * @return \c true if the expression refers to \c C
+     */
+    bool refersTo(const Matrix& C) const {
+        return self().refersTo(C);
+    }
+
+    /**
+     * A matrix of the expression whose storage layout is used for element-wise
+     * evaluation.
+     * @return pointer to an operand or \c NULL if there is none
+     */
+    const Matrix * layout() const {
+        return self().layout();
+    }
+
+    /**
+     * The <code>k</code>-th element of the expression in the internal storage
+     * of its operands. This may only be used if the expression is
+     * #isFusableInto the destination.
+     *
+     * @param k index
+     * @return value of the expression at position \c k
+     */
+    double coeff(size_t k) const {
+        return self().coeff(k);
+    }
+
+    /**
+     * Computes \f$C \leftarrow \gamma C + \mathrm{scale}\cdot E\f$ term by term.
+     * After the first term has been accumulated, \c gamma is set to 1.
+     *
+     * @param C destination matrix
+     * @param scale scalar which multiplies the expression
+     * @param gamma scalar which multiplies \c C (updated)
+     * @return status code (see Matrix::add)
+     */
+    int accumulate(Matrix& C, double scale, double& gamma) const {
+        return self().accumulate(C, scale, gamma);
+    }
+
+};
+
+/**
+ * \brief A scaled matrix, \f$\alpha A\f$
+ *
+ * Leaf of lazy matrix expressions; see MatrixExpression.
+ */
+class MatrixTerm : public MatrixExpression<MatrixTerm> {
+public:
+
+    /**
+     * Creates the term <code>alpha * A</code>.
+     * @param A matrix
+     * @param alpha scalar
+     */
+    explicit MatrixTerm(const Matrix& A, double alpha = 1.0) :
+    m_A(const_cast<Matrix*> (&A)), m_data(A.m_data), m_alpha(alpha) {
+    }
+
+    size_t getNrows() const {
+        return m_A->getNrows();
+    }
+
+    size_t getNcols() const {
+        return m_A->getNcols();
+    }
+
+    bool isFusableInto(const Matrix& C) const {
+        return m_A->m_type != Matrix::MATRIX_SPARSE
+                && m_A->m_type != Matrix::MATRIX_BLOCK
+                && m_A->m_type == C.m_type
+                && m_A->m_transpose == C.m_transpose
+                && m_A->m_nrows == C.m_nrows
+                && m_A->m_ncols == C.m_ncols
+                && m_A->m_dataLength == C.m_dataLength
+                && m_A->m_kl == C.m_kl
+                && m_A->m_ku == C.m_ku
+                && m_A->m_band_symmetric == C.m_band_symmetric
+                && m_A->isContiguous() && C.isContiguous();
+    }
+
+    bool refersTo(const Matrix& C) const {
+        return aliases(*m_A, C);
+    }
+
+    const Matrix * layout() const {
+        return m_A;
+    }
+
+    double coeff(size_t k) const {
+        return m_alpha * m_data[k];
+    }
+
+    int accumulate(Matrix& C, double scale, double& gamma) const {
+        int status = Matrix::add(C, scale * m_alpha, *m_A, gamma);
+        gamma = 1.0;
+        return status;
+    }
+
+    /**
+     * The matrix of this term.
+     * @return reference to the matrix
+     */
+    Matrix& matrix() const {
+        return *m_A;
+    }
+
+    /**
+     * The scalar of this term.
+     * @return scalar
+     */
+    double scalar() const {
+        return m_alpha;
+    }
+
+    /**
+     * Data of a matrix which are about to be overwritten. Unlike
+     * Matrix::getData, this does not stop the matrix from sharing its data
+     * with its copies later on.
+     *
+     * @param C destination matrix
+     * @return pointer to the (unshared) data of \c C
+     */
+    static double * destination(Matrix& C) {
+        C._detach();
+        return C.m_data;
+    }
+
+    /**
+     * Whether only one triangle (or half of the band) of \c A is stored,
+     * that is, whether \c A is symmetric or a symmetric banded matrix. The 
+     * stored data of such matrices cannot be used as if they were all their
+     * elements.
+     *
+     * @param A matrix
+     * @return \c true if the off-diagonal elements of \c A are stored once
+     */
+    static bool storesHalf(const Matrix& A) {
+        return A.m_type == Matrix::MATRIX_SYMMETRIC
+                || (A.m_type == Matrix::MATRIX_BANDED && A.m_band_symmetric);
+    }
+
+    /**
+     * Whether writing to \c C may modify the data of \c A, that is, whether
+     * \c A and \c C are the same matrix or their data overlap in memory.
+     *
+     * @param A operand
+     * @param C destination matrix
+     * @return \c true if \c A and \c C are aliased
+     */
+    static bool aliases(const Matrix& A, const Matrix& C) {
+        if (&A == &C) {
+            return true;
+        }
+        if (A.m_data == NULL || C.m_data == NULL) {
+            return false;
+        }
+        return A.m_data < C.m_data + C.m_dataLength
+                && C.m_data < A.m_data + A.m_dataLength;
+    }
+
+private:
+    Matrix * m_A;
+    const double * m_data;
+    double m_alpha;
+};
+
+/**
+ * \brief A scaled product of two matrices, \f$\alpha AB\f$
+ *
+ * Products are never evaluated element-wise; they are accumulated into the
+ * destination using Matrix::mult.
+ */
+class MatrixProduct : public MatrixExpression<MatrixProduct> {
+public:
+
+    /**
+     * Creates the term <code>alpha * A * B</code>.
+     * @param alpha scalar
+     * @param A left-hand side matrix
+     * @param B right-hand side matrix
+     *
+     * \exception std::invalid_argument if \c A and \c B are not conformable
+     */
+    MatrixProduct(double alpha, Matrix& A, Matrix& B) : m_A(&A), m_B(&B), m_alpha(alpha) {
+        if (A.getNcols() != B.getNrows()) {
+            throw std::invalid_argument("MatrixProduct: incompatible dimensions");
+        }
+    }
+
+    size_t getNrows() const {
+        return m_A->getNrows();
+    }
+
+    size_t getNcols() const {
+        return m_B->getNcols();
+    }
+
+    bool isFusableInto(const Matrix& C) const {
+        return false;
+    }
+
+    bool refersTo(const Matrix& C) const {
+        return MatrixTerm::aliases(*m_A, C) || MatrixTerm::aliases(*m_B, C);
+    }
+
+    const Matrix * layout() const {
+        return NULL;
+    }
+
+    double coeff(size_t k) const {
+        //LCOV_EXCL_START
+        throw std::logic_error("MatrixProduct cannot be evaluated element-wise");
+        //LCOV_EXCL_STOP
+    }
+
+    int accumulate(Matrix& C, double scale, double& gamma) const {
+        int status = Matrix::mult(C, scale * m_alpha, *m_A, *m_B, gamma);
+        gamma = 1.0;
+        return status;
+    }
+
+private:
+    Matrix * m_A;
+    Matrix * m_B;
+    double m_alpha;
+};
+
+/**
+ * \brief A scaled expression, \f$\alpha E\f$
+ */
+template<typename E>
+class MatrixScaled : public MatrixExpression<MatrixScaled<E> > {
+public:
+
+    /**
+     * Creates the expression <code>alpha * e</code>.
+     * @param alpha scalar
+     * @param e expression
+     */
+    MatrixScaled(double alpha, const E& e) : m_e(e), m_alpha(alpha) {
+    }
+
+    size_t getNrows() const {
+        return m_e.getNrows();
+    }
+
+    size_t getNcols() const {
+        return m_e.getNcols();
+    }
+
+    bool isFusableInto(const Matrix& C) const {
+        return m_e.isFusableInto(C);
+    }
+
+    bool refersTo(const Matrix& C) const {
+        return m_e.refersTo(C);
+    }
+
+    const Matrix * layout() const {
+        return m_e.layout();
+    }
+
+    double coeff(size_t k) const {
+        return m_alpha * m_e.coeff(k);
+    }
+
+    int accumulate(Matrix& C, double scale, double& gamma) const {
+        return m_e.accumulate(C, scale * m_alpha, gamma);
+    }
+
+private:
+    E m_e;
+    double m_alpha;
+};
+
+/**
+ * \brief The sum of two expressions, \f$L + R\f$
+ */
+template<typename L, typename R>
+class MatrixSum : public MatrixExpression<MatrixSum<L, R> > {
+public:
+
+    /**
+     * Creates the expression <code>l + r</code>.
+     * @param l left-hand side expression
+     * @param r right-hand side expression
+     *
+     * \exception std::invalid_argument if \c l and \c r have different dimensions
+     */
+    MatrixSum(const L& l, const R& r) : m_l(l), m_r(r) {
+        if (l.getNrows() != r.getNrows() || l.getNcols() != r.getNcols()) {
+            throw std::invalid_argument("MatrixSum: incompatible dimensions");
+        }
+    }
+
+    size_t getNrows() const {
+        return m_l.getNrows();
+    }
+
+    size_t getNcols() const {
+        return m_l.getNcols();
+    }
+
+    bool isFusableInto(const Matrix& C) const {
+        return m_l.isFusableInto(C) && m_r.isFusableInto(C);
+    }
+
+    bool refersTo(const Matrix& C) const {
+        return m_l.refersTo(C) || m_r.refersTo(C);
+    }
+
+    const Matrix * layout() const {
+        return m_l.layout() != NULL ? m_l.layout() : m_r.layout();
+    }
+
+    double coeff(size_t k) const {
+        return m_l.coeff(k) + m_r.coeff(k);
+    }
+
+    int accumulate(Matrix& C, double scale, double& gamma) const {
+        int status_l = m_l.accumulate(C, scale, gamma);
+        if (!ForBESUtils::is_status_ok(status_l)) {
+            return status_l;
+        }
+        int status_r = m_r.accumulate(C, scale, gamma);
+        if (!ForBESUtils::is_status_ok(status_r)) {
+            return status_r;
+        }
+        return std::max(status_l, status_r);
+    }
+
+private:
+    L m_l;
+    R m_r;
+};
+
+/**
+ * Wraps a matrix into a lazy expression.
+ * @param A matrix
+ * @return the term <code>1.0 * A</code>
+ */
+inline MatrixTerm lazy(const Matrix& A) {
+    return MatrixTerm(A);
+}
+
+inline MatrixTerm operator*(double alpha, const MatrixTerm& t) {
+    return MatrixTerm(t.matrix(), alpha * t.scalar());
+}
+
+inline MatrixTerm operator*(const MatrixTerm& t, double alpha) {
+    return MatrixTerm(t.matrix(), alpha * t.scalar());
+}
+
+inline MatrixTerm operator-(const MatrixTerm& t) {
+    return MatrixTerm(t.matrix(), -t.scalar());
+}
+
+inline MatrixProduct operator*(const MatrixTerm& l, const MatrixTerm& r) {
+    return MatrixProduct(l.scalar() * r.scalar(), l.matrix(), r.matrix());
+}
+
+template<typename E>
+MatrixScaled<E> operator*(double alpha, const MatrixExpression<E>& e) {
+    return MatrixScaled<E>(alpha, e.self());
+}
+
+template<typename E>
+MatrixScaled<E> operator*(const MatrixExpression<E>& e, double alpha) {
+    return MatrixScaled<E>(alpha, e.self());
+}
+
+template<typename E>
+MatrixScaled<E> operator-(const MatrixExpression<E>& e) {
+    return MatrixScaled<E>(-1.0, e.self());
+}
+
+template<typename L, typename R>
+MatrixSum<L, R> operator+(const MatrixExpression<L>& l, const MatrixExpression<R>& r) {
+    return MatrixSum<L, R>(l.self(), r.self());
+}
+
+template<typename L, typename R>
+MatrixSum<L, MatrixScaled<R> > operator-(const MatrixExpression<L>& l, const MatrixExpression<R>& r) {
+    return MatrixSum<L, MatrixScaled<R> >(l.self(), MatrixScaled<R>(-1.0, r.self()));
+}
+
+/**
+ * Evaluates a lazy expression into a destination matrix, that is
+ * \f[
+ * C \leftarrow \gamma C + E.
+ * \f]
+ *
+ * If all operands of \c E have the same layout as \c C, this is done in a
+ * single pass over the data. Otherwise, the terms of \c E are accumulated
+ * into \c C one by one using Matrix::add and Matrix::mult. The destination
+ * may appear in the expression.
+ *
+ * If \c gamma is zero and \c C does not have the dimensions of \c E, \c C is
+ * re-allocated as a dense matrix; the expression is then evaluated into a new
+ * matrix which replaces \c C, so \c C may still appear in it
+ * (e.g., <code>evaluate(C, lazy(A) * lazy(C))</code>).
+ *
+ * @param C destination matrix
+ * @param expression lazy expression
+ * @param gamma scalar which multiplies \c C
+ * @return status code (see Matrix::add)
+ *
+ * \exception std::invalid_argument if \c gamma is not zero and \c C does not
+ * have the dimensions of the expression
+ */
+template<typename E>
+int evaluate(Matrix& C, const MatrixExpression<E>& expression, double gamma = 0.0) {
+    const E& e = expression.self();
+    if (C.getNrows() != e.getNrows() || C.getNcols() != e.getNcols()) {
+        if (gamma != 0.0) {
+            throw std::invalid_argument("evaluate: LHS and RHS do not have compatible dimensions");
+        }
+        /* C may be an operand: it is replaced only after it has been read */
+        Matrix result(e.getNrows(), e.getNcols());
+        int status = evaluate(result, e);
+        C = std::move(result);
+        return status;
+    }
+    if (e.isFusableInto(C)) {
+        double * c = MatrixTerm::destination(C);
+        const size_t n = C.length();
+        if (gamma == 0.0) {
+            for (size_t k = 0; k < n; k++) {
+                c[k] = e.coeff(k);
+            }
+        } else {
+            for (size_t k = 0; k < n; k++) {
+                c[k] = gamma * c[k] + e.coeff(k);
+            }
+        }
+        return ForBESUtils::STATUS_OK;
+    }
+    if (e.refersTo(C)) {
+        /* C is both an operand and the destination */
+        Matrix result(C);
+        int status = e.accumulate(result, 1.0, gamma);
+        C = std::move(result);
+        return status;
+    }
+    return e.accumulate(C, 1.0, gamma);
+}
+
+/**
+ * Inner product of two lazy expressions, \f$\langle L, R\rangle = \mathrm{trace}(L^\top R)\f$.
+ *
+ * If both expressions consist of dense, diagonal, lower triangular or 
+ * non-symmetric banded matrices of the same layout, the inner product is computed in a single pass without
+ * evaluating the expressions. Otherwise, the expressions are first evaluated
+ * into dense matrices.
+ *
+ * @param l left-hand side expression
+ * @param r right-hand side expression
+ * @return inner product
+ *
+ * \exception std::invalid_argument if \c l and \c r have different dimensions
+ */
+template<typename L, typename R>
+double dot(const MatrixExpression<L>& l, const MatrixExpression<R>& r) {
+    if (l.getNrows() != r.getNrows() || l.getNcols() != r.getNcols()) {
+        throw std::invalid_argument("dot: incompatible dimensions");
+    }
+    double t = 0.0;
+    const Matrix * layout = l.layout();
+    if (layout != NULL
+            && !MatrixTerm::storesHalf(*layout)
+            && l.isFusableInto(*layout) && r.isFusableInto(*layout)) {
+        const size_t n = layout->length();
+        for (size_t k = 0; k < n; k++) {
+            t += l.coeff(k) * r.coeff(k);
+        }
+        return t;
+    }
+    Matrix lval(l.getNrows(), l.getNcols());
+    Matrix rval(r.getNrows(), r.getNcols());
+    evaluate(lval, l);
+    evaluate(rval, r);
+    for (size_t j = 0; j < lval.getNcols(); j++) {
+        for (size_t i = 0; i < lval.getNrows(); i++) {
+            t += lval.get(i, j) * rval.get(i, j);
+        }
+    }
+    return t;
+}
+
+#endif	/* MATRIXEXPRESSION_H */
@@ -0,0 +1,328 @@
+/*
+ * File:   MatrixF.cpp
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 3:20 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "MatrixF.h"
+#include "SparseMatrixBuilder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#ifdef USE_LIBS
+#include <cblas.h>
+#endif
+
+/* minimum number of nonzeros for which the sparse kernels run in parallel */
+static const size_t SPMV_PARALLEL_MIN_NNZ = 20000;
+
+MatrixF::MatrixF() {
+    _init(0, 0, 0);
+}
+
+MatrixF::MatrixF(size_t nrows, size_t ncols) {
+    _init(nrows, ncols, nrows * ncols);
+}
+
+MatrixF::MatrixF(Matrix& A) {
+    if (A.getType() == Matrix::MATRIX_SPARSE) {
+        A._createSparse();
+        cholmod_sparse * S = A.m_sparse;
+        if (S->stype != 0) { /* store both triangles */
+            S = cholmod_copy(A.m_sparse, 0, 1, Matrix::cholmod_handle());
+        }
+        const int * Sp = static_cast<int*> (S->p);
+        const int * Si = static_cast<int*> (S->i);
+        const double * Sx = static_cast<double*> (S->x);
+        size_t nnz = 0;
+        for (size_t j = 0; j < S->ncol; j++) {
+            nnz += S->packed ? Sp[j + 1] - Sp[j] : (static_cast<int*> (S->nz))[j];
+        }
+        _init(A.getNrows(), A.getNcols(), nnz);
+        m_sparse = true;
+        m_transpose = A.m_transpose;
+        m_colptr.resize(S->ncol + 1);
+        m_rowind.resize(nnz);
+        std::vector<std::pair<int, float> > column;
+        size_t k = 0;
+        m_colptr[0] = 0;
+        for (size_t j = 0; j < S->ncol; j++) {
+            int p = Sp[j];
+            int pend = S->packed ? Sp[j + 1] : p + (static_cast<int*> (S->nz))[j];
+            column.clear();
+            for (; p < pend; p++) {
+                column.push_back(std::make_pair(Si[p], static_cast<float> (Sx[p])));
+            }
+            if (!S->sorted) {
+                std::sort(column.begin(), column.end());
+            }
+            for (size_t q = 0; q < column.size(); q++, k++) {
+                m_rowind[k] = column[q].first;
+                m_data[k] = column[q].second;
+            }
+            m_colptr[j + 1] = k;
+        }
+        if (S != A.m_sparse) {
+            cholmod_free_sparse(&S, Matrix::cholmod_handle());
+        }
+    } else if (A.getType() == Matrix::MATRIX_DENSE && A.isContiguous()) {
+        _init(A.getNrows(), A.getNcols(), A.getNrows() * A.getNcols());
+        m_transpose = A.m_transpose; /* same layout as A */
+        for (size_t k = 0; k < m_dataLength; k++) {
+            m_data[k] = static_cast<float> (A.m_data[k]);
+        }
+    } else {
+        _init(A.getNrows(), A.getNcols(), A.getNrows() * A.getNcols());
+        for (size_t j = 0; j < m_ncols; j++) {
+            for (size_t i = 0; i < m_nrows; i++) {
+                m_data[i + j * m_nrows] = static_cast<float> (A.get(i, j));
+            }
+        }
+    }
+}
+
+MatrixF::MatrixF(const MatrixF& orig) {
+    _init(orig.m_nrows, orig.m_ncols, orig.m_dataLength);
+    m_transpose = orig.m_transpose;
+    m_sparse = orig.m_sparse;
+    m_colptr = orig.m_colptr;
+    m_rowind = orig.m_rowind;
+    memcpy(m_data, orig.m_data, m_dataLength * sizeof (float));
+}
+
+MatrixF::MatrixF(MatrixF&& orig) {
+    _init(0, 0, 0);
+    *this = std::move(orig);
+}
+
+MatrixF& MatrixF::operator=(const MatrixF& right) {
+    if (this == &right) {
+        return *this;
+    }
+    MatrixF copy(right);
+    return *this = std::move(copy);
+}
+
+MatrixF& MatrixF::operator=(MatrixF&& right) {
+    if (this == &right) {
+        return *this;
+    }
+    std::swap(m_nrows, right.m_nrows);
+    std::swap(m_ncols, right.m_ncols);
+    std::swap(m_transpose, right.m_transpose);
+    std::swap(m_sparse, right.m_sparse);
+    std::swap(m_dataLength, right.m_dataLength);
+    std::swap(m_data, right.m_data);
+    m_colptr.swap(right.m_colptr);
+    m_rowind.swap(right.m_rowind);
+    return *this;
+}
+
+MatrixF::~MatrixF() {
+    MatrixAllocator::free_bytes(m_data);
+    m_data = NULL;
+}
+
+void MatrixF::_init(size_t nrows, size_t ncols, size_t dataLength) {
+    m_nrows = nrows;
+    m_ncols = ncols;
+    m_transpose = false;
+    m_sparse = false;
+    m_dataLength = dataLength;
+    m_data = static_cast<float*> (MatrixAllocator::allocate_bytes(dataLength * sizeof (float), true));
+}
+
+size_t MatrixF::getNrows() const {
+    return m_nrows;
+}
+
+size_t MatrixF::getNcols() const {
+    return m_ncols;
+}
+
+bool MatrixF::isSparse() const {
+    return m_sparse;
+}
+
+size_t MatrixF::length() const {
+    return m_dataLength;
+}
+
+long MatrixF::_position(size_t i, size_t j) const {
+    size_t i_ = m_transpose ? j : i; /* position in the stored matrix */
+    size_t j_ = m_transpose ? i : j;
+    if (!m_sparse) {
+        return i_ + j_ * (m_transpose ? m_ncols : m_nrows);
+    }
+    const int * begin = &m_rowind[0] + m_colptr[j_];
+    const int * end = &m_rowind[0] + m_colptr[j_ + 1];
+    const int * pos = std::lower_bound(begin, end, static_cast<int> (i_));
+    return (pos != end && *pos == static_cast<int> (i_)) ? (pos - &m_rowind[0]) : -1;
+}
+
+float MatrixF::get(size_t i, size_t j) const {
+    if (i >= m_nrows || j >= m_ncols) {
+        throw std::out_of_range("Index out of range!");
+    }
+    long k = _position(i, j);
+    return k >= 0 ? m_data[k] : 0.0f;
+}
+
+void MatrixF::set(size_t i, size_t j, float v) {
+    if (i >= m_nrows || j >= m_ncols) {
+        throw std::out_of_range("Index out of range!");
+    }
+    long k = _position(i, j);
+    if (k < 0) {
+        throw std::invalid_argument("The sparsity pattern of a MatrixF cannot be altered");
+    }
+    m_data[k] = v;
+}
+
+void MatrixF::transpose() {
+    m_transpose = !m_transpose;
+    std::swap(m_nrows, m_ncols);
+}
+
+Matrix MatrixF::toMatrix() const {
+    if (!m_sparse) {
+        Matrix A(m_nrows, m_ncols);
+        for (size_t j = 0; j < m_ncols; j++) {
+            for (size_t i = 0; i < m_nrows; i++) {
+                A.m_data[i + j * m_nrows] = get(i, j);
+            }
+        }
+        return A;
+    }
+    size_t stored_ncols = m_colptr.size() - 1;
+    SparseMatrixBuilder builder(m_nrows, m_ncols);
+    builder.reserve(m_dataLength);
+    for (size_t j = 0; j < stored_ncols; j++) {
+        for (int p = m_colptr[j]; p < m_colptr[j + 1]; p++) {
+            if (m_transpose) {
+                builder.set(j, m_rowind[p], m_data[p]);
+            } else {
+                builder.set(m_rowind[p], j, m_data[p]);
+            }
+        }
+    }
+    return builder.build();
+}
+
+int MatrixF::mult(Matrix& C, double alpha, MatrixF& A, Matrix& B, double gamma) {
+    return mult(C, alpha, A, B, gamma, false);
+}
+
+int MatrixF::mult(Matrix& C, double alpha, MatrixF& A, Matrix& B, double gamma, bool transA) {
+    size_t opA_nrows = transA ? A.getNcols() : A.getNrows();
+    size_t opA_ncols = transA ? A.getNrows() : A.getNcols();
+    if (B.getType() != Matrix::MATRIX_DENSE) {
+        throw std::invalid_argument("MatrixF can only be multiplied by dense matrices");
+    }
+    if (opA_ncols != B.getNrows() || C.getNrows() != opA_nrows || C.getNcols() != B.getNcols()) {
+        std::ostringstream oss;
+        oss << "op(A) (" << opA_nrows << "x" << opA_ncols << "), B (" << B.getNrows()
+                << "x" << B.getNcols() << ") and C (" << C.getNrows() << "x" << C.getNcols()
+                << ") do not have compatible dimensions";
+        throw std::invalid_argument(oss.str().c_str());
+    }
+    if (C.getType() != Matrix::MATRIX_DENSE || C.m_transpose || !C.isContiguous()
+            || C.m_data == B.m_data) {
+        /* compute alpha * op(A) * B into a temporary and add it to C */
+        Matrix AB(C.getNrows(), C.getNcols());
+        int status = mult(AB, alpha, A, B, 0.0, transA);
+        return std::max(status, Matrix::add(C, 1.0, AB, gamma));
+    }
+
+    bool trans = (A.m_transpose != transA); /* whether to use the stored matrix transposed */
+    size_t lda = A.m_transpose ? A.m_ncols : A.m_nrows; /* rows of the stored matrix */
+    size_t sda = A.m_transpose ? A.m_nrows : A.m_ncols; /* columns of the stored matrix */
+    size_t m = C.getNrows();
+    size_t k = B.getNrows();
+    size_t n = B.getNcols();
+
+    if (!A.m_sparse) {
+        /* single-precision copies of B and of the product */
+        float * Bf = static_cast<float*> (MatrixAllocator::allocate_bytes(k * n * sizeof (float), false));
+        float * ABf = static_cast<float*> (MatrixAllocator::allocate_bytes(m * n * sizeof (float), false));
+        for (size_t j = 0; j < n; j++) {
+            for (size_t l = 0; l < k; l++) {
+                Bf[l + j * k] = static_cast<float> (B.get(l, j)); /* B may be transposed or strided */
+            }
+        }
+        if (n == 1) {
+            cblas_sgemv(CblasColMajor, trans ? CblasTrans : CblasNoTrans,
+                    lda, sda, 1.0f, A.m_data, lda, Bf, 1, 0.0f, ABf, 1);
+        } else {
+            cblas_sgemm(CblasColMajor, trans ? CblasTrans : CblasNoTrans, CblasNoTrans,
+                    m, n, k, 1.0f, A.m_data, lda, Bf, k, 0.0f, ABf, m);
+        }
+        for (size_t q = 0; q < m * n; q++) {
+            C.m_data[q] = (gamma == 0.0 ? 0.0 : gamma * C.m_data[q]) + alpha * ABf[q];
+        }
+        MatrixAllocator::free_bytes(Bf);
+        MatrixAllocator::free_bytes(ABf);
+        return ForBESUtils::STATUS_OK;
+    }
+
+    /* sparse: single-precision values, double-precision accumulation */
+    const int * Ap = &A.m_colptr[0];
+    const int * Ai = A.m_rowind.empty() ? NULL : &A.m_rowind[0];
+    const float * Ax = A.m_data;
+    /* B is copied if its columns are not contiguous in memory */
+    bool copy_B = !B.isContiguous() || (B.m_transpose && n > 1);
+    Matrix B_untransposed(true);
+    if (copy_B) {
+        B_untransposed = Matrix(k, n);
+        for (size_t j = 0; j < n; j++) {
+            for (size_t l = 0; l < k; l++) {
+                B_untransposed.m_data[l + j * k] = B.get(l, j);
+            }
+        }
+    }
+    const double * B_data = copy_B ? B_untransposed.m_data : B.m_data;
+    for (size_t col = 0; col < n; col++) {
+        const double * x = B_data + col * k;
+        double * y = C.m_data + col * m;
+        if (trans) { /* y(j) = gamma * y(j) + alpha * A(:,j)' * x */
+            long ncols = static_cast<long> (sda);
+#pragma omp parallel for schedule(static) if (A.m_dataLength >= SPMV_PARALLEL_MIN_NNZ)
+            for (long j = 0; j < ncols; j++) {
+                double t = 0.0;
+                for (int p = Ap[j]; p < Ap[j + 1]; p++) {
+                    t += Ax[p] * x[Ai[p]];
+                }
+                y[j] = (gamma == 0.0 ? 0.0 : gamma * y[j]) + alpha * t;
+            }
+        } else { /* y = gamma * y + alpha * A * x */
+            for (size_t i = 0; i < m; i++) {
+                y[i] = (gamma == 0.0) ? 0.0 : gamma * y[i];
+            }
+            for (size_t j = 0; j < sda; j++) {
+                double xj = alpha * x[j];
+                for (int p = Ap[j]; p < Ap[j + 1]; p++) {
+                    y[Ai[p]] += Ax[p] * xj;
+                }
+            }
+        }
+    }
+    return ForBESUtils::STATUS_OK;
+}
@@ -0,0 +1,198 @@
+/*
+ * File:   MatrixF.h
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 3:20 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MATRIXF_H
+#define	MATRIXF_H
+
+#include "Matrix.h"
+
+#include <vector>
+
+/**
+ * \class MatrixF
+ * \brief Single-precision dense or sparse matrix
+ * \version version 0.1
+ * \date Created on October 17, 2026, 3:20 PM
+ * \author ForBES contributors
+ *
+ * A matrix whose entries are stored in single precision (<code>float</code>),
+ * which halves the memory footprint and the memory traffic of matrix-vector
+ * products with large data matrices compared to %Matrix.
+ *
+ * A MatrixF is either dense (column-major) or sparse (compressed-column storage).
+ * It is meant to be used as the data matrix of linear operators: products with
+ * %Matrix vectors (see #mult) read the matrix in single precision and return
+ * the result in double precision. Dense products are delegated to
+ * <code>cblas_sgemv</code> and <code>cblas_sgemm</code>, while sparse products
+ * accumulate in double precision.
+ *
+ * \sa MatrixOperator
+ */
+class MatrixF {
+public:
+
+    /**
+     * Creates an empty matrix.
+     */
+    MatrixF();
+
+    /**
+     * Creates a dense <code>nrows</code>-by-<code>ncols</code> matrix of zeros.
+     *
+     * @param nrows number of rows
+     * @param ncols number of columns
+     */
+    MatrixF(size_t nrows, size_t ncols);
+
+    /**
+     * Creates a single-precision copy of a given %Matrix (entries are rounded to
+     * the nearest float).
+     *
+     * Sparse matrices remain sparse; all other types of matrices are stored as
+     * dense matrices.
+     *
+     * @param A matrix to be converted
+     */
+    explicit MatrixF(Matrix& A);
+
+    MatrixF(const MatrixF& orig);
+
+    MatrixF(MatrixF&& orig);
+
+    MatrixF& operator=(const MatrixF& right);
+
+    MatrixF& operator=(MatrixF&& right);
+
+    virtual ~MatrixF();
+
+    /**
+     * Number of rows.
+     * @return number of rows
+     */
+    size_t getNrows() const;
+
+    /**
+     * Number of columns.
+     * @return number of columns
+     */
+    size_t getNcols() const;
+
+    /**
+     * Whether the matrix is stored in sparse form.
+     * @return <code>true</code> if the matrix is sparse
+     */
+    bool isSparse() const;
+
+    /**
+     * Number of stored entries (<code>nrows*ncols</code> for dense matrices).
+     * @return number of stored entries
+     */
+    size_t length() const;
+
+    /**
+     * Element at position <code>(i,j)</code>.
+     *
+     * @param i row index
+     * @param j column index
+     * @return value of the element
+     *
+     * \exception std::out_of_range if the index is out of range
+     */
+    float get(size_t i, size_t j) const;
+
+    /**
+     * Sets the element at position <code>(i,j)</code>. The sparsity pattern of
+     * sparse matrices cannot be altered.
+     *
+     * @param i row index
+     * @param j column index
+     * @param v new value
+     *
+     * \exception std::out_of_range if the index is out of range
+     * \exception std::invalid_argument if the matrix is sparse and <code>(i,j)</code>
+     * is not a stored entry
+     */
+    void set(size_t i, size_t j, float v);
+
+    /**
+     * Transposes the matrix (only a flag is toggled).
+     */
+    void transpose();
+
+    /**
+     * Converts this matrix back to a (double precision) %Matrix.
+     *
+     * @return dense or sparse %Matrix
+     */
+    Matrix toMatrix() const;
+
+    /**
+     * Performs the operation
+     * \f[
+     * C \leftarrow \gamma C + \alpha \mathrm{op}(A) B,
+     * \f]
+     * where \f$\mathrm{op}(A) = A^\top\f$ if <code>transA</code> is <code>true</code>
+     * and \f$\mathrm{op}(A) = A\f$ otherwise, <code>A</code> is a single-precision
+     * matrix and <code>B</code> is dense.
+     *
+     * @param C reference of matrix to be updated
+     * @param alpha scalar which multiplies the product <code>op(A)B</code>
+     * @param A single-precision matrix
+     * @param B dense matrix
+     * @param gamma scalar which multiplies C
+     * @param transA whether A should be transposed
+     * @return status code; \link ForBESUtils::STATUS_OK STATUS_OK\endlink if the
+     * operation has succeeded without memory reallocation.
+     *
+     * \exception std::invalid_argument if the matrices are not conformable or
+     * <code>B</code> is not dense
+     */
+    static int mult(Matrix& C, double alpha, MatrixF& A, Matrix& B, double gamma, bool transA);
+
+    /**
+     * Performs the operation \f$C \leftarrow \gamma C + \alpha A B\f$.
+     *
+     * \sa #mult(Matrix&, double, MatrixF&, Matrix&, double, bool)
+     */
+    static int mult(Matrix& C, double alpha, MatrixF& A, Matrix& B, double gamma);
+
+private:
+
+    size_t m_nrows; /**< number of rows */
+    size_t m_ncols; /**< number of columns */
+    bool m_transpose; /**< whether the matrix is transposed */
+    bool m_sparse; /**< whether the matrix is sparse */
+    size_t m_dataLength; /**< length of m_data */
+    float * m_data; /**< dense data or sparse nonzero values */
+    std::vector<int> m_colptr; /**< column pointers (sparse, of the stored matrix) */
+    std::vector<int> m_rowind; /**< row indices (sparse, of the stored matrix) */
+
+    void _init(size_t nrows, size_t ncols, size_t dataLength);
+
+    /**
+     * Position of element <code>(i,j)</code> of the stored matrix in m_data or
+     * <code>-1</code> if it is not stored.
+     */
+    long _position(size_t i, size_t j) const;
+
+};
+
+#endif	/* MATRIXF_H */
+
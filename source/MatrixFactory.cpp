@@ -22,6 +22,7 @@
 
 #include "MatrixFactory.h"
 #include "Matrix.h"
+#include "SparseMatrixBuilder.h"
 
 #include <vector>       // std::vector
 #include <algorithm>    // std::random_shuffle
@@ -36,13 +37,32 @@ typedef std::pair<size_t, size_t> nice_pair;
 Matrix MatrixFactory::MakeIdentity(size_t n, double alpha) {
     Matrix mat(n, n, Matrix::MATRIX_DIAGONAL);
     for (size_t i = 0; i < n; i++) {
-        mat[i] = alpha;
+        mat.m_data[i] = alpha;
     }
     return mat;
 }
 
+Matrix MatrixFactory::MakeBanded(size_t nrows, size_t ncols, size_t kl, size_t ku) {
+    return Matrix(nrows, ncols, kl, ku, false);
+}
+
+Matrix MatrixFactory::MakeBandedSymmetric(size_t n, size_t kd) {
+    return Matrix(n, n, kd, kd, true);
+}
+
+Matrix MatrixFactory::MakeBlock(const std::vector<size_t>& row_sizes, const std::vector<size_t>& col_sizes) {
+    return Matrix(row_sizes, col_sizes);
+}
+
 Matrix MatrixFactory::MakeRandomSparse(size_t nrows, size_t ncols, size_t nnz, float offset, float scale) {        
-    Matrix R = MakeSparse(nrows, ncols, nnz, Matrix::SPARSE_UNSYMMETRIC);
+    if (nnz > nrows * ncols) {
+        std::ostringstream oss;
+        oss << "Matrix " << nrows << "x" << ncols << "(max_size=" << (nrows*ncols) 
+            << " cannot allocate " << nnz << "non-zeros";
+        throw std::invalid_argument(oss.str().c_str());
+    }
+    SparseMatrixBuilder builder(nrows, ncols);
+    builder.reserve(nnz);
     std::set<nice_pair> s;
     nice_pair p;
     while (true) { // construct pairs
@@ -56,9 +76,9 @@ Matrix MatrixFactory::MakeRandomSparse(size_t nrows, size_t ncols, size_t nnz, f
     for (std::set<nice_pair>::iterator it = s.begin(); it != s.end(); ++it) {
         double rand;
         rand = offset + (scale * std::rand()) / RAND_MAX;
-        R.set(it->first, it->second, rand);
+        builder.set(it->first, it->second, rand);
     }
-    return R;
+    return builder.build();
 }
 
 Matrix MatrixFactory::MakeRandomMatrix(size_t nrows, size_t ncols, float offset, float scale, Matrix::MatrixType type) {
@@ -82,7 +102,7 @@ Matrix MatrixFactory::MakeRandomMatrix(size_t nrows, size_t ncols, float offset,
     }
     Matrix mat(nrows, ncols, type);
     for (size_t j = 0; j < len; j++) {
-        mat[j] = static_cast<double> (offset + (scale * std::rand()) / RAND_MAX);
+        mat.m_data[j] = static_cast<double> (offset + (scale * std::rand()) / RAND_MAX);
     }
     return mat;
 }
@@ -120,6 +140,7 @@ Matrix MatrixFactory::ReadSparse(FILE* fp) {
 }
 
 Matrix MatrixFactory::ShallowMatrix(const Matrix& orig) {
+    const_cast<Matrix&> (orig)._expose(); /* writes through the shallow matrix are not tracked */
     Matrix mat_shallow = Matrix(true);
     mat_shallow.m_transpose = orig.m_transpose;
     mat_shallow.m_nrows = orig.m_nrows;
@@ -127,11 +148,14 @@ Matrix MatrixFactory::ShallowMatrix(const Matrix& orig) {
     mat_shallow.m_dataLength = orig.m_dataLength;
     mat_shallow.m_delete_data = false;
     mat_shallow.m_data = orig.m_data;
+    mat_shallow.m_ld = orig.m_ld;
     mat_shallow.m_type = orig.m_type;
     mat_shallow.m_sparseStorageType = orig.m_sparseStorageType;
     mat_shallow.m_dense = orig.m_dense;
     mat_shallow.m_triplet = orig.m_triplet;
     mat_shallow.m_sparse = orig.m_sparse;
+    mat_shallow.m_sparse_dirty = orig.m_sparse_dirty;
+    mat_shallow.m_exposed = true;
     return mat_shallow;
 }
 
@@ -142,6 +166,10 @@ Matrix MatrixFactory::ShallowVector(const Matrix& orig, size_t size, size_t offs
     if (orig.getNcols() != 1 && orig.getNrows() != 1) {
         throw std::invalid_argument("This method can only be applied to vectors");
     }
+    if (!orig.isContiguous()) {
+        return MatrixFactory::ShallowVector(orig, size, offset, 1);
+    }
+    const_cast<Matrix&> (orig)._expose();
     Matrix v_shallow = Matrix(true);
     v_shallow.m_transpose = orig.m_transpose;
     v_shallow.m_nrows = orig.m_transpose ? 1 : size;
@@ -149,9 +177,57 @@ Matrix MatrixFactory::ShallowVector(const Matrix& orig, size_t size, size_t offs
     v_shallow.m_dataLength = v_shallow.m_nrows * v_shallow.m_ncols;
     v_shallow.m_delete_data = false;
     v_shallow.m_data = orig.m_data + offset;
+    v_shallow.m_ld = v_shallow._storedRows();
+    return v_shallow;
+}
+
+Matrix MatrixFactory::ShallowVector(const Matrix& orig, size_t size, size_t offset, size_t stride) {
+    if (orig.getType() != Matrix::MATRIX_DENSE) {
+        throw std::invalid_argument("This method can only be applied to dense vectors");
+    }
+    if (orig.getNcols() != 1 && orig.getNrows() != 1) {
+        throw std::invalid_argument("This method can only be applied to vectors");
+    }
+    if (stride == 0) {
+        throw std::invalid_argument("The stride must be positive");
+    }
+    if (size > 0 && offset + (size - 1) * stride >= orig.length()) {
+        throw std::out_of_range("The strided vector exceeds the original vector");
+    }
+    /* 
+     * A column vector with a non-unit stride is stored as a (transposed) row
+     * whose leading dimension is the stride
+     */
+    const_cast<Matrix&> (orig)._expose();
+    bool column = orig.isColumnVector();
+    size_t inc = orig._vectorInc();
+    Matrix v_shallow = Matrix(true);
+    v_shallow.m_data = orig.m_data + offset * inc;
+    inc *= stride;
+    v_shallow.m_transpose = column && inc > 1;
+    v_shallow.m_nrows = column ? size : 1;
+    v_shallow.m_ncols = column ? 1 : size;
+    v_shallow.m_dataLength = size;
+    v_shallow.m_delete_data = false;
+    v_shallow.m_ld = (inc > 1) ? inc : v_shallow._storedRows();
     return v_shallow;
 }
 
+Matrix MatrixFactory::ShallowSubmatrix(const Matrix& orig, size_t row_start, size_t row_end,
+        size_t col_start, size_t col_end) {
+    if (orig.getType() != Matrix::MATRIX_DENSE) {
+        throw std::invalid_argument("This method can only be applied to dense matrices");
+    }
+    if (row_end < row_start || col_end < col_start) {
+        throw std::out_of_range("MatrixFactory::ShallowSubmatrix:: start > end is not allowed");
+    }
+    if (row_end >= orig.getNrows() || col_end >= orig.getNcols()) {
+        throw std::out_of_range("MatrixFactory::ShallowSubmatrix:: index out of range");
+    }
+    const_cast<Matrix&> (orig)._expose();
+    return orig._view(row_start, row_end - row_start + 1, col_start, col_end - col_start + 1);
+}
+
 Matrix MatrixFactory::ShallowVector(const Matrix& orig, size_t offset) {
     return MatrixFactory::ShallowVector(orig, orig.length() - offset, offset);
 }
@@ -164,6 +240,7 @@ Matrix MatrixFactory::ShallowVector(double* data, size_t size, size_t offset) {
     v_shallow.m_dataLength = v_shallow.m_nrows;
     v_shallow.m_delete_data = false;
     v_shallow.m_data = data + offset;
+    v_shallow.m_ld = size;
     return v_shallow;
 }
 
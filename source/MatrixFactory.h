@@ -99,6 +99,57 @@ public:
      */
     static Matrix MakeSparseSymmetric(size_t n, size_t max_nnz);
 
+    /**
+     * Creates a banded matrix of type <code>Matrix::MATRIX_BANDED</code> with
+     * <code>kl</code> nonzero sub-diagonals and <code>ku</code> nonzero 
+     * super-diagonals, initialized with zeros. Only the band is stored 
+     * (in LAPACK band storage), so that products cost <code>O((kl+ku)n)</code>
+     * operations using <code>dgbmv</code>.
+     * 
+     * @param nrows number of rows
+     * @param ncols number of columns
+     * @param kl lower bandwidth
+     * @param ku upper bandwidth
+     * @return Allocated banded matrix
+     * 
+     * \exception std::invalid_argument if <code>kl>=nrows</code> or 
+     * <code>ku>=ncols</code>
+     */
+    static Matrix MakeBanded(size_t nrows, size_t ncols, size_t kl, size_t ku);
+
+    /**
+     * Creates a symmetric banded matrix of type <code>Matrix::MATRIX_BANDED</code>
+     * with <code>kd</code> sub-diagonals (and as many super-diagonals),
+     * initialized with zeros. Only the lower band is stored. Products are 
+     * computed using <code>dsbmv</code> and CholeskyFactorization uses
+     * <code>dpbtrf</code>, so that systems can be solved in <code>O(kd^2 n)</code>
+     * operations.
+     * 
+     * @param n matrix size (matrix is square)
+     * @param kd bandwidth
+     * @return Allocated symmetric banded matrix
+     * 
+     * \exception std::invalid_argument if <code>kd>=n</code>
+     */
+    static Matrix MakeBandedSymmetric(size_t n, size_t kd);
+
+    /**
+     * Creates a block matrix of type <code>Matrix::MATRIX_BLOCK</code> whose
+     * block rows have sizes <code>row_sizes</code> and whose block columns have
+     * sizes <code>col_sizes</code>. All blocks are initially zero; blocks of any
+     * type (dense, sparse, diagonal, etc) are set using Matrix::setBlock. 
+     * Products and sums are computed block by block, using the best kernel 
+     * for each block, and independent blocks are processed in parallel.
+     * 
+     * @param row_sizes numbers of rows of the block rows
+     * @param col_sizes numbers of columns of the block columns
+     * @return Allocated block matrix
+     * 
+     * \exception std::invalid_argument if a partition is empty or contains 
+     * blocks of zero size
+     */
+    static Matrix MakeBlock(const std::vector<size_t>& row_sizes, const std::vector<size_t>& col_sizes);
+
     /**
      * Allocates a sparse matrix of given dimensions and instantiates it with
      * random entries at random positions. The client needs to specify the
@@ -198,6 +249,59 @@ public:
      */
     static Matrix ShallowVector(const Matrix& vector, size_t offset);
 
+    /**
+     * Creates a <em>strided</em> shallow vector from a given dense vector, i.e.,
+     * a vector whose elements are the elements <code>offset</code>, 
+     * <code>offset + stride</code>, ..., <code>offset + (size-1)*stride</code>
+     * of <code>vector</code>. For instance, a row of a (column-major) matrix with 
+     * <code>m</code> rows is a strided vector with stride <code>m</code>.
+     *
+     * The returned vector is a column vector if <code>vector</code> is a column
+     * vector and a row vector otherwise. It points to the data of <code>vector</code>
+     * and can be used in Matrix::mult and Matrix::add without any copying (see
+     * Matrix::isContiguous).
+     *
+     * @param vector any dense vector (possibly, itself a strided vector)
+     * @param size size/length of the shallow vector to be created
+     * @param offset offset with respect to the original vector
+     * @param stride distance between two consecutive elements of the new vector
+     * in the original vector
+     * @return strided shallow vector
+     *
+     * \exception std::invalid_argument if <code>vector</code> is not a dense
+     * vector or <code>stride</code> is zero
+     * \exception std::out_of_range if the strided vector exceeds <code>vector</code>
+     */
+    static Matrix ShallowVector(const Matrix& vector, size_t size, size_t offset, size_t stride);
+
+    /**
+     * Creates a <em>shallow submatrix</em> (a strided view) of a given dense 
+     * matrix, which consists of the rows <code>row_start</code> to <code>row_end</code>
+     * and the columns <code>col_start</code> to <code>col_end</code> (inclusive)
+     * of <code>mat</code>.
+     *
+     * The view points to the data of <code>mat</code> with the leading dimension
+     * of <code>mat</code> (see Matrix::getLeadingDimension), so no data are copied; 
+     * modifications of the view are visible in <code>mat</code> and vice versa.
+     * Views can be used in place of dense matrices in Matrix::mult and 
+     * Matrix::add, which pass them directly to BLAS. The original matrix must
+     * outlive the view.
+     *
+     * @param mat dense matrix (possibly, itself a view or transposed)
+     * @param row_start first row
+     * @param row_end last row
+     * @param col_start first column
+     * @param col_end last column
+     * @return shallow submatrix
+     *
+     * \exception std::invalid_argument if <code>mat</code> is not dense
+     * \exception std::out_of_range if the indices are out of range
+     *
+     * \sa \link Matrix::submatrixCopy submatrixCopy\endlink
+     */
+    static Matrix ShallowSubmatrix(const Matrix& mat, size_t row_start, size_t row_end,
+            size_t col_start, size_t col_end);
+
     /**
      * Creates a <em>shallow vector</em> from a given pointer-to-double.
      * Shallow vectors do not allocate space for their data, but instead point to 
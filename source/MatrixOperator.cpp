@@ -21,7 +21,14 @@
 #include "MatrixOperator.h"
 
 Matrix& MatrixOperator::getMatrix() const {
-    return m_A;
+    if (m_A == NULL) {
+        throw std::logic_error("This operator is defined by a single-precision matrix");
+    }
+    return *m_A;
+}
+
+MatrixF* MatrixOperator::getMatrixF() const {
+    return m_Af;
 }
 
 bool MatrixOperator::isSelfAdjoint() {
@@ -29,11 +36,14 @@ bool MatrixOperator::isSelfAdjoint() {
 }
 
 void MatrixOperator::setMatrix(Matrix& A) {
-    this->m_A = A;
+    if (m_A == NULL) {
+        throw std::logic_error("This operator is defined by a single-precision matrix");
+    }
+    *m_A = A;
     m_isSelfAdjoint = (A.getNrows() == A.getNcols() && A.isSymmetric());
 }
 
-MatrixOperator::MatrixOperator(Matrix& A) : m_A(A) {
+MatrixOperator::MatrixOperator(Matrix& A) : m_A(&A), m_Af(NULL) {
     if (A.isSymmetric()) {
         this->m_isSelfAdjoint = true;
     } else {
@@ -41,29 +51,50 @@ MatrixOperator::MatrixOperator(Matrix& A) : m_A(A) {
     }
 }
 
+MatrixOperator::MatrixOperator(MatrixF& A) : m_A(NULL), m_Af(&A) {
+    this->m_isSelfAdjoint = false;
+}
+
 MatrixOperator::~MatrixOperator() {
 }
 
 int MatrixOperator::call(Matrix& y, double alpha, Matrix& x, double gamma) {
-    return Matrix::mult(y, alpha, m_A, x, gamma);
+    if (m_Af != NULL) {
+        return MatrixF::mult(y, alpha, *m_Af, x, gamma, false);
+    }
+    return Matrix::mult(y, alpha, *m_A, x, gamma);
 }
 
 int MatrixOperator::callAdjoint(Matrix& y, double alpha, Matrix& x, double gamma) {
     if (isSelfAdjoint()) {
         return call(y, alpha, x, gamma);
     }
-    m_A.transpose();
-    int status = Matrix::mult(y, alpha, m_A, x, gamma);    
-    m_A.transpose();
-    return status;
+    if (m_Af != NULL) {
+        return MatrixF::mult(y, alpha, *m_Af, x, gamma, true);
+    }
+    return Matrix::mult(y, alpha, *m_A, x, gamma, true);
+}
+
+int MatrixOperator::call(VectorView y, double alpha, VectorView x, double gamma) {
+    if (m_Af != NULL) {
+        return LinearOperator::call(y, alpha, x, gamma);
+    }
+    return Matrix::mult(y, alpha, *m_A, x, gamma, false);
+}
+
+int MatrixOperator::callAdjoint(VectorView y, double alpha, VectorView x, double gamma) {
+    if (m_Af != NULL) {
+        return LinearOperator::callAdjoint(y, alpha, x, gamma);
+    }
+    return Matrix::mult(y, alpha, *m_A, x, gamma, true);
 }
 
 std::pair<size_t, size_t> MatrixOperator::dimensionIn() {
-    return _VECTOR_OP_DIM(m_A.getNcols());
+    return _VECTOR_OP_DIM(m_Af != NULL ? m_Af->getNcols() : m_A->getNcols());
 }
 
 std::pair<size_t, size_t> MatrixOperator::dimensionOut() {
-    return _VECTOR_OP_DIM(m_A.getNrows());
+    return _VECTOR_OP_DIM(m_Af != NULL ? m_Af->getNrows() : m_A->getNrows());
 }
 
 
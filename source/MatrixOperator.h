@@ -22,6 +22,7 @@
 #define	MATRIXOPERATOR_H
 
 #include "Matrix.h"
+#include "MatrixF.h"
 #include "LinearOperator.h"
 
 /**
@@ -32,6 +33,10 @@
  * \date Created on July 24, 2015, 7:31 PM
  * \ingroup LinOp
  * 
+ * The matrix may also be a single-precision MatrixF, in which case the operator
+ * is evaluated with single-precision matrix data (and double-precision input
+ * and output vectors).
+ * 
  * \example matop_example.cpp
  */
 class MatrixOperator : public LinearOperator {
@@ -47,15 +52,33 @@ public:
      */
     explicit MatrixOperator(Matrix& A);
 
+    /**
+     * Defines a constructs a new instance of MatrixOperator providing a reference
+     * to a single-precision matrix.
+     * @param A single-precision matrix
+     */
+    explicit MatrixOperator(MatrixF& A);
+
     /**
      * Provides access to the underlying matrix.
      * @return this operator as a matrix.
+     * 
+     * \exception std::logic_error if the operator is defined by a MatrixF
      */
     Matrix& getMatrix() const;
 
+    /**
+     * Provides access to the underlying single-precision matrix.
+     * @return the single-precision matrix of this operator or <code>NULL</code>
+     * if the operator is defined by a %Matrix.
+     */
+    MatrixF* getMatrixF() const;
+
     /**
      * Allows the update of the underlying matrix.
      * @param A a new instance of Matrix
+     * 
+     * \exception std::logic_error if the operator is defined by a MatrixF
      */
     void setMatrix(Matrix& A);
 
@@ -68,8 +91,45 @@ public:
 
     virtual int call(Matrix& y, double alpha, Matrix& x, double gamma);
 
+    /**
+     * Computes \f$y \leftarrow \gamma y + \alpha A^\top x\f$ without transposing
+     * the underlying matrix, so the operator is only read. Several threads may
+     * call this method on the same operator concurrently as long as none of 
+     * them modifies the matrix (the sparse representation of a sparse matrix
+     * is built once, under the lock of its data; see Matrix::_createSparse).
+     * 
+     * @param y vector to be updated
+     * @param alpha scalar \f$\alpha\f$
+     * @param x vector x
+     * @param gamma scalar \f$\gamma\f$
+     * @return status code
+     */
     virtual int callAdjoint(Matrix& y, double alpha, Matrix& x, double gamma);
 
+    /**
+     * Computes \f$y \leftarrow \gamma y + \alpha A x\f$ on lightweight vectors
+     * (see Matrix::mult(VectorView, double, Matrix&, VectorView, double, bool)).
+     * 
+     * @param y vector to be updated
+     * @param alpha scalar \f$\alpha\f$
+     * @param x vector x
+     * @param gamma scalar \f$\gamma\f$
+     * @return status code
+     */
+    virtual int call(VectorView y, double alpha, VectorView x, double gamma);
+
+    /**
+     * Computes \f$y \leftarrow \gamma y + \alpha A^\top x\f$ on lightweight 
+     * vectors.
+     * 
+     * @param y vector to be updated
+     * @param alpha scalar \f$\alpha\f$
+     * @param x vector x
+     * @param gamma scalar \f$\gamma\f$
+     * @return status code
+     */
+    virtual int callAdjoint(VectorView y, double alpha, VectorView x, double gamma);
+
     virtual std::pair<size_t, size_t> dimensionIn();
 
     virtual std::pair<size_t, size_t> dimensionOut();
@@ -80,7 +140,8 @@ public:
     virtual ~MatrixOperator();
 
 private:
-    Matrix & m_A; /**< matrix which defines the operator */
+    Matrix * m_A; /**< matrix which defines the operator */
+    MatrixF * m_Af; /**< single-precision matrix which defines the operator */
     bool m_isSelfAdjoint;/**< whether this is self-adjoint */
 };
 
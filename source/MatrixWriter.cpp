@@ -37,14 +37,19 @@ void MatrixWriter::setWriteFormat(WriteFormat format) {
 }
 
 void MatrixWriter::printJSON(FILE* fp) {
+    cholmod_triplet * triplet = NULL; /* triplets of a sparse matrix */
     fprintf(fp, "{\n");
     fprintf(fp, "  \"%s\":\"%s\",\n", MATRIX_TYPE, m_matrix.getTypeString().c_str());
-    fprintf(fp, "  \"%s\":"FMT_SIZE_T",\n", MATRIX_NROWS, m_matrix.getNrows());
-    fprintf(fp, "  \"%s\":"FMT_SIZE_T",\n", MATRIX_NCOLS, m_matrix.getNcols());
+    fprintf(fp, "  \"%s\":" FMT_SIZE_T ",\n", MATRIX_NROWS, m_matrix.getNrows());
+    fprintf(fp, "  \"%s\":" FMT_SIZE_T ",\n", MATRIX_NCOLS, m_matrix.getNcols());
     if (m_matrix.getType() != Matrix::MATRIX_SPARSE) {
-        fprintf(fp, "  \"%s\":"FMT_SIZE_T",\n", MATRIX_DATALENGTH, m_matrix.length());
+        fprintf(fp, "  \"%s\":" FMT_SIZE_T ",\n", MATRIX_DATALENGTH, m_matrix.length());
     } else {
-        fprintf(fp, "  \"%s\":"FMT_SIZE_T",\n", MATRIX_NZ, m_matrix.m_triplet->nnz);
+        triplet = m_matrix.m_triplet;
+        if (triplet == NULL) { /* the matrix may be stored as CSC only */
+            triplet = cholmod_sparse_to_triplet(m_matrix._sparseOp(false), Matrix::cholmod_handle());
+        }
+        fprintf(fp, "  \"%s\":" FMT_SIZE_T ",\n", MATRIX_NZ, triplet->nnz);
     }
 
     fprintf(fp, "  \"%s\":%d,\n", MATRIX_ENFORCE_DENSE_MODE, m_enforceDenseMode);
@@ -67,23 +72,26 @@ void MatrixWriter::printJSON(FILE* fp) {
             }
         }
     } else if (m_matrix.getType() == Matrix::MATRIX_SPARSE) {
-        for (size_t i = 0; i < m_matrix.m_triplet->nnz; i++) {
+        for (size_t i = 0; i < triplet->nnz; i++) {
             fprintf(fp, "[%d, %d, %g]",
-                    (static_cast<int*> (m_matrix.m_triplet->i))[i],
-                    (static_cast<int*> (m_matrix.m_triplet->j))[i],
-                    (static_cast<double*> (m_matrix.m_triplet->x))[i]);
-            if (i != m_matrix.m_triplet->nnz - 1) {
+                    (static_cast<int*> (triplet->i))[i],
+                    (static_cast<int*> (triplet->j))[i],
+                    (static_cast<double*> (triplet->x))[i]);
+            if (i != triplet->nnz - 1) {
                 fprintf(fp, ", ");
             }
         }
     }
     fprintf(fp, "]\n}");
+    if (triplet != NULL && triplet != m_matrix.m_triplet) {
+        cholmod_free_triplet(&triplet, Matrix::cholmod_handle());
+    }
 }
 
 void MatrixWriter::printTXT(FILE* fp) {
     fprintf(fp, "%d ", static_cast<int> (m_matrix.getType()));
-    fprintf(fp, FMT_SIZE_T" ", m_matrix.getNrows());
-    fprintf(fp, FMT_SIZE_T"\n", m_matrix.getNcols());
+    fprintf(fp, FMT_SIZE_T " ", m_matrix.getNrows());
+    fprintf(fp, FMT_SIZE_T "\n", m_matrix.getNcols());
 
     if (m_matrix.getType() == Matrix::MATRIX_DENSE || m_enforceDenseMode) {
         for (size_t j = 0; j < m_matrix.getNcols(); j++) {
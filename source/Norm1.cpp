@@ -19,6 +19,7 @@
  */
 
 #include "Norm1.h"
+#include "ElementWise.h"
 #include <cmath>
 
 Norm1::Norm1() : Norm() {
@@ -40,11 +41,12 @@ int Norm1::call(Matrix& x, double& f) {
         throw std::invalid_argument("x must be a column-vector");
     }
     //LCOV_EXCL_STOP
-    f = 0.0;
-    for (size_t i = 0; i < x.getNrows(); i++) {
-        f += std::abs(x[i]);
+    if (!x.isContiguous()) { /* strided view: evaluated on a compact copy */
+        Matrix x_compact(x);
+        return call(x_compact, f);
     }
-    f *= m_mu;
+    const Matrix& cx = x;
+    f = m_mu * ElementWise::sumAbs(x.getNrows(), cx.getData());
     return ForBESUtils::STATUS_OK;
 }
 
@@ -54,16 +56,11 @@ int Norm1::callProx(Matrix& x, double gamma, Matrix& prox) {
         throw std::invalid_argument("x must be a column-vector");
     }
     //LCOV_EXCL_STOP
-    double gm = gamma * m_mu;
-    for (size_t i = 0; i < x.getNrows(); i++) {
-        double xi;
-        xi = x[i];
-        if (xi >= gm) {
-            prox[i] = xi - gm;
-        } else if (xi <= -gm) {
-            prox[i] = xi + gm;
-        }
+    if (!x.isContiguous() || !prox.isContiguous()) { /* strided views */
+        return Function::callProx(VectorView(x), gamma, VectorView(prox));
     }
+    const Matrix& cx = x;
+    ElementWise::softThreshold(x.getNrows(), cx.getData(), gamma * m_mu, prox.getData());
     return ForBESUtils::STATUS_OK;
 }
 
@@ -73,22 +70,35 @@ int Norm1::callProx(Matrix& x, double gamma, Matrix& prox, double& f_at_prox) {
         throw std::invalid_argument("x must be a column-vector");
     }
     //LCOV_EXCL_STOP
-    double gm = gamma * m_mu;
-    f_at_prox = 0.0;
-    for (size_t i = 0; i < x.getNrows(); i++) {
-        double pi;
-        double xi = x[i];
-        if (xi >= gm) {
-            pi = xi - gm;
-        } else if (xi <= -gm) {
-            pi = xi + gm;
-        } else {
-            pi = 0.0;
-        }
-        prox[i] = pi;
-        f_at_prox += std::abs(pi);
+    if (!x.isContiguous() || !prox.isContiguous()) { /* strided views */
+        return Function::callProx(VectorView(x), gamma, VectorView(prox), f_at_prox);
     }
-    f_at_prox *= m_mu;
+    const Matrix& cx = x;
+    f_at_prox = m_mu * ElementWise::softThreshold(x.getNrows(), cx.getData(), gamma * m_mu, prox.getData());
+    return ForBESUtils::STATUS_OK;
+}
+
+int Norm1::call(VectorView x, double& f) {
+    if (x.stride() != 1) {
+        return Function::call(x, f);
+    }
+    f = m_mu * ElementWise::sumAbs(x.size(), x.data());
+    return ForBESUtils::STATUS_OK;
+}
+
+int Norm1::callProx(VectorView x, double gamma, VectorView prox) {
+    double f_at_prox;
+    return callProx(x, gamma, prox, f_at_prox);
+}
+
+int Norm1::callProx(VectorView x, double gamma, VectorView prox, double& f_at_prox) {
+    if (x.size() != prox.size()) {
+        throw std::invalid_argument("x and prox must have the same size");
+    }
+    if (x.stride() != 1 || prox.stride() != 1) {
+        return Function::callProx(x, gamma, prox, f_at_prox);
+    }
+    f_at_prox = m_mu * ElementWise::softThreshold(x.size(), x.data(), gamma * m_mu, prox.data());
     return ForBESUtils::STATUS_OK;
 }
 
@@ -98,14 +108,12 @@ int Norm1::dualNorm(Matrix& x, double& norm) {
         throw std::invalid_argument("x must be a column-vector");
     }
     //LCOV_EXCL_STOP
-    norm = std::abs(x[0]);
-    for (size_t i = 1; i < x.getNrows(); i++) {
-        double absi = std::abs(x[i]);
-        if (absi > norm) {
-            norm = absi;
-        }
+    if (!x.isContiguous()) { /* strided view: evaluated on a compact copy */
+        Matrix x_compact(x);
+        return dualNorm(x_compact, norm);
     }
-    norm /= m_mu;
+    const Matrix& cx = x;
+    norm = ElementWise::maxAbs(x.getNrows(), cx.getData()) / m_mu;
     return ForBESUtils::STATUS_OK;
 }
 
@@ -104,6 +104,12 @@ public:
     virtual int callProx(Matrix& x, double gamma, Matrix& prox);
     
     virtual int callProx(Matrix& x, double gamma, Matrix& prox, double& f_at_prox);
+
+    virtual int call(VectorView x, double& f);
+
+    virtual int callProx(VectorView x, double gamma, VectorView prox);
+
+    virtual int callProx(VectorView x, double gamma, VectorView prox, double& f_at_prox);
     
     virtual FunctionOntologicalClass category();
 
@@ -69,6 +69,7 @@ class Norm2 : public Norm {
 public:
 
     using Function::call;
+    using Function::callProx;
     using Norm::callConj;
 
     /**
@@ -71,9 +71,9 @@ public:
      * and it was created now for the first time.
      */
     template<typename T> bool add_property(std::string key, int type, T* value) {
-        TypedPair pair = std::make_pair<int, void*>(type, value);
+        TypedPair pair(type, value);
         std::pair < PropertiesMap::iterator, bool> insertion_status =
-                m_map->insert(std::make_pair<std::string, TypedPair>(key, pair));
+                m_map->insert(std::make_pair(key, pair));
         return insertion_status.second;
     }
 
@@ -21,6 +21,12 @@
 #include "QuadOverAffine.h"
 #include "LDLFactorization.h"
 
+#include <algorithm>
+#include <vector>
+
+#define KKT_REGULARIZATION 1e-8
+#define KKT_REFINEMENT_STEPS 3
+
 void checkConstructorArguments(const Matrix& Q, const Matrix& q, const Matrix& A, const Matrix& b);
 
 QuadOverAffine::QuadOverAffine() : Function() {
@@ -31,6 +37,9 @@ QuadOverAffine::QuadOverAffine() : Function() {
     m_q = NULL;
     m_b = NULL;
     m_sigma = NULL;
+    m_delta = 0.0;
+    m_residual = NULL;
+    m_correction = NULL;
 }
 
 QuadOverAffine::~QuadOverAffine() {
@@ -43,6 +52,12 @@ QuadOverAffine::~QuadOverAffine() {
     if (m_sigma != NULL) {
         delete m_sigma;
     }
+    if (m_residual != NULL) {
+        delete m_residual;
+    }
+    if (m_correction != NULL) {
+        delete m_correction;
+    }
 }
 
 void checkConstructorArguments(const Matrix& Q, const Matrix& q, const Matrix& A, const Matrix& b) {
@@ -72,6 +87,9 @@ QuadOverAffine::QuadOverAffine(Matrix& Q, Matrix& q, Matrix& A, Matrix& b) {
     m_F = NULL;
     m_Fsolver = NULL;
     m_sigma = NULL;
+    m_delta = 0.0;
+    m_residual = NULL;
+    m_correction = NULL;
 
     this->m_Q = &Q;
     this->m_q = &q;
@@ -80,7 +98,7 @@ QuadOverAffine::QuadOverAffine(Matrix& Q, Matrix& q, Matrix& A, Matrix& b) {
     size_t n = Q.getNrows();
     size_t s = A.getNrows();
     size_t nF = n + s;
-    if (Q.getType() == Matrix::MATRIX_DENSE) {
+    if (Q.getType() == Matrix::MATRIX_DENSE && A.getType() != Matrix::MATRIX_SPARSE) {
         m_F = new Matrix(nF, nF, Matrix::MATRIX_DENSE);
         /*
          * F = [Q  * ; *  *]
@@ -106,6 +124,17 @@ QuadOverAffine::QuadOverAffine(Matrix& Q, Matrix& q, Matrix& A, Matrix& b) {
         if (ForBESUtils::STATUS_OK != status) {
             throw std::invalid_argument("LDL factorization failed for matrix F = [Q A'; A 0] (dense) - invalid arguments Q and A");
         }
+    } else {
+        /* sparse or structured Q and A: quasi-definite F, factorized with AMD and LDL */
+        m_delta = KKT_REGULARIZATION;
+        sparseKKT(Q, A);
+        m_Fsolver = new LDLFactorization(*m_F);
+        int status = m_Fsolver -> factorize();
+        if (ForBESUtils::STATUS_OK != status) {
+            throw std::invalid_argument("LDL factorization failed for matrix F = [Q A'; A 0] (sparse) - invalid arguments Q and A");
+        }
+        m_residual = new Matrix(nF, 1, Matrix::MATRIX_DENSE);
+        m_correction = new Matrix(nF, 1, Matrix::MATRIX_DENSE);
     }
     m_sigma = new Matrix(nF, 1, Matrix::MATRIX_DENSE);
     for (size_t i = 0; i < s; i++) {
@@ -113,6 +142,135 @@ QuadOverAffine::QuadOverAffine(Matrix& Q, Matrix& q, Matrix& A, Matrix& b) {
     }
 }
 
+cholmod_sparse * QuadOverAffine::cscBlock(Matrix& M, bool transposed) {
+    if (M.getType() == Matrix::MATRIX_SPARSE) {
+        cholmod_sparse * S = M._sparseOp(M.m_transpose != transposed);
+        if (S->stype != 0) { /* both triangles */
+            return cholmod_copy(S, 0, 1, Matrix::cholmod_handle());
+        }
+        return S;
+    }
+    size_t nrows = transposed ? M.getNcols() : M.getNrows();
+    size_t ncols = transposed ? M.getNrows() : M.getNcols();
+    /* only rows j - above, ..., j + below of column j may be nonzero */
+    size_t below = nrows;
+    size_t above = ncols;
+    if (M.getType() == Matrix::MATRIX_DIAGONAL) {
+        below = 0;
+        above = 0;
+    } else if (M.getType() == Matrix::MATRIX_BANDED) {
+        below = transposed ? M.getUpperBandwidth() : M.getLowerBandwidth();
+        above = transposed ? M.getLowerBandwidth() : M.getUpperBandwidth();
+    }
+    std::vector<int> Sp(ncols + 1);
+    std::vector<int> Si;
+    std::vector<double> Sx;
+    for (size_t j = 0; j < ncols; j++) {
+        Sp[j] = Si.size();
+        size_t i_end = std::min(nrows, j + below + 1);
+        for (size_t i = (j > above ? j - above : 0); i < i_end; i++) {
+            double v = transposed ? M.get(j, i) : M.get(i, j);
+            if (v != 0.0) {
+                Si.push_back(i);
+                Sx.push_back(v);
+            }
+        }
+    }
+    Sp[ncols] = Si.size();
+    cholmod_sparse * S = cholmod_allocate_sparse(nrows, ncols, Si.size(), true, true, 0, CHOLMOD_REAL, Matrix::cholmod_handle());
+    std::copy(Sp.begin(), Sp.end(), static_cast<int*> (S->p));
+    std::copy(Si.begin(), Si.end(), static_cast<int*> (S->i));
+    std::copy(Sx.begin(), Sx.end(), static_cast<double*> (S->x));
+    return S;
+}
+
+void QuadOverAffine::sparseKKT(Matrix& Q, Matrix& A) {
+    cholmod_common * handle = Matrix::cholmod_handle();
+    size_t n = Q.getNrows();
+    size_t s = A.getNrows();
+    size_t nF = n + s;
+    cholmod_sparse * Qs = cscBlock(Q, false);
+    cholmod_sparse * Ats = cscBlock(A, true); /* column k of A' is row k of A */
+    size_t nnz_max = cholmod_nnz(Qs, handle) + cholmod_nnz(Ats, handle) + nF;
+    cholmod_sparse * F = cholmod_allocate_sparse(nF, nF, nnz_max, true, true, 1, CHOLMOD_REAL, handle);
+    int * Fp = static_cast<int*> (F->p);
+    int * Fi = static_cast<int*> (F->i);
+    double * Fx = static_cast<double*> (F->x);
+    int nz = 0;
+    /* F = [Q + delta*I  * ; *  *] (upper triangle of Q, diagonal last) */
+    const int * Qp = static_cast<int*> (Qs->p);
+    const int * Qi = static_cast<int*> (Qs->i);
+    const double * Qx = static_cast<double*> (Qs->x);
+    for (size_t j = 0; j < n; j++) {
+        Fp[j] = nz;
+        int pend = Qs->packed ? Qp[j + 1] : Qp[j] + static_cast<int*> (Qs->nz)[j];
+        double diag = m_delta;
+        for (int p = Qp[j]; p < pend; p++) {
+            size_t i = Qi[p];
+            if (i < j) {
+                Fi[nz] = i;
+                Fx[nz++] = Qx[p];
+            } else if (i == j) {
+                diag += Qx[p];
+            }
+        }
+        Fi[nz] = j;
+        Fx[nz++] = diag;
+    }
+    /* F = [Q + delta*I  A' ; *  -delta*I] */
+    const int * Ap = static_cast<int*> (Ats->p);
+    const int * Ai = static_cast<int*> (Ats->i);
+    const double * Ax = static_cast<double*> (Ats->x);
+    for (size_t k = 0; k < s; k++) {
+        Fp[n + k] = nz;
+        int pend = Ats->packed ? Ap[k + 1] : Ap[k] + static_cast<int*> (Ats->nz)[k];
+        for (int p = Ap[k]; p < pend; p++) {
+            Fi[nz] = Ai[p];
+            Fx[nz++] = Ax[p];
+        }
+        Fi[nz] = n + k;
+        Fx[nz++] = -m_delta;
+    }
+    Fp[nF] = nz;
+    F->sorted = Qs->sorted && Ats->sorted;
+    if (Qs != Q.m_sparse) {
+        cholmod_free_sparse(&Qs, handle);
+    }
+    if (Ats != A.m_sparse) {
+        cholmod_free_sparse(&Ats, handle);
+    }
+    m_F = new Matrix(nF, nF, Matrix::MATRIX_SPARSE);
+    m_F->m_sparse = F;
+    m_F->m_sparse_dirty = false;
+    m_F->m_sparseStorageType = Matrix::CHOLMOD_TYPE_SPARSE;
+}
+
+int QuadOverAffine::refine(Matrix& z) {
+    size_t n = m_Q->getNrows();
+    size_t nF = m_F->getNrows();
+    double minus_one[2] = {-1.0, 0.0};
+    double one[2] = {1.0, 0.0};
+    double * zx = z.getData();
+    double * r = m_residual->getData();
+    const double * sigma = m_sigma->getData();
+    int status = ForBESUtils::STATUS_OK;
+    for (int k = 0; k < KKT_REFINEMENT_STEPS && ForBESUtils::STATUS_OK == status; k++) {
+        /* r = sigma - S*z = sigma - S_delta*z + diag(delta*I, -delta*I)*z */
+        for (size_t i = 0; i < nF; i++) {
+            r[i] = sigma[i] + (i < n ? m_delta : -m_delta) * zx[i];
+        }
+        cholmod_dense z_dense = CholmodContext::wrapDense(nF, 1, zx);
+        cholmod_dense r_dense = CholmodContext::wrapDense(nF, 1, r);
+        cholmod_sdmult(m_F->m_sparse, 0, minus_one, one, &z_dense, &r_dense, Matrix::cholmod_handle());
+        status = m_Fsolver->solve(*m_residual, *m_correction);
+        const double * dz = m_correction->getData();
+        for (size_t i = 0; i < nF; i++) {
+            zx[i] += dz[i];
+        }
+    }
+    return status;
+}
+
 int QuadOverAffine::callConj(Matrix& y, double& f_star) {
     Matrix grad(y.getNrows(), y.getNcols());
     return callConj(y, f_star, grad);
@@ -125,6 +283,9 @@ int QuadOverAffine::callConj(Matrix& y, double& f_star, Matrix& grad) {
     }    
     /* Solve F*grad = sigma */
     int status = m_Fsolver->solve(*m_sigma, grad);
+    if (ForBESUtils::STATUS_OK == status && m_residual != NULL) {
+        status = refine(grad); /* remove the effect of the regularization */
+    }
     /* Take the first n elements of grad */
     grad.reshape(m_Q->getNrows(), 1);
     /* f_star = grad' * Q * grad / 2.0 */
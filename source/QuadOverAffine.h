@@ -74,6 +74,28 @@
  * F^*(x^*) = -\frac{1}{2} \left(\gamma(x^*)'Q\gamma(x^*) + (q-x^*)'\gamma(x^*)\right)
  * \f]
  * 
+ * If \f$Q\f$ is a <code>MATRIX_DENSE</code> matrix and \f$A\f$ is not sparse,
+ * then \f$S\f$ is stored as a dense matrix and factorized by a dense LDL 
+ * factorization. Otherwise (e.g., if \f$Q\f$ or \f$A\f$ are sparse, diagonal
+ * or banded), the regularized matrix
+ * 
+ * \f[
+ * S_\delta = \begin{bmatrix}
+ * Q + \delta I & A'\\
+ * A & -\delta I
+ * \end{bmatrix},
+ * \f]
+ * 
+ * with a small \f$\delta > 0\f$, is assembled directly in compressed-column 
+ * form (only its upper triangle is stored) and factorized by a sparse 
+ * LDL factorization with a fill-reducing ordering (see LDLFactorization).
+ * Provided that \f$Q\f$ is positive semidefinite, \f$S_\delta\f$ is 
+ * quasi-definite, so its LDL factorization exists for every symmetric 
+ * permutation and no pivoting is needed. The error due to the regularization
+ * is then removed by a few steps of iterative refinement with respect to 
+ * \f$S\f$, so that every evaluation of the conjugate costs a few sparse 
+ * triangular solves.
+ * 
  * Here is an example of use
  * 
  * \code{.cpp}
@@ -106,6 +128,9 @@ public:
      * 
      * \exception std::invalid_argument in case the given parameters have incompatible
      * dimensions or matrix F = [Q A'; A 0] cannot be LDL-decomposed.
+     * 
+     * \note The matrices which are passed to this constructor are not copied;
+     * they should not be destroyed while this function is in use.
      */
     QuadOverAffine(Matrix& Q, Matrix& q, Matrix& A, Matrix& b);
 
@@ -126,6 +151,24 @@ private:
 
     QuadOverAffine();
 
+    /**
+     * Assembles the regularized KKT matrix \f$S_\delta\f$ in compressed-column
+     * form (upper triangle) and stores it in #m_F.
+     */
+    void sparseKKT(Matrix& Q, Matrix& A);
+
+    /**
+     * Iterative refinement of the solution \f$z\f$ of \f$S_\delta z = \sigma\f$
+     * towards the solution of \f$S z = \sigma\f$.
+     */
+    int refine(Matrix& z);
+
+    /**
+     * Compressed-column form of M (or of M' if transposed is true); the caller
+     * needs to free it if it is not <code>M.m_sparse</code>.
+     */
+    static cholmod_sparse * cscBlock(Matrix& M, bool transposed);
+
     Matrix *m_Q; /**< Matrix Q (Hessian) */
     Matrix *m_q; /**< Vector q (Linear term) */
     Matrix *m_A; /**< Matrix A */
@@ -134,6 +177,9 @@ private:
     Matrix *m_F; /**< Matrix <code>F = [Q A'; A 0]</code> */
     Matrix *m_sigma;
     FactoredSolver * m_Fsolver; /**< Factorizer for matrix F */
+    double m_delta; /**< Static regularization of F (zero if F is dense) */
+    Matrix *m_residual; /**< Residual workspace of iterative refinement (sparse F only) */
+    Matrix *m_correction; /**< Correction workspace of iterative refinement (sparse F only) */
 };
 
 #endif	/* QUADOVERAFFINE_H */
@@ -21,6 +21,7 @@
 #include "Quadratic.h"
 #include "MatrixFactory.h"
 #include "CGSolver.h"
+#include "LDLFactorization.h"
 
 using namespace std;
 
@@ -31,6 +32,11 @@ Quadratic::Quadratic() {
     m_Q = NULL;
     m_q = NULL;
     m_delete_Q = false;
+    m_cache = NULL;
+    m_delete_cache = false;
+    m_version = 0;
+    m_eig_V = NULL;
+    m_eig_values = NULL;
 }
 
 Quadratic::Quadratic(Matrix& QQ) {
@@ -40,6 +46,11 @@ Quadratic::Quadratic(Matrix& QQ) {
     m_solver = NULL;
     m_q = NULL;
     m_delete_Q = false;
+    m_cache = NULL;
+    m_delete_cache = false;
+    m_version = 0;
+    m_eig_V = NULL;
+    m_eig_values = NULL;
 }
 
 Quadratic::Quadratic(Matrix& QQ, Matrix& qq) {
@@ -49,21 +60,86 @@ Quadratic::Quadratic(Matrix& QQ, Matrix& qq) {
     m_is_Q_eye = false;
     m_is_q_zero = false;
     m_delete_Q = false;
+    m_cache = NULL;
+    m_delete_cache = false;
+    m_version = 0;
+    m_eig_V = NULL;
+    m_eig_values = NULL;
 }
 
 Quadratic::~Quadratic() {
+    if (m_delete_Q) {
+        delete m_Q;
+    }
+    resetQ();
+    if (m_delete_cache) {
+        delete m_cache;
+    }
+}
+
+void Quadratic::resetQ() {
     if (m_solver != NULL) {
         delete m_solver;
+        m_solver = NULL;
     }
-    if (m_delete_Q) {
-        delete m_Q;
+    if (m_cache != NULL) {
+        m_cache->invalidate(this);
+    }
+    m_version++;
+    if (m_eig_V != NULL) {
+        delete m_eig_V;
+        delete m_eig_values;
+        m_eig_V = NULL;
+        m_eig_values = NULL;
     }
 }
 
 void Quadratic::setQ(Matrix& Q) {
+    resetQ();
     m_is_Q_eye = false;
     this->m_Q = &Q;
-    this->m_solver = NULL;
+}
+
+void Quadratic::invalidate() {
+    resetQ();
+}
+
+void Quadratic::setFactorizationCache(FactorizationCache& cache) {
+    if (m_cache != NULL) {
+        m_cache->invalidate(this);
+        if (m_delete_cache) {
+            delete m_cache;
+        }
+    }
+    m_cache = &cache;
+    m_delete_cache = false;
+}
+
+int Quadratic::computeEigendecomposition() {
+    if (m_is_Q_eye || m_Q == NULL) {
+        return ForBESUtils::STATUS_UNDEFINED_FUNCTION;
+    }
+    size_t n = m_Q->getNrows();
+    Matrix * V = new Matrix(n, n);
+    Matrix * lambda = new Matrix(n, 1);
+    for (size_t j = 0; j < n; j++) {
+        for (size_t i = j; i < n; i++) {
+            V->set(i, j, m_Q->get(i, j));
+        }
+    }
+    int info = LAPACKE_dsyevd(LAPACK_COL_MAJOR, 'V', 'L', n, V->getData(), n, lambda->getData());
+    if (info != ForBESUtils::STATUS_OK) {
+        delete V;
+        delete lambda;
+        return ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+    }
+    if (m_eig_V != NULL) {
+        delete m_eig_V;
+        delete m_eig_values;
+    }
+    m_eig_V = V;
+    m_eig_values = lambda;
+    return ForBESUtils::STATUS_OK;
 }
 
 void Quadratic::setq(Matrix& q) {
@@ -156,27 +232,52 @@ FunctionOntologicalClass Quadratic::category() {
     return FunctionOntologyRegistry::quadratic();
 }
 
+/*
+ * Q_tilde := I + gamma * Q_tilde
+ */
+static int shift_and_scale(Matrix& Q_tilde, double gamma) {
+    Q_tilde *= gamma;
+    Matrix Eye = MatrixFactory::MakeIdentity(Q_tilde.getNrows(), 1.0);
+    return Matrix::add(Q_tilde, 1.0, Eye, 1.0);
+}
+
+FactoredSolver * Quadratic::proxSolver(double gamma) {
+    Matrix::MatrixType type = m_Q->getType();
+    if (type != Matrix::MATRIX_DENSE && type != Matrix::MATRIX_SYMMETRIC
+            && type != Matrix::MATRIX_BANDED && type != Matrix::MATRIX_SPARSE) {
+        return NULL;
+    }
+    if (m_cache == NULL) {
+        m_cache = new FactorizationCache();
+        m_delete_cache = true;
+    }
+    FactoredSolver * solver = m_cache->find(this, m_version, gamma);
+    if (solver != NULL) {
+        return solver;
+    }
+    Matrix * Q_tilde = new Matrix(*m_Q);
+    int status = shift_and_scale(*Q_tilde, gamma);
+    if (!ForBESUtils::is_status_ok(status) || Q_tilde->getType() != type) {
+        delete Q_tilde;
+        return NULL;
+    }
+    if (type == Matrix::MATRIX_SPARSE) {
+        solver = new LDLFactorization(*Q_tilde); /* with an AMD ordering */
+    } else {
+        solver = new CholeskyFactorization(*Q_tilde);
+    }
+    if (solver->factorize() != ForBESUtils::STATUS_OK) {
+        delete solver;
+        delete Q_tilde;
+        return NULL;
+    }
+    m_cache->insert(this, m_version, gamma, Q_tilde, solver);
+    return solver;
+}
+
 int Quadratic::callProx(Matrix& v, double gamma, Matrix& prox) {
     // (I+gamma Q)^{-1}(v-gamma q)
     int status;
-    CGSolver * solver = NULL;
-    if (!m_is_Q_eye) {
-        // If Q is not I, we need to create a CGSolver for (I + gamma Q)
-        Matrix Q_tilde(*m_Q);
-        size_t n = m_Q->getNrows();
-        static Matrix Eye = MatrixFactory::MakeIdentity(n, 1.0);
-        status = Matrix::add(Q_tilde, 1.0, Eye, gamma);
-        if (!ForBESUtils::is_status_ok(status)) {
-            return status;
-        }
-        MatrixOperator Q_tilde_op(Q_tilde);
-        Matrix P(n, n, Matrix::MATRIX_DIAGONAL);
-        for (size_t i = 0; i < n; i++) {
-            P[i] = 1 / Q_tilde.get(i, i);
-        }
-        MatrixOperator P_op(P);
-        solver = new CGSolver(Q_tilde_op, P_op);
-    }
     /*
      * v_gamma_b = v - gamma * b
      */
@@ -190,18 +291,54 @@ int Quadratic::callProx(Matrix& v, double gamma, Matrix& prox) {
             return status;
         }
     }
-    if (!m_is_Q_eye) {
-        status = solver->solve(v_gamma_b, prox);
+    if (m_is_Q_eye) {
+        prox = v_gamma_b;
+        return ForBESUtils::STATUS_OK;
+    }
+    size_t n = m_Q->getNrows();
+    if (Matrix::MATRIX_DIAGONAL == m_Q->getType()) {
+        /* Q is diagonal: O(n) */
+        prox = v_gamma_b;
+        for (size_t i = 0; i < n; i++) {
+            prox[i] /= (1.0 + gamma * m_Q->get(i, i));
+        }
+        return ForBESUtils::STATUS_OK;
+    }
+    if (m_eig_V != NULL) {
+        /* prox = V * (I + gamma*Lambda)^{-1} * V' * (v - gamma*q) */
+        Matrix w(n, v_gamma_b.getNcols());
+        status = Matrix::mult(w, 1.0, *m_eig_V, v_gamma_b, 0.0, true);
         if (!ForBESUtils::is_status_ok(status)) {
             return status;
         }
-    } else {
-        prox = v_gamma_b;
+        /* w := (I + gamma*Lambda)^{-1} * w (row i of w is scaled by 1/(1 + gamma*lambda_i)) */
+        double * w_data = w.getData();
+        const Matrix& eig_values = *m_eig_values;
+        const double * lambda = eig_values.getData();
+        for (size_t i = 0; i < n; i++) {
+            cblas_dscal(w.getNcols(), 1.0 / (1.0 + gamma * lambda[i]), w_data + i, n);
+        }
+        prox = (*m_eig_V) * w;
+        return ForBESUtils::STATUS_OK;
     }
-    if (solver != NULL) {
-        delete solver;
+    FactoredSolver * factorization = proxSolver(gamma);
+    if (factorization != NULL) {
+        return factorization->solve(v_gamma_b, prox);
     }
-    return ForBESUtils::STATUS_OK;
+    /* conjugate gradient method for (I + gamma Q) */
+    Matrix Q_tilde(*m_Q);
+    status = shift_and_scale(Q_tilde, gamma);
+    if (!ForBESUtils::is_status_ok(status)) {
+        return status;
+    }
+    MatrixOperator Q_tilde_op(Q_tilde);
+    Matrix P(n, n, Matrix::MATRIX_DIAGONAL);
+    for (size_t i = 0; i < n; i++) {
+        P[i] = 1 / Q_tilde.get(i, i);
+    }
+    MatrixOperator P_op(P);
+    CGSolver solver(Q_tilde_op, P_op);
+    return solver.solve(v_gamma_b, prox);
 
 }
 
@@ -24,6 +24,7 @@
 #include "Function.h"
 #include "Matrix.h"
 #include "CholeskyFactorization.h"
+#include "FactorizationCache.h"
 #include <iostream>
 
 /**
@@ -56,8 +57,28 @@
  * \mathrm{prox}_{\gamma f}(v) = (I+\gamma Q)^{-1}(v-\gamma b),
  * \f]
  * 
- * where the linear system \f$(I+\gamma Q)^{-1}(v-\gamma b)\f$ is solved using the
- * conjugate gradient algorithm implemented in CGSolver.
+ * where the linear system \f$(I+\gamma Q)^{-1}(v-\gamma b)\f$ is solved as follows:
+ * 
+ * - If \f$Q\f$ is diagonal, the solution is computed element-wise at a cost
+ *   of \f$O(n)\f$ for every \f$\gamma\f$.
+ * - If the eigendecomposition \f$Q=V\Lambda V^{\top}\f$ has been computed 
+ *   (see #computeEigendecomposition), then 
+ *   \f$(I+\gamma Q)^{-1} = V(I+\gamma\Lambda)^{-1}V^{\top}\f$, i.e., the 
+ *   system is solved without any factorization for every \f$\gamma\f$. 
+ *   Every call costs \f$O(n^2)\f$ operations (two products with \f$V\f$); 
+ *   only the scaling in the eigenbasis, which costs \f$O(n)\f$, depends on
+ *   \f$\gamma\f$.
+ * - Otherwise, if \f$Q\f$ is dense, symmetric, banded or sparse, the matrix
+ *   \f$I+\gamma Q\f$ is factorized (Cholesky factorization, or sparse LDL 
+ *   factorization with a fill-reducing ordering if \f$Q\f$ is sparse) and the
+ *   factorization is stored in a FactorizationCache under the key 
+ *   \f$\gamma\f$, so that algorithms which revisit the same step sizes do not
+ *   need to factorize \f$I+\gamma Q\f$ again. The cache may be shared by 
+ *   several functions (see #setFactorizationCache). The cached factorizations
+ *   are those of the matrix which was passed to the constructor or to #setQ;
+ *   if it is modified in place, #invalidate must be called.
+ * - In all other cases, the system is solved using the conjugate gradient 
+ *   algorithm implemented in CGSolver.
  * 
  * 
  * Here is a simple example:
@@ -92,6 +113,7 @@
 class Quadratic : public Function {
 public:
 
+    using Function::call;
     using Function::callConj;
     using Function::callProx;
 
@@ -128,11 +150,53 @@ public:
     virtual FunctionOntologicalClass category();
 
     /**
-     * Setter method for matrix \f$Q\f$
+     * Setter method for matrix \f$Q\f$. 
+     * 
+     * All factorizations and the eigendecomposition of the previous matrix 
+     * are discarded.
+     * 
+     * \note The function keeps a reference to \c Q. If \c Q is modified in 
+     * place afterwards, #invalidate must be called, otherwise #callProx and
+     * #callConj will keep using the factorizations of the old matrix.
+     * 
      * @param Q %Matrix \c Q
      */
     void setQ(Matrix& Q);
 
+    /**
+     * Discards all factorizations and the eigendecomposition of \f$Q\f$. This
+     * must be called whenever \f$Q\f$ is modified in place (see #setQ).
+     */
+    void invalidate();
+
+    /**
+     * Sets the cache where the factorizations of \f$I+\gamma Q\f$, which are
+     * computed by #callProx, are stored. By default, every function has its 
+     * own cache. A cache may be shared by several functions, in which case it
+     * must outlive them.
+     * 
+     * @param cache factorization cache
+     */
+    void setFactorizationCache(FactorizationCache& cache);
+
+    /**
+     * Computes and stores the eigendecomposition \f$Q=V\Lambda V^{\top}\f$ 
+     * (using LAPACK's <code>dsyevd</code>), which is then used by #callProx 
+     * to compute the proximal operator for every \f$\gamma\f$ without 
+     * factorizing \f$I+\gamma Q\f$.
+     * 
+     * The eigendecomposition costs \f$O(n^3)\f$ operations and \f$O(n^2)\f$
+     * memory (regardless of the type of \f$Q\f$), so it pays off when many
+     * different values of \f$\gamma\f$ are used. Only the lower triangular 
+     * part of \f$Q\f$ is considered.
+     * 
+     * @return status code; \link ForBESUtils::STATUS_UNDEFINED_FUNCTION 
+     * STATUS_UNDEFINED_FUNCTION\endlink if \f$Q\f$ has not been set and
+     * \link ForBESUtils::STATUS_NUMERICAL_PROBLEMS STATUS_NUMERICAL_PROBLEMS\endlink
+     * if the eigenvalue algorithm failed to converge
+     */
+    int computeEigendecomposition();
+
     /**
      * Setter method for vector \f$q\f$
      * @param q Vector \c q
@@ -188,6 +252,24 @@ private:
     bool m_is_Q_eye; /**< TRUE if Q is the identity matrix */
     bool m_is_q_zero; /**< TRUE is q is the zero vector */
     bool m_delete_Q; /**< Whether to delete Q in the destructor */
+    FactorizationCache *m_cache; /**< Factorizations of I + gamma*Q */
+    bool m_delete_cache; /**< Whether m_cache is owned by this function */
+    unsigned long m_version; /**< Version of Q (in m_cache) */
+    Matrix *m_eig_V; /**< Eigenvectors of Q (or NULL) */
+    Matrix *m_eig_values; /**< Eigenvalues of Q (or NULL) */
+
+    /**
+     * Factorization of \f$I+\gamma Q\f$ from the cache; if it is not in the 
+     * cache, it is computed and inserted into it. Returns <code>NULL</code> 
+     * if \f$I+\gamma Q\f$ cannot be factorized (e.g., if its type is not
+     * supported).
+     */
+    FactoredSolver * proxSolver(double gamma);
+
+    /**
+     * Discards the factorizations and the eigendecomposition of Q.
+     */
+    void resetQ();
 
     /**
      * Computes the gradient of this function at a given vector x. 
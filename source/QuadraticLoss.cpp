@@ -58,13 +58,13 @@ int QuadraticLoss::call(Matrix& x, double& f) {
     f = 0.0;
     for (size_t j = 0; j < x.getNrows(); j++) {
         double fi;
-        fi = x[j];
+        fi = x.get(j);
         if (!m_is_zero_p) {
-            fi -= m_p->getData()[j];
+            fi -= m_p->get(j);
         }
         fi *= fi;
         if (!m_is_uniform_weights) {
-            fi *= m_w->getData()[j];
+            fi *= m_w->get(j);
         }
         f += fi;
     }
@@ -80,14 +80,14 @@ int QuadraticLoss::call(Matrix& x, double& f, Matrix& grad) {
     for (size_t j = 0; j < x.getNrows(); j++) {
         double fi;
         double gi;
-        fi = x[j];
+        fi = x.get(j);
         if (!m_is_zero_p) {
-            fi -= m_p->getData()[j];
+            fi -= m_p->get(j);
         }
         gi = fi;
         fi *= fi;
         if (!m_is_uniform_weights) {
-            double w = m_w->getData()[j];
+            double w = m_w->get(j);
             fi *= w;
             gi *= w;
         }
@@ -104,8 +104,8 @@ int QuadraticLoss::call(Matrix& x, double& f, Matrix& grad) {
 int QuadraticLoss::callConj(Matrix& x, double& f_star) {
     f_star = 0.0;
     for (size_t i = 0; i < x.getNrows(); i++) {
-        f_star += x[i]*(2.0 * (m_is_zero_p ? 0.0 : m_p->get(i))
-                + (x[i] / (m_is_uniform_weights ? m_uniform_w : m_w->get(i))));
+        f_star += x.get(i)*(2.0 * (m_is_zero_p ? 0.0 : m_p->get(i))
+                + (x.get(i) / (m_is_uniform_weights ? m_uniform_w : m_w->get(i))));
     }
     f_star /= 2.0;
     return ForBESUtils::STATUS_OK;
@@ -117,9 +117,9 @@ int QuadraticLoss::callConj(Matrix& x, double& f_star, Matrix& grad) {
         double gradi;
         double pi;
         pi = m_is_zero_p ? 0.0 : m_p->get(i);
-        gradi = pi + x[i] / (m_is_uniform_weights ? m_uniform_w : m_w->get(i));
+        gradi = pi + x.get(i) / (m_is_uniform_weights ? m_uniform_w : m_w->get(i));
         grad.set(i, 0, gradi);
-        f_star += x[i]*(gradi + pi);
+        f_star += x.get(i)*(gradi + pi);
     }
     f_star /= 2.0;
     return ForBESUtils::STATUS_OK;
@@ -19,6 +19,7 @@
  */
 
 #include "QuadraticLossOverAffine.h"
+#include "MatrixExpression.h"
 #include <cmath>
 
 QuadraticLossOverAffine::QuadraticLossOverAffine(Matrix& A, Matrix& b, Matrix& w, Matrix& p) {
@@ -69,19 +70,25 @@ int QuadraticLossOverAffine::callConj(Matrix& y, double& f_star, Matrix& grad) {
     for (size_t i = 0; i < ny; i++) {
         sigma[i] =  y[i] / m_w->get(i) + m_p->get(i);
     }
-    Matrix h = (*m_A) * sigma - (*m_b);
+    Matrix h(m_A->getNrows(), 1);
+    int status = evaluate(h, lazy(*m_A) * lazy(sigma) - lazy(*m_b)); /* h = A*sigma - b */
+    if (!ForBESUtils::is_status_ok(status)) {
+        return status;
+    }
     Matrix q;
-    int status = m_solver -> solve(h, q);
+    status = m_solver -> solve(h, q);
     if (ForBESUtils::STATUS_OK != status) {
         return status;
     }
-    m_A->transpose();
-    Matrix c = (*m_A) * q;
-    m_A->transpose();
+    Matrix c(m_A->getNcols(), 1);
+    status = Matrix::mult(c, 1.0, *m_A, q, 0.0, true); /* c = A'*q */
+    if (!ForBESUtils::is_status_ok(status)) {
+        return status;
+    }
     for (size_t i = 0; i < ny; i++) {
         grad[i] = sigma[i] - c[i] / m_w->get(i);
     }
-    f_star = (grad *  (y))[0];
+    f_star = dot(lazy(grad), lazy(y));
     return ForBESUtils::STATUS_OK;
 }
 
@@ -20,43 +20,109 @@
 
 #include "S_LDLFactorization.h"
 
+#include <algorithm>
+
 Matrix S_LDLFactorization::multiply_AAtr_betaI(Matrix& A, double beta) {
     size_t n = A.getNrows();
     size_t m = A.getNcols();
-    Matrix result(n, n, Matrix::MATRIX_SYMMETRIC);
-
-    for (size_t i = 0; i < n; i++) {
-        for (size_t j = 0; j <= i; j++) {
-            result.set(i, j, 0.0);
-            for (size_t k = 0; k < m; k++) {
-                result.set(i, j, result.get(i, j) + A.get(i, k) * A.get(j, k));
-            }
-            if (i == j) {
-                result.set(i, j, result.get(i, j) + beta);
-            }
+    Matrix result(n, n);
+    /* lower triangle of AA' (A is stored either as it is or as A') */
+    cblas_dsyrk(CblasColMajor, CblasLower, A.m_transpose ? CblasTrans : CblasNoTrans,
+            n, m, 1.0, A.m_data, std::max<size_t>(A.m_ld, 1), 0.0, result.m_data, n);
+    for (size_t j = 0; j < n; j++) {
+        result.m_data[j + j * n] += beta;
+        for (size_t i = j + 1; i < n; i++) {
+            result.m_data[j + i * n] = result.m_data[i + j * n];
         }
     }
     return result;
 }
 
-S_LDLFactorization::S_LDLFactorization(Matrix& matrix, double beta) : FactoredSolver(matrix), m_beta(beta) {
+S_LDLFactorization::S_LDLFactorization(Matrix& matrix, double beta, bool augmented) :
+FactoredSolver(matrix), m_beta(beta), m_augmented(augmented && matrix.getType() == Matrix::MATRIX_SPARSE) {
     m_factor = NULL;
     m_delegated_solver = NULL;
+    if (m_augmented) {
+        /* K is quasi-definite: it has an LDL' factorization, but not an LL' one */
+        m_cholmod.handle()->supernodal = CHOLMOD_SIMPLICIAL;
+        m_cholmod.handle()->final_ll = false;
+    }
+}
+
+cholmod_sparse * S_LDLFactorization::augmented_matrix() {
+    cholmod_common * common = m_cholmod.handle();
+    size_t n = m_matrix_nrows;
+    size_t m = m_matrix_ncols;
+    /* the CSC of A', i.e., the rows of A */
+    cholmod_sparse * At = m_matrix->_sparseOp(!m_matrix->m_transpose);
+    cholmod_sparse * At_full = (At->stype == 0) ? At : cholmod_copy(At, 0, 1, common);
+    const int * Atp = static_cast<const int*> (At_full->p);
+    const int * Ati = static_cast<const int*> (At_full->i);
+    const int * Atnz = static_cast<const int*> (At_full->nz);
+    const double * Atx = static_cast<const double*> (At_full->x);
+
+    /* lower triangle of K = [beta*I A; A' -I] */
+    size_t nnz = n + m + cholmod_nnz(At_full, common);
+    cholmod_sparse * K = cholmod_allocate_sparse(n + m, n + m, nnz, true, true, -1, CHOLMOD_REAL, common);
+    int * Kp = static_cast<int*> (K->p);
+    int * Ki = static_cast<int*> (K->i);
+    double * Kx = static_cast<double*> (K->x);
+    int idx = 0;
+    for (size_t j = 0; j < n; j++) {
+        Kp[j] = idx;
+        Ki[idx] = j;
+        Kx[idx++] = m_beta;
+        int end = At_full->packed ? Atp[j + 1] : Atp[j] + Atnz[j];
+        for (int p = Atp[j]; p < end; p++) {
+            Ki[idx] = n + Ati[p];
+            Kx[idx++] = Atx[p];
+        }
+    }
+    for (size_t j = n; j < n + m; j++) {
+        Kp[j] = idx;
+        Ki[idx] = j;
+        Kx[idx++] = -1.0;
+    }
+    Kp[n + m] = idx;
+
+    if (At_full != At) {
+        cholmod_free_sparse(&At_full, common);
+    }
+    if (At != m_matrix->m_sparse) {
+        cholmod_free_sparse(&At, Matrix::cholmod_handle());
+    }
+    return K;
 }
 
 int S_LDLFactorization::factorize() {
+    if (m_augmented) {
+        cholmod_sparse * K = augmented_matrix();
+        if (m_factor != NULL) {
+            cholmod_free_factor(&m_factor, m_cholmod.handle());
+        }
+        m_factor = cholmod_analyze(K, m_cholmod.handle());
+        _savePattern(K);
+        cholmod_factorize(K, m_factor, m_cholmod.handle());
+        cholmod_free_sparse(&K, m_cholmod.handle());
+        return (m_factor->minor == m_factor->n) ? ForBESUtils::STATUS_OK : ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+    }
     if (m_matrix_type == Matrix::MATRIX_SPARSE) {
         double beta_temp[2];
         beta_temp[0] = m_beta;
         beta_temp[1] = 0.0;
 
-        if (m_matrix->m_sparse == NULL) {
-            m_matrix->_createSparse();
+        /* the CSC of the matrix as it is stored is transposed only if needed */
+        cholmod_sparse * A = m_matrix->_sparseOp(m_matrix->m_transpose);
+        A->stype = 0;
+        if (m_factor != NULL) {
+            cholmod_free_factor(&m_factor, m_cholmod.handle());
+        }
+        m_factor = cholmod_analyze(A, m_cholmod.handle());
+        _savePattern(A);
+        cholmod_factorize_p(A, beta_temp, NULL, 0, m_factor, m_cholmod.handle());
+        if (A != m_matrix->m_sparse) {
+            cholmod_free_sparse(&A, Matrix::cholmod_handle());
         }
-
-        m_matrix->m_sparse->stype = 0;
-        m_factor = cholmod_analyze(m_matrix->m_sparse, Matrix::cholmod_handle());
-        cholmod_factorize_p(m_matrix->m_sparse, beta_temp, NULL, 0, m_factor, Matrix::cholmod_handle());
         return (m_factor->minor == m_matrix->m_nrows) ? ForBESUtils::STATUS_OK : ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
     } else if (m_matrix_type == Matrix::MATRIX_DENSE) {
         /* 
@@ -65,6 +131,10 @@ int S_LDLFactorization::factorize() {
          * 1. A is short (more columns than rows)
          * 2. A is tall  (more rows than columns)
          */
+        if (m_delegated_solver != NULL) {
+            delete m_delegated_solver;
+            m_delegated_solver = NULL;
+        }
         if (m_matrix->getNrows() <= m_matrix->getNcols()) {
             /* this is a ###SHORT### matrix */
             /*
@@ -95,20 +165,85 @@ int S_LDLFactorization::factorize() {
     }
 }
 
+int S_LDLFactorization::refactorize() {
+    if (m_matrix_type != Matrix::MATRIX_SPARSE || m_factor == NULL) {
+        return factorize();
+    }
+    if (m_augmented) {
+        cholmod_sparse * K = augmented_matrix();
+        bool same_pattern = _hasSavedPattern(K);
+        if (same_pattern) {
+            cholmod_factorize(K, m_factor, m_cholmod.handle());
+        }
+        cholmod_free_sparse(&K, m_cholmod.handle());
+        if (!same_pattern) {
+            return factorize();
+        }
+        return (m_factor->minor == m_factor->n) ? ForBESUtils::STATUS_OK : ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+    }
+    cholmod_sparse * A = m_matrix->_sparseOp(m_matrix->m_transpose);
+    A->stype = 0;
+    bool same_pattern = _hasSavedPattern(A);
+    if (same_pattern) {
+        /* numeric factorization of AA' + beta*I only (the symbolic factor is reused) */
+        double beta_temp[2];
+        beta_temp[0] = m_beta;
+        beta_temp[1] = 0.0;
+        cholmod_factorize_p(A, beta_temp, NULL, 0, m_factor, m_cholmod.handle());
+    }
+    if (A != m_matrix->m_sparse) {
+        cholmod_free_sparse(&A, Matrix::cholmod_handle());
+    }
+    if (!same_pattern) {
+        return factorize(); /* new pattern: analyze again */
+    }
+    return (m_factor->minor == m_matrix->m_nrows) ? ForBESUtils::STATUS_OK : ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+}
+
+int S_LDLFactorization::refactorize(double beta) {
+    m_beta = beta;
+    return refactorize();
+}
+
+int S_LDLFactorization::update(Matrix& C) {
+    return updown(true, C);
+}
+
+int S_LDLFactorization::downdate(Matrix& C) {
+    return updown(false, C);
+}
+
+int S_LDLFactorization::updown(bool update, Matrix& C) {
+    if (C.getNrows() != m_matrix_nrows) {
+        throw std::invalid_argument("C must have as many rows as A");
+    }
+    if (m_matrix_type != Matrix::MATRIX_SPARSE || m_augmented) {
+        throw std::logic_error("[uoe] Updates are only supported for sparse matrices (without augmentation)");
+    }
+    if (m_factor == NULL) {
+        throw std::logic_error(__FCT_MISS_EXCPT);
+    }
+    return _updownFactor(update, C, m_factor, m_cholmod.handle());
+}
+
 int S_LDLFactorization::solve(Matrix& rhs, Matrix& solution) {
-    solution = Matrix(rhs.m_nrows, rhs.m_ncols);
+    if (&rhs == &solution) {
+        Matrix rhs_copy(rhs); /* shares the data of rhs until solution is written */
+        return solve(rhs_copy, solution);
+    }
     if (m_matrix_type == Matrix::MATRIX_SPARSE) {
         if (m_factor == NULL) {
             throw std::invalid_argument(__FCT_MISS_EXCPT);
         }
-        cholmod_dense *b;
-        cholmod_dense *x;
-        b = cholmod_allocate_dense(rhs.m_nrows, rhs.m_ncols, rhs.m_nrows, CHOLMOD_REAL, Matrix::cholmod_handle());
-        b->x = rhs.m_data;
-        x = cholmod_solve(CHOLMOD_A, m_factor, b, Matrix::cholmod_handle());
-        solution.m_delete_data = false;
-        memcpy(solution.m_data, static_cast<double*> (x->x), rhs.m_nrows * rhs.m_ncols * sizeof (double));
-        cholmod_free_dense(&x, Matrix::cholmod_handle());
+        /* solve directly into the storage of solution (reused if possible) */
+        _prepareSolution(solution, rhs.m_nrows, rhs.m_ncols);
+        const double * b = _rhsData(rhs, solution);
+        if (m_augmented) {
+            return solve_augmented(b, rhs.m_ncols, solution.m_data);
+        }
+        if (!m_cholmod.solve(CHOLMOD_A, m_factor, rhs.m_ncols, b, solution.m_data)) {
+            return ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+        }
         return ForBESUtils::STATUS_OK;
     } else if (m_matrix_type == Matrix::MATRIX_DENSE) {
         if (m_delegated_solver == NULL) {
@@ -120,18 +255,19 @@ int S_LDLFactorization::solve(Matrix& rhs, Matrix& solution) {
             return status;
         } else {
             /* m_matrix is ~~~TALL~~~ and dense */
-            m_matrix->transpose();
-            Matrix temp = (*m_matrix) * const_cast<Matrix&>(rhs);
-            m_matrix->transpose();
-            Matrix c;
-            int status = m_delegated_solver->solve(temp, c);
+            _prepareSolution(m_work_rhs, m_matrix->getNcols(), rhs.getNcols());
+            int status = Matrix::mult(m_work_rhs, 1.0, *m_matrix, rhs, 0.0, true);
+            if (!ForBESUtils::is_status_ok(status)) {
+                return status;
+            }
+            status = m_delegated_solver->solve(m_work_rhs, m_work_sol);
             if (status != ForBESUtils::STATUS_OK){
                 return status;
             }
-            solution = *m_matrix * c - rhs;
-            double beta_inv = -1.0/m_beta;
-            solution *= beta_inv;
-            return ForBESUtils::STATUS_OK;
+            /* solution = (rhs - A*c)/beta */
+            double beta_inv = 1.0 / m_beta;
+            _copyRhs(rhs, solution);
+            return Matrix::mult(solution, -beta_inv, *m_matrix, m_work_sol, beta_inv);
         }
 
     } else {
@@ -139,9 +275,28 @@ int S_LDLFactorization::solve(Matrix& rhs, Matrix& solution) {
     }
 }
 
+int S_LDLFactorization::solve_augmented(const double * b, size_t ncols, double * x) {
+    /* K [x; y] = [b; 0] */
+    size_t n = m_matrix_nrows;
+    size_t dim = m_factor->n;
+    _prepareSolution(m_work_rhs, dim, ncols);
+    double * z = m_work_rhs.m_data;
+    for (size_t j = 0; j < ncols; j++) {
+        memcpy(z + j * dim, b + j * n, n * sizeof (double));
+        std::fill(z + j * dim + n, z + (j + 1) * dim, 0.0);
+    }
+    if (!m_cholmod.solve(CHOLMOD_A, m_factor, ncols, z, z)) {
+        return ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+    }
+    for (size_t j = 0; j < ncols; j++) {
+        memcpy(x + j * n, z + j * dim, n * sizeof (double));
+    }
+    return ForBESUtils::STATUS_OK;
+}
+
 S_LDLFactorization::~S_LDLFactorization() {
     if (m_factor != NULL) {
-        cholmod_free_factor(&m_factor, Matrix::cholmod_handle());
+        cholmod_free_factor(&m_factor, m_cholmod.handle());
         m_factor = NULL;
     }
     if (m_delegated_solver != NULL) {
@@ -77,8 +77,29 @@
  * \f]
  * which is determined using the LDL factorization of \f$\tilde{F}\f$.
  * 
+ * For dense matrices, \f$AA^{\top}\f$ (or \f$A^{\top}A\f$) is computed 
+ * with the level-3 BLAS routine <code>dsyrk</code>. Sparse matrices are passed
+ * to CHOLMOD, which computes the factorization of \f$AA^{\top}+\beta I\f$ 
+ * without forming \f$AA^{\top}\f$ explicitly.
+ * 
+ * If \f$AA^{\top}\f$ is considerably denser than \f$A\f$ (e.g., when \f$A\f$
+ * has a few dense columns), it is preferable to factorize the augmented matrix
+ * 
+ * \f[
+ *  K = \begin{bmatrix}\beta I & A\\ A^{\top} & -I\end{bmatrix},
+ * \f]
+ * 
+ * which has as many nonzeros as \f$A\f$ (plus its diagonal). Since \f$K\f$ is
+ * quasi-definite, it has an \f$LDL^{\top}\f$ factorization for every 
+ * fill-reducing ordering, and the solution of \f$Fz=t\f$ is given by the first
+ * \f$n\f$ elements of the solution of \f$K(z, y) = (t, 0)\f$. This is enabled
+ * by passing <code>augmented = true</code> to the constructor (for sparse 
+ * matrices only).
+ * 
  * This class is powered by <a href="http://faculty.cse.tamu.edu/davis/suitesparse.html">SuiteSparse</a> 
- * for sparse matrices.
+ * for sparse matrices; each factorization owns its CHOLMOD workspace (see 
+ * CholmodContext), so different factorizations may be used by different
+ * threads concurrently.
  */
 class S_LDLFactorization : public FactoredSolver {
 public:
@@ -88,13 +109,77 @@ public:
      * 
      * @param matrix Any matrix of type <code>MATRIX_DENSE</code> or <code>MATRIX_SPARSE</code>
      * @param beta A positive scalar
+     * @param augmented whether to factorize the augmented matrix \f$K\f$ instead
+     * of \f$AA^{\top}+\beta I\f$ (sparse matrices only; ignored otherwise)
      */
-    S_LDLFactorization(Matrix& matrix, double beta);
+    S_LDLFactorization(Matrix& matrix, double beta, bool augmented = false);
 
     virtual ~S_LDLFactorization();
 
     virtual int factorize();
 
+    using FactoredSolver::refactorize;
+
+    /**
+     * Recomputes the factorization of \f$AA^{\top}+\beta I\f$ after the values
+     * of \f$A\f$ have changed.
+     * 
+     * If \f$A\f$ is sparse and its sparsity pattern has not changed, the 
+     * symbolic analysis (fill-reducing ordering and pattern of the factor) of
+     * the previous factorization is reused and only the numeric factorization
+     * is computed again; otherwise, this is the same as #factorize.
+     * 
+     * @return status code (see #factorize)
+     */
+    virtual int refactorize(void);
+
+    /**
+     * Recomputes the factorization for a new value of \f$\beta\f$, i.e., it
+     * factorizes \f$AA^{\top}+\beta I\f$ reusing the symbolic analysis of 
+     * the previous factorization (see #refactorize()).
+     * 
+     * @param beta new value of \f$\beta\f$
+     * @return status code (see #factorize)
+     */
+    int refactorize(double beta);
+
+    /**
+     * Updates the factorization of \f$F=AA^{\top}+\beta I\f$ so that it becomes
+     * a factorization of \f$F+CC^{\top}\f$, where \f$C\f$ has as many rows 
+     * as \f$A\f$, using <code>cholmod_updown</code>. This is equivalent to 
+     * appending the columns of \f$C\f$ to \f$A\f$, but does not require that
+     * the factorization be computed from scratch.
+     * 
+     * Matrix \f$A\f$ is not modified; a subsequent call to #factorize or 
+     * #refactorize will discard all updates.
+     * 
+     * @param C matrix \f$C\f$ (of any type)
+     * @return status code (see #factorize)
+     * 
+     * \exception std::invalid_argument if \f$C\f$ has incompatible dimensions
+     * \exception std::logic_error if \f$A\f$ is not sparse, or it has not
+     * been factorized
+     * 
+     * \sa #downdate
+     */
+    int update(Matrix& C);
+
+    /**
+     * Updates the factorization of \f$F=AA^{\top}+\beta I\f$ so that it becomes
+     * a factorization of \f$F-CC^{\top}\f$ (see #update). If this matrix is not
+     * positive definite, the method returns 
+     * \link ForBESUtils::STATUS_NUMERICAL_PROBLEMS STATUS_NUMERICAL_PROBLEMS\endlink
+     * and the factorization needs to be recomputed.
+     * 
+     * @param C matrix \f$C\f$ (of any type)
+     * @return status code (see #factorize)
+     * 
+     * \exception std::invalid_argument if \f$C\f$ has incompatible dimensions
+     * \exception std::logic_error if \f$A\f$ is not sparse, or it has not
+     * been factorized
+     */
+    int downdate(Matrix& C);
+
     /**
      * Computes the solution of the linear system
      * 
@@ -187,10 +272,18 @@ private:
      * A cholmod_factor used when m_matrix is sparse
      */
     cholmod_factor * m_factor;
+    /**
+     * CHOLMOD workspace of this factorization (see CholmodContext)
+     */
+    CholmodContext m_cholmod;
     /**
      * Scalar beta
      */
     double m_beta;
+    /**
+     * Whether the augmented matrix K is factorized (sparse matrices only)
+     */
+    bool m_augmented;
     
     /**
      * A delegated LDL solver (used when m_matrix is dense)
@@ -198,15 +291,37 @@ private:
     FactoredSolver * m_delegated_solver;
 
     /**
-     * Performs AA'+beta*I for dense matrices. The result will be a 
-     * symmetric matrix (type <code>MATRIX_SYMMETRIC</code>).
+     * Workspaces of #solve for tall dense matrices (reused between calls)
+     */
+    Matrix m_work_rhs;
+    Matrix m_work_sol;
+
+    /**
+     * Performs AA'+beta*I for dense matrices using <code>dsyrk</code>. The 
+     * result will be a (symmetric) matrix of type <code>MATRIX_DENSE</code>.
      * 
-     * @param A given matrix
+     * @param A given dense matrix
      * @param beta scalar beta
-     * @return matrix AA'
+     * @return matrix AA'+beta*I
      */
     static Matrix multiply_AAtr_betaI(Matrix& A, double beta);
 
+    /**
+     * The lower triangular part of the augmented matrix K = [beta*I A; A' -I]
+     * as a CHOLMOD sparse matrix (to be freed by the caller).
+     */
+    cholmod_sparse * augmented_matrix();
+
+    /**
+     * Solves Fx = b using the factorization of the augmented matrix K.
+     */
+    int solve_augmented(const double * b, size_t ncols, double * x);
+
+    /**
+     * Rank-k update (or downdate) of the factor, F := F + CC' (or F - CC').
+     */
+    int updown(bool update, Matrix& C);
+
 };
 
 #endif	/* LDLFACTORIZATION_AAT_H */
@@ -19,11 +19,35 @@
  */
 
 #include "SeparableSum.h"
+#include "MatrixFactory.h"
 #include <iostream>
 
 
 void prepare_cx(std::vector<size_t> * c_idx, const Matrix& x, Matrix * c_x);
 
+/* whether x(idx) is a contiguous slice of x, i.e., idx = {i0, i0+1, ..., i0+n-1} */
+static bool is_slice(const std::vector<size_t>& idx, const Matrix& x) {
+    if (idx.empty() || x.getType() != Matrix::MATRIX_DENSE || !x.isContiguous()) {
+        return false;
+    }
+    for (size_t k = 1; k < idx.size(); k++) {
+        if (idx[k] != idx[0] + k) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/* x(idx): a shallow vector if it is a contiguous slice of x, otherwise a copy */
+static Matrix sub_vector(std::vector<size_t> * idx, Matrix& x) {
+    if (is_slice(*idx, x)) {
+        return MatrixFactory::ShallowVector(x, idx->size(), idx->front());
+    }
+    Matrix c_x(idx->size(), 1);
+    prepare_cx(idx, x, &c_x);
+    return c_x;
+}
+
 SeparableSum::~SeparableSum() {
 }
 
@@ -48,9 +72,6 @@ int SeparableSum::call(Matrix& x, double& f) {
     }
     //LCOV_EXCL_STOP
 
-    /* sub-matrix */
-    Matrix *c_x = NULL;
-
     /* initialization of result f(x) */
     f = 0.0;
 
@@ -75,28 +96,18 @@ int SeparableSum::call(Matrix& x, double& f) {
         /* Function indices         */
         c_idx = map_iterator->second;
 
-        /* initialize new sub-matrix */
-        c_x = new Matrix(c_idx->size(), 1);
-
-        /* iterator for the indices of c_fun */
-        prepare_cx(c_idx, x, c_x);
+        /* sub-vector x(c_idx) (not copied if it is a slice of x) */
+        Matrix c_x = sub_vector(c_idx, x);
 
         /* invoke sub-function on c_x, return f_temp */
-        status = c_fun -> call(*c_x, f_temp);
+        status = c_fun -> call(c_x, f_temp);
         //LCOV_EXCL_START
         if (ForBESUtils::STATUS_OK != status) {
-            delete c_x;
-            c_x = NULL;
             return status;
         }
         //LCOV_EXCL_STOP
         f += f_temp;
     }
-
-    if (c_x != NULL) {
-        delete c_x;
-        c_x = NULL;
-    }
     return ForBESUtils::STATUS_OK;
 }
 
@@ -111,35 +122,35 @@ int SeparableSum::callProx(Matrix& x, double gamma, Matrix& prox) {
     }
     //LCOV_EXCL_STOP
 
-    Matrix *c_x = NULL;
-    Matrix *c_prox = NULL;
-
+    const Matrix& cx = x;
+    const Matrix& cprox = prox;
     for (std::map<Function*, std::vector<size_t> * >::iterator map_iterator = m_fun_idx_map.begin()
             ; map_iterator != m_fun_idx_map.end()
             ; ++map_iterator) {
         Function * c_fun = map_iterator->first;
         std::vector<size_t> * c_idx = map_iterator->second;
-        c_x = new Matrix(c_idx->size(), 1);
-        prepare_cx(c_idx, x, c_x);
-
-        c_prox = new Matrix(c_idx->size(), 1);
-        int status = c_fun -> callProx(*c_x, gamma, *c_prox);
+        Matrix c_x = sub_vector(c_idx, x);
+
+        /* if prox(c_idx) is a slice of prox (and x is not prox), the prox is computed in place */
+        bool in_place = is_slice(*c_idx, prox) && cx.getData() != cprox.getData();
+        Matrix c_prox = in_place
+                ? MatrixFactory::ShallowVector(prox, c_idx->size(), c_idx->front())
+                : Matrix(c_idx->size(), 1);
+        int status = c_fun -> callProx(c_x, gamma, c_prox);
         //LCOV_EXCL_START
         if (ForBESUtils::STATUS_OK != status) {
-            delete c_x;
-            delete c_prox;
             return status;
         }
         //LCOV_EXCL_STOP
-        size_t k = 0;
-        std::vector<size_t>::iterator idx_iterator;
-        for (idx_iterator = c_idx->begin(); idx_iterator != c_idx->end(); ++idx_iterator) {
-            prox.set(*idx_iterator, 0, c_prox->get(k, 0));
-            k++;
+        if (!in_place) {
+            size_t k = 0;
+            std::vector<size_t>::iterator idx_iterator;
+            for (idx_iterator = c_idx->begin(); idx_iterator != c_idx->end(); ++idx_iterator) {
+                prox.set(*idx_iterator, 0, c_prox.get(k, 0));
+                k++;
+            }
         }
     }
-    delete c_x;
-    delete c_prox;
     return ForBESUtils::STATUS_OK;
 }
 
@@ -157,28 +168,21 @@ int SeparableSum::callConj(Matrix& x, double& f_star) {
 
     std::map<Function*, std::vector<size_t> * >::iterator map_iterator;
     Function * c_fun = NULL;
-    Matrix *c_x = NULL;
 
     for (map_iterator = m_fun_idx_map.begin(); map_iterator != m_fun_idx_map.end(); ++map_iterator) {
         std::vector<size_t> * c_idx = NULL;
         c_fun = map_iterator->first; // current function
         c_idx = map_iterator->second; // current index set I
-        c_x = new Matrix(c_idx->size(), 1); // prepare current vector
-        prepare_cx(c_idx, x, c_x);
+        Matrix c_x = sub_vector(c_idx, x); // prepare current vector
 
         double f_star_temp;
-        int status = c_fun -> callConj(*c_x, f_star_temp);
+        int status = c_fun -> callConj(c_x, f_star_temp);
         //LCOV_EXCL_START
         if (ForBESUtils::STATUS_OK != status) {
-            delete c_x;
             return status;
         }
         f_star += f_star_temp;
     }
-    if (c_x != NULL) {
-        delete c_x;
-        c_x = NULL;
-    }
     return ForBESUtils::STATUS_UNDEFINED_FUNCTION;
 }
 
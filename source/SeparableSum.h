@@ -60,6 +60,7 @@
 class SeparableSum : public Function {
 public:    
     using Function::call;
+    using Function::callProx;
     using Function::callConj;
 
     virtual ~SeparableSum();
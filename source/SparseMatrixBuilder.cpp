@@ -0,0 +1,111 @@
+/*
+ * File:   SparseMatrixBuilder.cpp
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 10:12 AM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SparseMatrixBuilder.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+SparseMatrixBuilder::SparseMatrixBuilder(size_t nrows, size_t ncols, Matrix::SparseMatrixType stype) {
+    if (stype != Matrix::SPARSE_UNSYMMETRIC && nrows != ncols) {
+        throw std::invalid_argument("Symmetric sparse matrices must be square");
+    }
+    m_nrows = nrows;
+    m_ncols = ncols;
+    m_stype = stype;
+}
+
+SparseMatrixBuilder::~SparseMatrixBuilder() {
+}
+
+void SparseMatrixBuilder::reserve(size_t nnz) {
+    m_i.reserve(nnz);
+    m_j.reserve(nnz);
+    m_x.reserve(nnz);
+    m_index.reserve(nnz);
+}
+
+void SparseMatrixBuilder::_canonicalIndex(size_t& i, size_t& j) const {
+    if (i >= m_nrows || j >= m_ncols) {
+        throw std::out_of_range("Index out of range!");
+    }
+    if ((m_stype > 0 && i > j) || (m_stype < 0 && i < j)) {
+        std::swap(i, j); /* only one triangle is stored */
+    }
+}
+
+size_t SparseMatrixBuilder::_position(size_t i, size_t j) {
+    std::pair < std::unordered_map<size_t, size_t>::iterator, bool> ins =
+            m_index.insert(std::make_pair(j * m_nrows + i, m_x.size()));
+    if (ins.second) { /* new nonzero - the vectors grow geometrically */
+        m_i.push_back(static_cast<int> (i));
+        m_j.push_back(static_cast<int> (j));
+        m_x.push_back(0.0);
+    }
+    return ins.first->second;
+}
+
+void SparseMatrixBuilder::set(size_t i, size_t j, double v) {
+    _canonicalIndex(i, j);
+    m_x[_position(i, j)] = v;
+}
+
+void SparseMatrixBuilder::add(size_t i, size_t j, double v) {
+    _canonicalIndex(i, j);
+    m_x[_position(i, j)] += v;
+}
+
+double SparseMatrixBuilder::get(size_t i, size_t j) const {
+    _canonicalIndex(i, j);
+    std::unordered_map<size_t, size_t>::const_iterator it = m_index.find(j * m_nrows + i);
+    return (it != m_index.end()) ? m_x[it->second] : 0.0;
+}
+
+size_t SparseMatrixBuilder::nnz() const {
+    return m_x.size();
+}
+
+Matrix SparseMatrixBuilder::build() const {
+    size_t nnz = m_x.size();
+    cholmod_triplet * triplet = cholmod_allocate_triplet(m_nrows, m_ncols, std::max(nnz, static_cast<size_t> (1)),
+            m_stype, CHOLMOD_REAL, Matrix::cholmod_handle());
+    if (nnz > 0) {
+        std::copy(m_i.begin(), m_i.end(), static_cast<int*> (triplet->i));
+        std::copy(m_j.begin(), m_j.end(), static_cast<int*> (triplet->j));
+        std::copy(m_x.begin(), m_x.end(), static_cast<double*> (triplet->x));
+    }
+    triplet->nnz = nnz;
+    /* there are no duplicates, so the CSC has exactly nnz entries */
+    cholmod_sparse * sparse = cholmod_triplet_to_sparse(triplet, nnz, Matrix::cholmod_handle());
+    cholmod_free_triplet(&triplet, Matrix::cholmod_handle());
+
+    Matrix mat(m_nrows, m_ncols, Matrix::MATRIX_SPARSE);
+    mat.m_sparse = sparse;
+    mat.m_sparse_dirty = false;
+    mat.m_sparseStorageType = Matrix::CHOLMOD_TYPE_SPARSE;
+    return mat;
+}
+
+void SparseMatrixBuilder::clear() {
+    m_i.clear();
+    m_j.clear();
+    m_x.clear();
+    m_index.clear();
+}
@@ -0,0 +1,164 @@
+/*
+ * File:   SparseMatrixBuilder.h
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 10:12 AM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SPARSEMATRIXBUILDER_H
+#define	SPARSEMATRIXBUILDER_H
+
+#include "Matrix.h"
+
+#include <vector>
+#include <unordered_map>
+
+/**
+ * \class SparseMatrixBuilder
+ * \brief Assembles sparse matrices entry by entry.
+ * \version version 0.1
+ * \date Created on October 17, 2026, 10:12 AM
+ * \author ForBES contributors
+ *
+ * Sparse matrices which are constructed by successive calls to
+ * \link Matrix::set Matrix::set\endlink need to look up existing triplets
+ * every time a new nonzero is inserted. SparseMatrixBuilder keeps the triplets
+ * in growable arrays together with a hash index on <code>(i,j)</code>, so that
+ * each of #set, #add and #get takes constant (amortized) time, and compresses
+ * them into a %Matrix in compressed-column form only once, in #build.
+ *
+ * Example:
+ *
+ * \code{.cpp}
+ * SparseMatrixBuilder builder(n, n);
+ * builder.reserve(3 * n);
+ * for (size_t i = 0; i < n; i++) {
+ *     builder.set(i, i, 2.0);
+ *     if (i > 0) builder.set(i, i - 1, -1.0);
+ *     if (i < n - 1) builder.set(i, i + 1, -1.0);
+ * }
+ * Matrix A = builder.build();
+ * \endcode
+ *
+ * For symmetric sparse matrices (see Matrix::SparseMatrixType), only one
+ * triangle is stored: entries <code>(i,j)</code> and <code>(j,i)</code> refer
+ * to the same element.
+ */
+class SparseMatrixBuilder {
+public:
+
+    /**
+     * Creates a new builder for a sparse matrix of given dimensions.
+     *
+     * @param nrows number of rows
+     * @param ncols number of columns
+     * @param stype symmetry type of the matrix to be constructed
+     */
+    SparseMatrixBuilder(size_t nrows, size_t ncols,
+            Matrix::SparseMatrixType stype = Matrix::SPARSE_UNSYMMETRIC);
+
+    virtual ~SparseMatrixBuilder();
+
+    /**
+     * Preallocates memory for (at least) the given number of nonzeros.
+     *
+     * @param nnz expected number of nonzeros
+     */
+    void reserve(size_t nnz);
+
+    /**
+     * Sets the value of an element of the matrix, i.e., \f$A_{ij} \leftarrow v\f$.
+     *
+     * @param i row index
+     * @param j column index
+     * @param v value
+     *
+     * \exception std::out_of_range if the index is out of range
+     */
+    void set(size_t i, size_t j, double v);
+
+    /**
+     * Adds a value to an element of the matrix, i.e., \f$A_{ij} \leftarrow A_{ij} + v\f$.
+     *
+     * @param i row index
+     * @param j column index
+     * @param v value to be added
+     *
+     * \exception std::out_of_range if the index is out of range
+     */
+    void add(size_t i, size_t j, double v);
+
+    /**
+     * Returns the value of an element of the matrix which is under construction.
+     *
+     * @param i row index
+     * @param j column index
+     * @return value of \f$A_{ij}\f$ (zero if it has not been set)
+     *
+     * \exception std::out_of_range if the index is out of range
+     */
+    double get(size_t i, size_t j) const;
+
+    /**
+     * Number of (structurally) nonzero elements which have been set so far.
+     * @return number of nonzeros
+     */
+    size_t nnz() const;
+
+    /**
+     * Constructs a sparse matrix out of the elements which have been set.
+     *
+     * The returned matrix is stored in compressed-column form. The builder
+     * is not modified and may be used to construct more matrices.
+     *
+     * @return sparse matrix
+     */
+    Matrix build() const;
+
+    /**
+     * Removes all elements from this builder.
+     */
+    void clear();
+
+private:
+
+    size_t m_nrows;
+    size_t m_ncols;
+    Matrix::SparseMatrixType m_stype;
+    std::vector<int> m_i;
+    std::vector<int> m_j;
+    std::vector<double> m_x;
+    /**
+     * Maps <code>j * nrows + i</code> to the position of the triplet
+     * <code>(i, j)</code> in #m_i, #m_j and #m_x.
+     */
+    std::unordered_map<size_t, size_t> m_index;
+
+    /**
+     * Position of the triplet which corresponds to <code>(i, j)</code>; a new
+     * (zero) triplet is appended if there is none.
+     */
+    size_t _position(size_t i, size_t j);
+
+    /**
+     * Checks the index and maps it to the stored triangle (for symmetric matrices).
+     */
+    void _canonicalIndex(size_t& i, size_t& j) const;
+
+};
+
+#endif	/* SPARSEMATRIXBUILDER_H */
+
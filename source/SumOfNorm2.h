@@ -78,6 +78,7 @@
 class SumOfNorm2 : public Norm {
 public:
     using Function::call;
+    using Function::callProx;
 
     /**
      * Defines a sum-of-norms function with a given partition length \f$k\f$
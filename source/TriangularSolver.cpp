@@ -0,0 +1,71 @@
+/*
+ * File:   TriangularSolver.cpp
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 6:40 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TriangularSolver.h"
+
+#include <stdexcept>
+#include <cblas.h>
+
+TriangularSolver::TriangularSolver(Matrix& matrix) : MatrixSolver(matrix) {
+    if (matrix.getType() != Matrix::MATRIX_LOWERTR) {
+        throw std::invalid_argument("TriangularSolver can only be applied to lower triangular matrices");
+    }
+}
+
+TriangularSolver::~TriangularSolver() {
+}
+
+int TriangularSolver::solve(Matrix& rhs, Matrix& solution) {
+    if (rhs.getNrows() != m_matrix_nrows) {
+        throw std::invalid_argument("The right-hand side does not have compatible dimensions");
+    }
+    if (rhs.getType() != Matrix::MATRIX_DENSE) {
+        throw std::invalid_argument("The right-hand side must be dense");
+    }
+    /* the system is singular iff a diagonal element is zero */
+    const double * L = m_matrix->m_data;
+    for (size_t i = 0; i < m_matrix_nrows; i++) {
+        if (L[i + m_matrix_nrows * i - i * (i + 1) / 2] == 0.0) {
+            return ForBESUtils::STATUS_NUMERICAL_PROBLEMS;
+        }
+    }
+    size_t ncols = rhs.getNcols();
+    solution = Matrix(m_matrix_nrows, ncols);
+    if (rhs.m_transpose || !rhs.isContiguous()) {
+        for (size_t j = 0; j < ncols; j++) {
+            for (size_t i = 0; i < m_matrix_nrows; i++) {
+                solution.m_data[i + j * m_matrix_nrows] = rhs.get(i, j);
+            }
+        }
+    } else {
+        cblas_dcopy(m_matrix_nrows * ncols, rhs.m_data, 1, solution.m_data, 1);
+    }
+    for (size_t j = 0; j < ncols; j++) {
+        cblas_dtpsv(CblasColMajor,
+                CblasLower,
+                m_matrix->m_transpose ? CblasTrans : CblasNoTrans,
+                CblasNonUnit,
+                m_matrix_nrows,
+                L,
+                solution.m_data + j * m_matrix_nrows,
+                1);
+    }
+    return ForBESUtils::STATUS_OK;
+}
@@ -0,0 +1,86 @@
+/*
+ * File:   TriangularSolver.h
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 6:40 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRIANGULARSOLVER_H
+#define	TRIANGULARSOLVER_H
+
+#include "MatrixSolver.h"
+#include "ForBESUtils.h"
+
+/**
+ * \class TriangularSolver
+ * \brief Solver for triangular linear systems.
+ * \ingroup LinSysSolver-group
+ * \version 0.1
+ * \author ForBES contributors
+ * \date Created on October 17, 2026, 6:40 PM
+ *
+ * Solves linear systems \f$Lx=b\f$, where \f$L\f$ is a matrix of type
+ * <code>MATRIX_LOWERTR</code>, or \f$L^{\top}x=b\f$ if \f$L\f$ is transposed
+ * (i.e., if it is upper triangular). No factorization is needed: the system
+ * is solved by forward (or backward) substitution on the packed storage of
+ * the matrix using <code>dtpsv</code>, at a cost of \f$O(n^2)\f$ operations
+ * per right-hand side.
+ *
+ * \code{.cpp}
+ *  Matrix L = MatrixFactory::MakeRandomMatrix(n, n, 1.0, 1.0, Matrix::MATRIX_LOWERTR);
+ *  Matrix b = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+ *  Matrix x;
+ *  TriangularSolver solver(L);
+ *  int status = solver.solve(b, x); // L * x = b
+ * \endcode
+ *
+ * \note The solver refers to the given matrix, so it must not go out of
+ * scope while the solver is in use.
+ */
+class TriangularSolver : public MatrixSolver {
+public:
+
+    /**
+     * Creates a new triangular solver.
+     *
+     * @param matrix lower triangular matrix (or transpose of a lower triangular
+     * matrix)
+     *
+     * \exception std::invalid_argument if the matrix is not of type
+     * <code>MATRIX_LOWERTR</code>
+     */
+    explicit TriangularSolver(Matrix& matrix);
+
+    virtual ~TriangularSolver();
+
+    /**
+     * Solves the triangular system with one or more right-hand sides.
+     *
+     * @param rhs right-hand side (a dense vector or matrix)
+     * @param solution the solution of the system
+     * @return status code; \link ForBESUtils::STATUS_OK STATUS_OK\endlink if the
+     * system was solved or \link ForBESUtils::STATUS_NUMERICAL_PROBLEMS STATUS_NUMERICAL_PROBLEMS\endlink
+     * if the matrix has a zero diagonal element (and is, therefore, singular)
+     *
+     * \exception std::invalid_argument if the right-hand side does not have
+     * compatible dimensions or is not dense
+     */
+    virtual int solve(Matrix& rhs, Matrix& solution);
+
+};
+
+#endif	/* TRIANGULARSOLVER_H */
+
@@ -0,0 +1,156 @@
+/*
+ * File:   Vector.cpp
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 6:40 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Vector.h"
+#include "MatrixAllocator.h"
+
+#include <cstring>
+#include <stdexcept>
+
+VectorView::VectorView() : m_data(NULL), m_size(0), m_stride(1) {
+}
+
+VectorView::VectorView(double* data, size_t size, size_t stride) :
+m_data(data), m_size(size), m_stride(stride) {
+    if (stride == 0) {
+        throw std::invalid_argument("The stride must be positive");
+    }
+}
+
+VectorView::VectorView(Vector& v) : m_data(v.data()), m_size(v.size()), m_stride(1) {
+}
+
+VectorView::VectorView(Matrix& x) {
+    if (x.getType() != Matrix::MATRIX_DENSE) {
+        throw std::invalid_argument("Only dense vectors can be viewed as VectorView");
+    }
+    if (!x.isColumnVector() && !x.isRowVector()) {
+        throw std::invalid_argument("x must be a vector");
+    }
+    x._expose(); /* the data may be modified through the view */
+    m_data = x.m_data;
+    m_size = x.m_nrows * x.m_ncols;
+    m_stride = x._vectorInc();
+}
+
+VectorView VectorView::segment(size_t offset, size_t size) const {
+    if (offset + size > m_size) {
+        throw std::out_of_range("The segment exceeds the vector");
+    }
+    return VectorView(m_data + offset * m_stride, size, m_stride);
+}
+
+Matrix VectorView::asMatrix() const {
+    /*
+     * A column vector with a non-unit stride is stored as a (transposed) row
+     * whose leading dimension is the stride (see MatrixFactory::ShallowVector)
+     */
+    bool strided = m_stride > 1 && m_size > 1;
+    Matrix x(true);
+    x.m_data = m_data;
+    x.m_dataLength = m_size;
+    x.m_nrows = m_size;
+    x.m_ncols = 1;
+    x.m_transpose = strided;
+    x.m_ld = strided ? m_stride : m_size;
+    x.m_exposed = true;
+    return x;
+}
+
+Matrix VectorView::asContiguousMatrix() const {
+    if (m_stride == 1) {
+        return asMatrix();
+    }
+    Matrix x(m_size, 1);
+    for (size_t i = 0; i < m_size; i++) {
+        x.m_data[i] = m_data[i * m_stride];
+    }
+    return x;
+}
+
+void VectorView::copyFrom(Matrix& x) const {
+    if (x.length() != m_size) {
+        throw std::invalid_argument("The vector and the view have different sizes");
+    }
+    if (x.m_type == Matrix::MATRIX_DENSE && x.m_data == m_data && x._vectorInc() == m_stride) {
+        return; /* x is a view of the same data */
+    }
+    for (size_t i = 0; i < m_size; i++) {
+        m_data[i * m_stride] = x.get(i);
+    }
+}
+
+Vector::Vector() : m_data(NULL), m_size(0) {
+}
+
+Vector::Vector(size_t size) : m_size(size) {
+    m_data = MatrixAllocator::allocate_data(size, true);
+}
+
+Vector::Vector(VectorView v) : m_size(v.size()) {
+    m_data = MatrixAllocator::allocate_data(m_size, false);
+    for (size_t i = 0; i < m_size; i++) {
+        m_data[i] = v[i];
+    }
+}
+
+Vector::Vector(const Vector& orig) : m_size(orig.m_size) {
+    m_data = NULL;
+    if (orig.m_data != NULL) {
+        m_data = MatrixAllocator::allocate_data(m_size, false);
+        memcpy(m_data, orig.m_data, m_size * sizeof (double));
+    }
+}
+
+Vector::Vector(Vector&& orig) : m_data(orig.m_data), m_size(orig.m_size) {
+    orig.m_data = NULL;
+    orig.m_size = 0;
+}
+
+Vector& Vector::operator=(const Vector& right) {
+    if (this == &right) {
+        return *this;
+    }
+    if (m_size != right.m_size || m_data == NULL) { /* otherwise, reuse the buffer */
+        MatrixAllocator::free_data(m_data);
+        m_data = (right.m_data != NULL) ? MatrixAllocator::allocate_data(right.m_size, false) : NULL;
+        m_size = right.m_size;
+    }
+    if (right.m_data != NULL) {
+        memcpy(m_data, right.m_data, m_size * sizeof (double));
+    }
+    return *this;
+}
+
+Vector& Vector::operator=(Vector&& right) {
+    if (this == &right) {
+        return *this;
+    }
+    MatrixAllocator::free_data(m_data);
+    m_data = right.m_data;
+    m_size = right.m_size;
+    right.m_data = NULL;
+    right.m_size = 0;
+    return *this;
+}
+
+Vector::~Vector() {
+    MatrixAllocator::free_data(m_data);
+}
@@ -0,0 +1,255 @@
+/*
+ * File:   Vector.h
+ * Author: ForBES contributors
+ *
+ * Created on October 17, 2026, 6:40 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef VECTOR_H
+#define	VECTOR_H
+
+#include "Matrix.h"
+
+#include <cstddef>
+
+class Vector;
+
+/**
+ * \class VectorView
+ * \brief Lightweight non-owning view of a (strided) vector of doubles
+ * \version version 0.1
+ * \date Created on October 17, 2026, 6:40 PM
+ * \author ForBES contributors
+ *
+ * A VectorView is just a pointer, a length and a stride; it has no virtual
+ * methods and does not own its data, so it is cheap to create and to pass by
+ * value. Element <code>i</code> of the view is <code>data()[i * stride()]</code>.
+ *
+ * Views can be created from raw arrays, from a Vector, or from a dense %Matrix
+ * which is a (column or row) vector, including strided shallow vectors (see
+ * MatrixFactory::ShallowVector). Functions and linear operators provide
+ * overloads of their hot methods (e.g., Function::call, Function::callProx
+ * and LinearOperator::call) which accept views, so that small problems which
+ * are solved at high rates do not pay for the generality of %Matrix.
+ *
+ * The viewed memory must outlive the view.
+ *
+ * \sa Vector
+ */
+class VectorView {
+public:
+
+    /**
+     * Creates an empty view.
+     */
+    VectorView();
+
+    /**
+     * Creates a view of an array.
+     *
+     * @param data pointer to the first element
+     * @param size number of elements
+     * @param stride distance between consecutive elements
+     *
+     * \exception std::invalid_argument if the stride is zero
+     */
+    VectorView(double * data, size_t size, size_t stride = 1);
+
+    /**
+     * Creates a view of a vector.
+     * @param v vector
+     */
+    VectorView(Vector& v);
+
+    /**
+     * Creates a view of the data of a dense vector. Like Matrix::getData, this
+     * stops the data of <code>x</code> from being shared with its copies.
+     *
+     * @param x dense column or row vector (possibly a strided shallow vector)
+     *
+     * \exception std::invalid_argument if <code>x</code> is not a dense vector
+     */
+    explicit VectorView(Matrix& x);
+
+    /**
+     * Number of elements.
+     * @return size of the view
+     */
+    size_t size() const {
+        return m_size;
+    }
+
+    /**
+     * Distance between consecutive elements in memory.
+     * @return stride
+     */
+    size_t stride() const {
+        return m_stride;
+    }
+
+    /**
+     * Pointer to the first element.
+     * @return data pointer
+     */
+    double * data() const {
+        return m_data;
+    }
+
+    /**
+     * Element <code>i</code> (no bounds checks are performed).
+     * @param i index
+     * @return reference to the element
+     */
+    double& operator[](size_t i) const {
+        return m_data[i * m_stride];
+    }
+
+    /**
+     * A contiguous part of this view.
+     *
+     * @param offset index of the first element
+     * @param size number of elements
+     * @return view of elements <code>offset</code> to <code>offset+size-1</code>
+     *
+     * \exception std::out_of_range if the segment exceeds this view
+     */
+    VectorView segment(size_t offset, size_t size) const;
+
+    /**
+     * A shallow column-vector %Matrix which points to the data of this view
+     * (a strided vector if the stride is not one).
+     *
+     * @return shallow matrix
+     */
+    Matrix asMatrix() const;
+
+    /**
+     * A contiguous column-vector %Matrix with the elements of this view: a 
+     * shallow matrix if the stride is one and a copy otherwise. Changes to a
+     * copy can be written back with #copyFrom.
+     * 
+     * @return contiguous matrix
+     */
+    Matrix asContiguousMatrix() const;
+
+    /**
+     * Copies the elements of a dense vector into this view; nothing is copied
+     * if <code>x</code> is a shallow matrix of this view.
+     * 
+     * @param x dense vector of the same size
+     * 
+     * \exception std::invalid_argument if the sizes do not match
+     */
+    void copyFrom(Matrix& x) const;
+
+private:
+    double * m_data; /**< first element */
+    size_t m_size; /**< number of elements */
+    size_t m_stride; /**< distance between consecutive elements */
+};
+
+/**
+ * \class Vector
+ * \brief Lightweight dense vector of doubles
+ * \version version 0.1
+ * \date Created on October 17, 2026, 6:40 PM
+ * \author ForBES contributors
+ *
+ * A contiguous vector which owns its (aligned) data; unlike %Matrix it holds
+ * nothing but a pointer and a length and has no virtual methods. Vectors
+ * are converted implicitly to VectorView.
+ *
+ * \sa VectorView
+ */
+class Vector {
+public:
+
+    /**
+     * Creates an empty vector.
+     */
+    Vector();
+
+    /**
+     * Creates a vector of zeros.
+     * @param size number of elements
+     */
+    explicit Vector(size_t size);
+
+    /**
+     * Creates a vector with a copy of the elements of a view.
+     * @param v view to be copied
+     */
+    explicit Vector(VectorView v);
+
+    Vector(const Vector& orig);
+
+    Vector(Vector&& orig);
+
+    Vector& operator=(const Vector& right);
+
+    Vector& operator=(Vector&& right);
+
+    ~Vector();
+
+    /**
+     * Number of elements.
+     * @return size of the vector
+     */
+    size_t size() const {
+        return m_size;
+    }
+
+    /**
+     * Pointer to the data.
+     * @return data pointer
+     */
+    double * data() {
+        return m_data;
+    }
+
+    /**
+     * Pointer to the data.
+     * @return data pointer
+     */
+    const double * data() const {
+        return m_data;
+    }
+
+    /**
+     * Element <code>i</code> (no bounds checks are performed).
+     * @param i index
+     * @return reference to the element
+     */
+    double& operator[](size_t i) {
+        return m_data[i];
+    }
+
+    /**
+     * Element <code>i</code> (no bounds checks are performed).
+     * @param i index
+     * @return value of the element
+     */
+    double operator[](size_t i) const {
+        return m_data[i];
+    }
+
+private:
+    double * m_data; /**< elements */
+    size_t m_size; /**< number of elements */
+};
+
+#endif	/* VECTOR_H */
+
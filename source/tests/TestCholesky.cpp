@@ -170,3 +170,420 @@ void TestCholesky::testCholeskySymmetric() {
 
 
 
+
+void TestCholesky::testCholeskyBanded() {
+    const double tol = 1e-9;
+    const size_t n = 200;
+    const size_t kd = 2;
+    Matrix A = MatrixFactory::MakeBandedSymmetric(n, kd);
+    for (size_t i = 0; i < n; i++) {
+        A.set(i, i, 6.0 + 0.01 * i);
+        if (i >= 1) A.set(i, i - 1, -1.0);
+        if (i >= 2) A.set(i, i - 2, 0.5);
+    }
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 2, 0.0, 1.0, Matrix::MATRIX_DENSE);
+
+    Matrix A_copy(A);
+    FactoredSolver * solver = new CholeskyFactorization(A);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver -> factorize());
+    A = Matrix(); // Goodbye A...
+    Matrix x;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver -> solve(b, x));
+    Matrix err = A_copy * x - b;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            _ASSERT(std::abs(err.get(i, j)) < tol);
+        }
+    }
+    delete solver;
+
+    /* general banded matrix: the lower band is used */
+    Matrix G = MatrixFactory::MakeBanded(n, n, kd, 1);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = (i > kd ? i - kd : 0); j <= i; j++) {
+            G.set(i, j, A_copy.get(i, j));
+        }
+    }
+    solver = new CholeskyFactorization(G);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver -> factorize());
+    Matrix x2;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver -> solve(b, x2));
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(x.get(i, 0), x2.get(i, 0), tol);
+    }
+    delete solver;
+
+    /* not positive definite */
+    Matrix N = MatrixFactory::MakeBandedSymmetric(4, 1);
+    N.set(0, 0, 1.0);
+    N.set(1, 0, 2.0);
+    N.set(1, 1, 1.0);
+    solver = new CholeskyFactorization(N);
+    _ASSERT_NEQ(ForBESUtils::STATUS_OK, solver -> factorize());
+    delete solver;
+}
+
+void TestCholesky::testRefactorizeSparse() {
+    const double tol = 1e-7;
+    const size_t n = 30;
+    Matrix A = MatrixFactory::MakeSparseSymmetric(n, 2 * n - 1);
+    Matrix b(n, 1);
+    for (size_t i = 0; i < n; i++) {
+        A.set(i, i, 4.0);
+        b.set(i, 0, i + 1.0);
+    }
+    for (size_t i = 1; i < n; i++) {
+        A.set(i, i - 1, 0.5);
+    }
+
+    CholeskyFactorization solver(A);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.refactorize()); /* first call: same as factorize */
+
+    Matrix x;
+    Matrix r;
+    for (size_t k = 1; k <= 5; k++) {
+        /* new values, same pattern */
+        for (size_t i = 0; i < n; i++) {
+            A.set(i, i, 4.0 + k);
+        }
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.refactorize());
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, x));
+        r = A * x;
+        for (size_t i = 0; i < n; i++) {
+            _ASSERT_NUM_EQ(b.get(i, 0), r.get(i, 0), tol);
+        }
+    }
+
+    /* a new matrix with the same pattern */
+    Matrix A2(A);
+    for (size_t i = 1; i < n; i++) {
+        A2.set(i, i - 1, -1.0);
+    }
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.refactorize(A2));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, x));
+    r = A2 * x;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(b.get(i, 0), r.get(i, 0), tol);
+    }
+
+    /* a matrix with a different pattern is factorized from scratch */
+    Matrix A3 = MatrixFactory::MakeSparseSymmetric(n, 2 * n);
+    for (size_t i = 0; i < n; i++) {
+        A3.set(i, i, 4.0);
+    }
+    for (size_t i = 1; i < n; i++) {
+        A3.set(i, i - 1, 0.5);
+    }
+    A3.set(n - 1, 0, 0.1);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.refactorize(A3));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, x));
+    r = A3 * x;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(b.get(i, 0), r.get(i, 0), tol);
+    }
+
+    /* incompatible matrices */
+    Matrix B = MatrixFactory::MakeSparseSymmetric(n + 1, n + 1);
+    Matrix C(n, n);
+    _ASSERT_EXCEPTION(solver.refactorize(B), std::invalid_argument);
+    _ASSERT_EXCEPTION(solver.refactorize(C), std::invalid_argument);
+}
+
+void TestCholesky::testRefactorizeDense() {
+    const double tol = 1e-9;
+    const size_t n = 6;
+    Matrix A(n, n);
+    for (size_t i = 0; i < n; i++) {
+        A.set(i, i, 5.0);
+        if (i > 0) {
+            A.set(i, i - 1, 1.0);
+            A.set(i - 1, i, 1.0);
+        }
+    }
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    CholeskyFactorization solver(A);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.factorize());
+
+    Matrix A2(A);
+    A2.set(0, 0, 10.0);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.refactorize(A2));
+    Matrix x;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, x));
+    Matrix r = A2 * x;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(b.get(i, 0), r.get(i, 0), tol);
+    }
+
+    Matrix D = MatrixFactory::MakeIdentity(n, 3.0);
+    _ASSERT_EXCEPTION(solver.refactorize(D), std::invalid_argument);
+}
+
+/*
+ * Asserts that (A + sign*CC')x = b.
+ */
+static void assert_updated_solution(Matrix& A, Matrix& C, double sign, Matrix& x, Matrix& b, double tol) {
+    Matrix Ct(C);
+    Ct.transpose();
+    Matrix r = A * x;
+    Matrix Ctx = Ct * x;
+    Matrix s = C * Ctx;
+    for (size_t i = 0; i < A.getNrows(); i++) {
+        _ASSERT_NUM_EQ(b.get(i, 0), r.get(i, 0) + sign * s.get(i, 0), tol);
+    }
+}
+
+void TestCholesky::testUpdateSparse() {
+    const double tol = 1e-7;
+    const size_t n = 30;
+    Matrix A = MatrixFactory::MakeSparseSymmetric(n, 2 * n - 1);
+    Matrix b(n, 1);
+    for (size_t i = 0; i < n; i++) {
+        A.set(i, i, 4.0);
+        b.set(i, 0, i + 1.0);
+    }
+    for (size_t i = 1; i < n; i++) {
+        A.set(i, i - 1, 0.5);
+    }
+
+    CholeskyFactorization solver(A);
+    Matrix C = MatrixFactory::MakeRandomMatrix(n, 2, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    _ASSERT_EXCEPTION(solver.update(C), std::logic_error); /* not factorized yet */
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.factorize());
+
+    Matrix x;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.update(C));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, x));
+    assert_updated_solution(A, C, 1.0, x, b, tol);
+
+    /* downdating with the same C recovers the factorization of A */
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.downdate(C));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, x));
+    Matrix r = A * x;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(b.get(i, 0), r.get(i, 0), tol);
+    }
+
+    /* sparse update */
+    Matrix S = MatrixFactory::MakeRandomSparse(n, 3, 10, 0.0, 1.0);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.update(S));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, x));
+    assert_updated_solution(A, S, 1.0, x, b, tol);
+
+    /* the matrix is factorized from scratch */
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, x));
+    r = A * x;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(b.get(i, 0), r.get(i, 0), tol);
+    }
+
+    Matrix D(n + 1, 1);
+    _ASSERT_EXCEPTION(solver.update(D), std::invalid_argument);
+}
+
+void TestCholesky::testUpdateDense() {
+    const double tol = 1e-8;
+    const size_t n = 10;
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix C = MatrixFactory::MakeRandomMatrix(n, 3, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix x;
+
+    /* dense */
+    Matrix A(n, n);
+    for (size_t i = 0; i < n; i++) {
+        A.set(i, i, 5.0);
+        if (i > 0) {
+            A.set(i, i - 1, 1.0);
+            A.set(i - 1, i, 1.0);
+        }
+    }
+    CholeskyFactorization solver(A);
+    _ASSERT_EXCEPTION(solver.update(C), std::logic_error); /* not factorized yet */
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.update(C));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, x));
+    assert_updated_solution(A, C, 1.0, x, b, tol);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.downdate(C));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, x));
+    assert_updated_solution(A, C, 0.0, x, b, tol);
+
+    /* A - 10*ee' is not positive definite */
+    Matrix E(n, 1);
+    for (size_t i = 0; i < n; i++) {
+        E.set(i, 0, std::sqrt(10.0));
+    }
+    _ASSERT_EQ(ForBESUtils::STATUS_NUMERICAL_PROBLEMS, solver.downdate(E));
+    _ASSERT_EXCEPTION(solver.update(C), std::logic_error); /* invalid factor */
+
+    /* symmetric (packed) */
+    Matrix As = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 0.1, Matrix::MATRIX_SYMMETRIC);
+    for (size_t i = 0; i < n; i++) {
+        As.set(i, i, As.get(i, i) + 2.0);
+    }
+    CholeskyFactorization solver_sym(As);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_sym.factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_sym.update(C));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_sym.solve(b, x));
+    assert_updated_solution(As, C, 1.0, x, b, tol);
+
+    /* banded factors are not updated */
+    Matrix Ab = MatrixFactory::MakeBandedSymmetric(n, 1);
+    for (size_t i = 0; i < n; i++) {
+        Ab.set(i, i, 2.0);
+    }
+    CholeskyFactorization solver_band(Ab);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_band.factorize());
+    _ASSERT_EXCEPTION(solver_band.update(C), std::logic_error);
+}
+
+/*
+ * Asserts that two matrices have the same dimensions and values (up to tol).
+ */
+static void assert_near(Matrix& A, Matrix& B, double tol) {
+    _ASSERT_EQ(A.getNrows(), B.getNrows());
+    _ASSERT_EQ(A.getNcols(), B.getNcols());
+    for (size_t i = 0; i < A.getNrows(); i++) {
+        for (size_t j = 0; j < A.getNcols(); j++) {
+            _ASSERT_NUM_EQ(A.get(i, j), B.get(i, j), tol);
+        }
+    }
+}
+
+void TestCholesky::testSolveMultipleRhs() {
+    const double tol = 1e-7;
+    const size_t n = 30;
+    const size_t k = 5;
+    Matrix A = MatrixFactory::MakeSparseSymmetric(n, 2 * n - 1);
+    for (size_t i = 0; i < n; i++) {
+        A.set(i, i, 4.0);
+    }
+    for (size_t i = 1; i < n; i++) {
+        A.set(i, i - 1, 0.5);
+    }
+    Matrix A_dense(n, n);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            A_dense.set(i, j, A.get(i, j));
+        }
+    }
+    CholeskyFactorization solver(A);
+    CholeskyFactorization solver_dense(A_dense);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_dense.factorize());
+
+    Matrix B = MatrixFactory::MakeRandomMatrix(n, k, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix X;
+    Matrix X_dense;
+    for (size_t rep = 0; rep < 3; rep++) {
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(B, X));
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_dense.solve(B, X_dense));
+        _ASSERT_EQ(n, X.getNrows());
+        _ASSERT_EQ(k, X.getNcols());
+        Matrix R = A * X;
+        assert_near(B, R, tol);
+        assert_near(X, X_dense, tol);
+    }
+
+    /* the storage of the solution is reused */
+    const Matrix& X_const = X;
+    const double * x_data = X_const.getData();
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(B, X));
+    _ASSERT_EQ(x_data, X_const.getData());
+
+    /* copies of the solution are not modified */
+    Matrix X_copy(X);
+    Matrix B2(B);
+    B2 *= 2.0;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(B2, X));
+    Matrix X2 = X_copy;
+    X2 *= 2.0;
+    assert_near(X, X2, tol);
+
+    /* a single column of a transposed right-hand side */
+    Matrix b = MatrixFactory::MakeRandomMatrix(1, n, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    b.transpose();
+    Matrix x;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, x));
+    Matrix r = A * x;
+    assert_near(b, r, tol);
+
+    /* in place */
+    Matrix b_copy(b);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(b, b));
+    assert_near(b, x, tol);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_dense.solve(b_copy, b_copy));
+    assert_near(b_copy, x, tol);
+
+    /* a solution which used to be larger does not keep its old values */
+    Matrix x_big = MatrixFactory::MakeRandomMatrix(2 * n, 1, 10.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix b_col = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_dense.solve(b_col, x_big));
+    _ASSERT_EQ(n, x_big.getNrows());
+    _ASSERT_EQ(n, x_big.length());
+    double norm_sq = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        norm_sq += x_big.get(i, 0) * x_big.get(i, 0);
+    }
+    _ASSERT_NUM_EQ(std::sqrt(norm_sq), x_big.norm_fro_sq(), 1e-10); /* (returns the norm) */
+    Matrix y(n, 1);
+    y += x_big;
+    assert_near(x_big, y, tol);
+}
+
+void TestCholesky::testMixedPrecision() {
+    const size_t n = 40;
+    const size_t k = 3;
+    /* a well-conditioned matrix: A = B'B + nI */
+    Matrix B = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix Bt(B);
+    Bt.transpose();
+    Matrix A = Bt * B;
+    for (size_t i = 0; i < n; i++) {
+        A.set(i, i, A.get(i, i) + n);
+    }
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, k, 0.0, 1.0, Matrix::MATRIX_DENSE);
+
+    CholeskyFactorization mixed(A);
+    _ASSERT_NOT(mixed.isMixedPrecision());
+    mixed.setMixedPrecision(true);
+    _ASSERT(mixed.isMixedPrecision());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, mixed.factorize());
+    Matrix x;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, mixed.solve(b, x));
+    _ASSERT(mixed.getRefinementIterations() > 0);
+
+    CholeskyFactorization reference(A);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, reference.factorize());
+    Matrix x_ref;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, reference.solve(b, x_ref));
+    _ASSERT_EQ(0, reference.getRefinementIterations());
+    assert_near(x_ref, x, 1e-11);
+
+    /* an ill-conditioned matrix: A = ee' + 1e-7*I (falls back to double precision) */
+    Matrix A_ill(n, n);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            A_ill.set(i, j, (i == j) ? 1.0 + 1e-7 : 1.0);
+        }
+    }
+    CholeskyFactorization mixed_ill(A_ill);
+    mixed_ill.setMixedPrecision(true);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, mixed_ill.factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, mixed_ill.solve(b, x));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, mixed_ill.solve(b, x));
+    _ASSERT_EQ(0, mixed_ill.getRefinementIterations());
+    CholeskyFactorization reference_ill(A_ill);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, reference_ill.factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, reference_ill.solve(b, x_ref));
+    assert_near(x_ref, x, 1e-6 * std::abs(x_ref.get(0, 0)));
+    Matrix r = A_ill * x;
+    assert_near(b, r, 1e-7);
+    
+    /* the double-precision factor can be updated */
+    Matrix c = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, mixed.update(c));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, mixed.solve(b, x));
+    _ASSERT_EQ(0, mixed.getRefinementIterations());
+    assert_updated_solution(A, c, 1.0, x, b, 1e-8);
+}
+
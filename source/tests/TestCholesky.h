@@ -35,6 +35,13 @@ class TestCholesky : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(testCholeskySymmetric);
     CPPUNIT_TEST(testCholeskySymmetric2);
     CPPUNIT_TEST(testCholeskySparse);
+    CPPUNIT_TEST(testCholeskyBanded);
+    CPPUNIT_TEST(testRefactorizeSparse);
+    CPPUNIT_TEST(testRefactorizeDense);
+    CPPUNIT_TEST(testUpdateSparse);
+    CPPUNIT_TEST(testUpdateDense);
+    CPPUNIT_TEST(testSolveMultipleRhs);
+    CPPUNIT_TEST(testMixedPrecision);
     
 
     CPPUNIT_TEST_SUITE_END();
@@ -50,6 +57,13 @@ private:
     void testCholeskySymmetric();
     void testCholeskySymmetric2();
     void testCholeskySparse();
+    void testCholeskyBanded();
+    void testRefactorizeSparse();
+    void testRefactorizeDense();
+    void testUpdateSparse();
+    void testUpdateDense();
+    void testSolveMultipleRhs();
+    void testMixedPrecision();
     
 };
 
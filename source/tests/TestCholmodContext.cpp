@@ -0,0 +1,118 @@
+/*
+ * File:   TestCholmodContext.cpp
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 8:52:40 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestCholmodContext.h"
+
+#include <thread>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCholmodContext);
+
+TestCholmodContext::TestCholmodContext() {
+}
+
+TestCholmodContext::~TestCholmodContext() {
+}
+
+void TestCholmodContext::setUp() {
+}
+
+void TestCholmodContext::tearDown() {
+    Matrix::destroy_handle();
+}
+
+/*
+ * Factorizes a sparse tridiagonal matrix and returns the error of the solution
+ * of a linear system (or a negative number if something went wrong).
+ */
+static double sparse_solve_error(size_t n, double shift) {
+    Matrix A = MatrixFactory::MakeSparseSymmetric(n, 2 * n - 1);
+    Matrix b(n, 1);
+    for (size_t i = 0; i < n; i++) {
+        A.set(i, i, n + shift);
+        b.set(i, 0, i + 1.0);
+    }
+    for (size_t i = 1; i < n; i++) {
+        A.set(i, i - 1, 0.5);
+    }
+    Matrix x;
+    CholeskyFactorization solver(A);
+    if (solver.factorize() != ForBESUtils::STATUS_OK || solver.solve(b, x) != ForBESUtils::STATUS_OK) {
+        return -1.0;
+    }
+    Matrix r = A * x; /* sparse product */
+    double err = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        err = std::max(err, std::abs(r.get(i, 0) - b.get(i, 0)));
+    }
+    return err;
+}
+
+void TestCholmodContext::testThreadHandles() {
+    cholmod_common * main_handle = Matrix::cholmod_handle();
+    _ASSERT(main_handle != NULL);
+    _ASSERT_EQ(main_handle, Matrix::cholmod_handle());
+    _ASSERT_EQ(main_handle, CholmodContext::current()->handle());
+
+    cholmod_common * other_handle = NULL;
+    std::thread worker([&other_handle]() {
+        other_handle = Matrix::cholmod_handle();
+    });
+    worker.join();
+    _ASSERT(other_handle != NULL);
+    _ASSERT_NEQ(main_handle, other_handle);
+
+    /* each context has its own cholmod_common */
+    CholmodContext context;
+    _ASSERT_NEQ(main_handle, context.handle());
+    _ASSERT_EQ(0, context.handle()->status);
+}
+
+void TestCholmodContext::testDestroyHandle() {
+    Matrix::cholmod_handle();
+    _ASSERT_EQ(1, Matrix::destroy_handle());
+    _ASSERT_EQ(0, Matrix::destroy_handle());
+    _ASSERT(Matrix::cholmod_handle() != NULL); /* a new handle is created */
+    _ASSERT_EQ(0, Matrix::cholmod_handle()->status);
+}
+
+void TestCholmodContext::testConcurrentFactorizations() {
+    const size_t num_threads = 4;
+    const size_t repetitions = 20;
+    std::vector<double> errors(num_threads, 0.0);
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < num_threads; t++) {
+        workers.push_back(std::thread([t, &errors]() {
+            for (size_t k = 0; k < repetitions && errors[t] >= 0.0; k++) {
+                double err = sparse_solve_error(30 + t, 1.5 + k);
+                errors[t] = (err < 0.0) ? err : std::max(errors[t], err);
+            }
+        }));
+    }
+    for (size_t t = 0; t < num_threads; t++) {
+        workers[t].join();
+    }
+    for (size_t t = 0; t < num_threads; t++) {
+        _ASSERT(errors[t] >= 0.0);
+        _ASSERT(errors[t] < 1e-7);
+    }
+}
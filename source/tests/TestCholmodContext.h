@@ -0,0 +1,39 @@
+/*
+ * File:   TestCholmodContext.h
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 8:52:40 PM
+ */
+
+#ifndef TESTCHOLMODCONTEXT_H
+#define	TESTCHOLMODCONTEXT_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#define FORBES_TEST_UTILS
+#include "ForBES.h"
+
+class TestCholmodContext : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(TestCholmodContext);
+
+    CPPUNIT_TEST(testThreadHandles);
+    CPPUNIT_TEST(testDestroyHandle);
+    CPPUNIT_TEST(testConcurrentFactorizations);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    TestCholmodContext();
+    virtual ~TestCholmodContext();
+    void setUp();
+    void tearDown();
+
+private:
+    void testThreadHandles();
+    void testDestroyHandle();
+    void testConcurrentFactorizations();
+
+};
+
+#endif	/* TESTCHOLMODCONTEXT_H */
+
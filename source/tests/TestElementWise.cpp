@@ -0,0 +1,285 @@
+/*
+ * File:   TestElementWise.cpp
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 7:48:10 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestElementWise.h"
+
+#include <cmath>
+#include <algorithm>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestElementWise);
+
+/* an odd length, so that the remainder loops of the kernels are tested too */
+static const size_t N = 37;
+
+static void fill(double * x, size_t n, double scale) {
+    for (size_t i = 0; i < n; i++) {
+        x[i] = scale * std::sin(1.3 * i + 0.2) * (1.0 + (i % 4));
+    }
+}
+
+TestElementWise::TestElementWise() {
+}
+
+TestElementWise::~TestElementWise() {
+}
+
+void TestElementWise::setUp() {
+}
+
+void TestElementWise::tearDown() {
+}
+
+void TestElementWise::testGeneric() {
+    double x[N];
+    double z[N];
+    double y[N];
+    fill(x, N, 1.0);
+    fill(z, N, -0.5);
+
+    ElementWise::map(N, x, y, [](double xi) {
+        return 2.0 * xi + 1.0;
+    });
+    for (size_t i = 0; i < N; i++) {
+        _ASSERT_NUM_EQ(2.0 * x[i] + 1.0, y[i], 1e-14);
+    }
+
+    ElementWise::zip(N, x, z, y, [](double xi, double zi) {
+        return xi * zi;
+    });
+    double expected_dot = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        _ASSERT_NUM_EQ(x[i] * z[i], y[i], 1e-14);
+        expected_dot += x[i] * z[i];
+    }
+
+    double dot = ElementWise::zipReduce(N, x, z, [](double xi, double zi) {
+        return xi * zi;
+    });
+    _ASSERT_NUM_EQ(expected_dot, dot, 1e-12);
+
+    double sum = ElementWise::reduce(N, x, [](double xi) {
+        return xi;
+    });
+    double expected_sum = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        expected_sum += x[i];
+    }
+    _ASSERT_NUM_EQ(expected_sum, sum, 1e-12);
+
+    /* y = max(x, 0) and the sum of y in one pass */
+    double sum_pos = ElementWise::fusedReduce(N, [&x, &y](size_t i) {
+        y[i] = std::max(x[i], 0.0);
+        return y[i];
+    });
+    double expected_sum_pos = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        _ASSERT_NUM_EQ(std::max(x[i], 0.0), y[i], 1e-14);
+        expected_sum_pos += y[i];
+    }
+    _ASSERT_NUM_EQ(expected_sum_pos, sum_pos, 1e-12);
+
+    /* nothing happens for empty arrays */
+    _ASSERT_EQ(0.0, ElementWise::sumAbs(0, x));
+    _ASSERT_EQ(0.0, ElementWise::maxAbs(0, x));
+}
+
+void TestElementWise::testNorms() {
+    double x[N];
+    double z[N];
+    double d[N];
+    fill(x, N, 1.5);
+    fill(z, N, 0.7);
+    z[N - 1] = 100.0;
+
+    double sum_abs = 0.0;
+    double max_abs = 0.0;
+    double sum_sq = 0.0;
+    double sum_sq_diff = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        sum_abs += std::abs(x[i]);
+        max_abs = std::max(max_abs, std::abs(x[i]));
+        sum_sq += x[i] * x[i];
+        sum_sq_diff += (x[i] - z[i]) * (x[i] - z[i]);
+    }
+    _ASSERT_NUM_EQ(sum_abs, ElementWise::sumAbs(N, x), 1e-12);
+    _ASSERT_NUM_EQ(max_abs, ElementWise::maxAbs(N, x), 1e-14);
+    _ASSERT_NUM_EQ(sum_sq, ElementWise::sumSquares(N, x), 1e-12);
+    _ASSERT_NUM_EQ(sum_sq_diff, ElementWise::subtractSumSquares(N, x, z, d), 1e-10);
+    for (size_t i = 0; i < N; i++) {
+        _ASSERT_NUM_EQ(x[i] - z[i], d[i], 1e-14);
+    }
+
+    /* in place: z = x - z */
+    ElementWise::subtractSumSquares(N, x, z, z);
+    for (size_t i = 0; i < N; i++) {
+        _ASSERT_EQ(d[i], z[i]);
+    }
+}
+
+void TestElementWise::testSoftThreshold() {
+    double x[N];
+    double y[N];
+    fill(x, N, 2.0);
+    const double t = 1.1;
+
+    double norm1 = ElementWise::softThreshold(N, x, t, y);
+    double expected_norm1 = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        double yi = std::abs(x[i]) > t ? x[i] - (x[i] > 0 ? t : -t) : 0.0;
+        _ASSERT_NUM_EQ(yi, y[i], 1e-14);
+        expected_norm1 += std::abs(yi);
+    }
+    _ASSERT_NUM_EQ(expected_norm1, norm1, 1e-12);
+}
+
+void TestElementWise::testBox() {
+    double x[N];
+    double y[N];
+    double lb[N];
+    double ub[N];
+    fill(x, N, 3.0);
+    for (size_t i = 0; i < N; i++) {
+        lb[i] = -1.0 - 0.1 * i;
+        ub[i] = 0.5 + 0.2 * i;
+    }
+
+    size_t outside = 0;
+    ElementWise::clamp(N, x, -1.0, 2.0, y);
+    for (size_t i = 0; i < N; i++) {
+        _ASSERT_EQ(std::min(2.0, std::max(-1.0, x[i])), y[i]);
+        if (x[i] < -1.0 || x[i] > 2.0) {
+            outside++;
+        }
+    }
+    _ASSERT(outside > 0);
+    _ASSERT_EQ(outside, ElementWise::countOutside(N, x, -1.0, 2.0));
+    _ASSERT_EQ(static_cast<size_t> (0), ElementWise::countOutside(N, y, -1.0, 2.0));
+
+    outside = 0;
+    ElementWise::clamp(N, x, lb, ub, y);
+    for (size_t i = 0; i < N; i++) {
+        _ASSERT_EQ(std::min(ub[i], std::max(lb[i], x[i])), y[i]);
+        if (x[i] < lb[i] || x[i] > ub[i]) {
+            outside++;
+        }
+    }
+    _ASSERT_EQ(outside, ElementWise::countOutside(N, x, lb, ub));
+    _ASSERT_EQ(static_cast<size_t> (0), ElementWise::countOutside(N, y, lb, ub));
+
+    /* infinite bounds */
+    _ASSERT_EQ(static_cast<size_t> (0), ElementWise::countOutside(N, x, -INFINITY, INFINITY));
+}
+
+void TestElementWise::testHuber() {
+    double x[N];
+    double grad[N];
+    fill(x, N, 1.0);
+    const double delta = 0.8;
+
+    double f_expected = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        double ai = std::abs(x[i]);
+        f_expected += (ai <= delta) ? x[i] * x[i] / (2.0 * delta) : ai - delta / 2.0;
+    }
+    _ASSERT_NUM_EQ(f_expected, ElementWise::huber(N, x, delta, NULL), 1e-12);
+    _ASSERT_NUM_EQ(f_expected, ElementWise::huber(N, x, delta, grad), 1e-12);
+    for (size_t i = 0; i < N; i++) {
+        double gi = (std::abs(x[i]) <= delta) ? x[i] / delta : (x[i] > 0 ? 1.0 : -1.0);
+        _ASSERT_NUM_EQ(gi, grad[i], 1e-14);
+    }
+}
+
+void TestElementWise::testLogLogistic() {
+    double x[N];
+    double grad[N];
+    fill(x, N, 2.0);
+    const double mu = 1.7;
+
+    double f_expected = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        f_expected += std::log(1.0 + std::exp(-x[i]));
+    }
+    f_expected *= mu;
+    _ASSERT_NUM_EQ(f_expected, ElementWise::logLogistic(N, x, mu, NULL), 1e-12);
+    _ASSERT_NUM_EQ(f_expected, ElementWise::logLogistic(N, x, mu, grad), 1e-12);
+    for (size_t i = 0; i < N; i++) {
+        double si = 1.0 / (1.0 + std::exp(-x[i]));
+        _ASSERT_NUM_EQ(mu * (si - 1.0), grad[i], 1e-14);
+    }
+
+    /* no overflow for large |x| */
+    double x_large[4] = {-800.0, -40.0, 40.0, 800.0};
+    double f = ElementWise::logLogistic(4, x_large, 1.0, grad);
+    _ASSERT_NUM_EQ(840.0, f, 1e-10);
+    _ASSERT_NUM_EQ(-1.0, grad[0], 1e-14);
+    _ASSERT_NUM_EQ(-1.0, grad[1], 1e-14);
+    _ASSERT_NUM_EQ(0.0, grad[2], 1e-14);
+    _ASSERT_NUM_EQ(0.0, grad[3], 1e-14);
+}
+
+void TestElementWise::testDistanceToBox() {
+    double x[N];
+    double lb[N];
+    double ub[N];
+    double w[N];
+    double grad[N];
+    fill(x, N, 3.0);
+    for (size_t i = 0; i < N; i++) {
+        lb[i] = -1.0 - 0.1 * i;
+        ub[i] = 0.5 + 0.2 * i;
+        w[i] = 1.0 + 0.5 * (i % 3);
+    }
+
+    /* element-wise bounds and weights */
+    double f_expected = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        double di = x[i] - std::min(ub[i], std::max(lb[i], x[i]));
+        f_expected += w[i] * di * di / 2.0;
+    }
+    _ASSERT_NUM_EQ(f_expected, ElementWise::distanceToBox(N, x, lb, ub, w, 0.0, 0.0, 0.0, NULL), 1e-12);
+    _ASSERT_NUM_EQ(f_expected, ElementWise::distanceToBox(N, x, lb, ub, w, 0.0, 0.0, 0.0, grad), 1e-12);
+    for (size_t i = 0; i < N; i++) {
+        double di = x[i] - std::min(ub[i], std::max(lb[i], x[i]));
+        _ASSERT_NUM_EQ(w[i] * di, grad[i], 1e-14);
+    }
+
+    /* uniform bounds and weight */
+    const double lb0 = -0.5;
+    const double ub0 = 1.5;
+    const double w0 = 2.5;
+    f_expected = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        double di = x[i] - std::min(ub0, std::max(lb0, x[i]));
+        f_expected += w0 * di * di / 2.0;
+    }
+    _ASSERT_NUM_EQ(f_expected, ElementWise::distanceToBox(N, x, NULL, NULL, NULL, lb0, ub0, w0, grad), 1e-12);
+    for (size_t i = 0; i < N; i++) {
+        double di = x[i] - std::min(ub0, std::max(lb0, x[i]));
+        _ASSERT_NUM_EQ(w0 * di, grad[i], 1e-14);
+    }
+
+    /* element-wise lower bounds and uniform upper bound */
+    f_expected = 0.0;
+    for (size_t i = 0; i < N; i++) {
+        double di = x[i] - std::min(ub0, std::max(lb[i], x[i]));
+        f_expected += w0 * di * di / 2.0;
+    }
+    _ASSERT_NUM_EQ(f_expected, ElementWise::distanceToBox(N, x, lb, NULL, NULL, 0.0, ub0, w0, NULL), 1e-12);
+}
@@ -0,0 +1,47 @@
+/*
+ * File:   TestElementWise.h
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 7:48:10 PM
+ */
+
+#ifndef TESTELEMENTWISE_H
+#define	TESTELEMENTWISE_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#define FORBES_TEST_UTILS
+#include "ForBES.h"
+
+class TestElementWise : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(TestElementWise);
+
+    CPPUNIT_TEST(testGeneric);
+    CPPUNIT_TEST(testNorms);
+    CPPUNIT_TEST(testSoftThreshold);
+    CPPUNIT_TEST(testBox);
+    CPPUNIT_TEST(testHuber);
+    CPPUNIT_TEST(testLogLogistic);
+    CPPUNIT_TEST(testDistanceToBox);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    TestElementWise();
+    virtual ~TestElementWise();
+    void setUp();
+    void tearDown();
+
+private:
+    void testGeneric();
+    void testNorms();
+    void testSoftThreshold();
+    void testBox();
+    void testHuber();
+    void testLogLogistic();
+    void testDistanceToBox();
+
+};
+
+#endif	/* TESTELEMENTWISE_H */
+
@@ -0,0 +1,124 @@
+/*
+ * File:   TestFactorizationCache.cpp
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 11:12:36 PM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestFactorizationCache.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFactorizationCache);
+
+TestFactorizationCache::TestFactorizationCache() {
+}
+
+TestFactorizationCache::~TestFactorizationCache() {
+}
+
+void TestFactorizationCache::setUp() {
+}
+
+void TestFactorizationCache::tearDown() {
+}
+
+/*
+ * Inserts the factorization of (1 + parameter) * I (of size n) into a cache.
+ */
+static FactoredSolver * insert_factorization(FactorizationCache& cache, const void * owner,
+        unsigned long version, double parameter, size_t n) {
+    Matrix * A = new Matrix(n, n);
+    for (size_t i = 0; i < n; i++) {
+        A->set(i, i, 1.0 + parameter);
+    }
+    FactoredSolver * solver = new CholeskyFactorization(*A);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver->factorize());
+    cache.insert(owner, version, parameter, A, solver);
+    return solver;
+}
+
+void TestFactorizationCache::testFindInsert() {
+    const size_t n = 5;
+    int owner;
+    FactorizationCache cache(4);
+    _ASSERT_EQ(4, cache.getCapacity());
+    _ASSERT_EQ(0, cache.size());
+    _ASSERT(cache.find(&owner, 0, 0.5) == NULL);
+    _ASSERT_EQ(1, cache.getMisses());
+
+    FactoredSolver * solver = insert_factorization(cache, &owner, 0, 0.5, n);
+    _ASSERT_EQ(1, cache.size());
+    _ASSERT_EQ(solver, cache.find(&owner, 0, 0.5));
+    _ASSERT_EQ(1, cache.getHits());
+    _ASSERT(cache.find(&owner, 1, 0.5) == NULL); /* other version */
+    _ASSERT(cache.find(&owner, 0, 0.25) == NULL); /* other parameter */
+    _ASSERT_EQ(3, cache.getMisses());
+
+    /* the cached solver can be used */
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix x;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, cache.find(&owner, 0, 0.5)->solve(b, x));
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(b.get(i, 0) / 1.5, x.get(i, 0), 1e-12);
+    }
+
+    /* same key: replaced */
+    FactoredSolver * solver2 = insert_factorization(cache, &owner, 0, 0.5, n);
+    _ASSERT_EQ(1, cache.size());
+    _ASSERT_EQ(solver2, cache.find(&owner, 0, 0.5));
+
+    _ASSERT_EXCEPTION(FactorizationCache(0), std::invalid_argument);
+    _ASSERT_EXCEPTION(cache.setCapacity(0), std::invalid_argument);
+}
+
+void TestFactorizationCache::testLeastRecentlyUsed() {
+    int owner;
+    FactorizationCache cache(3);
+    for (size_t k = 0; k < 3; k++) {
+        insert_factorization(cache, &owner, 0, 0.1 * k, 4);
+    }
+    _ASSERT_EQ(3, cache.size());
+    /* 0.0 is used again, so 0.1 is the least recently used */
+    _ASSERT(cache.find(&owner, 0, 0.0) != NULL);
+    insert_factorization(cache, &owner, 0, 0.3, 4);
+    _ASSERT_EQ(3, cache.size());
+    _ASSERT(cache.find(&owner, 0, 0.1) == NULL);
+    _ASSERT(cache.find(&owner, 0, 0.0) != NULL);
+    _ASSERT(cache.find(&owner, 0, 0.2) != NULL);
+    _ASSERT(cache.find(&owner, 0, 0.3) != NULL);
+
+    /* shrinking keeps the most recently used */
+    cache.setCapacity(1);
+    _ASSERT_EQ(1, cache.size());
+    _ASSERT(cache.find(&owner, 0, 0.3) != NULL);
+
+    cache.clear();
+    _ASSERT_EQ(0, cache.size());
+}
+
+void TestFactorizationCache::testInvalidate() {
+    int owner1;
+    int owner2;
+    FactorizationCache cache(8);
+    insert_factorization(cache, &owner1, 0, 1.0, 3);
+    insert_factorization(cache, &owner1, 0, 2.0, 3);
+    insert_factorization(cache, &owner2, 0, 1.0, 3);
+    _ASSERT_EQ(3, cache.size());
+    _ASSERT_EQ(2, cache.invalidate(&owner1));
+    _ASSERT_EQ(1, cache.size());
+    _ASSERT(cache.find(&owner1, 0, 1.0) == NULL);
+    _ASSERT(cache.find(&owner2, 0, 1.0) != NULL);
+    _ASSERT_EQ(0, cache.invalidate(&owner1));
+}
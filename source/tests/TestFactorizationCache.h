@@ -0,0 +1,39 @@
+/*
+ * File:   TestFactorizationCache.h
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 11:12:36 PM
+ */
+
+#ifndef TESTFACTORIZATIONCACHE_H
+#define	TESTFACTORIZATIONCACHE_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#define FORBES_TEST_UTILS
+#include "ForBES.h"
+
+class TestFactorizationCache : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(TestFactorizationCache);
+
+    CPPUNIT_TEST(testFindInsert);
+    CPPUNIT_TEST(testLeastRecentlyUsed);
+    CPPUNIT_TEST(testInvalidate);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    TestFactorizationCache();
+    virtual ~TestFactorizationCache();
+    void setUp();
+    void tearDown();
+
+private:
+    void testFindInsert();
+    void testLeastRecentlyUsed();
+    void testInvalidate();
+
+};
+
+#endif	/* TESTFACTORIZATIONCACHE_H */
+
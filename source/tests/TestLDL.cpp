@@ -181,3 +181,198 @@ void TestLDL::testSolveSparse2() {
     delete solver;
 }
 
+
+void TestLDL::testSolveBanded() {
+    const double tol = 1e-9;
+    const size_t n = 100;
+
+    /* symmetric indefinite banded matrix */
+    Matrix K = MatrixFactory::MakeBandedSymmetric(n, 2);
+    for (size_t i = 0; i < n; i++) {
+        K.set(i, i, (i % 2 == 0) ? 4.0 : -4.0);
+        if (i >= 1) K.set(i, i - 1, 1.0);
+        if (i >= 2) K.set(i, i - 2, 0.3);
+    }
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix x;
+    FactoredSolver * ldlSolver = new LDLFactorization(K);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldlSolver->factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldlSolver->solve(b, x));
+    Matrix err = K * x - b;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT(std::abs(err.get(i, 0)) < tol);
+    }
+    delete ldlSolver;
+
+    /* non-symmetric banded matrix (pivoting is needed) */
+    Matrix G = MatrixFactory::MakeBanded(n, n, 1, 2);
+    for (size_t i = 0; i < n; i++) {
+        G.set(i, i, 0.01);
+        if (i >= 1) G.set(i, i - 1, 2.0);
+        if (i + 1 < n) G.set(i, i + 1, -1.0);
+        if (i + 2 < n) G.set(i, i + 2, 0.5);
+    }
+    G.transpose();
+    ldlSolver = new LDLFactorization(G);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldlSolver->factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldlSolver->solve(b, x));
+    err = G * x - b;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT(std::abs(err.get(i, 0)) < tol);
+    }
+    delete ldlSolver;
+}
+
+void TestLDL::testSparseOrdering() {
+    const double tol = 1e-9;
+    const size_t n = 50;
+    /* arrow matrix: without a permutation, L is full */
+    Matrix A = MatrixFactory::MakeSparse(n, n, 2 * n - 1, Matrix::SPARSE_SYMMETRIC_L);
+    A.set(0, 0, -2.0 * n);
+    for (size_t i = 1; i < n; i++) {
+        A.set(i, i, 3.0 + i);
+        A.set(0, i, 1.0);
+    }
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 2, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix x_natural;
+    Matrix x_amd;
+    Matrix x_user;
+
+    LDLFactorization natural(A);
+    natural.setOrdering(LDLFactorization::ORDERING_NATURAL);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, natural.factorize());
+    _ASSERT_EQ(n * (n - 1) / 2, natural.getFactorNonzeros());
+    _ASSERT(natural.getPermutation().empty());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, natural.solve(b, x_natural));
+
+    LDLFactorization amd(A);
+    _ASSERT_EQ(LDLFactorization::ORDERING_AMD, amd.getOrdering());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, amd.factorize());
+    _ASSERT_EQ(n - 1, amd.getFactorNonzeros());
+    _ASSERT_EQ(n, amd.getPermutation().size());
+    _ASSERT(amd.getFactorFlops() < natural.getFactorFlops());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, amd.solve(b, x_amd));
+
+    LDLFactorization user(A);
+    _ASSERT_EXCEPTION(user.setOrdering(LDLFactorization::ORDERING_USER), std::invalid_argument);
+    std::vector<int> P(n);
+    for (size_t k = 0; k < n; k++) {
+        P[k] = n - 1 - k;
+    }
+    user.setPermutation(P);
+    _ASSERT_EQ(LDLFactorization::ORDERING_USER, user.getOrdering());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, user.factorize());
+    _ASSERT_EQ(n - 1, user.getFactorNonzeros());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, user.solve(b, x_user));
+
+    Matrix r = A * x_amd;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            _ASSERT_NUM_EQ(b.get(i, j), r.get(i, j), tol);
+            _ASSERT_NUM_EQ(x_natural.get(i, j), x_amd.get(i, j), tol);
+            _ASSERT_NUM_EQ(x_natural.get(i, j), x_user.get(i, j), tol);
+        }
+    }
+
+    /* new values, same pattern: the symbolic factorization is reused */
+    for (size_t i = 1; i < n; i++) {
+        A.set(i, i, 5.0 + i);
+    }
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, amd.refactorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, amd.solve(b, x_amd));
+    r = A * x_amd;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(b.get(i, 0), r.get(i, 0), tol);
+    }
+
+    P[0] = 1;
+    _ASSERT_EXCEPTION(user.setPermutation(P), std::invalid_argument);
+    P.pop_back();
+    _ASSERT_EXCEPTION(user.setPermutation(P), std::invalid_argument);
+}
+
+void TestLDL::testMixedPrecision() {
+    const size_t n = 30;
+    /* symmetric indefinite matrix */
+    Matrix A = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < i; j++) {
+            A.set(j, i, A.get(i, j));
+        }
+        A.set(i, i, (i % 2 == 0) ? 10.0 + i : -10.0 - i);
+    }
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 2, 0.0, 1.0, Matrix::MATRIX_DENSE);
+
+    LDLFactorization mixed(A);
+    mixed.setMixedPrecision(true);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, mixed.factorize());
+    _ASSERT(mixed.getLDL() == NULL);
+    Matrix x;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, mixed.solve(b, x));
+    _ASSERT(mixed.getRefinementIterations() > 0);
+
+    LDLFactorization reference(A);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, reference.factorize());
+    Matrix x_ref;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, reference.solve(b, x_ref));
+
+    Matrix r = A * x;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            _ASSERT_NUM_EQ(b.get(i, j), r.get(i, j), 1e-11);
+            _ASSERT_NUM_EQ(x_ref.get(i, j), x.get(i, j), 1e-11);
+        }
+    }
+}
+
+
+void TestLDL::testRefactorize() {
+    const double tol = 1e-9;
+    const size_t n = 30;
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix x;
+
+    /* symmetric: refactorize with a new matrix and after an in-place update */
+    Matrix S = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_SYMMETRIC);
+    Matrix S2 = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_SYMMETRIC);
+    LDLFactorization ldl_sym(S);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldl_sym.factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldl_sym.refactorize(S2));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldl_sym.solve(b, x));
+    Matrix err = S2 * x - b;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT(std::abs(err.get(i, 0)) < tol);
+    }
+    S2 *= 2.0;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldl_sym.refactorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldl_sym.solve(b, x));
+    err = S2 * x - b;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT(std::abs(err.get(i, 0)) < tol);
+    }
+
+    /* banded */
+    Matrix K = MatrixFactory::MakeBandedSymmetric(n, 1);
+    Matrix K2 = MatrixFactory::MakeBandedSymmetric(n, 1);
+    for (size_t i = 0; i < n; i++) {
+        K.set(i, i, 4.0);
+        K2.set(i, i, (i % 2 == 0) ? 3.0 : -5.0);
+        if (i >= 1) {
+            K.set(i, i - 1, 1.0);
+            K2.set(i, i - 1, -0.7);
+        }
+    }
+    LDLFactorization ldl_band(K);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldl_band.factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldl_band.refactorize(K2));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ldl_band.solve(b, x));
+    err = K2 * x - b;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT(std::abs(err.get(i, 0)) < tol);
+    }
+    Matrix K3 = MatrixFactory::MakeBandedSymmetric(n, 2);
+    for (size_t i = 0; i < n; i++) {
+        K3.set(i, i, 1.0);
+    }
+    _ASSERT_EXCEPTION(ldl_band.refactorize(K3), std::invalid_argument);
+}
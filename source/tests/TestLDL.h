@@ -24,6 +24,10 @@ class TestLDL : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(testSolveSymmetric);
     CPPUNIT_TEST(testSolveSparse);
     CPPUNIT_TEST(testSolveSparse2);
+    CPPUNIT_TEST(testSolveBanded);
+    CPPUNIT_TEST(testSparseOrdering);
+    CPPUNIT_TEST(testMixedPrecision);
+    CPPUNIT_TEST(testRefactorize);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -38,6 +42,10 @@ private:
     void testSolveSymmetric();
     void testSolveSparse();
     void testSolveSparse2();
+    void testSolveBanded();
+    void testSparseOrdering();
+    void testMixedPrecision();
+    void testRefactorize();
 
 };
 
@@ -20,6 +20,8 @@
 
 #include "TestMatrix.h"
 
+#include <thread>
+#include <vector>
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestMatrix);
 
@@ -269,6 +271,63 @@ void TestMatrix::testAssignment() {
     _ASSERT_OK(f = f);
 }
 
+void TestMatrix::testMoveConstructor() {
+    const size_t n = 8;
+    const size_t m = 3;
+    Matrix f = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix f_copy(f);
+    double * data = f.getData();
+
+    Matrix g(std::move(f));
+    _ASSERT_EQ(data, g.getData()); /* no allocation, no copy */
+    _ASSERT_EQ(n, g.getNrows());
+    _ASSERT_EQ(m, g.getNcols());
+    _ASSERT_EQ(f_copy, g);
+    _ASSERT(f.isEmpty());
+    _ASSERT_EQ(static_cast<size_t> (0), f.length());
+
+    Matrix S = MatrixFactory::MakeRandomSparse(n, n, 10, 0.0, 1.0);
+    Matrix S_copy(S);
+    Matrix T(std::move(S));
+    _ASSERT_EQ(Matrix::MATRIX_SPARSE, T.getType());
+    _ASSERT_EQ(S_copy, T);
+    _ASSERT(S.isEmpty());
+}
+
+void TestMatrix::testMoveAssignment() {
+    const size_t n = 10;
+    Matrix A = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix y = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix y_expected(n, 1);
+    Matrix::mult(y_expected, 1.0, A, x, 0.0);
+
+    y = A * x; /* move-assign a temporary */
+    _ASSERT_EQ(y_expected, y);
+
+    Matrix z(n, 1);
+    double * z_data = z.getData();
+    z = y_expected; /* copy-assign: buffer of the same size is reused */
+    _ASSERT_EQ(z_data, z.getData());
+    _ASSERT_EQ(y_expected, z);
+
+    Matrix w;
+    w = std::move(z);
+    _ASSERT_EQ(z_data, w.getData());
+    _ASSERT(z.isEmpty());
+    _ASSERT_EQ(y_expected, w);
+}
+
+void TestMatrix::testMoveShallow() {
+    const size_t n = 10;
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix x_part = MatrixFactory::ShallowVector();
+    x_part = MatrixFactory::ShallowVector(x, 4, 2);
+    _ASSERT_EQ(x.getData() + 2, x_part.getData());
+    x_part[0] = 100.0;
+    _ASSERT_EQ(100.0, x[2]);
+}
+
 void TestMatrix::testAdditionBad() {
     Matrix A(5, 6);
     Matrix B(7, 8);
@@ -1422,6 +1481,123 @@ void TestMatrix::testSparseDotProd() {
     _ASSERT_EQ(4.0, result.get(0, 0));
 }
 
+void TestMatrix::testSparseSetTranspose() {
+    const size_t n = 4;
+    const size_t m = 3;
+    Matrix S = MatrixFactory::MakeSparse(n, m, 4, Matrix::SPARSE_UNSYMMETRIC);
+    S.set(0, 0, 1.0);
+    S.set(3, 1, 2.0);
+    S.set(2, 2, 3.0);
+
+    S.transpose();
+    _ASSERT_EQ(m, S.getNrows());
+    _ASSERT_EQ(n, S.getNcols());
+    _ASSERT_EQ(2.0, S.get(1, 3));
+    _ASSERT_EQ(0.0, S.get(0, 3));
+
+    S.set(0, 2, 7.0); /* set on the transpose */
+    _ASSERT_EQ(7.0, S.get(0, 2));
+    _ASSERT_EQ(2.0, S.get(1, 3));
+
+    S.transpose();
+    _ASSERT_EQ(7.0, S.get(2, 0));
+    _ASSERT_EQ(0.0, S.get(0, 2));
+}
+
+void TestMatrix::testSparseSetAfterMultiply() {
+    const size_t n = 6;
+    const double tol = 1e-10;
+    Matrix A = MatrixFactory::MakeSparse(n, n, 2 * n, Matrix::SPARSE_UNSYMMETRIC);
+    for (size_t i = 0; i < n; i++) {
+        A.set(i, i, 2.0 + i);
+    }
+    A.set(0, n - 1, 1.5);
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+
+    for (size_t round = 0; round < 4; round++) {
+        Matrix y = A * x;
+        for (size_t i = 0; i < n; i++) {
+            double yi = 0.0;
+            for (size_t j = 0; j < n; j++) {
+                yi += A.get(i, j) * x.get(j, 0);
+            }
+            _ASSERT_NUM_EQ(yi, y.get(i, 0), tol);
+        }
+        switch (round) {
+            case 0: /* existing nonzero: same sparsity pattern */
+                A.set(0, n - 1, -3.0);
+                _ASSERT_EQ(-3.0, A.get(0, n - 1));
+                break;
+            case 1: /* new nonzero: the pattern changes */
+                A.set(n - 1, 0, 4.0);
+                _ASSERT_EQ(4.0, A.get(n - 1, 0));
+                _ASSERT_EQ(-3.0, A.get(0, n - 1));
+                break;
+            case 2: /* transposition does not touch the data */
+                A.transpose();
+                _ASSERT_EQ(-3.0, A.get(n - 1, 0));
+                _ASSERT_EQ(4.0, A.get(0, n - 1));
+                break;
+            default:
+                break;
+        }
+    }
+}
+
+void TestMatrix::testSparseScaleInPlace() {
+    const size_t n = 15;
+    const size_t m = 9;
+    const double tol = 1e-10;
+    Matrix A = MatrixFactory::MakeRandomSparse(n, m, 30, -1.0, 2.0);
+    Matrix A0(A);
+    Matrix x = MatrixFactory::MakeRandomMatrix(m, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix y0 = A * x;
+
+    A *= 2.5;
+    Matrix y = A * x;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(2.5 * y0.get(i, 0), y.get(i, 0), tol);
+        for (size_t j = 0; j < m; j++) {
+            _ASSERT_NUM_EQ(2.5 * A0.get(i, j), A.get(i, j), tol);
+        }
+    }
+
+    A.transpose();
+    A *= -2.0;
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(-5.0 * A0.get(j, i), A.get(i, j), tol);
+        }
+    }
+}
+
+void TestMatrix::testSparseAddSamePattern() {
+    const size_t n = 12;
+    const size_t m = 7;
+    const double tol = 1e-10;
+    Matrix A = MatrixFactory::MakeRandomSparse(n, m, 25, -1.0, 2.0);
+    Matrix B(A);
+    B *= 3.0;
+    Matrix A0(A);
+
+    A += B; /* A and B have the same sparsity pattern */
+    _ASSERT_EQ(Matrix::MATRIX_SPARSE, A.getType());
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < m; j++) {
+            _ASSERT_NUM_EQ(4.0 * A0.get(i, j), A.get(i, j), tol);
+        }
+    }
+
+    A.transpose();
+    B.transpose();
+    A -= B;
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(A0.get(j, i), A.get(i, j), tol);
+        }
+    }
+}
+
 /* Tests R = DENSE + (?) */
 
 void TestMatrix::test_ADD2() {
@@ -2295,3 +2471,965 @@ void TestMatrix::test_ASTDT() {
 
 
 
+
+/* fills the band of a banded matrix with random entries */
+static void random_band(Matrix& B) {
+    for (size_t j = 0; j < B.getNcols(); j++) {
+        for (size_t i = 0; i < B.getNrows(); i++) {
+            if (i <= j + B.getLowerBandwidth() && j <= i + B.getUpperBandwidth()) {
+                B.set(i, j, 1.0 + static_cast<double> (std::rand()) / RAND_MAX);
+            }
+        }
+    }
+}
+
+/* dense copy of any matrix */
+static Matrix dense_copy(Matrix& B) {
+    Matrix D(B.getNrows(), B.getNcols());
+    for (size_t i = 0; i < B.getNrows(); i++) {
+        for (size_t j = 0; j < B.getNcols(); j++) {
+            D.set(i, j, B.get(i, j));
+        }
+    }
+    return D;
+}
+
+void TestMatrix::testBanded() {
+    size_t n = 8;
+    size_t m = 6;
+    Matrix B = MatrixFactory::MakeBanded(n, m, 2, 1);
+    _ASSERT_EQ(Matrix::MATRIX_BANDED, B.getType());
+    _ASSERT_EQ(static_cast<size_t> (2), B.getLowerBandwidth());
+    _ASSERT_EQ(static_cast<size_t> (1), B.getUpperBandwidth());
+    _ASSERT_EQ(static_cast<size_t> (4 * m), B.length());
+    _ASSERT_NOT(B.isSymmetric());
+
+    B.set(3, 1, 1.5);
+    B.set(1, 2, -2.0);
+    _ASSERT_EQ(1.5, B.get(3, 1));
+    _ASSERT_EQ(-2.0, B.get(1, 2));
+    _ASSERT_EQ(0.0, B.get(1, 3));
+    _ASSERT_EQ(0.0, B.get(4, 1));
+    _ASSERT_EXCEPTION(B.set(4, 1, 1.0), std::out_of_range);
+    _ASSERT_EXCEPTION(B.set(0, 2, 1.0), std::out_of_range);
+
+    B.transpose();
+    _ASSERT_EQ(m, B.getNrows());
+    _ASSERT_EQ(n, B.getNcols());
+    _ASSERT_EQ(static_cast<size_t> (1), B.getLowerBandwidth());
+    _ASSERT_EQ(static_cast<size_t> (2), B.getUpperBandwidth());
+    _ASSERT_EQ(1.5, B.get(1, 3));
+    _ASSERT_EQ(-2.0, B.get(2, 1));
+    _ASSERT_EXCEPTION(B.set(1, 4, 1.0), std::out_of_range);
+
+    random_band(B);
+    Matrix D = dense_copy(B);
+    _ASSERT_NUM_EQ(D.norm_fro_sq(), B.norm_fro_sq(), 1e-10);
+
+    Matrix B_copy(B);
+    _ASSERT_EQ(B, B_copy);
+    Matrix B_assigned;
+    B_assigned = B;
+    _ASSERT_EQ(B, B_assigned);
+
+    Matrix S = B + B_copy; /* element-wise on the band */
+    _ASSERT_EQ(Matrix::MATRIX_BANDED, S.getType());
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(2.0 * D.get(i, j), S.get(i, j), 1e-10);
+        }
+    }
+
+    _ASSERT_EXCEPTION(MatrixFactory::MakeBanded(4, 4, 4, 0), std::invalid_argument);
+    _ASSERT_EXCEPTION(MatrixFactory::MakeBandedSymmetric(3, 3), std::invalid_argument);
+}
+
+void TestMatrix::testBandedSymmetric() {
+    size_t n = 10;
+    size_t kd = 2;
+    Matrix H = MatrixFactory::MakeBandedSymmetric(n, kd);
+    _ASSERT_EQ(Matrix::MATRIX_BANDED, H.getType());
+    _ASSERT(H.isSymmetric());
+    _ASSERT_EQ(kd, H.getLowerBandwidth());
+    _ASSERT_EQ(kd, H.getUpperBandwidth());
+    _ASSERT_EQ((kd + 1) * n, H.length());
+
+    H.set(5, 3, 0.7);
+    _ASSERT_EQ(0.7, H.get(3, 5));
+    H.set(2, 4, -1.1);
+    _ASSERT_EQ(-1.1, H.get(4, 2));
+    _ASSERT_EXCEPTION(H.set(0, 3, 1.0), std::out_of_range);
+
+    random_band(H);
+    Matrix D = dense_copy(H);
+    H.transpose(); /* no effect */
+    _ASSERT_EQ(D.get(3, 1), H.get(3, 1));
+    _ASSERT_NUM_EQ(D.norm_fro_sq(), H.norm_fro_sq(), 1e-10);
+
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    _ASSERT_NUM_EQ(D.quad(x), H.quad(x), 1e-10);
+}
+
+void TestMatrix::test_MBD() {
+    size_t n = 12;
+    size_t m = 9;
+    const double tol = 1e-10;
+    Matrix B = MatrixFactory::MakeBanded(n, m, 3, 1);
+    random_band(B);
+    Matrix D = dense_copy(B);
+
+    Matrix x = MatrixFactory::MakeRandomMatrix(m, 1, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix y = B * x;
+    Matrix y_expected = D * x;
+    _ASSERT_EQ(y_expected, y);
+
+    Matrix X = MatrixFactory::MakeRandomMatrix(m, 3, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix Y = B * X;
+    Matrix Y_expected = D * X;
+    _ASSERT_EQ(Y_expected, Y);
+
+    /* C := gamma*C + alpha*B'*Z */
+    Matrix Z = MatrixFactory::MakeRandomMatrix(n, 2, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix C = MatrixFactory::MakeRandomMatrix(m, 2, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix C_expected(C);
+    _ASSERT_OK(Matrix::mult(C, 0.5, B, Z, 2.0, true));
+    _ASSERT_OK(Matrix::mult(C_expected, 0.5, D, Z, 2.0, true));
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            _ASSERT_NUM_EQ(C_expected.get(i, j), C.get(i, j), tol);
+        }
+    }
+
+    /* transposed banded matrix */
+    B.transpose();
+    D.transpose();
+    Matrix w = B * Z;
+    Matrix w_expected = D * Z;
+    _ASSERT_EQ(w_expected, w);
+}
+
+void TestMatrix::test_MBHD() {
+    size_t n = 15;
+    Matrix H = MatrixFactory::MakeBandedSymmetric(n, 3);
+    random_band(H);
+    Matrix D = dense_copy(H);
+    Matrix X = MatrixFactory::MakeRandomMatrix(n, 2, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix Y = H * X;
+    Matrix Y_expected = D * X;
+    _ASSERT_EQ(Y_expected, Y);
+
+    Matrix C = MatrixFactory::MakeRandomMatrix(n, 2, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix C_expected(C);
+    _ASSERT_OK(Matrix::mult(C, -1.0, H, X, 0.5, true));
+    _ASSERT_OK(Matrix::mult(C_expected, -1.0, D, X, 0.5));
+    _ASSERT_EQ(C_expected, C);
+}
+
+void TestMatrix::test_ABX() {
+    size_t n = 7;
+    const double tol = 1e-10;
+    Matrix B = MatrixFactory::MakeBanded(n, n, 1, 2);
+    random_band(B);
+    Matrix B_dense = dense_copy(B);
+
+    /* BANDED + DIAGONAL = BANDED */
+    Matrix I = MatrixFactory::MakeIdentity(n, 3.0);
+    Matrix BI(B);
+    _ASSERT_OK(Matrix::add(BI, 1.0, I, 2.0));
+    _ASSERT_EQ(Matrix::MATRIX_BANDED, BI.getType());
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(2.0 * B_dense.get(i, j) + (i == j ? 3.0 : 0.0), BI.get(i, j), tol);
+        }
+    }
+
+    /* BANDED + DENSE = DENSE */
+    Matrix D = MatrixFactory::MakeRandomMatrix(n, n, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix BD(B);
+    _ASSERT_EQ(ForBESUtils::STATUS_HAD_TO_REALLOC, Matrix::add(BD, 1.0, D, 1.0));
+    _ASSERT_EQ(Matrix::MATRIX_DENSE, BD.getType());
+
+    /* DENSE + BANDED = DENSE */
+    Matrix DB(D);
+    _ASSERT_OK(Matrix::add(DB, -1.0, B, 0.5));
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(B_dense.get(i, j) + D.get(i, j), BD.get(i, j), tol);
+            _ASSERT_NUM_EQ(0.5 * D.get(i, j) - B_dense.get(i, j), DB.get(i, j), tol);
+        }
+    }
+
+    /* BANDED + BANDED (different bands) = DENSE */
+    Matrix H = MatrixFactory::MakeBandedSymmetric(n, 1);
+    random_band(H);
+    Matrix BH(B);
+    BH += H;
+    _ASSERT_EQ(Matrix::MATRIX_DENSE, BH.getType());
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(B_dense.get(i, j) + H.get(i, j), BH.get(i, j), tol);
+        }
+    }
+}
+
+void TestMatrix::test_AXA() {
+    size_t n = 6;
+    const double tol = 1e-10;
+    const double alpha = -1.5;
+    const double gamma = 0.5;
+    Matrix X = MatrixFactory::MakeRandomMatrix(n, n, 2.0, 10.0, Matrix::MATRIX_DIAGONAL);
+
+    Matrix B = MatrixFactory::MakeBanded(n, n, 1, 2);
+    random_band(B);
+    Matrix Bt(B);
+    Bt.transpose();
+    Matrix K = MatrixFactory::MakeBandedSymmetric(n, 1);
+    random_band(K);
+    std::vector<size_t> sizes = {2, 4};
+    Matrix Q = MatrixFactory::MakeBlock(sizes, sizes);
+    Q.setBlock(0, 0, MatrixFactory::MakeRandomMatrix(2, 2, -1.0, 2.0, Matrix::MATRIX_DENSE));
+    Q.setBlock(1, 0, MatrixFactory::MakeRandomSparse(4, 2, 3, -1.0, 2.0));
+    Matrix Dt = MatrixFactory::MakeRandomMatrix(n, n, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Dt.transpose();
+    Matrix Lt = MatrixFactory::MakeRandomMatrix(n, n, -1.0, 2.0, Matrix::MATRIX_LOWERTR);
+    Lt.transpose();
+
+    /* DIAGONAL + A: the result has the type of A (DENSE for BLOCK) */
+    std::vector<Matrix> operands = {
+        MatrixFactory::MakeRandomMatrix(n, n, -1.0, 2.0, Matrix::MATRIX_DENSE),
+        Dt,
+        MatrixFactory::MakeRandomMatrix(n, n, -1.0, 2.0, Matrix::MATRIX_SYMMETRIC),
+        MatrixFactory::MakeRandomMatrix(n, n, -1.0, 2.0, Matrix::MATRIX_LOWERTR),
+        Lt,
+        MatrixFactory::MakeRandomSparse(n, n, 10, -1.0, 2.0),
+        B, Bt, K, Q
+    };
+    for (size_t k = 0; k < operands.size(); k++) {
+        Matrix& A = operands[k];
+        Matrix C(X);
+        _ASSERT_EQ(ForBESUtils::STATUS_HAD_TO_REALLOC, Matrix::add(C, alpha, A, gamma));
+        Matrix::MatrixType expected_type = A.getType() == Matrix::MATRIX_BLOCK
+                ? Matrix::MATRIX_DENSE : A.getType();
+        _ASSERT_EQ(expected_type, C.getType());
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                _ASSERT_NUM_EQ(gamma * X.get(i, j) + alpha * A.get(i, j), C.get(i, j), tol);
+            }
+        }
+    }
+
+    /* through the operators */
+    Matrix S = MatrixFactory::MakeRandomSparse(n, n, 10, -1.0, 2.0);
+    Matrix R = X + S;
+    _ASSERT_EQ(Matrix::MATRIX_SPARSE, R.getType());
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(X.get(i, j) + S.get(i, j), R.get(i, j), tol);
+        }
+    }
+}
+
+/* a 10x8 block matrix with dense, sparse, banded, diagonal and zero blocks */
+static Matrix random_block() {
+    std::vector<size_t> rows = {3, 4, 3};
+    std::vector<size_t> cols = {5, 3};
+    Matrix A = MatrixFactory::MakeBlock(rows, cols);
+    A.setBlock(0, 0, MatrixFactory::MakeRandomMatrix(3, 5, -1.0, 2.0, Matrix::MATRIX_DENSE));
+    A.setBlock(1, 0, MatrixFactory::MakeRandomSparse(4, 5, 7, -1.0, 2.0));
+    A.setBlock(1, 1, MatrixFactory::MakeRandomSparse(4, 3, 5, -1.0, 2.0));
+    Matrix B = MatrixFactory::MakeBanded(3, 5, 1, 1);
+    random_band(B);
+    A.setBlock(2, 0, B);
+    A.setBlock(2, 1, MatrixFactory::MakeRandomMatrix(3, 3, 1.0, 2.0, Matrix::MATRIX_DIAGONAL));
+    return A;
+}
+
+void TestMatrix::testBlock() {
+    std::vector<size_t> rows = {2, 3};
+    std::vector<size_t> cols = {4, 1, 2};
+    Matrix A = MatrixFactory::MakeBlock(rows, cols);
+    _ASSERT_EQ(Matrix::MATRIX_BLOCK, A.getType());
+    _ASSERT_EQ(static_cast<size_t> (5), A.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (7), A.getNcols());
+    _ASSERT_EQ(static_cast<size_t> (2), A.getBlockRows());
+    _ASSERT_EQ(static_cast<size_t> (3), A.getBlockCols());
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = 0; j < 7; j++) {
+            _ASSERT_EQ(0.0, A.get(i, j));
+        }
+    }
+
+    Matrix A01 = MatrixFactory::MakeRandomMatrix(2, 1, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix A12 = MatrixFactory::MakeRandomSparse(3, 2, 3, -1.0, 2.0);
+    A.setBlock(0, 1, A01);
+    A.setBlock(1, 2, A12);
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            _ASSERT_EQ(A12.get(i, j), A.get(2 + i, 5 + j));
+        }
+    }
+    _ASSERT_EQ(A01.get(1, 0), A.get(1, 4));
+    A.set(1, 4, 3.5);
+    _ASSERT_EQ(3.5, A.get(1, 4));
+    _ASSERT_EXCEPTION(A.set(0, 0, 1.0), std::logic_error);
+
+    Matrix A12_copy = A.getBlock(1, 2);
+    _ASSERT_EQ(Matrix::MATRIX_SPARSE, A12_copy.getType());
+    _ASSERT_EQ(A12, A12_copy);
+    Matrix A00 = A.getBlock(0, 0);
+    _ASSERT_EQ(static_cast<size_t> (2), A00.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (4), A00.getNcols());
+    _ASSERT_EQ(0.0, A00.get(1, 3));
+
+    _ASSERT_EXCEPTION(A.setBlock(0, 3, A01), std::out_of_range);
+    _ASSERT_EXCEPTION(A.setBlock(1, 1, A01), std::invalid_argument);
+    _ASSERT_EXCEPTION(A01.setBlock(0, 0, A01), std::logic_error);
+    _ASSERT_EXCEPTION(MatrixFactory::MakeBlock(std::vector<size_t>(), cols), std::invalid_argument);
+    _ASSERT_EXCEPTION(MatrixFactory::MakeBlock(rows, std::vector<size_t>(2, 0)), std::invalid_argument);
+
+    /* transposition */
+    Matrix A_copy(A);
+    A.transpose();
+    _ASSERT_EQ(static_cast<size_t> (7), A.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (3), A.getBlockRows());
+    _ASSERT_EQ(static_cast<size_t> (2), A.getBlockCols());
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = 0; j < 7; j++) {
+            _ASSERT_EQ(A_copy.get(i, j), A.get(j, i));
+        }
+    }
+    Matrix A21 = A.getBlock(2, 1);
+    _ASSERT_EQ(static_cast<size_t> (2), A21.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (3), A21.getNcols());
+    Matrix B = MatrixFactory::MakeRandomMatrix(4, 3, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    A.setBlock(0, 1, B);
+    _ASSERT_EQ(B.get(3, 2), A.get(3, 4));
+    _ASSERT_EQ(B.get(1, 0), A.get(1, 2));
+    _ASSERT_EQ(0.0, A_copy.get(4, 3)); /* the copy is not affected */
+
+    const double tol = 1e-10;
+    Matrix D = dense_copy(A_copy);
+    _ASSERT_NUM_EQ(D.norm_fro_sq(), A_copy.norm_fro_sq(), tol);
+    A_copy *= 2.0;
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = 0; j < 7; j++) {
+            _ASSERT_NUM_EQ(2.0 * D.get(i, j), A_copy.get(i, j), tol);
+        }
+    }
+}
+
+void TestMatrix::test_MBlockD() {
+    const double tol = 1e-10;
+    Matrix A = random_block();
+    Matrix D = dense_copy(A);
+
+    Matrix x = MatrixFactory::MakeRandomMatrix(8, 1, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix y = A * x;
+    Matrix y_expected = D * x;
+    for (size_t i = 0; i < 10; i++) {
+        _ASSERT_NUM_EQ(y_expected.get(i, 0), y.get(i, 0), tol);
+    }
+
+    /* C := gamma*C + alpha*A'*Z */
+    Matrix Z = MatrixFactory::MakeRandomMatrix(10, 3, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix C = MatrixFactory::MakeRandomMatrix(8, 3, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix C_expected(C);
+    _ASSERT_OK(Matrix::mult(C, 0.5, A, Z, 2.0, true));
+    _ASSERT_OK(Matrix::mult(C_expected, 0.5, D, Z, 2.0, true));
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t j = 0; j < 3; j++) {
+            _ASSERT_NUM_EQ(C_expected.get(i, j), C.get(i, j), tol);
+        }
+    }
+
+    /* transposed block matrix times sparse matrix */
+    A.transpose();
+    D.transpose();
+    Matrix S = MatrixFactory::MakeRandomSparse(10, 4, 12, -1.0, 2.0);
+    Matrix W = A * S;
+    Matrix W_expected = D * S;
+    _ASSERT_EQ(static_cast<size_t> (8), W.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (4), W.getNcols());
+    for (size_t i = 0; i < 8; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            _ASSERT_NUM_EQ(W_expected.get(i, j), W.get(i, j), tol);
+        }
+    }
+
+    /* many blocks (which are multiplied in parallel) */
+    size_t nb = 20;
+    std::vector<size_t> sizes(nb, 5);
+    Matrix L = MatrixFactory::MakeBlock(sizes, sizes);
+    for (size_t I = 0; I < nb; I++) {
+        L.setBlock(I, I, MatrixFactory::MakeRandomMatrix(5, 5, 1.0, 2.0, Matrix::MATRIX_DIAGONAL));
+        if (I > 0) {
+            L.setBlock(I, I - 1, MatrixFactory::MakeRandomMatrix(5, 5, -1.0, 2.0, Matrix::MATRIX_DENSE));
+        }
+    }
+    Matrix L_dense = dense_copy(L);
+    Matrix X = MatrixFactory::MakeRandomMatrix(5 * nb, 2, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix Y = L * X;
+    Matrix Y_expected = L_dense * X;
+    for (size_t i = 0; i < 5 * nb; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            _ASSERT_NUM_EQ(Y_expected.get(i, j), Y.get(i, j), tol);
+        }
+    }
+}
+
+void TestMatrix::test_ABlock() {
+    const double tol = 1e-10;
+    Matrix A = random_block();
+    Matrix A_dense = dense_copy(A);
+
+    /* BLOCK + BLOCK (same partition) = BLOCK */
+    Matrix B = random_block();
+    Matrix B_dense = dense_copy(B);
+    Matrix AB(A);
+    _ASSERT_OK(Matrix::add(AB, 2.0, B, 0.5));
+    _ASSERT_EQ(Matrix::MATRIX_BLOCK, AB.getType());
+    for (size_t i = 0; i < 10; i++) {
+        for (size_t j = 0; j < 8; j++) {
+            _ASSERT_NUM_EQ(0.5 * A_dense.get(i, j) + 2.0 * B_dense.get(i, j), AB.get(i, j), tol);
+        }
+    }
+
+    /* a zero block of C and a nonzero block of A */
+    std::vector<size_t> rows = {3, 4, 3};
+    std::vector<size_t> cols = {5, 3};
+    Matrix Z = MatrixFactory::MakeBlock(rows, cols);
+    _ASSERT_OK(Matrix::add(Z, -1.0, A, 1.0));
+    for (size_t i = 0; i < 10; i++) {
+        for (size_t j = 0; j < 8; j++) {
+            _ASSERT_NUM_EQ(-A_dense.get(i, j), Z.get(i, j), tol);
+        }
+    }
+
+    /* BLOCK + DENSE = DENSE */
+    Matrix D = MatrixFactory::MakeRandomMatrix(10, 8, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix AD(A);
+    _ASSERT_EQ(ForBESUtils::STATUS_HAD_TO_REALLOC, Matrix::add(AD, 1.0, D, 3.0));
+    _ASSERT_EQ(Matrix::MATRIX_DENSE, AD.getType());
+
+    /* DENSE + BLOCK' = DENSE */
+    Matrix At(A);
+    At.transpose();
+    Matrix E = MatrixFactory::MakeRandomMatrix(8, 10, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix EA(E);
+    _ASSERT_OK(Matrix::add(EA, 2.0, At, -1.0));
+    for (size_t i = 0; i < 10; i++) {
+        for (size_t j = 0; j < 8; j++) {
+            _ASSERT_NUM_EQ(3.0 * A_dense.get(i, j) + D.get(i, j), AD.get(i, j), tol);
+            _ASSERT_NUM_EQ(2.0 * A_dense.get(i, j) - E.get(j, i), EA.get(j, i), tol);
+        }
+    }
+
+    /* BLOCK + DIAGONAL = BLOCK (square blocks on the diagonal) */
+    std::vector<size_t> sizes = {2, 3};
+    Matrix S = MatrixFactory::MakeBlock(sizes, sizes);
+    S.setBlock(0, 1, MatrixFactory::MakeRandomMatrix(2, 3, -1.0, 2.0, Matrix::MATRIX_DENSE));
+    S.setBlock(1, 1, MatrixFactory::MakeRandomMatrix(3, 3, -1.0, 2.0, Matrix::MATRIX_DENSE));
+    Matrix S_dense = dense_copy(S);
+    Matrix I = MatrixFactory::MakeIdentity(5, 4.0);
+    _ASSERT_OK(Matrix::add(S, 1.0, I, 2.0));
+    _ASSERT_EQ(Matrix::MATRIX_BLOCK, S.getType());
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = 0; j < 5; j++) {
+            _ASSERT_NUM_EQ(2.0 * S_dense.get(i, j) + (i == j ? 4.0 : 0.0), S.get(i, j), tol);
+        }
+    }
+}
+
+void TestMatrix::testBlockQuad() {
+    std::vector<size_t> sizes = {4, 2, 3};
+    Matrix Q = MatrixFactory::MakeBlock(sizes, sizes);
+    Matrix Q00 = MatrixFactory::MakeRandomMatrix(4, 4, -1.0, 2.0, Matrix::MATRIX_SYMMETRIC);
+    Matrix Q12 = MatrixFactory::MakeRandomMatrix(2, 3, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Q.setBlock(0, 0, Q00);
+    Q.setBlock(1, 2, Q12);
+    Q12.transpose();
+    Q.setBlock(2, 1, Q12);
+    Q.setBlock(2, 2, MatrixFactory::MakeRandomMatrix(3, 3, 1.0, 2.0, Matrix::MATRIX_DIAGONAL));
+    Matrix Q_dense = dense_copy(Q);
+    Matrix x = MatrixFactory::MakeRandomMatrix(9, 1, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    _ASSERT_NUM_EQ(Q_dense.quad(x), Q.quad(x), 1e-10);
+}
+
+/* largest absolute difference between the elements of two matrices */
+static double max_diff(Matrix& A, Matrix& B) {
+    double d = 0.0;
+    for (size_t i = 0; i < A.getNrows(); i++) {
+        for (size_t j = 0; j < A.getNcols(); j++) {
+            d = std::max(d, std::abs(A.get(i, j) - B.get(i, j)));
+        }
+    }
+    return d;
+}
+
+void TestMatrix::testMultStructured() {
+    const double tol = 1e-10;
+    size_t n = 9;
+    size_t m = 5;
+    size_t k = 4;
+    Matrix S = MatrixFactory::MakeRandomMatrix(n, n, -1.0, 2.0, Matrix::MATRIX_SYMMETRIC);
+    Matrix S_dense = dense_copy(S);
+
+    /* SYMMETRIC * DENSE (dsymm) */
+    Matrix B = MatrixFactory::MakeRandomMatrix(n, k, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix C = MatrixFactory::MakeRandomMatrix(n, k, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix C_expected(C);
+    _ASSERT_OK(Matrix::mult(C, 2.0, S, B, -0.5));
+    _ASSERT_OK(Matrix::mult(C_expected, 2.0, S_dense, B, -0.5));
+    _ASSERT(max_diff(C_expected, C) < tol);
+    Matrix SB = S * B;
+    Matrix SB_expected = S_dense * B;
+    _ASSERT(max_diff(SB_expected, SB) < tol);
+
+    /* SYMMETRIC * DENSE' */
+    Matrix Bt = MatrixFactory::MakeRandomMatrix(k, n, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Bt.transpose();
+    Matrix SBt = S * Bt;
+    Matrix SBt_expected = S_dense * Bt;
+    _ASSERT(max_diff(SBt_expected, SBt) < tol);
+
+    /* DENSE * SYMMETRIC and DENSE' * SYMMETRIC (dsymm from the right) */
+    Matrix A = MatrixFactory::MakeRandomMatrix(m, n, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix AS = A * S;
+    Matrix AS_expected = A * S_dense;
+    _ASSERT(max_diff(AS_expected, AS) < tol);
+    Matrix At = MatrixFactory::MakeRandomMatrix(n, m, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix D = MatrixFactory::MakeRandomMatrix(m, n, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix D_expected(D);
+    _ASSERT_OK(Matrix::mult(D, 1.5, At, S, 0.5, true));
+    _ASSERT_OK(Matrix::mult(D_expected, 1.5, At, S_dense, 0.5, true));
+    _ASSERT(max_diff(D_expected, D) < tol);
+
+    /* DENSE * DIAGONAL and DIAGONAL * DENSE (row/column scaling) */
+    Matrix Q = MatrixFactory::MakeRandomMatrix(n, n, 1.0, 2.0, Matrix::MATRIX_DIAGONAL);
+    Matrix Q_dense = dense_copy(Q);
+    Matrix AQ = A * Q;
+    Matrix AQ_expected = A * Q_dense;
+    _ASSERT(max_diff(AQ_expected, AQ) < tol);
+    Matrix E = MatrixFactory::MakeRandomMatrix(m, n, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix E_expected(E);
+    _ASSERT_OK(Matrix::mult(E, -1.0, At, Q, 3.0, true));
+    _ASSERT_OK(Matrix::mult(E_expected, -1.0, At, Q_dense, 3.0, true));
+    _ASSERT(max_diff(E_expected, E) < tol);
+    Matrix QB = Q * B;
+    Matrix QB_expected = Q_dense * B;
+    _ASSERT(max_diff(QB_expected, QB) < tol);
+    Matrix F = MatrixFactory::MakeRandomMatrix(n, k, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix F_expected(F);
+    _ASSERT_OK(Matrix::mult(F, 0.5, Q, Bt, 2.0));
+    _ASSERT_OK(Matrix::mult(F_expected, 0.5, Q_dense, Bt, 2.0));
+    _ASSERT(max_diff(F_expected, F) < tol);
+
+    /* DIAGONAL * SYMMETRIC, DIAGONAL * SPARSE */
+    Matrix QS(n, n);
+    _ASSERT_OK(Matrix::mult(QS, 1.0, Q, S, 0.0));
+    Matrix QS_expected = Q_dense * S_dense;
+    _ASSERT(max_diff(QS_expected, QS) < tol);
+    Matrix Sp = MatrixFactory::MakeRandomSparse(n, k, 12, -1.0, 2.0);
+    Matrix QSp(n, k);
+    _ASSERT_OK(Matrix::mult(QSp, 2.0, Q, Sp, 0.0));
+    Matrix QSp_expected = Q_dense * Sp;
+    QSp_expected *= 2.0;
+    _ASSERT(max_diff(QSp_expected, QSp) < tol);
+
+    /* DENSE * SPARSE and DENSE' * SPARSE */
+    Matrix G = MatrixFactory::MakeRandomMatrix(m, k, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix G_expected(G);
+    Matrix Sp_dense = dense_copy(Sp);
+    _ASSERT_OK(Matrix::mult(G, 2.0, A, Sp, 0.5));
+    _ASSERT_OK(Matrix::mult(G_expected, 2.0, A, Sp_dense, 0.5));
+    _ASSERT(max_diff(G_expected, G) < tol);
+    Matrix H(m, k);
+    Matrix H_expected(m, k);
+    _ASSERT_OK(Matrix::mult(H, 1.0, At, Sp, 0.0, true));
+    _ASSERT_OK(Matrix::mult(H_expected, 1.0, At, Sp_dense, 0.0, true));
+    _ASSERT(max_diff(H_expected, H) < tol);
+
+    /* DENSE * SPARSE (symmetric) */
+    Matrix Ssp = MatrixFactory::MakeSparseSymmetric(n, 6);
+    Ssp.set(0, 0, 2.0);
+    Ssp.set(3, 1, -1.0);
+    Ssp.set(8, 2, 0.5);
+    Matrix Ssp_dense = dense_copy(Ssp);
+    Matrix ASsp(m, n);
+    _ASSERT_OK(Matrix::mult(ASsp, 1.0, A, Ssp, 0.0));
+    Matrix ASsp_expected = A * Ssp_dense;
+    _ASSERT(max_diff(ASsp_expected, ASsp) < tol);
+}
+
+void TestMatrix::testMultLowerTriangular() {
+    const double tol = 1e-10;
+    size_t n = 8;
+    size_t k = 3;
+    Matrix L = MatrixFactory::MakeRandomMatrix(n, n, 1.0, 2.0, Matrix::MATRIX_LOWERTR);
+    Matrix L_dense = dense_copy(L);
+
+    /* LOWER * vector (dtpmv) */
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix y = L * x;
+    Matrix y_expected = L_dense * x;
+    _ASSERT(max_diff(y_expected, y) < tol);
+
+    /* LOWER' * vector */
+    Matrix z = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix z_expected(z);
+    _ASSERT_OK(Matrix::mult(z, 2.0, L, x, -1.0, true));
+    _ASSERT_OK(Matrix::mult(z_expected, 2.0, L_dense, x, -1.0, true));
+    _ASSERT(max_diff(z_expected, z) < tol);
+
+    /* LOWER * DENSE and UPPER * DENSE' (dtrmm) */
+    Matrix B = MatrixFactory::MakeRandomMatrix(n, k, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix LB = L * B;
+    Matrix LB_expected = L_dense * B;
+    _ASSERT(max_diff(LB_expected, LB) < tol);
+    Matrix U(L);
+    U.transpose();
+    Matrix U_dense = dense_copy(U);
+    Matrix Bt = MatrixFactory::MakeRandomMatrix(k, n, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Bt.transpose();
+    Matrix C = MatrixFactory::MakeRandomMatrix(n, k, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix C_expected(C);
+    _ASSERT_OK(Matrix::mult(C, -1.0, U, Bt, 0.5));
+    _ASSERT_OK(Matrix::mult(C_expected, -1.0, U_dense, Bt, 0.5));
+    _ASSERT(max_diff(C_expected, C) < tol);
+
+    /* DENSE * LOWER and DENSE * UPPER (dtrmm from the right) */
+    Matrix A = MatrixFactory::MakeRandomMatrix(k, n, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix AL = A * L;
+    Matrix AL_expected = A * L_dense;
+    _ASSERT(max_diff(AL_expected, AL) < tol);
+    Matrix AU = A * U;
+    Matrix AU_expected = A * U_dense;
+    _ASSERT(max_diff(AU_expected, AU) < tol);
+
+    /* LOWER * SPARSE */
+    Matrix S = MatrixFactory::MakeRandomSparse(n, k, 10, -1.0, 2.0);
+    Matrix LS(n, k);
+    _ASSERT_OK(Matrix::mult(LS, 1.0, L, S, 0.0));
+    Matrix LS_expected = L_dense * S;
+    _ASSERT(max_diff(LS_expected, LS) < tol);
+}
+
+void TestMatrix::testAddStructured() {
+    const double tol = 1e-10;
+    size_t n = 7;
+    Matrix A = MatrixFactory::MakeRandomMatrix(n, n, -1.0, 2.0, Matrix::MATRIX_DENSE);
+
+    /* DENSE + DIAGONAL: all elements of C are scaled by gamma */
+    Matrix Q = MatrixFactory::MakeRandomMatrix(n, n, 1.0, 2.0, Matrix::MATRIX_DIAGONAL);
+    Matrix AQ(A);
+    _ASSERT_OK(Matrix::add(AQ, 2.0, Q, 0.5));
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(0.5 * A.get(i, j) + 2.0 * Q.get(i, j), AQ.get(i, j), tol);
+        }
+    }
+
+    /* DENSE' + LOWER, DENSE + UPPER */
+    Matrix L = MatrixFactory::MakeRandomMatrix(n, n, -1.0, 2.0, Matrix::MATRIX_LOWERTR);
+    Matrix At(A);
+    At.transpose();
+    Matrix AtL(At);
+    _ASSERT_OK(Matrix::add(AtL, -1.0, L, 3.0));
+    Matrix U(L);
+    U.transpose();
+    Matrix AU(A);
+    _ASSERT_OK(Matrix::add(AU, 1.0, U, 1.0));
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(3.0 * A.get(j, i) - L.get(i, j), AtL.get(i, j), tol);
+            _ASSERT_NUM_EQ(A.get(i, j) + L.get(j, i), AU.get(i, j), tol);
+        }
+    }
+
+    /* DENSE + SYMMETRIC */
+    Matrix S = MatrixFactory::MakeRandomMatrix(n, n, -1.0, 2.0, Matrix::MATRIX_SYMMETRIC);
+    Matrix AS(A);
+    _ASSERT_OK(Matrix::add(AS, 0.5, S, -1.0));
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(-A.get(i, j) + 0.5 * S.get(i, j), AS.get(i, j), tol);
+        }
+    }
+
+    /* DENSE + DENSE' (rectangular) */
+    Matrix R = MatrixFactory::MakeRandomMatrix(4, 6, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix Rt = MatrixFactory::MakeRandomMatrix(6, 4, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Rt.transpose();
+    Matrix RRt(R);
+    _ASSERT_OK(Matrix::add(RRt, 2.0, Rt, 1.0));
+    for (size_t i = 0; i < 4; i++) {
+        for (size_t j = 0; j < 6; j++) {
+            _ASSERT_NUM_EQ(R.get(i, j) + 2.0 * Rt.get(i, j), RRt.get(i, j), tol);
+        }
+    }
+
+    /* LOWER + DIAGONAL */
+    Matrix LQ(L);
+    _ASSERT_OK(Matrix::add(LQ, 1.0, Q, 2.0));
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j <= i; j++) {
+            _ASSERT_NUM_EQ(2.0 * L.get(i, j) + Q.get(i, j), LQ.get(i, j), tol);
+        }
+    }
+}
+
+void TestMatrix::testSymmetricRankK() {
+    const double tol = 1e-10;
+    size_t n = 6;
+    size_t k = 9;
+    Matrix A = MatrixFactory::MakeRandomMatrix(k, n, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix C = MatrixFactory::MakeRandomMatrix(n, n, -1.0, 2.0, Matrix::MATRIX_SYMMETRIC);
+    Matrix C_expected = dense_copy(C);
+    Matrix A_copy(A);
+    /* C := 0.5*C + 2*A'*A (C remains symmetric) */
+    _ASSERT_OK(Matrix::mult(C, 2.0, A, A, 0.5, true));
+    _ASSERT_OK(Matrix::mult(C_expected, 2.0, A_copy, A_copy, 0.5, true));
+    _ASSERT_EQ(Matrix::MATRIX_SYMMETRIC, C.getType());
+    _ASSERT(max_diff(C_expected, C) < tol);
+
+    /* A is transposed, so A'A is the product of the stored data with its transpose */
+    Matrix B = MatrixFactory::MakeRandomMatrix(n, k, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    B.transpose();
+    Matrix G(n, n, Matrix::MATRIX_SYMMETRIC);
+    _ASSERT_OK(Matrix::mult(G, 1.0, B, B, 0.0, true));
+    Matrix Bt(B);
+    Bt.transpose();
+    Matrix G_expected = Bt * B;
+    _ASSERT_EQ(Matrix::MATRIX_SYMMETRIC, G.getType());
+    _ASSERT(max_diff(G_expected, G) < tol);
+
+    /* C must be n-by-n */
+    Matrix W(n + 1, n + 1, Matrix::MATRIX_SYMMETRIC);
+    _ASSERT_EXCEPTION(Matrix::mult(W, 1.0, A, A, 0.0, true), std::invalid_argument);
+}
+
+void TestMatrix::testStridedViews() {
+    const double tol = 1e-10;
+    Matrix A = MatrixFactory::MakeRandomMatrix(10, 9, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix B = MatrixFactory::MakeRandomMatrix(7, 8, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix C = MatrixFactory::MakeRandomMatrix(9, 7, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix C_orig(C);
+
+    Matrix Av = MatrixFactory::ShallowSubmatrix(A, 1, 6, 2, 6); /* 6x5 */
+    Matrix Bv = MatrixFactory::ShallowSubmatrix(B, 2, 6, 1, 4); /* 5x4 */
+    Matrix Cv = MatrixFactory::ShallowSubmatrix(C, 1, 6, 2, 5); /* 6x4 */
+    _ASSERT_NOT(Av.isContiguous());
+    _ASSERT_NOT(Cv.isContiguous());
+
+    /* Cv := 0.5 * Cv + 2 * Av * Bv (gemm on the views) */
+    Matrix A_c = dense_copy(Av);
+    Matrix B_c = dense_copy(Bv);
+    Matrix C_c = dense_copy(Cv);
+    Matrix AB = A_c * B_c;
+    _ASSERT_OK(Matrix::mult(Cv, 2.0, Av, Bv, 0.5));
+    for (size_t i = 0; i < 6; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            _ASSERT_NUM_EQ(0.5 * C_c.get(i, j) + 2.0 * AB.get(i, j), C.get(i + 1, j + 2), tol);
+        }
+    }
+    /* the rest of C is not modified */
+    for (size_t i = 0; i < C.getNrows(); i++) {
+        for (size_t j = 0; j < C.getNcols(); j++) {
+            if (i < 1 || i > 6 || j < 2 || j > 5) {
+                _ASSERT_EQ(C_orig.get(i, j), C.get(i, j));
+            }
+        }
+    }
+
+    /* the product operator */
+    Matrix AB_v = Av * Bv;
+    _ASSERT(max_diff(AB, AB_v) < tol);
+
+    /* transposed view: Cv := Cv + op(At)' * Bv */
+    Matrix At = MatrixFactory::ShallowSubmatrix(A, 0, 4, 3, 8); /* 5x6 */
+    Matrix At_c = dense_copy(At);
+    C_c = dense_copy(Cv);
+    _ASSERT_OK(Matrix::mult(C_c, 1.0, At_c, B_c, 1.0, true));
+    _ASSERT_OK(Matrix::mult(Cv, 1.0, At, Bv, 1.0, true));
+    _ASSERT(max_diff(C_c, Cv) < tol);
+
+    /* sparse and diagonal left-hand side matrices */
+    Matrix S = MatrixFactory::MakeRandomSparse(6, 5, 12, -1.0, 2.0);
+    C_c = dense_copy(Cv);
+    _ASSERT_OK(Matrix::mult(C_c, -1.0, S, B_c, 1.0));
+    _ASSERT_OK(Matrix::mult(Cv, -1.0, S, Bv, 1.0));
+    _ASSERT(max_diff(C_c, Cv) < tol);
+
+    Matrix D = MatrixFactory::MakeRandomMatrix(6, 6, 1.0, 2.0, Matrix::MATRIX_DIAGONAL);
+    Matrix Bv6 = MatrixFactory::ShallowSubmatrix(B, 0, 5, 3, 6); /* 6x4 */
+    Matrix B6_c = dense_copy(Bv6);
+    C_c = dense_copy(Cv);
+    _ASSERT_OK(Matrix::mult(C_c, 1.5, D, B6_c, 0.5));
+    _ASSERT_OK(Matrix::mult(Cv, 1.5, D, Bv6, 0.5));
+    _ASSERT(max_diff(C_c, Cv) < tol);
+
+    /* matrix-vector product with a strided vector (every other element of x) */
+    Matrix x = MatrixFactory::MakeRandomMatrix(10, 1, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix x_strided = MatrixFactory::ShallowVector(x, 5, 0, 2);
+    Matrix x_c = dense_copy(x_strided);
+    Matrix y = MatrixFactory::ShallowSubmatrix(C, 1, 6, 0, 0);
+    Matrix y_c = dense_copy(y);
+    _ASSERT_OK(Matrix::mult(y_c, 1.0, A_c, x_c, 0.0));
+    _ASSERT_OK(Matrix::mult(y, 1.0, Av, x_strided, 0.0));
+    _ASSERT(max_diff(y_c, y) < tol);
+
+    /* additions and scaling */
+    C_c = dense_copy(Cv);
+    _ASSERT_OK(Matrix::add(C_c, -1.0, B6_c, 2.0));
+    _ASSERT_OK(Matrix::add(Cv, -1.0, Bv6, 2.0));
+    _ASSERT(max_diff(C_c, Cv) < tol);
+    Cv *= 3.0;
+    C_c *= 3.0;
+    _ASSERT(max_diff(C_c, Cv) < tol);
+    _ASSERT_NUM_EQ(C_c.norm_fro_sq(), Cv.norm_fro_sq(), tol);
+
+    /* copies of views are contiguous */
+    Matrix Cv_copy(Cv);
+    _ASSERT(Cv_copy.isContiguous());
+    _ASSERT_EQ(static_cast<size_t> (6), Cv_copy.getLeadingDimension());
+    _ASSERT(max_diff(C_c, Cv_copy) < tol);
+}
+
+
+void TestMatrix::testCopyOnWrite() {
+    const double tol = 1e-12;
+
+    /* dense: modifying a copy leaves the original intact (and vice versa) */
+    Matrix A = MatrixFactory::MakeRandomMatrix(5, 4, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    double a00 = A.get(0, 0);
+    Matrix B(A);
+    Matrix C = B;
+    B.set(0, 0, a00 + 1.0);
+    _ASSERT_NUM_EQ(a00, A.get(0, 0), tol);
+    _ASSERT_NUM_EQ(a00, C.get(0, 0), tol);
+    _ASSERT_NUM_EQ(a00 + 1.0, B.get(0, 0), tol);
+    A *= 2.0;
+    _ASSERT_NUM_EQ(a00, C.get(0, 0), tol);
+    _ASSERT_NUM_EQ(2.0 * a00, A.get(0, 0), tol);
+
+    /* the destination of add/mult is detached before it is written */
+    Matrix D(C);
+    Matrix I = MatrixFactory::MakeIdentity(4, 1.0);
+    _ASSERT_OK(Matrix::mult(D, 1.0, C, I, 1.0));
+    _ASSERT_NUM_EQ(2.0 * a00, D.get(0, 0), tol);
+    _ASSERT_NUM_EQ(a00, C.get(0, 0), tol);
+    Matrix E(C);
+    _ASSERT_OK(Matrix::add(E, 1.0, C, 1.0));
+    _ASSERT_NUM_EQ(2.0 * a00, E.get(0, 0), tol);
+    _ASSERT_NUM_EQ(a00, C.get(0, 0), tol);
+
+    /* copies outlive the original */
+    Matrix * P = new Matrix(C);
+    Matrix Q(*P);
+    delete P;
+    _ASSERT_NUM_EQ(a00, Q.get(0, 0), tol);
+
+    /* data exposed by getData or operator[] are never shared */
+    Matrix F(C);
+    double * f = F.getData();
+    Matrix G(F);
+    f[0] = -1.0;
+    _ASSERT_NUM_EQ(-1.0, F.get(0, 0), tol);
+    _ASSERT_NUM_EQ(a00, G.get(0, 0), tol);
+    _ASSERT_NUM_EQ(a00, C.get(0, 0), tol);
+    Matrix H(C);
+    H[1] = -2.0;
+    Matrix K(H);
+    H[1] = -3.0;
+    _ASSERT_NUM_EQ(-2.0, K.get(1, 0), tol);
+    _ASSERT_NUM_EQ(-3.0, H.get(1, 0), tol);
+    _ASSERT_NUM_EQ(A.get(1, 0) / 2.0, C.get(1, 0), tol);
+
+    /* shallow vectors write into their original, not into its copies */
+    Matrix x = MatrixFactory::MakeRandomMatrix(6, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix x_copy(x);
+    Matrix x_part = MatrixFactory::ShallowVector(x, 3, 2);
+    x_part.set(0, 0, 10.0);
+    _ASSERT_NUM_EQ(10.0, x.get(2, 0), tol);
+    _ASSERT(x_copy.get(2, 0) < 1.0 + tol);
+    Matrix x_copy2(x);
+    x_part.set(1, 0, 20.0);
+    _ASSERT_NUM_EQ(20.0, x.get(3, 0), tol);
+    _ASSERT(x_copy2.get(3, 0) < 1.0 + tol);
+
+    /* sparse: set, scaling and assignment */
+    Matrix S = MatrixFactory::MakeRandomSparse(8, 6, 20, 1.0, 2.0);
+    Matrix S_dense = dense_copy(S);
+    Matrix T(S);
+    Matrix U;
+    U = S;
+    T *= -1.0;
+    _ASSERT(max_diff(S_dense, S) < tol);
+    _ASSERT(max_diff(S_dense, U) < tol);
+    Matrix minus_S = dense_copy(T);
+    minus_S *= -1.0;
+    _ASSERT(max_diff(S_dense, minus_S) < tol);
+    size_t i = 0;
+    size_t j = 0;
+    for (; i < 8; i++) { /* find a nonzero */
+        for (j = 0; j < 6 && S.get(i, j) == 0.0; j++) {
+        }
+        if (j < 6) break;
+    }
+    _ASSERT(i < 8);
+    U.set(i, j, 100.0);
+    _ASSERT_NUM_EQ(100.0, U.get(i, j), tol);
+    _ASSERT_NUM_EQ(S_dense.get(i, j), S.get(i, j), tol);
+    Matrix V = S; /* CSC is built from the shared triplets */
+    Matrix y = MatrixFactory::MakeRandomMatrix(6, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix Sy = V * y;
+    Matrix Sy_ref = S_dense * y;
+    _ASSERT(max_diff(Sy_ref, Sy) < 1e-10);
+    _ASSERT(max_diff(S_dense, S) < tol);
+}
+
+void TestMatrix::testCopyOnWriteReads() {
+    const double tol = 1e-12;
+    const size_t n = 40;
+    Matrix A = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    const Matrix& cA = A;
+
+    /* read-only access and products do not stop the data from being shared */
+    double a0 = cA[0];
+    const double * a = cA.getData();
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix Ax = A * x;
+    Matrix B(A);
+    const Matrix& cB = B;
+    _ASSERT_EQ(a, cB.getData());
+    _ASSERT_NUM_EQ(a0, cB[0], tol);
+
+    /* copies and products of the same (sparse) matrix from several threads */
+    Matrix S = MatrixFactory::MakeRandomSparse(200, 150, 1500, 1.0, 2.0);
+    Matrix S_dense = dense_copy(S);
+    Matrix y = MatrixFactory::MakeRandomMatrix(150, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix Sy_ref = S_dense * y;
+    const size_t nthreads = 8;
+    std::vector<double> errors(nthreads, 0.0);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nthreads; t++) {
+        threads.push_back(std::thread([&S, &A, &y, &Sy_ref, &errors, t]() {
+            const Matrix& cS = S;
+            for (size_t k = 0; k < 20; k++) {
+                Matrix S_copy(cS);
+                Matrix A_copy(A);
+                Matrix Sy = S_copy * y;
+                errors[t] = std::max(errors[t], max_diff(Sy_ref, Sy));
+                S_copy *= 2.0; /* writes to copies are not seen by the others */
+            }
+        }));
+    }
+    for (size_t t = 0; t < nthreads; t++) {
+        threads[t].join();
+    }
+    for (size_t t = 0; t < nthreads; t++) {
+        _ASSERT(errors[t] < 1e-10);
+    }
+    _ASSERT(max_diff(S_dense, S) < tol);
+    _ASSERT_EQ(a, cA.getData());
+}
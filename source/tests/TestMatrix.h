@@ -41,6 +41,9 @@ class TestMatrix : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(testQuadratic);
     CPPUNIT_TEST(testQuadratic2);
     CPPUNIT_TEST(testAssignment);
+    CPPUNIT_TEST(testMoveConstructor);
+    CPPUNIT_TEST(testMoveAssignment);
+    CPPUNIT_TEST(testMoveShallow);
     CPPUNIT_TEST(testQuadratic3);
     CPPUNIT_TEST(testAdditionBad);
     CPPUNIT_TEST(testFBMatrix);
@@ -76,6 +79,10 @@ class TestMatrix : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(testSparseQuadSparseX);
     CPPUNIT_TEST(testSparseQuad_q);
     CPPUNIT_TEST(testSparseDotProd);
+    CPPUNIT_TEST(testSparseSetTranspose);
+    CPPUNIT_TEST(testSparseSetAfterMultiply);
+    CPPUNIT_TEST(testSparseScaleInPlace);
+    CPPUNIT_TEST(testSparseAddSamePattern);
     CPPUNIT_TEST(testSubmatrix);
     CPPUNIT_TEST(testSubmatrixSparse);
     CPPUNIT_TEST(testSubmatrixTranspose);
@@ -153,6 +160,24 @@ class TestMatrix : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(test_MXL);
     CPPUNIT_TEST(test_MDX);
 
+    CPPUNIT_TEST(testBanded);
+    CPPUNIT_TEST(testBandedSymmetric);
+    CPPUNIT_TEST(test_MBD);
+    CPPUNIT_TEST(test_MBHD);
+    CPPUNIT_TEST(test_ABX);
+    CPPUNIT_TEST(test_AXA);
+    CPPUNIT_TEST(testBlock);
+    CPPUNIT_TEST(test_MBlockD);
+    CPPUNIT_TEST(test_ABlock);
+    CPPUNIT_TEST(testBlockQuad);
+    CPPUNIT_TEST(testMultStructured);
+    CPPUNIT_TEST(testMultLowerTriangular);
+    CPPUNIT_TEST(testAddStructured);
+    CPPUNIT_TEST(testSymmetricRankK);
+    CPPUNIT_TEST(testStridedViews);
+    CPPUNIT_TEST(testCopyOnWrite);
+    CPPUNIT_TEST(testCopyOnWriteReads);
+
     CPPUNIT_TEST_SUITE_END();
 
         
@@ -176,6 +201,9 @@ private:
     void testGetSet();
     void testGetSetTranspose();
     void testAssignment();
+    void testMoveConstructor();
+    void testMoveAssignment();
+    void testMoveShallow();
     void test_ADD1();
     void testAdditionBad();
     void testFBMatrix();
@@ -211,6 +239,10 @@ private:
     void testSparseQuadSparseX();
     void testSparseQuad_q();
     void testSparseDotProd();
+    void testSparseSetTranspose();
+    void testSparseSetAfterMultiply();
+    void testSparseScaleInPlace();
+    void testSparseAddSamePattern();
     void testSubmatrix();
     void testSubmatrixSparse();
     void testSubmatrixTranspose();
@@ -304,6 +336,7 @@ private:
     void test_AXS();
     void test_AXH();
     void test_AXX();
+    void test_AXA();
     void test_AXL();
     void test_AXW();
 
@@ -341,6 +374,26 @@ private:
     void test_MDS();
     void test_MSDT();
     void test_MSTDT();
+
+    /*
+     * BANDED MATRICES
+     */
+    void testBanded();
+    void testBandedSymmetric();
+    void test_MBD();
+    void test_MBHD();
+    void test_ABX();
+    void testBlock();
+    void test_MBlockD();
+    void test_ABlock();
+    void testBlockQuad();
+    void testMultStructured();
+    void testMultLowerTriangular();
+    void testAddStructured();
+    void testSymmetricRankK();
+    void testStridedViews();
+    void testCopyOnWrite();
+    void testCopyOnWriteReads();
 };
 
 #endif	/* TESTMATRIX_H */
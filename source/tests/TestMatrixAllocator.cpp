@@ -0,0 +1,175 @@
+/*
+ * File:   TestMatrixAllocator.cpp
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 1:31:11 PM
+ * 
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *  
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestMatrixAllocator.h"
+
+#include <cstdlib>
+#include <stdint.h>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestMatrixAllocator);
+
+/* a custom allocator which counts allocations */
+class CountingAllocator : public MatrixAllocator {
+public:
+
+    CountingAllocator() : allocations(0), deallocations(0) {
+    }
+
+    void * allocate(size_t bytes) {
+        void * ptr = NULL;
+        allocations++;
+        return posix_memalign(&ptr, ALIGNMENT, bytes) == 0 ? ptr : NULL;
+    }
+
+    void deallocate(void * ptr, size_t bytes) {
+        deallocations++;
+        free(ptr);
+    }
+
+    size_t allocations;
+    size_t deallocations;
+};
+
+static bool is_aligned(const double * ptr) {
+    return reinterpret_cast<uintptr_t> (ptr) % MatrixAllocator::ALIGNMENT == 0;
+}
+
+TestMatrixAllocator::TestMatrixAllocator() {
+}
+
+TestMatrixAllocator::~TestMatrixAllocator() {
+}
+
+void TestMatrixAllocator::setUp() {
+}
+
+void TestMatrixAllocator::tearDown() {
+    Matrix::destroy_handle();
+}
+
+void TestMatrixAllocator::testAlignment() {
+    for (size_t n = 1; n < 40; n += 3) {
+        Matrix A(n, n + 1);
+        Matrix D(n, n, Matrix::MATRIX_DIAGONAL);
+        Matrix S(n, n, Matrix::MATRIX_SYMMETRIC);
+        Matrix B(A);
+        _ASSERT(is_aligned(A.getData()));
+        _ASSERT(is_aligned(D.getData()));
+        _ASSERT(is_aligned(S.getData()));
+        _ASSERT(is_aligned(B.getData()));
+        /* new matrices are zero */
+        for (size_t i = 0; i < A.length(); i++) {
+            _ASSERT_EQ(0.0, A[i]);
+        }
+    }
+    double * data = MatrixAllocator::allocate_data(0, true);
+    _ASSERT(is_aligned(data));
+    _ASSERT_EQ(0.0, data[0]);
+    MatrixAllocator::free_data(data);
+    MatrixAllocator::free_data(NULL);
+}
+
+void TestMatrixAllocator::testArenaReuse() {
+    size_t n = 100;
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    MatrixArena arena;
+    size_t pooled = 0;
+    for (size_t k = 0; k < 50; k++) {
+        Matrix y = 2.0 * x;
+        Matrix z = y + x;
+        _ASSERT_NUM_EQ(3.0 * x[n - 1], z[n - 1], 1e-12);
+        _ASSERT(is_aligned(z.getData()));
+        if (k == 0) {
+            pooled = arena.pooledBytes();
+        }
+    }
+    /* after the first iteration, all memory is reused */
+    _ASSERT_EQ(pooled, arena.pooledBytes());
+    _ASSERT(arena.reuseCount() >= 49);
+}
+
+void TestMatrixAllocator::testOutliveArena() {
+    Matrix * A;
+    Matrix B;
+    {
+        MatrixArena arena;
+        A = new Matrix(5, 5);
+        A->set(4, 4, 1.5);
+        B = MatrixFactory::MakeRandomMatrix(7, 3, 0.0, 1.0);
+    }
+    /* memory allocated in the arena is still valid */
+    _ASSERT_EQ(1.5, A->get(4, 4));
+    B *= 2.0;
+    delete A;
+    Matrix C(7, 3);
+    C = B;
+    _ASSERT_EQ(B, C);
+}
+
+void TestMatrixAllocator::testNestedArenas() {
+    MatrixAllocator * outside = MatrixAllocator::current();
+    {
+        MatrixArena outer;
+        MatrixAllocator * in_outer = MatrixAllocator::current();
+        _ASSERT_NEQ(outside, in_outer);
+        Matrix A(10, 10);
+        {
+            MatrixArena inner;
+            _ASSERT_NEQ(in_outer, MatrixAllocator::current());
+            Matrix B(10, 10);
+            A = B; /* A keeps its buffer (from the outer arena) */
+            _ASSERT(inner.pooledBytes() > 0);
+        }
+        _ASSERT_EQ(in_outer, MatrixAllocator::current());
+    }
+    _ASSERT_EQ(outside, MatrixAllocator::current());
+}
+
+void TestMatrixAllocator::testCustomAllocator() {
+    CountingAllocator counting;
+    MatrixAllocator * previous = MatrixAllocator::setCurrent(&counting);
+    {
+        Matrix A(4, 3);
+        Matrix B(A); /* shares the data of A until it is modified */
+        _ASSERT_EQ(static_cast<size_t> (1), counting.allocations);
+        B.set(0, 0, 1.0);
+        _ASSERT_EQ(static_cast<size_t> (2), counting.allocations);
+    }
+    _ASSERT_EQ(static_cast<size_t> (2), counting.deallocations);
+    _ASSERT_EQ(&counting, MatrixAllocator::setCurrent(previous));
+
+    /* memory is returned to the allocator it came from */
+    MatrixAllocator::setCurrent(&counting);
+    Matrix * C = new Matrix(2, 2);
+    MatrixAllocator::setCurrent(previous);
+    delete C;
+    _ASSERT_EQ(static_cast<size_t> (3), counting.allocations);
+    _ASSERT_EQ(static_cast<size_t> (3), counting.deallocations);
+}
+
+void TestMatrixAllocator::testHugePages() {
+    MatrixAllocator::setHugePages(true);
+    size_t n = 1000;
+    Matrix A(n, n); /* 8MB */
+    _ASSERT(is_aligned(A.getData()));
+    A.set(n - 1, n - 1, 3.0);
+    _ASSERT_EQ(3.0, A.get(n - 1, n - 1));
+    MatrixAllocator::setHugePages(false);
+}
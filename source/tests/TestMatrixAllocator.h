@@ -0,0 +1,44 @@
+/*
+ * File:   TestMatrixAllocator.h
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 1:31:11 PM
+ */
+
+#ifndef TESTMATRIXALLOCATOR_H
+#define	TESTMATRIXALLOCATOR_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#define FORBES_TEST_UTILS
+#include "ForBES.h"
+
+class TestMatrixAllocator : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(TestMatrixAllocator);
+
+    CPPUNIT_TEST(testAlignment);
+    CPPUNIT_TEST(testArenaReuse);
+    CPPUNIT_TEST(testOutliveArena);
+    CPPUNIT_TEST(testNestedArenas);
+    CPPUNIT_TEST(testCustomAllocator);
+    CPPUNIT_TEST(testHugePages);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    TestMatrixAllocator();
+    virtual ~TestMatrixAllocator();
+    void setUp();
+    void tearDown();
+
+private:
+    void testAlignment();
+    void testArenaReuse();
+    void testOutliveArena();
+    void testNestedArenas();
+    void testCustomAllocator();
+    void testHugePages();
+
+};
+
+#endif	/* TESTMATRIXALLOCATOR_H */
@@ -0,0 +1,321 @@
+/*
+ * File:   TestMatrixExpression.cpp
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 11:02:18 AM
+ *
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestMatrixExpression.h"
+#include "MatrixFactory.h"
+#include "MatrixExpression.h"
+#include "ForBES.h"
+#include <cmath>
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestMatrixExpression);
+
+TestMatrixExpression::TestMatrixExpression() {
+}
+
+TestMatrixExpression::~TestMatrixExpression() {
+}
+
+void TestMatrixExpression::setUp() {
+}
+
+void TestMatrixExpression::tearDown() {
+    Matrix::destroy_handle();
+}
+
+void TestMatrixExpression::test_wrong_args() {
+    Matrix A(5, 6);
+    Matrix B(5, 7);
+    Matrix C(5, 6);
+    _ASSERT_EXCEPTION(evaluate(C, lazy(A) + lazy(B)), std::invalid_argument);
+    _ASSERT_EXCEPTION(dot(lazy(A), lazy(B)), std::invalid_argument);
+    _ASSERT_EXCEPTION(evaluate(C, lazy(A) * lazy(A)), std::invalid_argument);
+    Matrix D(6, 6);
+    _ASSERT_EXCEPTION(evaluate(D, lazy(A), 1.0), std::invalid_argument);
+}
+
+void TestMatrixExpression::test_axpby() {
+    const size_t n = 10;
+    const size_t m = 15;
+    const double tol = 1e-10;
+    Matrix X = MatrixFactory::MakeRandomMatrix(n, m, 2.0, 1.0);
+    Matrix Y = MatrixFactory::MakeRandomMatrix(n, m, -1.0, 3.0);
+    Matrix C(n, m);
+    const double alpha = 1.5;
+    const double beta = -0.7;
+
+    int status = evaluate(C, alpha * lazy(X) + beta * lazy(Y));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, status);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < m; j++) {
+            _ASSERT_NUM_EQ(alpha * X.get(i, j) + beta * Y.get(i, j), C.get(i, j), tol);
+        }
+    }
+}
+
+void TestMatrixExpression::test_linear_combination() {
+    const size_t n = 20;
+    const double tol = 1e-10;
+    Matrix X = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix Y = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix Z = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix C(n, 1);
+
+    _ASSERT_OK(evaluate(C, 2.0 * (lazy(X) - lazy(Y)) + lazy(Z) * 0.5 - (-lazy(X))));
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(3.0 * X[i] - 2.0 * Y[i] + 0.5 * Z[i], C[i], tol);
+    }
+}
+
+void TestMatrixExpression::test_gamma() {
+    const size_t n = 8;
+    const size_t m = 3;
+    const double tol = 1e-10;
+    Matrix X = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0);
+    Matrix Y = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0);
+    Matrix C = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0);
+    Matrix C0(C);
+    const double gamma = 0.3;
+
+    _ASSERT_OK(evaluate(C, lazy(X) - 4.0 * lazy(Y), gamma));
+    for (size_t k = 0; k < n * m; k++) {
+        _ASSERT_NUM_EQ(gamma * C0[k] + X[k] - 4.0 * Y[k], C[k], tol);
+    }
+}
+
+void TestMatrixExpression::test_alias() {
+    const size_t n = 12;
+    const double tol = 1e-10;
+    Matrix X = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix Y = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix X0(X);
+    double * data = X.getData();
+
+    // x = 2*x - y (in place)
+    _ASSERT_OK(evaluate(X, 2.0 * lazy(X) - lazy(Y)));
+    _ASSERT_EQ(data, X.getData());
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(2.0 * X0[i] - Y[i], X[i], tol);
+    }
+}
+
+void TestMatrixExpression::test_realloc() {
+    const size_t n = 7;
+    const size_t m = 4;
+    const double tol = 1e-10;
+    Matrix X = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0);
+    Matrix Y = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0);
+    Matrix C;
+
+    _ASSERT_OK(evaluate(C, lazy(X) + lazy(Y)));
+    _ASSERT_EQ(n, C.getNrows());
+    _ASSERT_EQ(m, C.getNcols());
+    for (size_t k = 0; k < n * m; k++) {
+        _ASSERT_NUM_EQ(X[k] + Y[k], C[k], tol);
+    }
+
+    /* C = A * C, where C must be re-allocated */
+    Matrix A = MatrixFactory::MakeRandomMatrix(m, n, 0.0, 1.0);
+    Matrix AC = A * C;
+    _ASSERT_OK(evaluate(C, lazy(A) * lazy(C)));
+    _ASSERT_EQ(m, C.getNrows());
+    _ASSERT_EQ(m, C.getNcols());
+    for (size_t k = 0; k < m * m; k++) {
+        _ASSERT_NUM_EQ(AC[k], C[k], tol);
+    }
+}
+
+void TestMatrixExpression::test_symmetric() {
+    const size_t n = 9;
+    const double tol = 1e-10;
+    Matrix S1 = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_SYMMETRIC);
+    Matrix S2 = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_SYMMETRIC);
+    Matrix C(n, n, Matrix::MATRIX_SYMMETRIC);
+
+    _ASSERT_OK(evaluate(C, lazy(S1) - 3.0 * lazy(S2)));
+    _ASSERT_EQ(Matrix::MATRIX_SYMMETRIC, C.getType());
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(S1.get(i, j) - 3.0 * S2.get(i, j), C.get(i, j), tol);
+        }
+    }
+}
+
+void TestMatrixExpression::test_transposed() {
+    const size_t n = 6;
+    const size_t m = 11;
+    const double tol = 1e-10;
+    Matrix X = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0);
+    Matrix Y = MatrixFactory::MakeRandomMatrix(m, n, 0.0, 1.0);
+    Matrix X0(X);
+    X.transpose();
+
+    /* X' and Y do not share their layout */
+    Matrix C(m, n);
+    _ASSERT_OK(evaluate(C, lazy(X) + 2.0 * lazy(Y)));
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(X0.get(j, i) + 2.0 * Y.get(i, j), C.get(i, j), tol);
+        }
+    }
+}
+
+void TestMatrixExpression::test_mixed_types() {
+    const size_t n = 10;
+    const double tol = 1e-10;
+    Matrix X = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0);
+    Matrix D = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_DIAGONAL);
+    Matrix L = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_LOWERTR);
+    Matrix C(n, n);
+
+    _ASSERT_OK(evaluate(C, lazy(X) - lazy(D) + 0.5 * lazy(L)));
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(X.get(i, j) - D.get(i, j) + 0.5 * L.get(i, j), C.get(i, j), tol);
+        }
+    }
+}
+
+void TestMatrixExpression::test_product() {
+    const size_t n = 10;
+    const size_t m = 6;
+    const double tol = 1e-10;
+    Matrix A = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0);
+    Matrix x = MatrixFactory::MakeRandomMatrix(m, 1, 0.0, 1.0);
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix y(n, 1);
+
+    _ASSERT_OK(evaluate(y, 2.0 * lazy(A) * lazy(x) - lazy(b)));
+    Matrix Ax = A * x;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(2.0 * Ax[i] - b[i], y[i], tol);
+    }
+}
+
+void TestMatrixExpression::test_product_alias() {
+    const size_t n = 8;
+    const double tol = 1e-10;
+    Matrix A = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0);
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix Ax = A * x;
+    Matrix x0(x);
+
+    // x = x + A*x (x appears in the product)
+    _ASSERT_OK(evaluate(x, lazy(A) * lazy(x), 1.0));
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(x0[i] + Ax[i], x[i], tol);
+    }
+}
+
+void TestMatrixExpression::test_dot() {
+    const size_t n = 30;
+    const double tol = 1e-10;
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix y = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix z = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+
+    double expected = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        expected += x[i] * (y[i] - 2.0 * z[i]);
+    }
+    _ASSERT_NUM_EQ(expected, dot(lazy(x), lazy(y) - 2.0 * lazy(z)), tol);
+    _ASSERT_NUM_EQ((x * y)[0], dot(lazy(x), lazy(y)), tol);
+}
+
+void TestMatrixExpression::test_dot_symmetric() {
+    const size_t n = 7;
+    const double tol = 1e-10;
+    Matrix S = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_SYMMETRIC);
+    Matrix T = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_SYMMETRIC);
+
+    double expected = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            expected += S.get(i, j) * T.get(i, j);
+        }
+    }
+    _ASSERT_NUM_EQ(expected, dot(lazy(S), lazy(T)), tol);
+
+    /* symmetric banded matrices: only the lower band is stored */
+    Matrix B1 = MatrixFactory::MakeBandedSymmetric(n, 2);
+    Matrix B2 = MatrixFactory::MakeBandedSymmetric(n, 2);
+    Matrix D1(n, n);
+    Matrix D2(n, n);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = (i > 2 ? i - 2 : 0); j <= i; j++) {
+            B1.set(i, j, 1.0 + i + 0.5 * j);
+            B2.set(i, j, 2.0 - 0.3 * i + j);
+        }
+    }
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            D1.set(i, j, B1.get(i, j));
+            D2.set(i, j, B2.get(i, j));
+        }
+    }
+    _ASSERT_NUM_EQ(dot(lazy(D1), lazy(D2)), dot(lazy(B1), lazy(B2)), tol);
+    _ASSERT_NUM_EQ(dot(lazy(D1), lazy(D1) - lazy(D2)), dot(lazy(B1), lazy(B1) - lazy(B2)), tol);
+}
+
+void TestMatrixExpression::test_dot_mixed_types() {
+    const size_t n = 7;
+    const double tol = 1e-10;
+    Matrix X = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0);
+    Matrix D = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_DIAGONAL);
+
+    double expected = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        expected += X.get(i, i) * D.get(i, i);
+    }
+    _ASSERT_NUM_EQ(expected, dot(lazy(X), lazy(D)), tol);
+    _ASSERT_NUM_EQ(expected, dot(lazy(D), lazy(X)), tol);
+}
+
+void TestMatrixExpression::test_operators() {
+    const size_t n = 9;
+    const size_t m = 5;
+    const double tol = 1e-10;
+    Matrix X = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0);
+    Matrix Y = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0);
+
+    Matrix S = X + Y;
+    Matrix D = X - Y;
+    for (size_t k = 0; k < n * m; k++) {
+        _ASSERT_NUM_EQ(X[k] + Y[k], S[k], tol);
+        _ASSERT_NUM_EQ(X[k] - Y[k], D[k], tol);
+    }
+
+    /* transposed operands keep their layout */
+    X.transpose();
+    Y.transpose();
+    Matrix ST = X + Y;
+    _ASSERT_EQ(m, ST.getNrows());
+    _ASSERT_EQ(n, ST.getNcols());
+    for (size_t i = 0; i < m; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_NUM_EQ(S.get(j, i), ST.get(i, j), tol);
+        }
+    }
+
+    Matrix Z(X);
+    Z *= -2.0;
+    for (size_t k = 0; k < n * m; k++) {
+        _ASSERT_NUM_EQ(-2.0 * X[k], Z[k], tol);
+    }
+}
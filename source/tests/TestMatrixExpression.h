@@ -0,0 +1,74 @@
+/*
+ * File:   TestMatrixExpression.h
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 11:02:18 AM
+ * 
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *  
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TESTMATRIXEXPRESSION_H
+#define	TESTMATRIXEXPRESSION_H
+
+#define FORBES_TEST_UTILS
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class TestMatrixExpression : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(TestMatrixExpression);
+
+    CPPUNIT_TEST(test_wrong_args);
+    CPPUNIT_TEST(test_axpby);
+    CPPUNIT_TEST(test_linear_combination);
+    CPPUNIT_TEST(test_gamma);
+    CPPUNIT_TEST(test_alias);
+    CPPUNIT_TEST(test_realloc);
+    CPPUNIT_TEST(test_symmetric);
+    CPPUNIT_TEST(test_transposed);
+    CPPUNIT_TEST(test_mixed_types);
+    CPPUNIT_TEST(test_product);
+    CPPUNIT_TEST(test_product_alias);
+    CPPUNIT_TEST(test_dot);
+    CPPUNIT_TEST(test_dot_symmetric);
+    CPPUNIT_TEST(test_dot_mixed_types);
+    CPPUNIT_TEST(test_operators);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    TestMatrixExpression();
+    virtual ~TestMatrixExpression();
+    void setUp();
+    void tearDown();
+
+private:
+    void test_wrong_args();
+    void test_axpby();
+    void test_linear_combination();
+    void test_gamma();
+    void test_alias();
+    void test_realloc();
+    void test_symmetric();
+    void test_transposed();
+    void test_mixed_types();
+    void test_product();
+    void test_product_alias();
+    void test_dot();
+    void test_dot_symmetric();
+    void test_dot_mixed_types();
+    void test_operators();
+};
+
+#endif	/* TESTMATRIXEXPRESSION_H */
+
@@ -649,6 +649,89 @@ void TestMatrixExtras::test_mult_SX() {
     }
 }
 
+void TestMatrixExtras::test_mult_SD() {
+    size_t n = 10;
+    size_t k = 8;
+    size_t m = 3;
+
+    size_t repetitions = 300;
+    for (size_t r = 0; r < repetitions; r++) {
+        Matrix A = MatrixFactory::MakeRandomSparse(n, k, std::ceil(n * k / 2), 2.0, 1.0);
+        Matrix At = MatrixFactory::MakeRandomSparse(k, n, std::ceil(n * k / 2), 2.0, 1.0);
+        Matrix B = MatrixFactory::MakeRandomMatrix(k, m, 0.0, 1.0);
+        Matrix C = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0);
+        Matrix D(C);
+        At.transpose();
+
+        double alpha = -2.0 + 2.0 * static_cast<double> (std::rand()) / static_cast<double> (RAND_MAX);
+        double gamma = -2.0 + 3.0 * static_cast<double> (std::rand()) / static_cast<double> (RAND_MAX);
+
+        Matrix C_orig(C);
+        Matrix D_orig(D);
+
+        int status = Matrix::mult(C, alpha, A, B, gamma); /* C = g*C + a*A*B   */
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, status);
+
+        status = Matrix::mult(D, alpha, At, B, gamma); /*    D = g*D + a*At'*B */
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, status);
+
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < m; j++) {
+                double c = gamma * C_orig.get(i, j);
+                double d = gamma * D_orig.get(i, j);
+                for (size_t l = 0; l < k; l++) {
+                    c += alpha * A.get(i, l) * B.get(l, j);
+                    d += alpha * At.get(i, l) * B.get(l, j);
+                }
+                _ASSERT_NUM_EQ(c, C.get(i, j), 1e-10);
+                _ASSERT_NUM_EQ(d, D.get(i, j), 1e-10);
+            }
+        }
+    }
+}
+
+void TestMatrixExtras::test_mult_SDlarge() {
+    /* enough nonzeros to trigger the multithreaded kernels */
+    size_t n = 300;
+    size_t k = 200;
+    size_t nnz = 21000;
+    Matrix A = MatrixFactory::MakeRandomSparse(n, k, nnz, -1.0, 2.0);
+    Matrix x = MatrixFactory::MakeRandomMatrix(k, 1, 0.0, 1.0);
+    Matrix z = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix y = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix w = MatrixFactory::MakeRandomMatrix(k, 1, 0.0, 1.0);
+
+    const double alpha = 1.5;
+    const double gamma = -0.5;
+
+    Matrix y_expected(n, 1);
+    for (size_t i = 0; i < n; i++) {
+        y_expected[i] = gamma * y[i];
+        for (size_t j = 0; j < k; j++) {
+            y_expected[i] += alpha * A.get(i, j) * x[j];
+        }
+    }
+    int status = Matrix::mult(y, alpha, A, x, gamma);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, status);
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(y_expected[i], y[i], 1e-9);
+    }
+
+    Matrix w_expected(k, 1);
+    for (size_t j = 0; j < k; j++) {
+        w_expected[j] = gamma * w[j];
+        for (size_t i = 0; i < n; i++) {
+            w_expected[j] += alpha * A.get(i, j) * z[i];
+        }
+    }
+    A.transpose();
+    status = Matrix::mult(w, alpha, A, z, gamma);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, status);
+    for (size_t j = 0; j < k; j++) {
+        _ASSERT_NUM_EQ(w_expected[j], w[j], 1e-9);
+    }
+}
+
 void TestMatrixExtras::test_mult_Hv() {
     size_t n = 10;
     Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
@@ -660,3 +743,86 @@ void TestMatrixExtras::test_mult_Hv() {
 
     _ASSERT_EQ(y2, y);
 }
+
+void TestMatrixExtras::test_mult_SDlargeModified() {
+    /* the rows of A are cached; they must follow changes of A */
+    size_t n = 250;
+    size_t k = 180;
+    size_t nnz = 22000;
+    Matrix A = MatrixFactory::MakeRandomSparse(n, k, nnz, -1.0, 2.0);
+    Matrix x = MatrixFactory::MakeRandomMatrix(k, 1, 0.0, 1.0);
+    Matrix y(n, 1);
+    Matrix y_expected(n, 1);
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < k; j++) {
+            y_expected.set(i, 0, y_expected.get(i, 0) + A.get(i, j) * x.get(j, 0));
+        }
+    }
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::mult(y, 1.0, A, x, 0.0));
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(y_expected.get(i, 0), y.get(i, 0), 1e-9);
+    }
+
+    Matrix B(A); /* shares the data of A */
+    B *= -2.0;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::mult(y, 1.0, B, x, 0.0));
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(-2.0 * y_expected.get(i, 0), y.get(i, 0), 1e-9);
+    }
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::mult(y, 1.0, A, x, 0.0));
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(y_expected.get(i, 0), y.get(i, 0), 1e-9);
+    }
+
+    A *= 3.0;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::mult(y, 1.0, A, x, 0.0));
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(3.0 * y_expected.get(i, 0), y.get(i, 0), 1e-9);
+    }
+}
+
+void TestMatrixExtras::test_mult_transA() {
+    size_t n = 8;
+    size_t k = 6;
+    size_t m = 5;
+    double alpha = -0.7;
+    double gamma = 1.3;
+
+    Matrix B = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0);
+    Matrix X = MatrixFactory::MakeRandomMatrix(k, k, 0.0, 1.0, Matrix::MATRIX_DIAGONAL);
+    Matrix S = MatrixFactory::MakeRandomSparse(n, k, 20, 0.0, 1.0);
+    Matrix types[2] = {MatrixFactory::MakeRandomMatrix(n, k, 0.0, 1.0), S};
+
+    for (size_t t = 0; t < 2; t++) {
+        Matrix A = types[t];
+        Matrix At(A);
+        At.transpose();
+
+        /* dense RHS: C = gamma * C + alpha * A' * B */
+        Matrix C = MatrixFactory::MakeRandomMatrix(k, m, 0.0, 1.0);
+        Matrix C_expected(C);
+        C_expected *= gamma;
+        Matrix AtB = At * B;
+        AtB *= alpha;
+        C_expected += AtB;
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::mult(C, alpha, A, B, gamma, true));
+        _ASSERT_EQ(C_expected, C);
+
+        /* A is not modified */
+        _ASSERT_EQ(n, A.getNrows());
+        _ASSERT_EQ(k, A.getNcols());
+
+        /* transposing twice: C = gamma * C + alpha * A * X */
+        Matrix D = MatrixFactory::MakeRandomMatrix(n, k, 0.0, 1.0);
+        Matrix D_expected(D);
+        D_expected *= gamma;
+        Matrix AX = A * X;
+        AX *= alpha;
+        D_expected += AX;
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::mult(D, alpha, At, X, gamma, true));
+        _ASSERT_EQ(D_expected, D);
+    }
+
+    Matrix C(n, m);
+    _ASSERT_EXCEPTION(Matrix::mult(C, alpha, types[0], B, gamma, true), std::invalid_argument);
+}
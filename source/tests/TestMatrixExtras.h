@@ -59,8 +59,12 @@ class TestMatrixExtras : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(test_mult_SS3);
     
     CPPUNIT_TEST(test_mult_SX);
+    CPPUNIT_TEST(test_mult_SD);
+    CPPUNIT_TEST(test_mult_SDlarge);
+    CPPUNIT_TEST(test_mult_SDlargeModified);
     
     CPPUNIT_TEST(test_mult_Hv);
+    CPPUNIT_TEST(test_mult_transA);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -102,7 +106,11 @@ private:
     void test_mult_SS3();
     
     void test_mult_SX();
+    void test_mult_SD();
+    void test_mult_SDlarge();
+    void test_mult_SDlargeModified();
     void test_mult_Hv();
+    void test_mult_transA();
 };
 
 #endif	/* TESTMATRIXEXTRAS_H */
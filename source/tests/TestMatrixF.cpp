@@ -0,0 +1,321 @@
+/*
+ * File:   TestMatrixF.cpp
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 3:52:39 PM
+ * 
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *  
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestMatrixF.h"
+
+/* tolerance for single-precision results */
+#define FLOAT_TOL 1e-4
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestMatrixF);
+
+TestMatrixF::TestMatrixF() {
+}
+
+TestMatrixF::~TestMatrixF() {
+}
+
+void TestMatrixF::setUp() {
+}
+
+void TestMatrixF::tearDown() {
+    Matrix::destroy_handle();
+}
+
+/* C = gamma * C + alpha * op(A) * B, computed element by element */
+static Matrix reference_mult(Matrix& C, double alpha, Matrix& A, Matrix& B, double gamma, bool transA) {
+    Matrix R(C.getNrows(), C.getNcols());
+    for (size_t i = 0; i < R.getNrows(); i++) {
+        for (size_t j = 0; j < R.getNcols(); j++) {
+            double t = 0.0;
+            for (size_t l = 0; l < B.getNrows(); l++) {
+                t += (transA ? A.get(l, i) : A.get(i, l)) * B.get(l, j);
+            }
+            R.set(i, j, gamma * C.get(i, j) + alpha * t);
+        }
+    }
+    return R;
+}
+
+static void assert_near(Matrix& expected, Matrix& actual, double tol) {
+    _ASSERT_EQ(expected.getNrows(), actual.getNrows());
+    _ASSERT_EQ(expected.getNcols(), actual.getNcols());
+    for (size_t i = 0; i < expected.getNrows(); i++) {
+        for (size_t j = 0; j < expected.getNcols(); j++) {
+            _ASSERT_NUM_EQ(expected.get(i, j), actual.get(i, j), tol);
+        }
+    }
+}
+
+void TestMatrixF::testConvertDense() {
+    size_t n = 7;
+    size_t m = 4;
+    Matrix A = MatrixFactory::MakeRandomMatrix(n, m, -1.0, 2.0);
+    MatrixF Af(A);
+    _ASSERT_EQ(n, Af.getNrows());
+    _ASSERT_EQ(m, Af.getNcols());
+    _ASSERT_NOT(Af.isSparse());
+    _ASSERT_EQ(n * m, Af.length());
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < m; j++) {
+            _ASSERT_EQ(static_cast<float> (A.get(i, j)), Af.get(i, j));
+        }
+    }
+    Matrix A_back = Af.toMatrix();
+    assert_near(A, A_back, 1e-6);
+
+    A.transpose();
+    MatrixF Aft(A);
+    _ASSERT_EQ(m, Aft.getNrows());
+    _ASSERT_EQ(static_cast<float> (A.get(3, 6)), Aft.get(3, 6));
+    Af.transpose();
+    _ASSERT_EQ(Aft.get(3, 6), Af.get(3, 6));
+
+    Af.set(0, 0, 3.5f);
+    _ASSERT_EQ(3.5f, Af.get(0, 0));
+}
+
+void TestMatrixF::testConvertSparse() {
+    size_t n = 20;
+    size_t m = 15;
+    Matrix A = MatrixFactory::MakeRandomSparse(n, m, 60, -1.0, 2.0);
+    MatrixF Af(A);
+    _ASSERT(Af.isSparse());
+    _ASSERT_EQ(static_cast<size_t> (60), Af.length());
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < m; j++) {
+            _ASSERT_EQ(static_cast<float> (A.get(i, j)), Af.get(i, j));
+        }
+    }
+    Matrix A_back = Af.toMatrix();
+    _ASSERT_EQ(Matrix::MATRIX_SPARSE, A_back.getType());
+    assert_near(A, A_back, 1e-6);
+
+    /* stored entries can be modified, but no new ones can be added */
+    size_t i = 0;
+    size_t j = 0;
+    while (A.get(i, j) == 0.0) {
+        i = (i + 1) % n;
+        j = (i == 0) ? j + 1 : j;
+    }
+    Af.set(i, j, -7.0f);
+    _ASSERT_EQ(-7.0f, Af.get(i, j));
+    Matrix Z = MatrixFactory::MakeSparse(3, 3, 1, Matrix::SPARSE_UNSYMMETRIC);
+    Z.set(0, 0, 1.0);
+    MatrixF Zf(Z);
+    _ASSERT_EXCEPTION(Zf.set(1, 1, 1.0f), std::invalid_argument);
+}
+
+void TestMatrixF::testConvertSymmetric() {
+    size_t n = 6;
+    Matrix H = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_SYMMETRIC);
+    MatrixF Hf(H);
+    _ASSERT_NOT(Hf.isSparse());
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_EQ(static_cast<float> (H.get(i, j)), Hf.get(i, j));
+        }
+    }
+
+    Matrix S = MatrixFactory::MakeSparseSymmetric(n, 2 * n);
+    for (size_t i = 0; i < n; i++) {
+        S.set(i, i, 2.0);
+        if (i > 0) {
+            S.set(i, i - 1, -1.0);
+        }
+    }
+    MatrixF Sf(S); /* both triangles are stored */
+    _ASSERT(Sf.isSparse());
+    _ASSERT_EQ(-1.0f, Sf.get(2, 3));
+    _ASSERT_EQ(-1.0f, Sf.get(3, 2));
+    _ASSERT_EQ(2.0f, Sf.get(3, 3));
+}
+
+void TestMatrixF::testMultDense() {
+    size_t n = 9;
+    size_t m = 5;
+    Matrix A = MatrixFactory::MakeRandomMatrix(n, m, -1.0, 2.0);
+    MatrixF Af(A);
+    Matrix x = MatrixFactory::MakeRandomMatrix(m, 1, -1.0, 2.0);
+    Matrix z = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0);
+    double alpha = 1.5;
+    double gamma = -0.7;
+
+    Matrix y = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0);
+    Matrix y_expected = reference_mult(y, alpha, A, x, gamma, false);
+    _ASSERT_OK(MatrixF::mult(y, alpha, Af, x, gamma));
+    assert_near(y_expected, y, FLOAT_TOL);
+
+    Matrix w = MatrixFactory::MakeRandomMatrix(m, 1, -1.0, 2.0);
+    Matrix w_expected = reference_mult(w, alpha, A, z, gamma, true);
+    _ASSERT_OK(MatrixF::mult(w, alpha, Af, z, gamma, true));
+    assert_near(w_expected, w, FLOAT_TOL);
+
+    /* transposed matrix, transposed product */
+    Af.transpose();
+    Matrix y2(n, 1);
+    Matrix y2_expected = A * x;
+    _ASSERT_OK(MatrixF::mult(y2, 1.0, Af, x, 0.0, true));
+    assert_near(y2_expected, y2, FLOAT_TOL);
+}
+
+void TestMatrixF::testMultDenseMatrix() {
+    size_t n = 6;
+    size_t k = 4;
+    size_t m = 3;
+    Matrix A = MatrixFactory::MakeRandomMatrix(n, k, -1.0, 2.0);
+    Matrix B = MatrixFactory::MakeRandomMatrix(m, k, -1.0, 2.0);
+    B.transpose(); /* k x m */
+    Matrix C = MatrixFactory::MakeRandomMatrix(n, m, -1.0, 2.0);
+    MatrixF Af(A);
+    Matrix C_expected = reference_mult(C, 0.5, A, B, 2.0, false);
+    _ASSERT_OK(MatrixF::mult(C, 0.5, Af, B, 2.0));
+    assert_near(C_expected, C, FLOAT_TOL);
+
+    /* the result is added to a sparse matrix */
+    Matrix D = MatrixFactory::MakeRandomSparse(n, m, 5, 0.0, 1.0);
+    Matrix D_expected = reference_mult(D, 1.0, A, B, 1.0, false);
+    MatrixF::mult(D, 1.0, Af, B, 1.0);
+    assert_near(D_expected, D, FLOAT_TOL);
+
+    /* B and C are views of submatrices (their leading dimension is larger) */
+    Matrix B_big = MatrixFactory::MakeRandomMatrix(k + 2, m + 1, -1.0, 2.0);
+    Matrix C_big = MatrixFactory::MakeRandomMatrix(n + 3, m, -1.0, 2.0);
+    Matrix B_view = MatrixFactory::ShallowSubmatrix(B_big, 1, k, 0, m - 1);
+    Matrix C_view = MatrixFactory::ShallowSubmatrix(C_big, 2, n + 1, 0, m - 1);
+    Matrix C_big_before(C_big);
+    Matrix E_expected = reference_mult(C_view, 0.5, A, B_view, 2.0, false);
+    _ASSERT_OK(MatrixF::mult(C_view, 0.5, Af, B_view, 2.0));
+    assert_near(E_expected, C_view, FLOAT_TOL);
+    for (size_t j = 0; j < m; j++) {
+        /* the rows of C_big outside the view are untouched */
+        _ASSERT_EQ(C_big_before.get(0, j), C_big.get(0, j));
+        _ASSERT_EQ(C_big_before.get(1, j), C_big.get(1, j));
+    }
+}
+
+void TestMatrixF::testMultSparse() {
+    size_t n = 30;
+    size_t m = 20;
+    Matrix A = MatrixFactory::MakeRandomSparse(n, m, 100, -1.0, 2.0);
+    MatrixF Af(A);
+    Matrix B = MatrixFactory::MakeRandomMatrix(m, 2, -1.0, 2.0);
+    Matrix Z = MatrixFactory::MakeRandomMatrix(n, 2, -1.0, 2.0);
+    double alpha = -2.0;
+    double gamma = 0.5;
+
+    Matrix C = MatrixFactory::MakeRandomMatrix(n, 2, -1.0, 2.0);
+    Matrix C_expected = reference_mult(C, alpha, A, B, gamma, false);
+    _ASSERT_OK(MatrixF::mult(C, alpha, Af, B, gamma));
+    assert_near(C_expected, C, FLOAT_TOL);
+
+    Matrix W = MatrixFactory::MakeRandomMatrix(m, 2, -1.0, 2.0);
+    Matrix W_expected = reference_mult(W, alpha, A, Z, gamma, true);
+    _ASSERT_OK(MatrixF::mult(W, alpha, Af, Z, gamma, true));
+    assert_near(W_expected, W, FLOAT_TOL);
+
+    /* transposed sparse matrix */
+    Af.transpose();
+    A.transpose();
+    Matrix V = MatrixFactory::MakeRandomMatrix(m, 2, -1.0, 2.0);
+    Matrix V_expected = reference_mult(V, alpha, A, Z, gamma, false);
+    _ASSERT_OK(MatrixF::mult(V, alpha, Af, Z, gamma));
+    assert_near(V_expected, V, FLOAT_TOL);
+
+    /* strided right-hand side vector and result */
+    Af.transpose();
+    A.transpose();
+    Matrix b_big = MatrixFactory::MakeRandomMatrix(2 * m, 1, -1.0, 2.0);
+    Matrix c_big = MatrixFactory::MakeRandomMatrix(3 * n, 1, -1.0, 2.0);
+    Matrix b = MatrixFactory::ShallowVector(b_big, m, 1, 2);
+    Matrix c = MatrixFactory::ShallowVector(c_big, n, 0, 3);
+    Matrix c_expected = reference_mult(c, alpha, A, b, gamma, false);
+    _ASSERT_OK(MatrixF::mult(c, alpha, Af, b, gamma));
+    assert_near(c_expected, c, FLOAT_TOL);
+}
+
+void TestMatrixF::testMultSparseLarge() {
+    size_t n = 300;
+    size_t m = 200;
+    Matrix A = MatrixFactory::MakeRandomSparse(n, m, 21000, -1.0, 2.0);
+    MatrixF Af(A);
+    Matrix z = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0);
+    Matrix w(m, 1);
+    Matrix w_expected = reference_mult(w, 1.0, A, z, 0.0, true);
+    _ASSERT_OK(MatrixF::mult(w, 1.0, Af, z, 0.0, true));
+    assert_near(w_expected, w, 1e-3);
+}
+
+void TestMatrixF::testCopyMove() {
+    Matrix A = MatrixFactory::MakeRandomSparse(10, 8, 20, -1.0, 2.0);
+    MatrixF Af(A);
+    MatrixF Bf(Af);
+    MatrixF Cf;
+    Cf = Af;
+    _ASSERT(Bf.isSparse());
+    _ASSERT(Cf.isSparse());
+    for (size_t i = 0; i < 10; i++) {
+        for (size_t j = 0; j < 8; j++) {
+            _ASSERT_EQ(Af.get(i, j), Bf.get(i, j));
+            _ASSERT_EQ(Af.get(i, j), Cf.get(i, j));
+        }
+    }
+    MatrixF Df(std::move(Bf));
+    _ASSERT_EQ(static_cast<size_t> (10), Df.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (0), Bf.getNrows());
+    Cf = MatrixF(3, 2);
+    _ASSERT_NOT(Cf.isSparse());
+    _ASSERT_EQ(0.0f, Cf.get(2, 1));
+}
+
+void TestMatrixF::testOperator() {
+    size_t n = 12;
+    size_t m = 5;
+    Matrix A = MatrixFactory::MakeRandomMatrix(n, m, -1.0, 2.0);
+    MatrixF Af(A);
+    MatrixOperator op(A);
+    MatrixOperator opf(Af);
+    _ASSERT_EQ(&Af, opf.getMatrixF());
+    _ASSERT(op.getMatrixF() == NULL);
+    _ASSERT_EXCEPTION(opf.getMatrix(), std::logic_error);
+    _ASSERT_EQ(op.dimensionIn(), opf.dimensionIn());
+    _ASSERT_EQ(op.dimensionOut(), opf.dimensionOut());
+
+    Matrix x = MatrixFactory::MakeRandomMatrix(m, 1, -1.0, 2.0);
+    Matrix y = op.call(x);
+    Matrix yf = opf.call(x);
+    assert_near(y, yf, FLOAT_TOL);
+
+    Matrix z = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0);
+    Matrix w = op.callAdjoint(z);
+    Matrix wf = opf.callAdjoint(z);
+    assert_near(w, wf, FLOAT_TOL);
+}
+
+void TestMatrixF::testWrongArgs() {
+    Matrix A = MatrixFactory::MakeRandomMatrix(4, 3, -1.0, 2.0);
+    MatrixF Af(A);
+    Matrix x(4, 1);
+    Matrix y(4, 1);
+    _ASSERT_EXCEPTION(MatrixF::mult(y, 1.0, Af, x, 0.0), std::invalid_argument);
+    Matrix D(3, 3, Matrix::MATRIX_DIAGONAL);
+    Matrix C(4, 3);
+    _ASSERT_EXCEPTION(MatrixF::mult(C, 1.0, Af, D, 0.0), std::invalid_argument);
+    _ASSERT_EXCEPTION(Af.get(4, 0), std::out_of_range);
+}
@@ -0,0 +1,52 @@
+/*
+ * File:   TestMatrixF.h
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 3:52:39 PM
+ */
+
+#ifndef TESTMATRIXF_H
+#define	TESTMATRIXF_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#define FORBES_TEST_UTILS
+#include "ForBES.h"
+
+class TestMatrixF : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(TestMatrixF);
+
+    CPPUNIT_TEST(testConvertDense);
+    CPPUNIT_TEST(testConvertSparse);
+    CPPUNIT_TEST(testConvertSymmetric);
+    CPPUNIT_TEST(testMultDense);
+    CPPUNIT_TEST(testMultDenseMatrix);
+    CPPUNIT_TEST(testMultSparse);
+    CPPUNIT_TEST(testMultSparseLarge);
+    CPPUNIT_TEST(testCopyMove);
+    CPPUNIT_TEST(testOperator);
+    CPPUNIT_TEST(testWrongArgs);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    TestMatrixF();
+    virtual ~TestMatrixF();
+    void setUp();
+    void tearDown();
+
+private:
+    void testConvertDense();
+    void testConvertSparse();
+    void testConvertSymmetric();
+    void testMultDense();
+    void testMultDenseMatrix();
+    void testMultSparse();
+    void testMultSparseLarge();
+    void testCopyMove();
+    void testOperator();
+    void testWrongArgs();
+
+};
+
+#endif	/* TESTMATRIXF_H */
@@ -259,6 +259,84 @@ void TestMatrixFactory::testFailSafe() {
     _ASSERT_EXCEPTION(A = MatrixFactory::MakeRandomSparse(10, 10, 101, 0.0, 1.0), std::invalid_argument);
 }
 
+void TestMatrixFactory::testShallowSubmatrix() {
+    Matrix A = MatrixFactory::MakeRandomMatrix(8, 6, -1.0, 2.0);
+    Matrix V = MatrixFactory::ShallowSubmatrix(A, 2, 5, 1, 4);
+    _ASSERT_EQ(static_cast<size_t> (4), V.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (4), V.getNcols());
+    _ASSERT_EQ(static_cast<size_t> (8), V.getLeadingDimension());
+    _ASSERT_NOT(V.isContiguous());
+    for (size_t i = 0; i < 4; i++) {
+        for (size_t j = 0; j < 4; j++) {
+            _ASSERT_EQ(A.get(i + 2, j + 1), V.get(i, j));
+        }
+    }
+    V.set(0, 0, 42.0); /* the view points to the data of A */
+    _ASSERT_EQ(42.0, A.get(2, 1));
+
+    Matrix W(V); /* a contiguous copy */
+    _ASSERT(W.isContiguous());
+    W.set(1, 1, -5.0);
+    _ASSERT_NEQ(-5.0, A.get(3, 2));
+    _ASSERT_EQ(W.get(2, 3), A.get(4, 4));
+
+    /* view of a view */
+    Matrix V2 = MatrixFactory::ShallowSubmatrix(V, 1, 3, 2, 2);
+    _ASSERT(V2.isColumnVector());
+    for (size_t i = 0; i < 3; i++) {
+        _ASSERT_EQ(A.get(i + 3, 3), V2.get(i, 0));
+    }
 
+    /* view of a transposed matrix */
+    Matrix At(A);
+    At.transpose();
+    Matrix Vt = MatrixFactory::ShallowSubmatrix(At, 1, 3, 2, 6);
+    _ASSERT_EQ(static_cast<size_t> (3), Vt.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (5), Vt.getNcols());
+    for (size_t i = 0; i < 3; i++) {
+        for (size_t j = 0; j < 5; j++) {
+            _ASSERT_EQ(A.get(j + 2, i + 1), Vt.get(i, j));
+        }
+    }
 
+    Matrix S = MatrixFactory::MakeRandomSparse(8, 6, 10, 0.0, 1.0);
+    _ASSERT_EXCEPTION(MatrixFactory::ShallowSubmatrix(S, 0, 1, 0, 1), std::invalid_argument);
+    _ASSERT_EXCEPTION(MatrixFactory::ShallowSubmatrix(A, 0, 8, 0, 1), std::out_of_range);
+    _ASSERT_EXCEPTION(MatrixFactory::ShallowSubmatrix(A, 3, 2, 0, 1), std::out_of_range);
+}
+
+void TestMatrixFactory::testStridedVector() {
+    const size_t n = 12;
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 10.0);
+    Matrix s = MatrixFactory::ShallowVector(x, 4, 1, 3); /* x[1], x[4], x[7], x[10] */
+    _ASSERT(s.isColumnVector());
+    _ASSERT_EQ(static_cast<size_t> (4), s.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (4), s.length());
+    _ASSERT_NOT(s.isContiguous());
+    for (size_t i = 0; i < 4; i++) {
+        _ASSERT_EQ(x.get(1 + 3 * i, 0), s.get(i, 0));
+    }
+    s.set(2, 0, -1.0);
+    _ASSERT_EQ(-1.0, x.get(7, 0));
+
+    Matrix s2 = MatrixFactory::ShallowVector(s, 2, 1, 2); /* x[4], x[10] */
+    _ASSERT_EQ(x.get(4, 0), s2.get(0, 0));
+    _ASSERT_EQ(x.get(10, 0), s2.get(1, 0));
+
+    Matrix s_copy(s);
+    _ASSERT(s_copy.isContiguous());
+    _ASSERT_EQ(x.get(10, 0), s_copy[3]);
+
+    /* a row of a matrix is a row vector */
+    Matrix A = MatrixFactory::MakeRandomMatrix(5, 4, 0.0, 1.0);
+    Matrix r = MatrixFactory::ShallowSubmatrix(A, 2, 2, 0, 3);
+    _ASSERT(r.isRowVector());
+    Matrix r_odd = MatrixFactory::ShallowVector(r, 2, 1, 2);
+    _ASSERT(r_odd.isRowVector());
+    _ASSERT_EQ(A.get(2, 1), r_odd.get(0, 0));
+    _ASSERT_EQ(A.get(2, 3), r_odd.get(0, 1));
+
+    _ASSERT_EXCEPTION(MatrixFactory::ShallowVector(x, 4, 0, 0), std::invalid_argument);
+    _ASSERT_EXCEPTION(MatrixFactory::ShallowVector(x, 5, 1, 3), std::out_of_range);
+}
 
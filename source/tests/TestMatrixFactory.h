@@ -26,6 +26,8 @@ class TestMatrixFactory : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(testShallow2);
     CPPUNIT_TEST(testShallow3);
     CPPUNIT_TEST(testShallow4);
+    CPPUNIT_TEST(testShallowSubmatrix);
+    CPPUNIT_TEST(testStridedVector);
     CPPUNIT_TEST(testFailSafe);
     
     CPPUNIT_TEST_SUITE_END();
@@ -47,6 +49,8 @@ private:
     void testShallow2();
     void testShallow3();
     void testShallow4();
+    void testShallowSubmatrix();
+    void testStridedVector();
     void testFailSafe();
 
 };
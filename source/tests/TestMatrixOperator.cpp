@@ -6,6 +6,8 @@
  */
 
 #include "TestMatrixOperator.h"
+#include <thread>
+#include <vector>
 
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestMatrixOperator);
@@ -105,3 +107,112 @@ void TestMatrixOperator::testCallAdjoint() {
     delete T;
 }
 
+void TestMatrixOperator::testCallAdjoint2() {
+    size_t n = 10;
+    size_t m = 4;
+    Matrix A = MatrixFactory::MakeRandomMatrix(n, m, -2.0, 4.0);
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix y = MatrixFactory::MakeRandomMatrix(m, 1, 0.0, 1.0);
+    Matrix y_copy(y);
+    MatrixOperator op(A);
+
+    double alpha = M_PI;
+    double gamma = M_SQRT2;
+
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, op.callAdjoint(y, alpha, x, gamma)); // y = gamma * y + alpha * A' * x
+
+    /* the matrix of the operator is not transposed (not even temporarily) */
+    _ASSERT_EQ(n, op.getMatrix().getNrows());
+    _ASSERT_EQ(m, op.getMatrix().getNcols());
+
+    for (size_t j = 0; j < m; j++) {
+        double yj = gamma * y_copy[j];
+        for (size_t i = 0; i < n; i++) {
+            yj += alpha * A.get(i, j) * x[i];
+        }
+        _ASSERT_NUM_EQ(yj, y[j], 1e-10);
+    }
+
+    /* the same for a transposed matrix: A' is m-by-n, so the adjoint is A */
+    Matrix B(A);
+    B.transpose();
+    MatrixOperator opB(B);
+    Matrix u = MatrixFactory::MakeRandomMatrix(m, 1, 0.0, 1.0);
+    Matrix v(n, 1);
+    Matrix v_expected = A * u;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, opB.callAdjoint(v, 1.0, u, 0.0));
+    _ASSERT_EQ(v_expected, v);
+}
+
+void TestMatrixOperator::testCallAdjointSparse() {
+    size_t n = 50;
+    size_t m = 30;
+    size_t nnz = 400;
+    Matrix A = MatrixFactory::MakeRandomSparse(n, m, nnz, -1.0, 2.0);
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix y = MatrixFactory::MakeRandomMatrix(m, 1, 0.0, 1.0);
+    Matrix y_copy(y);
+    MatrixOperator op(A);
+
+    double alpha = -1.5;
+    double gamma = 0.5;
+
+    for (size_t r = 0; r < 3; r++) {
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, op.callAdjoint(y, alpha, x, gamma));
+        _ASSERT_EQ(n, op.getMatrix().getNrows());
+        for (size_t j = 0; j < m; j++) {
+            double yj = gamma * y_copy[j];
+            for (size_t i = 0; i < n; i++) {
+                yj += alpha * A.get(i, j) * x[i];
+            }
+            _ASSERT_NUM_EQ(yj, y[j], 1e-10);
+        }
+        y_copy = y;
+    }
+}
+
+void TestMatrixOperator::testCallAdjointThreads() {
+    size_t n = 120;
+    size_t m = 80;
+    size_t nnz = 900;
+    const size_t nthreads = 8;
+    /* the CSC of A is built lazily, by whichever thread gets there first */
+    Matrix A = MatrixFactory::MakeRandomSparse(n, m, nnz, -1.0, 2.0);
+    Matrix D = MatrixFactory::MakeRandomMatrix(n, m, -1.0, 2.0);
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    MatrixOperator opA(A);
+    MatrixOperator opD(D);
+
+    std::vector<Matrix> yA(nthreads, Matrix(m, 1));
+    std::vector<Matrix> yD(nthreads, Matrix(m, 1));
+    std::vector<int> status(nthreads, ForBESUtils::STATUS_OK);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < nthreads; t++) {
+        threads.push_back(std::thread([&, t]() {
+            for (size_t k = 0; k < 10; k++) {
+                status[t] = std::max(status[t], opA.callAdjoint(yA[t], 1.0, x, 0.0));
+                status[t] = std::max(status[t], opD.callAdjoint(yD[t], 1.0, x, 0.0));
+            }
+        }));
+    }
+    for (size_t t = 0; t < nthreads; t++) {
+        threads[t].join();
+    }
+
+    for (size_t t = 0; t < nthreads; t++) {
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, status[t]);
+        for (size_t j = 0; j < m; j++) {
+            double yAj = 0.0;
+            double yDj = 0.0;
+            for (size_t i = 0; i < n; i++) {
+                yAj += A.get(i, j) * x[i];
+                yDj += D.get(i, j) * x[i];
+            }
+            _ASSERT_NUM_EQ(yAj, yA[t][j], 1e-10);
+            _ASSERT_NUM_EQ(yDj, yD[t][j], 1e-10);
+        }
+    }
+    /* the operators are left as they were */
+    _ASSERT_EQ(n, opA.getMatrix().getNrows());
+    _ASSERT_EQ(m, opD.getMatrix().getNcols());
+}
@@ -23,6 +23,9 @@ class TestMatrixOperator : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(testCall2);
     CPPUNIT_TEST(testCallId);
     CPPUNIT_TEST(testCallAdjoint);
+    CPPUNIT_TEST(testCallAdjoint2);
+    CPPUNIT_TEST(testCallAdjointSparse);
+    CPPUNIT_TEST(testCallAdjointThreads);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -37,6 +40,9 @@ private:
     void testCall2();
     void testCallId();
     void testCallAdjoint();
+    void testCallAdjoint2();
+    void testCallAdjointSparse();
+    void testCallAdjointThreads();
     
 };
 
@@ -48,3 +48,89 @@ void TestQuadOverAffine::testQuadOverAffine() {
 
 }
 
+/*
+ * Asserts that two instances of QuadOverAffine have the same conjugate 
+ * (and gradient thereof) at a point y.
+ */
+static void assert_same_conjugate(QuadOverAffine& f, QuadOverAffine& f_ref, Matrix& y) {
+    double fstar = 0.0;
+    double fstar_ref = 0.0;
+    Matrix grad;
+    Matrix grad_ref;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, f.callConj(y, fstar, grad));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, f_ref.callConj(y, fstar_ref, grad_ref));
+    _ASSERT_EQ(grad_ref.getNrows(), grad.getNrows());
+    _ASSERT_EQ(1, grad.getNcols());
+    _ASSERT_NUM_EQ(fstar_ref, fstar, 1e-7);
+    for (size_t i = 0; i < grad.getNrows(); i++) {
+        _ASSERT_NUM_EQ(grad_ref.get(i, 0), grad.get(i, 0), 1e-7);
+    }
+}
+
+void TestQuadOverAffine::testSparse() {
+    size_t n = 40;
+    size_t s = 6;
+    /* Q: tridiagonal, positive definite */
+    Matrix Q = MatrixFactory::MakeSparse(n, n, 3 * n, Matrix::SPARSE_UNSYMMETRIC);
+    Matrix Q_dense(n, n);
+    for (size_t i = 0; i < n; i++) {
+        Q.set(i, i, 4.0 + 0.1 * i);
+        Q_dense.set(i, i, 4.0 + 0.1 * i);
+        if (i > 0) {
+            Q.set(i, i - 1, -1.0);
+            Q.set(i - 1, i, -1.0);
+            Q_dense.set(i, i - 1, -1.0);
+            Q_dense.set(i - 1, i, -1.0);
+        }
+    }
+    /* A: every row couples a few variables */
+    Matrix A = MatrixFactory::MakeSparse(s, n, 4 * s, Matrix::SPARSE_UNSYMMETRIC);
+    Matrix A_dense(s, n);
+    for (size_t k = 0; k < s; k++) {
+        for (size_t l = 0; l < 4; l++) {
+            size_t j = (7 * k + 3 * l) % n;
+            double a = 1.0 + 0.5 * l - 0.2 * k;
+            A.set(k, j, a);
+            A_dense.set(k, j, a);
+        }
+    }
+    Matrix q = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix b = MatrixFactory::MakeRandomMatrix(s, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+
+    QuadOverAffine f(Q, q, A, b);
+    QuadOverAffine f_dense(Q_dense, q, A_dense, b);
+
+    for (size_t r = 0; r < 3; r++) {
+        Matrix y = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 2.0, Matrix::MATRIX_DENSE);
+        assert_same_conjugate(f, f_dense, y);
+    }
+
+    /* the gradient of the conjugate is feasible: A * grad = b */
+    Matrix y = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 2.0, Matrix::MATRIX_DENSE);
+    double fstar;
+    Matrix grad;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, f.callConj(y, fstar, grad));
+    Matrix A_grad = A_dense * grad;
+    for (size_t k = 0; k < s; k++) {
+        _ASSERT_NUM_EQ(b.get(k, 0), A_grad.get(k, 0), 1e-8);
+    }
+}
+
+void TestQuadOverAffine::testDiagonalQ() {
+    size_t n = 10;
+    size_t s = 3;
+    Matrix Q(n, n, Matrix::MATRIX_DIAGONAL);
+    Matrix Q_dense(n, n);
+    for (size_t i = 0; i < n; i++) {
+        Q.set(i, i, 1.0 + i);
+        Q_dense.set(i, i, 1.0 + i);
+    }
+    Matrix A = MatrixFactory::MakeRandomMatrix(s, n, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix q = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix b = MatrixFactory::MakeRandomMatrix(s, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+
+    QuadOverAffine f(Q, q, A, b);
+    QuadOverAffine f_dense(Q_dense, q, A, b);
+    Matrix y = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    assert_same_conjugate(f, f_dense, y);
+}
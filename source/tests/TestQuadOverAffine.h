@@ -18,6 +18,8 @@ class TestQuadOverAffine : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST_SUITE(TestQuadOverAffine);
 
     CPPUNIT_TEST(testQuadOverAffine);
+    CPPUNIT_TEST(testSparse);
+    CPPUNIT_TEST(testDiagonalQ);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -29,6 +31,8 @@ public:
 
 private:
     void testQuadOverAffine();
+    void testSparse();
+    void testDiagonalQ();
 };
 
 #endif	/* TESTQUADOVERAFFINE_H */
@@ -159,6 +159,133 @@ void TestQuadratic::testCallProx() {
     delete F;
 }
 
+/*
+ * Checks that (I + gamma*Q) * prox = v - gamma*q
+ */
+static void assert_prox(Matrix& Q, Matrix& q, Matrix& v, double gamma, Matrix& prox) {
+    const size_t n = Q.getNrows();
+    for (size_t i = 0; i < n; i++) {
+        double lhs = prox.get(i, 0);
+        for (size_t j = 0; j < n; j++) {
+            lhs += gamma * Q.get(i, j) * prox.get(j, 0);
+        }
+        _ASSERT_NUM_EQ(v.get(i, 0) - gamma * q.get(i, 0), lhs, 1e-9);
+    }
+}
+
+/*
+ * Tridiagonal positive definite matrix with 4 on the diagonal and -1 on the
+ * sub- and super-diagonal
+ */
+static void tridiagonal(Matrix& Q) {
+    const size_t n = Q.getNrows();
+    for (size_t i = 0; i < n; i++) {
+        Q.set(i, i, 4.0);
+        if (i > 0) {
+            Q.set(i, i - 1, -1.0);
+            Q.set(i - 1, i, -1.0);
+        }
+    }
+}
+
+void TestQuadratic::testCallProxCached() {
+    const size_t n = 8;
+    Matrix Q(n, n);
+    tridiagonal(Q);
+    Matrix q = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix v = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0);
+    Matrix prox;
+
+    FactorizationCache cache(4);
+    Quadratic f(Q, q);
+    f.setFactorizationCache(cache);
+
+    const double gammas[3] = {0.5, 1.0, 0.5};
+    for (size_t k = 0; k < 3; k++) {
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, f.callProx(v, gammas[k], prox));
+        assert_prox(Q, q, v, gammas[k], prox);
+    }
+    _ASSERT_EQ(2, cache.size());
+    _ASSERT_EQ(2, cache.getMisses());
+    _ASSERT_EQ(1, cache.getHits());
+
+    /* Q is modified in place: the cached factorizations must be discarded */
+    Q *= 3.0;
+    f.invalidate();
+    _ASSERT_EQ(0, cache.size());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, f.callProx(v, 0.5, prox));
+    assert_prox(Q, q, v, 0.5, prox);
+    _ASSERT_EQ(3, cache.getMisses());
+
+    /* a new Q invalidates the cached factorizations */
+    Matrix Q2(n, n);
+    tridiagonal(Q2);
+    Q2 *= 2.0;
+    f.setQ(Q2);
+    _ASSERT_EQ(0, cache.size());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, f.callProx(v, 0.5, prox));
+    assert_prox(Q2, q, v, 0.5, prox);
+    _ASSERT_EQ(1, cache.size());
+    _ASSERT_EQ(4, cache.getMisses());
+
+    /* diagonal Q: no factorization is needed */
+    Matrix D = MatrixFactory::MakeRandomMatrix(n, n, 1.0, 2.0, Matrix::MATRIX_DIAGONAL);
+    f.setQ(D);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, f.callProx(v, 0.7, prox));
+    assert_prox(D, q, v, 0.7, prox);
+    _ASSERT_EQ(0, cache.size());
+}
+
+void TestQuadratic::testCallProxSparse() {
+    const size_t n = 12;
+    Matrix Q(n, n);
+    tridiagonal(Q);
+    Matrix Q_sparse = MatrixFactory::MakeSparse(n, n, 3 * n - 2, Matrix::SPARSE_UNSYMMETRIC);
+    tridiagonal(Q_sparse);
+    Matrix v = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0);
+    Matrix q(n, 1);
+    Matrix prox;
+    Matrix prox_sparse;
+
+    Quadratic f(Q);
+    Quadratic f_sparse(Q_sparse);
+    for (size_t k = 1; k <= 3; k++) {
+        double gamma = 0.4 * k;
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, f.callProx(v, gamma, prox));
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, f_sparse.callProx(v, gamma, prox_sparse));
+        assert_prox(Q, q, v, gamma, prox_sparse);
+        for (size_t i = 0; i < n; i++) {
+            _ASSERT_NUM_EQ(prox.get(i, 0), prox_sparse.get(i, 0), 1e-10);
+        }
+    }
+}
+
+void TestQuadratic::testCallProxEigen() {
+    const size_t n = 10;
+    Matrix Q(n, n);
+    tridiagonal(Q);
+    Matrix q = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    Matrix v = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0);
+    Matrix prox;
+    Matrix prox_eig;
+
+    Quadratic f(Q, q);
+    Quadratic f_eig(Q, q);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, f_eig.computeEigendecomposition());
+    for (size_t k = 1; k <= 3; k++) {
+        double gamma = 0.3 * k;
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, f.callProx(v, gamma, prox));
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, f_eig.callProx(v, gamma, prox_eig));
+        assert_prox(Q, q, v, gamma, prox_eig);
+        for (size_t i = 0; i < n; i++) {
+            _ASSERT_NUM_EQ(prox.get(i, 0), prox_eig.get(i, 0), 1e-10);
+        }
+    }
+
+    Quadratic f_eye;
+    _ASSERT_EQ(ForBESUtils::STATUS_UNDEFINED_FUNCTION, f_eye.computeEigendecomposition());
+}
+
 void TestQuadratic::testCall() {
     const double * Qdata;
     Qdata = MAT2;
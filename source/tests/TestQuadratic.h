@@ -34,6 +34,9 @@ class TestQuadratic : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(testQuadratic2);
     CPPUNIT_TEST(testQuadratic3);
     CPPUNIT_TEST(testCallProx);
+    CPPUNIT_TEST(testCallProxCached);
+    CPPUNIT_TEST(testCallProxSparse);
+    CPPUNIT_TEST(testCallProxEigen);
     CPPUNIT_TEST(testCall);
     CPPUNIT_TEST(testCallWithGradient);
     CPPUNIT_TEST(testCallConj);
@@ -60,6 +63,9 @@ private:
     void testQuadratic2();
     void testQuadratic3();
     void testCallProx();
+    void testCallProxCached();
+    void testCallProxSparse();
+    void testCallProxEigen();
     void testCall();
     void testCallWithGradient();
     void testCallConj();
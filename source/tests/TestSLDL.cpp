@@ -153,3 +153,126 @@ void TestSLDL::testDenseTall() {
 
 }
 
+void TestSLDL::testRefactorize() {
+    const size_t n = 8;
+    const size_t m = 3;
+    Matrix X = MatrixFactory::MakeRandomSparse(n, m, 12, 0.0, 1.0);
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix sol;
+
+    double beta = 1.5;
+    S_LDLFactorization solver(X, beta);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.factorize());
+
+    for (size_t k = 0; k < 3; k++) {
+        /* new regularization, same matrix */
+        beta = 0.5 + k;
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.refactorize(beta));
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(x, sol));
+
+        Matrix Xt(X);
+        Xt.transpose();
+        Matrix g1 = X * Xt * sol;
+        Matrix g2 = x;
+        _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::add(g2, -beta, sol, 1.0));
+        _ASSERT_EQ(g1, g2);
+    }
+
+    /* new values, same pattern */
+    Matrix X2(X);
+    X2 *= 2.0;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.refactorize(X2));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(x, sol));
+    Matrix X2t(X2);
+    X2t.transpose();
+    Matrix g1 = X2 * X2t * sol;
+    Matrix g2 = x;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::add(g2, -beta, sol, 1.0));
+    _ASSERT_EQ(g1, g2);
+}
+
+void TestSLDL::testUpdate() {
+    const size_t n = 8;
+    const size_t m = 3;
+    const double tol = 1e-8;
+    Matrix X = MatrixFactory::MakeRandomSparse(n, m, 12, 0.0, 1.0);
+    Matrix C = MatrixFactory::MakeRandomMatrix(n, 2, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix sol;
+
+    double beta = 1.5;
+    S_LDLFactorization solver(X, beta);
+    _ASSERT_EXCEPTION(solver.update(C), std::logic_error);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.factorize());
+
+    /* (XX' + CC' + beta*I) sol = x */
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.update(C));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(x, sol));
+    Matrix Xt(X);
+    Xt.transpose();
+    Matrix Ct(C);
+    Ct.transpose();
+    Matrix Xt_sol = Xt * sol;
+    Matrix Ct_sol = Ct * sol;
+    Matrix g1 = X * Xt_sol;
+    Matrix g2 = C * Ct_sol;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(x.get(i, 0), g1.get(i, 0) + g2.get(i, 0) + beta * sol.get(i, 0), tol);
+    }
+
+    /* and back to XX' + beta*I */
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.downdate(C));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(x, sol));
+    Xt_sol = Xt * sol;
+    g1 = X * Xt_sol;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(x.get(i, 0), g1.get(i, 0) + beta * sol.get(i, 0), tol);
+    }
+
+    Matrix D(n + 1, 1);
+    _ASSERT_EXCEPTION(solver.update(D), std::invalid_argument);
+
+    /* dense matrices are not supported */
+    Matrix Y = MatrixFactory::MakeRandomMatrix(n, m, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    S_LDLFactorization solver_dense(Y, beta);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_dense.factorize());
+    _ASSERT_EXCEPTION(solver_dense.update(C), std::logic_error);
+}
+
+void TestSLDL::testAugmented() {
+    const size_t n = 10;
+    const size_t m = 25;
+    const double tol = 1e-8;
+    Matrix X = MatrixFactory::MakeRandomSparse(n, m, 40, 0.0, 1.0);
+    Matrix B = MatrixFactory::MakeRandomMatrix(n, 2, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix sol;
+    Matrix sol_aug;
+
+    double beta = 0.8;
+    S_LDLFactorization solver(X, beta);
+    S_LDLFactorization solver_aug(X, beta, true);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_aug.factorize());
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(B, sol));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_aug.solve(B, sol_aug));
+    _ASSERT_EQ(n, sol_aug.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (2), sol_aug.getNcols());
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            _ASSERT_NUM_EQ(sol.get(i, j), sol_aug.get(i, j), tol);
+        }
+    }
+
+    /* new beta, same pattern */
+    beta = 2.5;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.refactorize(beta));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_aug.refactorize(beta));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver.solve(B, sol));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, solver_aug.solve(B, sol_aug));
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < 2; j++) {
+            _ASSERT_NUM_EQ(sol.get(i, j), sol_aug.get(i, j), tol);
+        }
+    }
+    _ASSERT_EXCEPTION(solver_aug.update(B), std::logic_error);
+}
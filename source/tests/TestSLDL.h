@@ -31,6 +31,9 @@ class TestSLDL : public CPPUNIT_NS::TestFixture {
     CPPUNIT_TEST(testFactorizeAndSolve);
     CPPUNIT_TEST(testDenseShort);
     CPPUNIT_TEST(testDenseTall);
+    CPPUNIT_TEST(testRefactorize);
+    CPPUNIT_TEST(testUpdate);
+    CPPUNIT_TEST(testAugmented);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -44,6 +47,9 @@ private:
     void testFactorizeAndSolve();
     void testDenseShort();
     void testDenseTall();
+    void testRefactorize();
+    void testUpdate();
+    void testAugmented();
 };
 
 #endif	/* TESTSLDL_H */
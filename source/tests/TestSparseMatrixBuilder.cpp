@@ -0,0 +1,172 @@
+/*
+ * File:   TestSparseMatrixBuilder.cpp
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 10:40:01 AM
+ * 
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *  
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestSparseMatrixBuilder.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSparseMatrixBuilder);
+
+TestSparseMatrixBuilder::TestSparseMatrixBuilder() {
+}
+
+TestSparseMatrixBuilder::~TestSparseMatrixBuilder() {
+}
+
+void TestSparseMatrixBuilder::setUp() {
+}
+
+void TestSparseMatrixBuilder::tearDown() {
+    Matrix::destroy_handle();
+}
+
+void TestSparseMatrixBuilder::testBuild() {
+    size_t n = 6;
+    size_t m = 4;
+    SparseMatrixBuilder builder(n, m);
+    Matrix D(n, m);
+    /* insert in no particular order */
+    for (size_t k = n * m + 2; k >= 3; k -= 3) {
+        size_t i = (k - 3) % n;
+        size_t j = (k - 3) / n;
+        builder.set(i, j, k + 1.0);
+        D.set(i, j, k + 1.0);
+    }
+    _ASSERT_EQ(static_cast<size_t> (8), builder.nnz());
+
+    Matrix A = builder.build();
+    _ASSERT_EQ(Matrix::MATRIX_SPARSE, A.getType());
+    _ASSERT_EQ(n, A.getNrows());
+    _ASSERT_EQ(m, A.getNcols());
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < m; j++) {
+            _ASSERT_EQ(D.get(i, j), A.get(i, j));
+            _ASSERT_EQ(D.get(i, j), builder.get(i, j));
+        }
+    }
+
+    /* the matrix behaves like any other sparse matrix */
+    Matrix x = MatrixFactory::MakeRandomMatrix(m, 1, 0.0, 1.0);
+    _ASSERT_EQ(D * x, A * x);
+    A.set(0, 0, 100.0);
+    _ASSERT_EQ(100.0, A.get(0, 0));
+}
+
+void TestSparseMatrixBuilder::testSetAndAdd() {
+    SparseMatrixBuilder builder(3, 3);
+    builder.set(1, 2, 5.0);
+    builder.set(1, 2, 2.0); /* overwrites */
+    builder.add(1, 2, 0.5);
+    builder.add(0, 0, 1.0); /* adds to zero */
+    builder.add(0, 0, 1.0);
+    _ASSERT_EQ(static_cast<size_t> (2), builder.nnz());
+    _ASSERT_EQ(2.5, builder.get(1, 2));
+    _ASSERT_EQ(2.0, builder.get(0, 0));
+    _ASSERT_EQ(0.0, builder.get(2, 1));
+
+    Matrix A = builder.build();
+    _ASSERT_EQ(2.5, A.get(1, 2));
+    _ASSERT_EQ(2.0, A.get(0, 0));
+    _ASSERT_EQ(0.0, A.get(2, 1));
+
+    builder.clear();
+    _ASSERT_EQ(static_cast<size_t> (0), builder.nnz());
+    _ASSERT_EQ(0.0, builder.get(1, 2));
+    /* the matrix built before is unaffected */
+    _ASSERT_EQ(2.5, A.get(1, 2));
+}
+
+void TestSparseMatrixBuilder::testSymmetric() {
+    size_t n = 5;
+    SparseMatrixBuilder builder(n, n, Matrix::SPARSE_SYMMETRIC_L);
+    Matrix H(n, n, Matrix::MATRIX_SYMMETRIC);
+    for (size_t i = 0; i < n; i++) {
+        builder.set(i, i, 4.0 + i);
+        H.set(i, i, 4.0 + i);
+        if (i > 0) {
+            builder.set(i, i - 1, -1.0);
+            H.set(i, i - 1, -1.0);
+        }
+    }
+    builder.add(0, 1, -0.5); /* same element as (1, 0) */
+    H.set(1, 0, -1.5);
+    _ASSERT_EQ(2 * n - 1, builder.nnz());
+    _ASSERT_EQ(-1.5, builder.get(0, 1));
+
+    Matrix A = builder.build();
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < n; j++) {
+            _ASSERT_EQ(H.get(i, j), A.get(i, j));
+        }
+    }
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, 0.0, 1.0);
+    _ASSERT_EQ(H * x, A * x);
+
+    _ASSERT_EXCEPTION(SparseMatrixBuilder(3, 4, Matrix::SPARSE_SYMMETRIC_L), std::invalid_argument);
+}
+
+void TestSparseMatrixBuilder::testEmpty() {
+    SparseMatrixBuilder builder(4, 3);
+    Matrix A = builder.build();
+    _ASSERT_EQ(Matrix::MATRIX_SPARSE, A.getType());
+    _ASSERT_EQ(0.0, A.get(3, 2));
+    Matrix x = MatrixFactory::MakeRandomMatrix(3, 1, 0.0, 1.0);
+    Matrix y = A * x;
+    _ASSERT_EQ(static_cast<size_t> (4), y.getNrows());
+    for (size_t i = 0; i < 4; i++) {
+        _ASSERT_EQ(0.0, y[i]);
+    }
+}
+
+void TestSparseMatrixBuilder::testLarge() {
+    /* tridiagonal matrix with many nonzeros */
+    size_t n = 50000;
+    SparseMatrixBuilder builder(n, n);
+    builder.reserve(3 * n);
+    for (size_t i = 0; i < n; i++) {
+        builder.set(i, i, 2.0);
+        if (i > 0) {
+            builder.set(i, i - 1, -1.0);
+        }
+        if (i < n - 1) {
+            builder.set(i, i + 1, -1.0);
+        }
+    }
+    _ASSERT_EQ(3 * n - 2, builder.nnz());
+    Matrix A = builder.build();
+    _ASSERT_EQ(2.0, A.get(n - 1, n - 1));
+    _ASSERT_EQ(-1.0, A.get(n - 1, n - 2));
+    _ASSERT_EQ(0.0, A.get(n - 1, 0));
+
+    Matrix x(n, 1);
+    for (size_t i = 0; i < n; i++) {
+        x[i] = 1.0;
+    }
+    Matrix y = A * x; /* y = (1, 0, ..., 0, 1) */
+    _ASSERT_NUM_EQ(1.0, y[0], 1e-12);
+    _ASSERT_NUM_EQ(0.0, y[n / 2], 1e-12);
+    _ASSERT_NUM_EQ(1.0, y[n - 1], 1e-12);
+}
+
+void TestSparseMatrixBuilder::testOutOfRange() {
+    SparseMatrixBuilder builder(3, 2);
+    _ASSERT_EXCEPTION(builder.set(3, 0, 1.0), std::out_of_range);
+    _ASSERT_EXCEPTION(builder.add(0, 2, 1.0), std::out_of_range);
+    _ASSERT_EXCEPTION(builder.get(5, 5), std::out_of_range);
+    _ASSERT_EQ(static_cast<size_t> (0), builder.nnz());
+}
@@ -0,0 +1,44 @@
+/*
+ * File:   TestSparseMatrixBuilder.h
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 10:40:01 AM
+ */
+
+#ifndef TESTSPARSEMATRIXBUILDER_H
+#define	TESTSPARSEMATRIXBUILDER_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#define FORBES_TEST_UTILS
+#include "ForBES.h"
+
+class TestSparseMatrixBuilder : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(TestSparseMatrixBuilder);
+
+    CPPUNIT_TEST(testBuild);
+    CPPUNIT_TEST(testSetAndAdd);
+    CPPUNIT_TEST(testSymmetric);
+    CPPUNIT_TEST(testEmpty);
+    CPPUNIT_TEST(testLarge);
+    CPPUNIT_TEST(testOutOfRange);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    TestSparseMatrixBuilder();
+    virtual ~TestSparseMatrixBuilder();
+    void setUp();
+    void tearDown();
+
+private:
+    void testBuild();
+    void testSetAndAdd();
+    void testSymmetric();
+    void testEmpty();
+    void testLarge();
+    void testOutOfRange();
+
+};
+
+#endif	/* TESTSPARSEMATRIXBUILDER_H */
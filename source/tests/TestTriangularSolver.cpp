@@ -0,0 +1,112 @@
+/*
+ * File:   TestTriangularSolver.cpp
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 6:52:10 PM
+ * 
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *  
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestTriangularSolver.h"
+#include <cmath>
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestTriangularSolver);
+
+TestTriangularSolver::TestTriangularSolver() {
+}
+
+TestTriangularSolver::~TestTriangularSolver() {
+}
+
+void TestTriangularSolver::setUp() {
+}
+
+void TestTriangularSolver::tearDown() {
+    Matrix::destroy_handle();
+}
+
+void TestTriangularSolver::testSolveLower() {
+    size_t n = 20;
+    const double tol = 1e-9;
+    Matrix L = MatrixFactory::MakeRandomMatrix(n, n, 1.0, 1.0, Matrix::MATRIX_LOWERTR);
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0);
+    Matrix x;
+
+    TriangularSolver * solver = new TriangularSolver(L);
+    _ASSERT_OK(solver->solve(b, x));
+    _ASSERT_EQ(n, x.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (1), x.getNcols());
+
+    Matrix Lx = L * x;
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(b.get(i, 0), Lx.get(i, 0), tol);
+    }
+    delete solver;
+}
+
+void TestTriangularSolver::testSolveUpper() {
+    size_t n = 15;
+    const double tol = 1e-9;
+    Matrix U = MatrixFactory::MakeRandomMatrix(n, n, 1.0, 1.0, Matrix::MATRIX_LOWERTR);
+    U.transpose();
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0);
+    Matrix x;
+
+    TriangularSolver solver(U);
+    _ASSERT_OK(solver.solve(b, x));
+    for (size_t i = 0; i < n; i++) {
+        double Ux_i = 0.0;
+        for (size_t j = i; j < n; j++) {
+            Ux_i += U.get(i, j) * x.get(j, 0);
+        }
+        _ASSERT_NUM_EQ(b.get(i, 0), Ux_i, tol);
+    }
+}
+
+void TestTriangularSolver::testSolveMultipleRHS() {
+    size_t n = 12;
+    size_t k = 4;
+    const double tol = 1e-9;
+    Matrix L = MatrixFactory::MakeRandomMatrix(n, n, 1.0, 1.0, Matrix::MATRIX_LOWERTR);
+    Matrix B = MatrixFactory::MakeRandomMatrix(k, n, -1.0, 2.0);
+    B.transpose();
+    Matrix X;
+
+    TriangularSolver solver(L);
+    _ASSERT_OK(solver.solve(B, X));
+    _ASSERT_EQ(k, X.getNcols());
+    Matrix LX = L * X;
+    for (size_t i = 0; i < n; i++) {
+        for (size_t j = 0; j < k; j++) {
+            _ASSERT_NUM_EQ(B.get(i, j), LX.get(i, j), tol);
+        }
+    }
+
+    Matrix c = MatrixFactory::MakeRandomMatrix(n + 1, 1, -1.0, 2.0);
+    _ASSERT_EXCEPTION(solver.solve(c, X), std::invalid_argument);
+}
+
+void TestTriangularSolver::testSingular() {
+    size_t n = 6;
+    Matrix L = MatrixFactory::MakeRandomMatrix(n, n, 1.0, 1.0, Matrix::MATRIX_LOWERTR);
+    L.set(3, 3, 0.0);
+    Matrix b = MatrixFactory::MakeRandomMatrix(n, 1, -1.0, 2.0);
+    Matrix x;
+    TriangularSolver solver(L);
+    _ASSERT_EQ(ForBESUtils::STATUS_NUMERICAL_PROBLEMS, solver.solve(b, x));
+
+    Matrix D = MatrixFactory::MakeRandomMatrix(n, n, 1.0, 1.0, Matrix::MATRIX_DENSE);
+    _ASSERT_EXCEPTION(TriangularSolver solver2(D), std::invalid_argument);
+}
@@ -0,0 +1,56 @@
+/*
+ * File:   TestTriangularSolver.h
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 6:52:10 PM
+ * 
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *  
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TESTTRIANGULARSOLVER_H
+#define	TESTTRIANGULARSOLVER_H
+
+#define FORBES_TEST_UTILS
+
+#include "ForBES.h"
+#include "ForBESUtils.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+class TestTriangularSolver : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(TestTriangularSolver);
+
+    CPPUNIT_TEST(testSolveLower);
+    CPPUNIT_TEST(testSolveUpper);
+    CPPUNIT_TEST(testSolveMultipleRHS);
+    CPPUNIT_TEST(testSingular);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    TestTriangularSolver();
+    virtual ~TestTriangularSolver();
+    void setUp();
+    void tearDown();
+
+private:
+    void testSolveLower();
+    void testSolveUpper();
+    void testSolveMultipleRHS();
+    void testSingular();
+
+};
+
+#endif	/* TESTTRIANGULARSOLVER_H */
+
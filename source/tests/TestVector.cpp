@@ -0,0 +1,352 @@
+/*
+ * File:   TestVector.cpp
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 6:58:20 PM
+ * 
+ * ForBES is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *  
+ * ForBES is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU Lesser General Public License for more details.
+ * 
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ForBES. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "TestVector.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestVector);
+
+TestVector::TestVector() {
+}
+
+TestVector::~TestVector() {
+}
+
+void TestVector::setUp() {
+}
+
+void TestVector::tearDown() {
+    Matrix::destroy_handle();
+}
+
+void TestVector::testVector() {
+    Vector v(5);
+    _ASSERT_EQ(static_cast<size_t> (5), v.size());
+    for (size_t i = 0; i < v.size(); i++) {
+        _ASSERT_EQ(0.0, v[i]);
+        v[i] = i + 1.0;
+    }
+    Vector w(v);
+    w[0] = -1.0;
+    _ASSERT_EQ(1.0, v[0]);
+    _ASSERT_EQ(2.0, w[1]);
+
+    Vector z;
+    _ASSERT_EQ(static_cast<size_t> (0), z.size());
+    z = v;
+    _ASSERT_EQ(5.0, z[4]);
+    const double * z_data = z.data();
+    z = w; /* same size: the buffer is reused */
+    _ASSERT_EQ(z_data, z.data());
+    _ASSERT_EQ(-1.0, z[0]);
+
+    Vector u(std::move(z));
+    _ASSERT_EQ(z_data, u.data());
+    _ASSERT_EQ(static_cast<size_t> (0), z.size());
+
+    VectorView view = v; /* implicit conversion */
+    view[2] = 10.0;
+    _ASSERT_EQ(10.0, v[2]);
+    Vector copy(view);
+    _ASSERT_EQ(10.0, copy[2]);
+    _ASSERT_NEQ(v.data(), copy.data());
+}
+
+void TestVector::testViewOfMatrix() {
+    Matrix x = MatrixFactory::MakeRandomMatrix(6, 1, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    VectorView xv(x);
+    _ASSERT_EQ(static_cast<size_t> (6), xv.size());
+    _ASSERT_EQ(static_cast<size_t> (1), xv.stride());
+    xv[3] = 7.0;
+    _ASSERT_EQ(7.0, x.get(3, 0));
+
+    /* a row of a matrix is a strided vector */
+    Matrix A = MatrixFactory::MakeRandomMatrix(4, 5, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    Matrix row = MatrixFactory::ShallowSubmatrix(A, 2, 2, 0, 4);
+    VectorView rv(row);
+    _ASSERT_EQ(static_cast<size_t> (5), rv.size());
+    _ASSERT_EQ(static_cast<size_t> (4), rv.stride());
+    for (size_t j = 0; j < 5; j++) {
+        _ASSERT_EQ(A.get(2, j), rv[j]);
+    }
+
+    /* strided shallow vectors */
+    Matrix x_strided = MatrixFactory::ShallowVector(x, 3, 1, 2);
+    VectorView sv(x_strided);
+    _ASSERT_EQ(static_cast<size_t> (3), sv.size());
+    _ASSERT_EQ(static_cast<size_t> (2), sv.stride());
+    _ASSERT_EQ(7.0, sv[1]);
+
+    /* back to matrices */
+    Matrix sv_mat = sv.asMatrix();
+    _ASSERT_EQ(static_cast<size_t> (3), sv_mat.getNrows());
+    _ASSERT_EQ(static_cast<size_t> (1), sv_mat.getNcols());
+    _ASSERT_EQ(7.0, sv_mat.get(1, 0));
+    Matrix sv_compact = sv.asContiguousMatrix();
+    _ASSERT(sv_compact.isContiguous());
+    sv_compact.set(2, 0, -3.0);
+    _ASSERT_NEQ(-3.0, x.get(5, 0));
+    sv.copyFrom(sv_compact);
+    _ASSERT_EQ(-3.0, x.get(5, 0));
+
+    Matrix M = MatrixFactory::MakeRandomMatrix(3, 3, 0.0, 1.0, Matrix::MATRIX_DENSE);
+    _ASSERT_EXCEPTION(VectorView mv(M), std::invalid_argument);
+    Matrix S = MatrixFactory::MakeRandomSparse(5, 1, 2, 0.0, 1.0);
+    _ASSERT_EXCEPTION(VectorView svv(S), std::invalid_argument);
+    double data[4] = {1.0, 2.0, 3.0, 4.0};
+    _ASSERT_EXCEPTION(VectorView zero_stride(data, 4, 0), std::invalid_argument);
+}
+
+void TestVector::testSegment() {
+    double data[8] = {0.0, 1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0};
+    VectorView v(data, 4, 2); /* 0, 2, 4, 6 */
+    VectorView s = v.segment(1, 2);
+    _ASSERT_EQ(static_cast<size_t> (2), s.size());
+    _ASSERT_EQ(2.0, s[0]);
+    _ASSERT_EQ(4.0, s[1]);
+    _ASSERT_EXCEPTION(v.segment(3, 2), std::out_of_range);
+}
+
+void TestVector::testMult() {
+    const double tol = 1e-12;
+    Matrix A = MatrixFactory::MakeRandomMatrix(5, 4, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix x = MatrixFactory::MakeRandomMatrix(4, 1, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix y0 = MatrixFactory::MakeRandomMatrix(5, 1, -1.0, 2.0, Matrix::MATRIX_DENSE);
+
+    /* y = 0.5 * y + 2 * A * x */
+    Matrix y_ref(y0);
+    _ASSERT_OK(Matrix::mult(y_ref, 2.0, A, x, 0.5));
+    Vector y((VectorView(y0)));
+    Vector xv((VectorView(x)));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::mult(y, 2.0, A, xv, 0.5, false));
+    for (size_t i = 0; i < 5; i++) {
+        _ASSERT_NUM_EQ(y_ref.get(i, 0), y[i], tol);
+    }
+
+    /* A' * z with a strided z and a strided result */
+    double z_data[10];
+    double w_data[8];
+    for (size_t i = 0; i < 10; i++) {
+        z_data[i] = i - 4.0;
+    }
+    VectorView z(z_data, 5, 2);
+    VectorView w(w_data, 4, 2);
+    Matrix z_mat = z.asContiguousMatrix();
+    Matrix w_ref(4, 1);
+    _ASSERT_OK(Matrix::mult(w_ref, 1.0, A, z_mat, 0.0, true));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::mult(w, 1.0, A, z, 0.0, true));
+    for (size_t i = 0; i < 4; i++) {
+        _ASSERT_NUM_EQ(w_ref.get(i, 0), w[i], tol);
+    }
+
+    /* sparse and diagonal matrices */
+    Matrix S = MatrixFactory::MakeRandomSparse(5, 4, 8, -1.0, 2.0);
+    Matrix Sx_ref(5, 1);
+    _ASSERT_OK(Matrix::mult(Sx_ref, 1.0, S, x, 0.0));
+    Vector Sx(5);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::mult(Sx, 1.0, S, xv, 0.0, false));
+    for (size_t i = 0; i < 5; i++) {
+        _ASSERT_NUM_EQ(Sx_ref.get(i, 0), Sx[i], tol);
+    }
+    Matrix D = MatrixFactory::MakeRandomMatrix(4, 4, 1.0, 2.0, Matrix::MATRIX_DIAGONAL);
+    Vector Dx(4);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, Matrix::mult(Dx, 1.0, D, xv, 0.0, false));
+    for (size_t i = 0; i < 4; i++) {
+        _ASSERT_NUM_EQ(D.get(i, i) * x.get(i, 0), Dx[i], tol);
+    }
+
+    Vector wrong(3);
+    _ASSERT_EXCEPTION(Matrix::mult(wrong, 1.0, A, xv, 0.0, false), std::invalid_argument);
+}
+
+void TestVector::testFunctions() {
+    const double tol = 1e-12;
+    const size_t n = 6;
+    Matrix x = MatrixFactory::MakeRandomMatrix(n, 1, -2.0, 4.0, Matrix::MATRIX_DENSE);
+    double gamma = 0.7;
+
+    /* Norm1 */
+    Norm1 norm1(1.5);
+    Function& f = norm1;
+    double fx_ref;
+    double fx;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, f.call(x, fx_ref));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, f.call(VectorView(x), fx));
+    _ASSERT_NUM_EQ(fx_ref, fx, tol);
+    Matrix prox_ref(n, 1);
+    double f_prox_ref;
+    double f_prox;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, f.callProx(x, gamma, prox_ref, f_prox_ref));
+    Vector prox(n);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, f.callProx(VectorView(x), gamma, prox, f_prox));
+    _ASSERT_NUM_EQ(f_prox_ref, f_prox, tol);
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(prox_ref.get(i, 0), prox[i], tol);
+    }
+
+    /* IndBox */
+    double lb = -0.5;
+    double ub = 1.0;
+    IndBox box(lb, ub);
+    Vector box_prox(n);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, box.callProx(VectorView(x), gamma, box_prox));
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(std::min(ub, std::max(lb, x.get(i, 0))), box_prox[i], tol);
+    }
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, box.call(box_prox, fx));
+    _ASSERT_EQ(0.0, fx);
+    box_prox[0] = 2.0;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, box.call(box_prox, fx));
+    _ASSERT(std::isinf(fx));
+
+    /* default implementation (via matrices), with a strided output */
+    ElasticNet elastic(0.5, 1.2);
+    Function& g = elastic;
+    Matrix g_prox_ref(n, 1);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, g.callProx(x, gamma, g_prox_ref, f_prox_ref));
+    double out[2 * n];
+    VectorView g_prox(out, n, 2);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, g.callProx(VectorView(x), gamma, g_prox, f_prox));
+    _ASSERT_NUM_EQ(f_prox_ref, f_prox, tol);
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(g_prox_ref.get(i, 0), out[2 * i], tol);
+    }
+
+    /* the overloads on views are visible on the static type of subclasses */
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, elastic.callProx(VectorView(x), gamma, g_prox));
+    _ASSERT_NUM_EQ(g_prox_ref.get(0, 0), out[0], tol);
+    IndBall2 ball(1.0);
+    Matrix ball_prox_ref(n, 1);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ball.callProx(x, gamma, ball_prox_ref));
+    Vector ball_prox(n);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, ball.callProx(VectorView(x), gamma, ball_prox));
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(ball_prox_ref.get(i, 0), ball_prox[i], tol);
+    }
+    Matrix Q = MatrixFactory::MakeRandomMatrix(n, n, 0.0, 1.0, Matrix::MATRIX_DIAGONAL);
+    Quadratic quad(Q);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, quad.call(x, fx_ref));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, quad.call(VectorView(x), fx));
+    _ASSERT_NUM_EQ(fx_ref, fx, tol);
+}
+
+void TestVector::testFunctionsOnStridedMatrices() {
+    const double tol = 1e-12;
+    const size_t n = 5;
+    double gamma = 0.8;
+
+    /* linear access to a row of a matrix follows the leading dimension */
+    Matrix A = MatrixFactory::MakeRandomMatrix(4, n, -2.0, 4.0, Matrix::MATRIX_DENSE);
+    Matrix row = MatrixFactory::ShallowSubmatrix(A, 1, 1, 0, n - 1);
+    for (size_t j = 0; j < n; j++) {
+        _ASSERT_EQ(A.get(1, j), row.get(j));
+        _ASSERT_EQ(A.get(1, j), row[j]);
+    }
+    row[2] = 9.0;
+    _ASSERT_EQ(9.0, A.get(1, 2));
+
+    /* strided vector and its compact copy */
+    Matrix v = MatrixFactory::MakeRandomMatrix(2 * n, 1, -2.0, 4.0, Matrix::MATRIX_DENSE);
+    Matrix x = MatrixFactory::ShallowVector(v, n, 0, 2);
+    _ASSERT_NOT(x.isContiguous());
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_EQ(v[2 * i], x[i]);
+    }
+    Matrix xc(x);
+    _ASSERT(xc.isContiguous());
+
+    /* Norm1 */
+    Norm1 norm1(1.5);
+    double fx_ref;
+    double fx;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, norm1.call(xc, fx_ref));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, norm1.call(x, fx));
+    _ASSERT_NUM_EQ(fx_ref, fx, tol);
+    Matrix prox_ref(n, 1);
+    double f_prox_ref;
+    double f_prox;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, norm1.callProx(xc, gamma, prox_ref, f_prox_ref));
+    Matrix w = MatrixFactory::MakeRandomMatrix(3 * n, 1, -2.0, 4.0, Matrix::MATRIX_DENSE);
+    Matrix prox = MatrixFactory::ShallowVector(w, n, 1, 3);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, norm1.callProx(x, gamma, prox, f_prox));
+    _ASSERT_NUM_EQ(f_prox_ref, f_prox, tol);
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(prox_ref[i], w[3 * i + 1], tol);
+    }
+
+    /* IndBox */
+    double lb = -0.5;
+    double ub = 1.0;
+    IndBox box(lb, ub);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, box.callProx(xc, gamma, prox_ref, f_prox_ref));
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, box.callProx(x, gamma, prox, f_prox));
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(prox_ref[i], prox[i], tol);
+    }
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, box.call(prox, fx));
+    _ASSERT_EQ(0.0, fx);
+    x[0] = 2.0;
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, box.call(x, fx));
+    _ASSERT(std::isinf(fx));
+    Matrix lb_strided = MatrixFactory::ShallowVector(v, n, 0, 2);
+    Matrix ub_strided = MatrixFactory::ShallowVector(v, n, 1, 2);
+    _ASSERT_EXCEPTION(IndBox bad_box(lb_strided, ub_strided), std::invalid_argument);
+
+    /* HuberLoss with a strided gradient */
+    HuberLoss huber(0.7);
+    xc = x;
+    Matrix grad_ref(n, 1);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, huber.call(xc, fx_ref, grad_ref));
+    Matrix grad = MatrixFactory::ShallowVector(w, n, 2, 3);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, huber.call(x, fx, grad));
+    _ASSERT_NUM_EQ(fx_ref, fx, tol);
+    for (size_t i = 0; i < n; i++) {
+        _ASSERT_NUM_EQ(grad_ref[i], w[3 * i + 2], tol);
+    }
+}
+
+void TestVector::testOperators() {
+    const double tol = 1e-12;
+    Matrix A = MatrixFactory::MakeRandomMatrix(3, 5, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    MatrixOperator op(A);
+    Matrix x = MatrixFactory::MakeRandomMatrix(5, 1, -1.0, 2.0, Matrix::MATRIX_DENSE);
+    Matrix y_ref = op.call(x);
+    Vector y(3);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, op.call(y, 1.0, VectorView(x), 0.0));
+    for (size_t i = 0; i < 3; i++) {
+        _ASSERT_NUM_EQ(y_ref.get(i, 0), y[i], tol);
+    }
+    Matrix y_mat(3, 1, y.data());
+    Matrix z_ref = op.callAdjoint(y_mat);
+    Vector z(5);
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, op.callAdjoint(z, 1.0, y, 0.0));
+    for (size_t i = 0; i < 5; i++) {
+        _ASSERT_NUM_EQ(z_ref.get(i, 0), z[i], tol);
+    }
+
+    /* default implementation, with strided vectors */
+    OpReverseVector rev(4);
+    LinearOperator& T = rev;
+    double in[8] = {1.0, -1.0, 2.0, -1.0, 3.0, -1.0, 4.0, -1.0};
+    double res[4] = {1.0, 1.0, 1.0, 1.0};
+    _ASSERT_EQ(ForBESUtils::STATUS_OK, T.call(VectorView(res, 4), 2.0, VectorView(in, 4, 2), 1.0));
+    for (size_t i = 0; i < 4; i++) {
+        _ASSERT_NUM_EQ(1.0 + 2.0 * (4.0 - i), res[i], tol);
+    }
+}
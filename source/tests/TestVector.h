@@ -0,0 +1,47 @@
+/*
+ * File:   TestVector.h
+ * Author: ForBES contributors
+ *
+ * Created on Oct 17, 2026, 6:58:20 PM
+ */
+
+#ifndef TESTVECTOR_H
+#define	TESTVECTOR_H
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#define FORBES_TEST_UTILS
+#include "ForBES.h"
+
+class TestVector : public CPPUNIT_NS::TestFixture {
+    CPPUNIT_TEST_SUITE(TestVector);
+
+    CPPUNIT_TEST(testVector);
+    CPPUNIT_TEST(testViewOfMatrix);
+    CPPUNIT_TEST(testSegment);
+    CPPUNIT_TEST(testMult);
+    CPPUNIT_TEST(testFunctions);
+    CPPUNIT_TEST(testFunctionsOnStridedMatrices);
+    CPPUNIT_TEST(testOperators);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    TestVector();
+    virtual ~TestVector();
+    void setUp();
+    void tearDown();
+
+private:
+    void testVector();
+    void testViewOfMatrix();
+    void testSegment();
+    void testMult();
+    void testFunctions();
+    void testFunctionsOnStridedMatrices();
+    void testOperators();
+
+};
+
+#endif	/* TESTVECTOR_H */
+